@@ -0,0 +1,535 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element types in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* Microbenchmarks for the operations of the default element schemes.
+ * For every element class and several levels we take consecutive elements
+ * of a uniform refinement of the reference tree and time each operation
+ * on all of them. The results are written as CSV or JSON, reporting the
+ * time per operation in nanoseconds and the throughput.
+ * Optionally, a baseline in CSV format from a previous run is read and every
+ * operation that became slower than a given factor is reported.
+ *
+ * Usage example:
+ *   t8_bench_schemes -l 5 -o baseline.csv
+ *   t8_bench_schemes -l 5 -b baseline.csv
+ */
+
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_element_cxx.hxx>
+#include <sc_options.h>
+#include <string>
+#include <vector>
+#include <map>
+
+/* The result of timing one operation */
+typedef struct
+{
+  t8_eclass_t         eclass;
+  int                 level;
+  const char         *operation;
+  size_t              num_ops;
+  double              ns_per_op;
+} t8_bench_result_t;
+
+/* The data for the benchmarks of one element class and level */
+typedef struct
+{
+  t8_scheme_cxx_t    *scheme;
+  t8_eclass_scheme_c *ts;
+  int                 level;
+  size_t              num_elements;
+  std::vector < t8_element_t * >elements;
+  std::vector < t8_linearidx_t > ids;
+  t8_element_t       *out;
+  t8_element_t       *children[T8_ECLASS_MAX_CHILDREN];
+  /* One boundary element for each face class */
+  t8_element_t       *boundary[T8_ECLASS_COUNT];
+  /* Pairs of elements and root boundary faces */
+  std::vector < const t8_element_t *>boundary_elements;
+  std::vector < int >boundary_faces;
+  /* Families, each of num_children consecutive pointers */
+  std::vector < t8_element_t * >families;
+  std::vector < int >family_sizes;
+  long long           sink;
+} t8_bench_data_t;
+
+/* An operation to time on all elements */
+typedef void        (*t8_bench_op_t) (t8_bench_data_t *data);
+
+static void
+t8_bench_parent (t8_bench_data_t *data)
+{
+  for (size_t ielem = 0; ielem < data->num_elements; ielem++) {
+    data->ts->t8_element_parent (data->elements[ielem], data->out);
+  }
+}
+
+static void
+t8_bench_child (t8_bench_data_t *data)
+{
+  for (size_t ielem = 0; ielem < data->num_elements; ielem++) {
+    const t8_element_t *elem = data->elements[ielem];
+    data->ts->t8_element_child (elem,
+                                ielem %
+                                data->ts->t8_element_num_children (elem),
+                                data->out);
+  }
+}
+
+static void
+t8_bench_children (t8_bench_data_t *data)
+{
+  for (size_t ielem = 0; ielem < data->num_elements; ielem++) {
+    const t8_element_t *elem = data->elements[ielem];
+    data->ts->t8_element_children (elem,
+                                   data->ts->t8_element_num_children (elem),
+                                   data->children);
+  }
+}
+
+static void
+t8_bench_face_neighbor_inside (t8_bench_data_t *data)
+{
+  int                 neigh_face;
+
+  for (size_t ielem = 0; ielem < data->num_elements; ielem++) {
+    const t8_element_t *elem = data->elements[ielem];
+    data->sink +=
+      data->ts->t8_element_face_neighbor_inside (elem, data->out,
+                                                 ielem %
+                                                 data->ts->
+                                                 t8_element_num_faces (elem),
+                                                 &neigh_face);
+  }
+}
+
+static void
+t8_bench_set_linear_id (t8_bench_data_t *data)
+{
+  for (size_t ielem = 0; ielem < data->num_elements; ielem++) {
+    data->ts->t8_element_set_linear_id (data->out, data->level,
+                                        data->ids[ielem]);
+  }
+}
+
+static void
+t8_bench_get_linear_id (t8_bench_data_t *data)
+{
+  for (size_t ielem = 0; ielem < data->num_elements; ielem++) {
+    data->sink +=
+      data->ts->t8_element_get_linear_id (data->elements[ielem], data->level);
+  }
+}
+
+static void
+t8_bench_successor (t8_bench_data_t *data)
+{
+  for (size_t ielem = 0; ielem + 1 < data->num_elements; ielem++) {
+    data->ts->t8_element_successor (data->elements[ielem], data->out,
+                                    data->level);
+  }
+}
+
+static void
+t8_bench_compare (t8_bench_data_t *data)
+{
+  for (size_t ielem = 0; ielem + 1 < data->num_elements; ielem++) {
+    data->sink +=
+      data->ts->t8_element_compare (data->elements[ielem],
+                                    data->elements[ielem + 1]);
+  }
+}
+
+static void
+t8_bench_is_family (t8_bench_data_t *data)
+{
+  size_t              offset = 0;
+
+  for (size_t ifam = 0; ifam < data->family_sizes.size (); ifam++) {
+    data->sink += data->ts->t8_element_is_family (&data->families[offset]);
+    offset += data->family_sizes[ifam];
+  }
+}
+
+static void
+t8_bench_nca (t8_bench_data_t *data)
+{
+  for (size_t ielem = 0; ielem + 1 < data->num_elements; ielem++) {
+    data->ts->t8_element_nca (data->elements[ielem],
+                              data->elements[ielem + 1], data->out);
+  }
+}
+
+static void
+t8_bench_boundary_face (t8_bench_data_t *data)
+{
+  for (size_t ielem = 0; ielem < data->boundary_elements.size (); ielem++) {
+    const t8_element_t *elem = data->boundary_elements[ielem];
+    const int           face = data->boundary_faces[ielem];
+    const int           face_shape =
+      data->ts->t8_element_face_shape (elem, face);
+    data->ts->t8_element_boundary_face (elem, face,
+                                        data->boundary[face_shape],
+                                        data->scheme->
+                                        eclass_schemes[face_shape]);
+  }
+}
+
+static void
+t8_bench_vertex_reference_coords (t8_bench_data_t *data)
+{
+  double              coords[3];
+
+  for (size_t ielem = 0; ielem < data->num_elements; ielem++) {
+    const t8_element_t *elem = data->elements[ielem];
+    data->ts->t8_element_vertex_reference_coords (elem,
+                                                  ielem %
+                                                  data->ts->
+                                                  t8_element_num_corners
+                                                  (elem), coords);
+    data->sink += (long long) coords[0];
+  }
+}
+
+/* Build num_elements consecutive elements of level starting at the first
+ * element of the reference tree and the helper data for the operations. */
+static void
+t8_bench_data_init (t8_bench_data_t *data, t8_scheme_cxx_t *scheme,
+                    t8_eclass_t eclass, int level, size_t max_elements)
+{
+  t8_element_sfc_iterator_t iter;
+
+  data->scheme = scheme;
+  data->ts = scheme->eclass_schemes[eclass];
+  data->level = level;
+  data->sink = 0;
+  data->num_elements =
+    SC_MIN ((size_t) data->ts->t8_element_count_leafs_from_root (level),
+            max_elements);
+  data->elements.resize (data->num_elements);
+  data->ids.resize (data->num_elements);
+  data->ts->t8_element_new (data->num_elements, data->elements.data ());
+  data->ts->t8_element_new (1, &data->out);
+  data->ts->t8_element_new (T8_ECLASS_MAX_CHILDREN, data->children);
+  for (int ieclass = T8_ECLASS_ZERO; ieclass < T8_ECLASS_COUNT; ieclass++) {
+    scheme->eclass_schemes[ieclass]->t8_element_new (1,
+                                                     &data->boundary
+                                                     [ieclass]);
+  }
+
+  t8_element_sfc_iterator_init (&iter, data->ts, level, 0);
+  for (size_t ielem = 0; ielem < data->num_elements; ielem++) {
+    data->ts->t8_element_copy (t8_element_sfc_iterator_current (&iter),
+                               data->elements[ielem]);
+    data->ids[ielem] = data->num_elements - 1 - ielem;
+    if (ielem + 1 < data->num_elements) {
+      t8_element_sfc_iterator_next (&iter);
+    }
+  }
+  t8_element_sfc_iterator_reset (&iter);
+
+  for (size_t ielem = 0; ielem < data->num_elements; ielem++) {
+    const t8_element_t *elem = data->elements[ielem];
+    /* The first face of elem at the root boundary */
+    for (int iface = 0; iface < data->ts->t8_element_num_faces (elem);
+         iface++) {
+      if (data->ts->t8_element_is_root_boundary (elem, iface)) {
+        data->boundary_elements.push_back (elem);
+        data->boundary_faces.push_back (iface);
+        break;
+      }
+    }
+    /* The elements are consecutive, hence full families start with child 0 */
+    if (data->ts->t8_element_child_id (elem) == 0 && level > 0) {
+      const int           num_siblings =
+        data->ts->t8_element_num_siblings (elem);
+      if (ielem + num_siblings <= data->num_elements) {
+        for (int isib = 0; isib < num_siblings; isib++) {
+          data->families.push_back (data->elements[ielem + isib]);
+        }
+        data->family_sizes.push_back (num_siblings);
+      }
+    }
+  }
+}
+
+static void
+t8_bench_data_reset (t8_bench_data_t *data)
+{
+  data->ts->t8_element_destroy (data->num_elements, data->elements.data ());
+  data->ts->t8_element_destroy (1, &data->out);
+  data->ts->t8_element_destroy (T8_ECLASS_MAX_CHILDREN, data->children);
+  for (int ieclass = T8_ECLASS_ZERO; ieclass < T8_ECLASS_COUNT; ieclass++) {
+    data->scheme->eclass_schemes[ieclass]->t8_element_destroy (1,
+                                                               &data->boundary
+                                                               [ieclass]);
+  }
+}
+
+/* Time an operation. We take the minimum over all repetitions. */
+static void
+t8_bench_time (t8_bench_data_t *data, t8_eclass_t eclass, const char *name,
+               t8_bench_op_t op, size_t num_ops, int repetitions,
+               std::vector < t8_bench_result_t > &results)
+{
+  double              best = -1;
+
+  if (num_ops == 0) {
+    return;
+  }
+  for (int irep = 0; irep < repetitions; irep++) {
+    const double        start = sc_MPI_Wtime ();
+    op (data);
+    const double        elapsed = sc_MPI_Wtime () - start;
+    if (best < 0 || elapsed < best) {
+      best = elapsed;
+    }
+  }
+  t8_bench_result_t   result;
+  result.eclass = eclass;
+  result.level = data->level;
+  result.operation = name;
+  result.num_ops = num_ops;
+  result.ns_per_op = 1e9 * best / num_ops;
+  results.push_back (result);
+}
+
+static void
+t8_bench_write_results (FILE *file,
+                        const std::vector < t8_bench_result_t > &results,
+                        int json)
+{
+  if (json) {
+    fprintf (file, "[\n");
+  }
+  else {
+    fprintf (file, "eclass,level,operation,num_ops,ns_per_op,mops_per_s\n");
+  }
+  for (size_t ires = 0; ires < results.size (); ires++) {
+    const t8_bench_result_t *res = &results[ires];
+    const double        mops =
+      res->ns_per_op > 0 ? 1e3 / res->ns_per_op : 0;
+    if (json) {
+      fprintf (file,
+               "  {\"eclass\": \"%s\", \"level\": %i, \"operation\": \"%s\", "
+               "\"num_ops\": %zu, \"ns_per_op\": %.3f, \"mops_per_s\": %.3f}%s\n",
+               t8_eclass_to_string[res->eclass], res->level, res->operation,
+               res->num_ops, res->ns_per_op, mops,
+               ires + 1 < results.size ()? "," : "");
+    }
+    else {
+      fprintf (file, "%s,%i,%s,%zu,%.3f,%.3f\n",
+               t8_eclass_to_string[res->eclass], res->level, res->operation,
+               res->num_ops, res->ns_per_op, mops);
+    }
+  }
+  if (json) {
+    fprintf (file, "]\n");
+  }
+}
+
+/* Read a baseline in CSV format and report all operations that are slower
+ * than the baseline by more than the given factor.
+ * Return the number of regressions. */
+static int
+t8_bench_compare_baseline (const char *filename,
+                           const std::vector < t8_bench_result_t > &results,
+                           double factor)
+{
+  std::map < std::string, double >baseline;
+  char                line[BUFSIZ], eclass[BUFSIZ], operation[BUFSIZ];
+  int                 level, num_regressions = 0;
+  size_t              num_ops;
+  double              ns_per_op, mops;
+  FILE               *file = fopen (filename, "r");
+
+  SC_CHECK_ABORTF (file != NULL, "Could not open baseline file %s",
+                   filename);
+  while (fgets (line, BUFSIZ, file) != NULL) {
+    for (char *c = line; *c != '\0'; c++) {
+      if (*c == ',') {
+        *c = ' ';
+      }
+    }
+    if (sscanf (line, "%s %i %s %zu %lf %lf", eclass, &level, operation,
+                &num_ops, &ns_per_op, &mops) == 6) {
+      baseline[std::string (eclass) + "/" + std::to_string (level) + "/" +
+               operation] = ns_per_op;
+    }
+  }
+  fclose (file);
+
+  for (size_t ires = 0; ires < results.size (); ires++) {
+    const t8_bench_result_t *res = &results[ires];
+    const std::string   key =
+      std::string (t8_eclass_to_string[res->eclass]) + "/" +
+      std::to_string (res->level) + "/" + res->operation;
+    if (baseline.count (key) == 0 || baseline[key] <= 0) {
+      continue;
+    }
+    const double        ratio = res->ns_per_op / baseline[key];
+    if (ratio > factor) {
+      t8_global_productionf ("Regression %s: %.3f ns/op, baseline %.3f ns/op "
+                             "(%.2fx)\n", key.c_str (), res->ns_per_op,
+                             baseline[key], ratio);
+      num_regressions++;
+    }
+  }
+  t8_global_productionf ("%i regressions compared to baseline %s\n",
+                         num_regressions, filename);
+  return num_regressions;
+}
+
+static int
+t8_bench_schemes (int max_level, size_t max_elements, int repetitions,
+                  int json, const char *output, const char *baseline,
+                  double factor)
+{
+  t8_scheme_cxx_t    *scheme = t8_scheme_new_default_cxx ();
+  std::vector < t8_bench_result_t > results;
+  t8_bench_data_t     data;
+  int                 num_regressions = 0;
+
+  for (int ieclass = T8_ECLASS_ZERO; ieclass < T8_ECLASS_COUNT; ieclass++) {
+    const t8_eclass_t   eclass = (t8_eclass_t) ieclass;
+    t8_eclass_scheme_c *ts = scheme->eclass_schemes[eclass];
+    for (int level = 1;
+         level <= SC_MIN (max_level, ts->t8_element_maxlevel ()); level++) {
+      const int           has_faces = t8_eclass_to_dimension[eclass] > 0;
+      t8_bench_data_init (&data, scheme, eclass, level, max_elements);
+      const size_t        num = data.num_elements;
+
+      t8_bench_time (&data, eclass, "parent", t8_bench_parent, num,
+                     repetitions, results);
+      t8_bench_time (&data, eclass, "child", t8_bench_child, num,
+                     repetitions, results);
+      t8_bench_time (&data, eclass, "children", t8_bench_children, num,
+                     repetitions, results);
+      t8_bench_time (&data, eclass, "face_neighbor_inside",
+                     t8_bench_face_neighbor_inside, has_faces ? num : 0,
+                     repetitions, results);
+      t8_bench_time (&data, eclass, "set_linear_id", t8_bench_set_linear_id,
+                     num, repetitions, results);
+      t8_bench_time (&data, eclass, "get_linear_id", t8_bench_get_linear_id,
+                     num, repetitions, results);
+      t8_bench_time (&data, eclass, "successor", t8_bench_successor,
+                     num - 1, repetitions, results);
+      t8_bench_time (&data, eclass, "compare", t8_bench_compare, num - 1,
+                     repetitions, results);
+      t8_bench_time (&data, eclass, "is_family", t8_bench_is_family,
+                     data.family_sizes.size (), repetitions, results);
+      t8_bench_time (&data, eclass, "nca", t8_bench_nca, num - 1,
+                     repetitions, results);
+      t8_bench_time (&data, eclass, "boundary_face", t8_bench_boundary_face,
+                     has_faces ? data.boundary_elements.size () : 0,
+                     repetitions, results);
+      t8_bench_time (&data, eclass, "vertex_reference_coords",
+                     t8_bench_vertex_reference_coords, num, repetitions,
+                     results);
+      t8_bench_data_reset (&data);
+    }
+  }
+
+  if (output != NULL) {
+    FILE               *file = fopen (output, "w");
+    SC_CHECK_ABORTF (file != NULL, "Could not open output file %s", output);
+    t8_bench_write_results (file, results, json);
+    fclose (file);
+    t8_global_productionf ("Wrote %zu results to %s\n", results.size (),
+                           output);
+  }
+  else {
+    t8_bench_write_results (stdout, results, json);
+  }
+  if (baseline != NULL) {
+    num_regressions = t8_bench_compare_baseline (baseline, results, factor);
+  }
+  t8_scheme_cxx_unref (&scheme);
+  return num_regressions;
+}
+
+int
+main (int argc, char **argv)
+{
+  int                 mpiret;
+  sc_options_t       *opt;
+  int                 max_level, max_elements, repetitions, json;
+  int                 parsed, helpme, mpirank, num_regressions = 0;
+  const char         *output, *baseline;
+  double              factor;
+
+  mpiret = sc_MPI_Init (&argc, &argv);
+  SC_CHECK_MPI (mpiret);
+
+  sc_init (sc_MPI_COMM_WORLD, 1, 1, NULL, SC_LP_ESSENTIAL);
+  t8_init (SC_LP_DEFAULT);
+
+  opt = sc_options_new (argv[0]);
+  sc_options_add_switch (opt, 'h', "help", &helpme,
+                         "Display a short help message.");
+  sc_options_add_int (opt, 'l', "level", &max_level, 5,
+                      "The finest level to benchmark, starting at 1.");
+  sc_options_add_int (opt, 'n', "num-elements", &max_elements, 100000,
+                      "The maximum number of elements per level.");
+  sc_options_add_int (opt, 'r', "repetitions", &repetitions, 5,
+                      "The number of repetitions of each measurement. "
+                      "The fastest is reported.");
+  sc_options_add_switch (opt, 'j', "json", &json,
+                         "Write JSON instead of CSV.");
+  sc_options_add_string (opt, 'o', "output", &output, NULL,
+                         "Write the results to this file instead of stdout.");
+  sc_options_add_string (opt, 'b', "baseline", &baseline, NULL,
+                         "A CSV file of a previous run to compare against.");
+  sc_options_add_double (opt, 'f', "factor", &factor, 1.2,
+                         "Report operations slower than the baseline by more "
+                         "than this factor.");
+
+  parsed =
+    sc_options_parse (t8_get_package_id (), SC_LP_ERROR, opt, argc, argv);
+  mpiret = sc_MPI_Comm_rank (sc_MPI_COMM_WORLD, &mpirank);
+  SC_CHECK_MPI (mpiret);
+  if (helpme) {
+    sc_options_print_usage (t8_get_package_id (), SC_LP_ERROR, opt, NULL);
+  }
+  else if (parsed >= 0 && 1 <= max_level && 1 < max_elements
+           && 1 <= repetitions && factor > 0) {
+    /* The benchmark is serial */
+    if (mpirank == 0) {
+      num_regressions =
+        t8_bench_schemes (max_level, max_elements, repetitions, json, output,
+                          baseline, factor);
+    }
+  }
+  else {
+    /* wrong usage */
+    t8_global_productionf ("\n\t ERROR: Wrong usage.\n\n");
+    sc_options_print_usage (t8_get_package_id (), SC_LP_ERROR, opt, NULL);
+  }
+
+  sc_options_destroy (opt);
+  sc_finalize ();
+
+  mpiret = sc_MPI_Finalize ();
+  SC_CHECK_MPI (mpiret);
+
+  return num_regressions > 0;
+}
@@ -0,0 +1,142 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element types in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* Compare the memory footprint of the leaf elements of a uniform forest
+ * with the footprint of a compact element array storing them packed with
+ * t8_element_array_pack. We also measure the time needed to encode and decode. */
+
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_forest.h>
+#include <t8_data/t8_containers.h>
+#include <sc_flops.h>
+#include <sc_statistics.h>
+#include <sc_options.h>
+#include <t8_cmesh/t8_cmesh_examples.h>
+
+static void
+t8_time_compact_elements (int level, t8_eclass_t eclass)
+{
+  t8_forest_t         forest;
+  t8_eclass_scheme_c *ts;
+  t8_element_array_t *leafs;
+  t8_element_array_t  decoded;
+  t8_element_compact_array_t *compact;
+  t8_locidx_t         itree, num_trees;
+  size_t              full_bytes = 0, compact_bytes = 0;
+  sc_flopinfo_t       fi, snapshot;
+  sc_statinfo_t       stats[4];
+
+  forest =
+    t8_forest_new_uniform (t8_cmesh_new_hypercube
+                           (eclass, sc_MPI_COMM_WORLD, 0, 0, 0),
+                           t8_scheme_new_default_cxx (), level, 0,
+                           sc_MPI_COMM_WORLD);
+  num_trees = t8_forest_get_num_local_trees (forest);
+  compact = T8_ALLOC (t8_element_compact_array_t, num_trees);
+
+  /* Encode the leafs of all local trees */
+  sc_flops_start (&fi);
+  sc_flops_snap (&fi, &snapshot);
+  for (itree = 0; itree < num_trees; itree++) {
+    ts = t8_forest_get_eclass_scheme (forest,
+                                      t8_forest_get_tree_class (forest,
+                                                                itree));
+    leafs = t8_forest_tree_get_leafs (forest, itree);
+    t8_element_compact_array_init (&compact[itree], ts);
+    t8_element_compact_array_encode (&compact[itree], leafs);
+    full_bytes += t8_element_array_get_count (leafs) * ts->t8_element_size ();
+    compact_bytes += t8_element_compact_array_get_bytes (&compact[itree]);
+  }
+  sc_flops_shot (&fi, &snapshot);
+  sc_stats_set1 (&stats[0], snapshot.iwtime, "Encode");
+
+  /* Decode them again */
+  sc_flops_snap (&fi, &snapshot);
+  for (itree = 0; itree < num_trees; itree++) {
+    ts = compact[itree].scheme;
+    t8_element_array_init (&decoded, ts);
+    t8_element_compact_array_decode (&compact[itree], 0,
+                                     t8_element_compact_array_get_count
+                                     (&compact[itree]), &decoded);
+    t8_element_array_reset (&decoded);
+    t8_element_compact_array_reset (&compact[itree]);
+  }
+  sc_flops_shot (&fi, &snapshot);
+  sc_stats_set1 (&stats[1], snapshot.iwtime, "Decode");
+  sc_stats_set1 (&stats[2], (double) full_bytes, "Element bytes");
+  sc_stats_set1 (&stats[3], (double) compact_bytes, "Compact bytes");
+
+  T8_FREE (compact);
+  t8_forest_unref (&forest);
+
+  sc_stats_compute (sc_MPI_COMM_WORLD, 4, stats);
+  sc_stats_print (t8_get_package_id (), SC_LP_STATISTICS, 4, stats, 1, 1);
+}
+
+int
+main (int argc, char **argv)
+{
+  int                 mpiret;
+  sc_options_t       *opt;
+  int                 level, eclass_int;
+  int                 parsed, helpme;
+
+  mpiret = sc_MPI_Init (&argc, &argv);
+  SC_CHECK_MPI (mpiret);
+
+  sc_init (sc_MPI_COMM_WORLD, 1, 1, NULL, SC_LP_ESSENTIAL);
+  t8_init (SC_LP_DEFAULT);
+
+  opt = sc_options_new (argv[0]);
+  sc_options_add_switch (opt, 'h', "help", &helpme,
+                         "Display a short help message.");
+  sc_options_add_int (opt, 'l', "level", &level, 4,
+                      "The uniform refinement level of the forest.");
+  sc_options_add_int (opt, 'e', "elements", &eclass_int, 4,
+                      "This option specifies the type of elements to use.\n"
+                      "\t\t0 - vertex\n\t\t1 - line\n\t\t2 - quad\n"
+                      "\t\t3 - triangle\n\t\t4 - hexahedron\n"
+                      "\t\t5 - tetrahedron\n\t\t6 - prism\n\t\t7 - pyramid");
+
+  parsed =
+    sc_options_parse (t8_get_package_id (), SC_LP_ERROR, opt, argc, argv);
+  if (helpme) {
+    sc_options_print_usage (t8_get_package_id (), SC_LP_ERROR, opt, NULL);
+  }
+  else if (parsed >= 0 && 0 <= level && T8_ECLASS_ZERO <= eclass_int
+           && eclass_int < T8_ECLASS_COUNT) {
+    t8_time_compact_elements (level, (t8_eclass_t) eclass_int);
+  }
+  else {
+    /* wrong usage */
+    t8_global_productionf ("\n\t ERROR: Wrong usage.\n\n");
+    sc_options_print_usage (t8_get_package_id (), SC_LP_ERROR, opt, NULL);
+  }
+
+  sc_options_destroy (opt);
+  sc_finalize ();
+
+  mpiret = sc_MPI_Finalize ();
+  SC_CHECK_MPI (mpiret);
+
+  return 0;
+}
@@ -0,0 +1,501 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element types in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* This benchmark runs the production cycle of a forest
+ *   new -> adapt -> balance -> partition -> ghost -> ghost_exchange -> iterate
+ * on a choice of coarse meshes and refinement patterns and reports the
+ * runtime of each phase together with the message volume of partition
+ * and ghost, the peak resident set size and the number of live t8code
+ * allocations. All quantities are collected over all processes and all
+ * repetitions and are written in JSON format, such that scaling curves can
+ * be tracked over different versions of t8code.
+ */
+
+#include <sys/resource.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_forest.h>
+#include <t8_forest/t8_forest_types.h>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <sc_flops.h>
+#include <sc_statistics.h>
+#include <sc_options.h>
+
+/* The coarse meshes that can be chosen with the -m option. */
+enum
+{
+  T8_PIPELINE_MESH_HYPERCUBE,
+  T8_PIPELINE_MESH_HYPERCUBE_HYBRID,
+  T8_PIPELINE_MESH_FULL_HYBRID,
+  T8_PIPELINE_MESH_BIGMESH,
+  T8_PIPELINE_MESH_COUNT
+};
+
+static const char  *t8_pipeline_mesh_names[T8_PIPELINE_MESH_COUNT] = {
+  "hypercube",
+  "hypercube_hybrid",
+  "full_hybrid",
+  "bigmesh"
+};
+
+/* The refinement patterns that can be chosen with the -p option. */
+enum
+{
+  T8_PIPELINE_PATTERN_SHELL,
+  T8_PIPELINE_PATTERN_UNIFORM,
+  T8_PIPELINE_PATTERN_EVERY_OTHER,
+  T8_PIPELINE_PATTERN_COUNT
+};
+
+static const char  *t8_pipeline_pattern_names[T8_PIPELINE_PATTERN_COUNT] = {
+  "shell",
+  "uniform",
+  "every_other"
+};
+
+/* The quantities that we measure in each repetition. */
+enum
+{
+  T8_PIPELINE_STAT_NEW,
+  T8_PIPELINE_STAT_ADAPT,
+  T8_PIPELINE_STAT_BALANCE,
+  T8_PIPELINE_STAT_PARTITION,
+  T8_PIPELINE_STAT_GHOST,
+  T8_PIPELINE_STAT_GHOST_EXCHANGE,
+  T8_PIPELINE_STAT_GHOST_EXCHANGE_WAIT,
+  T8_PIPELINE_STAT_ITERATE,
+  T8_PIPELINE_STAT_TOTAL,
+  T8_PIPELINE_STAT_LOCAL_ELEMENTS,
+  T8_PIPELINE_STAT_BALANCE_ROUNDS,
+  T8_PIPELINE_STAT_PARTITION_ELEMENTS_SHIPPED,
+  T8_PIPELINE_STAT_PARTITION_BYTES_SENT,
+  T8_PIPELINE_STAT_PARTITION_PROCS_SENT,
+  T8_PIPELINE_STAT_GHOSTS_SHIPPED,
+  T8_PIPELINE_STAT_GHOSTS_RECEIVED,
+  T8_PIPELINE_STAT_GHOST_REMOTES,
+  T8_PIPELINE_STAT_GHOST_EXCHANGE_BYTES,
+  T8_PIPELINE_STAT_PEAK_RSS_KB,
+  T8_PIPELINE_STAT_LIVE_ALLOCATIONS,
+  T8_PIPELINE_STAT_COUNT
+};
+
+static const char  *t8_pipeline_stat_names[T8_PIPELINE_STAT_COUNT] = {
+  "time_new",
+  "time_adapt",
+  "time_balance",
+  "time_partition",
+  "time_ghost",
+  "time_ghost_exchange",
+  "time_ghost_exchange_wait",
+  "time_iterate",
+  "time_total",
+  "local_elements",
+  "balance_rounds",
+  "partition_elements_shipped",
+  "partition_bytes_sent",
+  "partition_procs_sent",
+  "ghosts_shipped",
+  "ghosts_received",
+  "ghost_remotes",
+  "ghost_exchange_bytes",
+  "peak_rss_kb",
+  "live_allocations"
+};
+
+/* The data passed to the adapt callback. */
+typedef struct
+{
+  int                 pattern;  /* The refinement pattern. */
+  int                 dim;      /* The dimension of the coarse mesh. */
+  int                 min_level;        /* Elements are not coarsened below this level. */
+  int                 max_level;        /* Elements are not refined beyond this level. */
+  double              midpoint[3];      /* The midpoint of the refined shell. */
+  double              radius;   /* The radius of the refined shell. */
+  double              width;    /* The width of the refined shell. */
+} t8_pipeline_adapt_data_t;
+
+/* Refine the elements according to the chosen pattern.
+ * For the shell pattern, we refine all elements whose centroid has
+ * distance radius +- width to the midpoint and coarsen all others. */
+static int
+t8_pipeline_adapt (t8_forest_t forest, t8_forest_t forest_from,
+                   t8_locidx_t which_tree, t8_locidx_t lelement_id,
+                   t8_eclass_scheme_c *ts, const int is_family,
+                   const int num_elements, t8_element_t *elements[])
+{
+  const t8_pipeline_adapt_data_t *adapt_data =
+    (const t8_pipeline_adapt_data_t *) t8_forest_get_user_data (forest);
+  double              centroid[3], dist = 0;
+  int                 level, idim;
+
+  T8_ASSERT (adapt_data != NULL);
+  level = ts->t8_element_level (elements[0]);
+
+  switch (adapt_data->pattern) {
+  case T8_PIPELINE_PATTERN_UNIFORM:
+    return level < adapt_data->max_level;
+  case T8_PIPELINE_PATTERN_EVERY_OTHER:
+    return level < adapt_data->max_level && lelement_id % 2 == 0;
+  case T8_PIPELINE_PATTERN_SHELL:
+    t8_forest_element_centroid (forest_from, which_tree, elements[0],
+                                centroid);
+    for (idim = 0; idim < adapt_data->dim; idim++) {
+      dist += (centroid[idim] - adapt_data->midpoint[idim])
+        * (centroid[idim] - adapt_data->midpoint[idim]);
+    }
+    dist = sqrt (dist);
+    if (fabs (dist - adapt_data->radius) <= adapt_data->width) {
+      return level < adapt_data->max_level;
+    }
+    if (is_family && level > adapt_data->min_level) {
+      return -1;
+    }
+    return 0;
+  default:
+    SC_ABORT_NOT_REACHED ();
+  }
+  return 0;
+}
+
+/* Return the peak resident set size of this process in kilobytes. */
+static double
+t8_pipeline_peak_rss ()
+{
+  struct rusage       usage;
+
+  if (getrusage (RUSAGE_SELF, &usage) != 0) {
+    return -1;
+  }
+  /* On linux ru_maxrss is given in kilobytes. */
+  return (double) usage.ru_maxrss;
+}
+
+static              t8_cmesh_t
+t8_pipeline_new_cmesh (int mesh, t8_eclass_t eclass, int num_trees)
+{
+  switch (mesh) {
+  case T8_PIPELINE_MESH_HYPERCUBE:
+    return t8_cmesh_new_hypercube (eclass, sc_MPI_COMM_WORLD, 0, 0, 0);
+  case T8_PIPELINE_MESH_HYPERCUBE_HYBRID:
+    return t8_cmesh_new_hypercube_hybrid (sc_MPI_COMM_WORLD, 0, 0);
+  case T8_PIPELINE_MESH_FULL_HYBRID:
+    return t8_cmesh_new_full_hybrid (sc_MPI_COMM_WORLD);
+  case T8_PIPELINE_MESH_BIGMESH:
+    return t8_cmesh_new_bigmesh (eclass, num_trees, sc_MPI_COMM_WORLD);
+  default:
+    SC_ABORT_NOT_REACHED ();
+  }
+  return NULL;
+}
+
+/* Run one cycle of the pipeline and store the measured values of this
+ * process in values. */
+static void
+t8_pipeline_run (t8_cmesh_t cmesh, t8_pipeline_adapt_data_t *adapt_data,
+                 double *values, t8_gloidx_t *num_global_elements)
+{
+  t8_forest_t         forest, forest_adapt;
+  t8_locidx_t         num_local, num_ghosts, ltree, ielement;
+  t8_locidx_t         num_trees, tree_elements;
+  const t8_element_t *element;
+  sc_array_t          element_data;
+  double              start, total_start, sum = 0;
+  int                 procs_sent, balance_rounds, ghosts_sent;
+
+  total_start = sc_MPI_Wtime ();
+
+  /* new */
+  start = sc_MPI_Wtime ();
+  t8_cmesh_ref (cmesh);
+  t8_forest_init (&forest);
+  t8_forest_set_cmesh (forest, cmesh, sc_MPI_COMM_WORLD);
+  t8_forest_set_scheme (forest, t8_scheme_new_default_cxx ());
+  t8_forest_set_level (forest, adapt_data->min_level);
+  t8_forest_commit (forest);
+  values[T8_PIPELINE_STAT_NEW] = sc_MPI_Wtime () - start;
+
+  /* adapt, balance, partition and ghost */
+  t8_forest_init (&forest_adapt);
+  t8_forest_set_profiling (forest_adapt, 1);
+  t8_forest_set_user_data (forest_adapt, adapt_data);
+  t8_forest_set_adapt (forest_adapt, forest, t8_pipeline_adapt, 1);
+  t8_forest_set_balance (forest_adapt, NULL, 1);
+  t8_forest_set_partition (forest_adapt, NULL, 0);
+  t8_forest_set_ghost (forest_adapt, 1, T8_GHOST_FACES);
+  t8_forest_commit (forest_adapt);
+  forest = forest_adapt;
+
+  values[T8_PIPELINE_STAT_ADAPT] = t8_forest_profile_get_adapt_time (forest);
+  values[T8_PIPELINE_STAT_BALANCE] =
+    t8_forest_profile_get_balance_time (forest, &balance_rounds);
+  values[T8_PIPELINE_STAT_PARTITION] =
+    t8_forest_profile_get_partition_time (forest, &procs_sent);
+  values[T8_PIPELINE_STAT_GHOST] =
+    t8_forest_profile_get_ghost_time (forest, &ghosts_sent);
+  values[T8_PIPELINE_STAT_BALANCE_ROUNDS] = balance_rounds;
+  values[T8_PIPELINE_STAT_PARTITION_PROCS_SENT] = procs_sent;
+  values[T8_PIPELINE_STAT_PARTITION_ELEMENTS_SHIPPED] =
+    forest->profile->partition_elements_shipped;
+  values[T8_PIPELINE_STAT_PARTITION_BYTES_SENT] =
+    forest->profile->partition_bytes_sent;
+  values[T8_PIPELINE_STAT_GHOSTS_SHIPPED] = ghosts_sent;
+  values[T8_PIPELINE_STAT_GHOSTS_RECEIVED] =
+    forest->profile->ghosts_received;
+  values[T8_PIPELINE_STAT_GHOST_REMOTES] = forest->profile->ghosts_remotes;
+
+  /* ghost exchange of one double per element */
+  num_local = t8_forest_get_local_num_elements (forest);
+  num_ghosts = t8_forest_get_num_ghosts (forest);
+  sc_array_init_size (&element_data, sizeof (double), num_local + num_ghosts);
+  for (ielement = 0; ielement < num_local; ielement++) {
+    *(double *) sc_array_index_int (&element_data, ielement) = ielement;
+  }
+  start = sc_MPI_Wtime ();
+  t8_forest_ghost_exchange_data (forest, &element_data);
+  values[T8_PIPELINE_STAT_GHOST_EXCHANGE] = sc_MPI_Wtime () - start;
+  values[T8_PIPELINE_STAT_GHOST_EXCHANGE_WAIT] =
+    t8_forest_profile_get_ghostexchange_waittime (forest);
+  values[T8_PIPELINE_STAT_GHOST_EXCHANGE_BYTES] =
+    (double) ghosts_sent * sizeof (double);
+
+  /* iterate over the leaves and combine their volume with the data */
+  start = sc_MPI_Wtime ();
+  num_trees = t8_forest_get_num_local_trees (forest);
+  for (ltree = 0, ielement = 0; ltree < num_trees; ltree++) {
+    tree_elements = t8_forest_get_tree_num_elements (forest, ltree);
+    for (t8_locidx_t ieltree = 0; ieltree < tree_elements;
+         ieltree++, ielement++) {
+      element = t8_forest_get_element_in_tree (forest, ltree, ieltree);
+      sum += t8_forest_element_volume (forest, ltree, element)
+        * *(double *) sc_array_index_int (&element_data, ielement);
+    }
+  }
+  values[T8_PIPELINE_STAT_ITERATE] = sc_MPI_Wtime () - start;
+  t8_debugf ("Weighted volume sum %f\n", sum);
+
+  values[T8_PIPELINE_STAT_TOTAL] = sc_MPI_Wtime () - total_start;
+  values[T8_PIPELINE_STAT_LOCAL_ELEMENTS] = num_local;
+  values[T8_PIPELINE_STAT_PEAK_RSS_KB] = t8_pipeline_peak_rss ();
+  values[T8_PIPELINE_STAT_LIVE_ALLOCATIONS] =
+    sc_memory_status (t8_get_package_id ());
+  *num_global_elements = t8_forest_get_global_num_elements (forest);
+
+  t8_forest_print_profile (forest);
+  sc_array_reset (&element_data);
+  t8_forest_unref (&forest);
+}
+
+/* Write the collected statistics as JSON to file. */
+static void
+t8_pipeline_write_json (FILE *file, sc_statinfo_t *stats, int mesh,
+                        t8_eclass_t eclass, int pattern,
+                        const t8_pipeline_adapt_data_t *adapt_data,
+                        int repetitions, t8_gloidx_t num_global_elements)
+{
+  int                 mpisize, mpiret, istat;
+
+  mpiret = sc_MPI_Comm_size (sc_MPI_COMM_WORLD, &mpisize);
+  SC_CHECK_MPI (mpiret);
+
+  fprintf (file, "{\n  \"benchmark\": \"t8_time_forest_pipeline\",\n");
+  fprintf (file, "  \"config\": {\n");
+  fprintf (file, "    \"mesh\": \"%s\",\n", t8_pipeline_mesh_names[mesh]);
+  fprintf (file, "    \"eclass\": \"%s\",\n",
+           mesh == T8_PIPELINE_MESH_HYPERCUBE
+           || mesh == T8_PIPELINE_MESH_BIGMESH ? t8_eclass_to_string[eclass]
+           : "hybrid");
+  fprintf (file, "    \"pattern\": \"%s\",\n",
+           t8_pipeline_pattern_names[pattern]);
+  fprintf (file, "    \"initial_level\": %i,\n", adapt_data->min_level);
+  fprintf (file, "    \"max_level\": %i,\n", adapt_data->max_level);
+  fprintf (file, "    \"repetitions\": %i,\n", repetitions);
+  fprintf (file, "    \"num_procs\": %i\n  },\n", mpisize);
+  fprintf (file, "  \"global_num_elements\": %lli,\n",
+           (long long) num_global_elements);
+  fprintf (file, "  \"stats\": {\n");
+  for (istat = 0; istat < T8_PIPELINE_STAT_COUNT; istat++) {
+    fprintf (file, "    \"%s\": {\"min\": %.9g, \"max\": %.9g, "
+             "\"avg\": %.9g, \"stddev\": %.9g, \"count\": %li}%s\n",
+             t8_pipeline_stat_names[istat], stats[istat].min,
+             stats[istat].max, stats[istat].average, stats[istat].standev,
+             stats[istat].count,
+             istat + 1 < T8_PIPELINE_STAT_COUNT ? "," : "");
+  }
+  fprintf (file, "  }\n}\n");
+}
+
+static void
+t8_pipeline (int mesh, t8_eclass_t eclass, int num_trees, int pattern,
+             int initial_level, int max_level, int repetitions,
+             const char *json_file)
+{
+  t8_cmesh_t          cmesh;
+  t8_pipeline_adapt_data_t adapt_data;
+  sc_statinfo_t       stats[T8_PIPELINE_STAT_COUNT];
+  double              values[T8_PIPELINE_STAT_COUNT];
+  t8_gloidx_t         num_global_elements = 0;
+  int                 istat, irep, mpirank, mpiret;
+  FILE               *file;
+
+  mpiret = sc_MPI_Comm_rank (sc_MPI_COMM_WORLD, &mpirank);
+  SC_CHECK_MPI (mpiret);
+
+  adapt_data.pattern = pattern;
+  adapt_data.dim = mesh == T8_PIPELINE_MESH_HYPERCUBE
+    || mesh == T8_PIPELINE_MESH_BIGMESH ? t8_eclass_to_dimension[eclass] : 3;
+  adapt_data.min_level = initial_level;
+  adapt_data.max_level = max_level;
+  adapt_data.midpoint[0] = adapt_data.midpoint[1] = adapt_data.midpoint[2] =
+    0.5;
+  adapt_data.radius = 0.25;
+  adapt_data.width = 0.05;
+
+  for (istat = 0; istat < T8_PIPELINE_STAT_COUNT; istat++) {
+    sc_stats_init (&stats[istat], t8_pipeline_stat_names[istat]);
+  }
+
+  cmesh = t8_pipeline_new_cmesh (mesh, eclass, num_trees);
+  for (irep = 0; irep < repetitions; irep++) {
+    t8_pipeline_run (cmesh, &adapt_data, values, &num_global_elements);
+    for (istat = 0; istat < T8_PIPELINE_STAT_COUNT; istat++) {
+      sc_stats_accumulate (&stats[istat], values[istat]);
+    }
+  }
+  t8_cmesh_destroy (&cmesh);
+
+  sc_stats_compute (sc_MPI_COMM_WORLD, T8_PIPELINE_STAT_COUNT, stats);
+  sc_stats_print (t8_get_package_id (), SC_LP_ESSENTIAL,
+                  T8_PIPELINE_STAT_COUNT, stats, 1, 1);
+
+  if (mpirank == 0) {
+    file = json_file != NULL && json_file[0] != '\0'
+      ? fopen (json_file, "w") : stdout;
+    SC_CHECK_ABORTF (file != NULL, "Could not open file %s.", json_file);
+    t8_pipeline_write_json (file, stats, mesh, eclass, pattern, &adapt_data,
+                            repetitions, num_global_elements);
+    if (file != stdout) {
+      fclose (file);
+      t8_global_productionf ("Wrote results to %s\n", json_file);
+    }
+  }
+}
+
+int
+main (int argc, char **argv)
+{
+  int                 mpiret;
+  sc_options_t       *opt;
+  char                usage[BUFSIZ];
+  char                help[BUFSIZ];
+  int                 mesh, eclass_int, num_trees, pattern;
+  int                 initial_level, refine_levels, repetitions;
+  const char         *json_file;
+  int                 parsed, helpme;
+  int                 sreturnA, sreturnB;
+
+  /* brief help message */
+  sreturnA = snprintf (usage, BUFSIZ, "Usage:\t%s <OPTIONS>\n\t%s -h\t"
+                       "for a brief overview of all options.",
+                       basename (argv[0]), basename (argv[0]));
+
+  /* long help message */
+  sreturnB = snprintf (help, BUFSIZ,
+                       "This program runs the forest pipeline\n"
+                       "new, adapt, balance, partition, ghost, ghost exchange"
+                       " and iterate\non a coarse mesh and reports the runtime,"
+                       " message volume and memory usage\nof each phase in JSON"
+                       " format. Run it with different numbers of processes\n"
+                       "to obtain scaling curves.\n\n%s\n", usage);
+
+  if (sreturnA > BUFSIZ || sreturnB > BUFSIZ) {
+    /* The usage string or help message was truncated */
+    /* Note: gcc >= 7.1 prints a warning if we 
+     * do not check the return value of snprintf. */
+    t8_debugf
+      ("Warning: Truncated usage string and help message to '%s' and '%s'\n",
+       usage, help);
+  }
+
+  mpiret = sc_MPI_Init (&argc, &argv);
+  SC_CHECK_MPI (mpiret);
+
+  sc_init (sc_MPI_COMM_WORLD, 1, 1, NULL, SC_LP_ESSENTIAL);
+  t8_init (SC_LP_ESSENTIAL);
+
+  /* initialize command line argument parser */
+  opt = sc_options_new (argv[0]);
+  sc_options_add_switch (opt, 'h', "help", &helpme,
+                         "Display a short help message.");
+  sc_options_add_int (opt, 'm', "mesh", &mesh, 0,
+                      "The coarse mesh to use.\n"
+                      "\t\t0 - hypercube of the element class given by -e\n"
+                      "\t\t1 - hybrid hypercube\n"
+                      "\t\t2 - full hybrid mesh\n"
+                      "\t\t3 - bigmesh of the element class given by -e");
+  sc_options_add_int (opt, 'e', "elements", &eclass_int, T8_ECLASS_HEX,
+                      "The element class for the meshes 0 and 3.");
+  sc_options_add_int (opt, 't', "trees", &num_trees, 64,
+                      "The number of trees of the bigmesh.");
+  sc_options_add_int (opt, 'p', "pattern", &pattern, 0,
+                      "The refinement pattern.\n"
+                      "\t\t0 - refine a spherical shell, coarsen elsewhere\n"
+                      "\t\t1 - refine uniformly\n"
+                      "\t\t2 - refine every other element");
+  sc_options_add_int (opt, 'l', "level", &initial_level, 2,
+                      "The initial uniform refinement level.");
+  sc_options_add_int (opt, 'r', "rlevel", &refine_levels, 2,
+                      "The number of additional refinement levels.");
+  sc_options_add_int (opt, 'n', "repetitions", &repetitions, 3,
+                      "The number of times the pipeline is run.");
+  sc_options_add_string (opt, 'o', "output", &json_file, "",
+                         "Write the JSON results to this file instead of "
+                         "stdout.");
+
+  parsed =
+    sc_options_parse (t8_get_package_id (), SC_LP_ERROR, opt, argc, argv);
+  if (helpme) {
+    /* display help message and usage */
+    t8_global_productionf ("%s\n", help);
+    sc_options_print_usage (t8_get_package_id (), SC_LP_ERROR, opt, NULL);
+  }
+  else if (parsed >= 0 && 0 <= mesh && mesh < T8_PIPELINE_MESH_COUNT
+           && T8_ECLASS_ZERO < eclass_int && eclass_int < T8_ECLASS_COUNT
+           && num_trees > 0 && 0 <= pattern
+           && pattern < T8_PIPELINE_PATTERN_COUNT && initial_level >= 0
+           && refine_levels >= 0 && repetitions > 0) {
+    t8_pipeline (mesh, (t8_eclass_t) eclass_int, num_trees, pattern,
+                 initial_level, initial_level + refine_levels, repetitions,
+                 json_file);
+  }
+  else {
+    /* wrong usage */
+    t8_global_productionf ("\n\t ERROR: Wrong usage.\n\n");
+    sc_options_print_usage (t8_get_package_id (), SC_LP_ERROR, opt, NULL);
+  }
+
+  sc_options_destroy (opt);
+  sc_finalize ();
+
+  mpiret = sc_MPI_Finalize ();
+  SC_CHECK_MPI (mpiret);
+
+  return 0;
+}
@@ -0,0 +1,244 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element types in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* Time the computation of linear ids of triangles and tetrahedra
+ * and the construction of triangles and tetrahedra from linear ids.
+ * We compare the table driven implementations of t8_dtri_linear_id,
+ * t8_dtri_init_linear_id and their tet counterparts with a reference
+ * implementation that processes one level at a time and check that
+ * both compute the same results. */
+
+#include <t8_schemes/t8_default/t8_default_tri/t8_dtri_bits.h>
+#include <t8_schemes/t8_default/t8_default_tri/t8_dtri_connectivity.h>
+#include <t8_schemes/t8_default/t8_default_tet/t8_dtet_bits.h>
+#include <t8_schemes/t8_default/t8_default_tet/t8_dtet_connectivity.h>
+#include <sc_flops.h>
+#include <sc_statistics.h>
+#include <sc_options.h>
+
+/* Reference implementation of t8_dtri_linear_id, one level at a time. */
+static              t8_linearidx_t
+t8_time_tri_linear_id_loop (const t8_dtri_t *t, int level)
+{
+  t8_linearidx_t      id = 0;
+  int                 type = t->type, cid, i;
+
+  T8_ASSERT (level == t->level);
+  for (i = level; i > 0; i--) {
+    const int           bit = T8_DTRI_MAXLEVEL - i;
+    cid = ((t->x >> bit) & 1) | (((t->y >> bit) & 1) << 1);
+    id |= ((t8_linearidx_t) t8_dtri_type_cid_to_Iloc[type][cid])
+      << (T8_DTRI_DIM * (level - i));
+    type = t8_dtri_cid_type_to_parenttype[cid][type];
+  }
+  return id;
+}
+
+/* Reference implementation of t8_dtri_init_linear_id, one level at a time. */
+static void
+t8_time_tri_init_linear_id_loop (t8_dtri_t *t, t8_linearidx_t id, int level)
+{
+  int                 type = 0, cid, iloc, i;
+
+  t->level = level;
+  t->x = t->y = t->n = 0;
+  for (i = 1; i <= level; i++) {
+    iloc = (id >> (T8_DTRI_DIM * (level - i))) & (T8_DTRI_CHILDREN - 1);
+    cid = t8_dtri_parenttype_Iloc_to_cid[type][iloc];
+    type = t8_dtri_parenttype_Iloc_to_type[type][iloc];
+    t->x |= (cid & 1) << (T8_DTRI_MAXLEVEL - i);
+    t->y |= ((cid & 2) >> 1) << (T8_DTRI_MAXLEVEL - i);
+  }
+  t->type = type;
+}
+
+/* Reference implementation of t8_dtet_linear_id, one level at a time. */
+static              t8_linearidx_t
+t8_time_tet_linear_id_loop (const t8_dtet_t *t, int level)
+{
+  t8_linearidx_t      id = 0;
+  int                 type = t->type, cid, i;
+
+  T8_ASSERT (level == t->level);
+  for (i = level; i > 0; i--) {
+    const int           bit = T8_DTET_MAXLEVEL - i;
+    cid = ((t->x >> bit) & 1) | (((t->y >> bit) & 1) << 1)
+      | (((t->z >> bit) & 1) << 2);
+    id |= ((t8_linearidx_t) t8_dtet_type_cid_to_Iloc[type][cid])
+      << (T8_DTET_DIM * (level - i));
+    type = t8_dtet_cid_type_to_parenttype[cid][type];
+  }
+  return id;
+}
+
+/* Reference implementation of t8_dtet_init_linear_id, one level at a time. */
+static void
+t8_time_tet_init_linear_id_loop (t8_dtet_t *t, t8_linearidx_t id, int level)
+{
+  int                 type = 0, cid, iloc, i;
+
+  t->level = level;
+  t->x = t->y = t->z = 0;
+  for (i = 1; i <= level; i++) {
+    iloc = (id >> (T8_DTET_DIM * (level - i))) & (T8_DTET_CHILDREN - 1);
+    cid = t8_dtet_parenttype_Iloc_to_cid[type][iloc];
+    type = t8_dtet_parenttype_Iloc_to_type[type][iloc];
+    t->x |= (cid & 1) << (T8_DTET_MAXLEVEL - i);
+    t->y |= ((cid & 2) >> 1) << (T8_DTET_MAXLEVEL - i);
+    t->z |= ((cid & 4) >> 2) << (T8_DTET_MAXLEVEL - i);
+  }
+  t->type = type;
+}
+
+/* Build num_elements simplices with pseudo random linear ids of the given
+ * level and time the conversion from and to linear ids with both
+ * implementations. */
+template < typename T > static void
+t8_time_linear_id (int level, int dim, int num_elements,
+                   t8_linearidx_t (*linear_id) (const T *, int),
+                   void (*init_linear_id) (T *, t8_linearidx_t, int),
+                   t8_linearidx_t (*linear_id_loop) (const T *, int),
+                   void (*init_linear_id_loop) (T *, t8_linearidx_t, int))
+{
+  T                  *elements = T8_ALLOC_ZERO (T, num_elements);
+  T                   element = T ();
+  t8_linearidx_t     *ids = T8_ALLOC (t8_linearidx_t, num_elements);
+  t8_linearidx_t      checksum_loop = 0, checksum_lut = 0;
+  const t8_linearidx_t num_ids = ((t8_linearidx_t) 1) << (dim * level);
+  t8_linearidx_t      state = 12345;
+  sc_flopinfo_t       fi, snapshot;
+  sc_statinfo_t       stats[4];
+  int                 ielement;
+
+  for (ielement = 0; ielement < num_elements; ielement++) {
+    /* A simple linear congruential generator */
+    state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+    ids[ielement] = state % num_ids;
+  }
+
+  sc_flops_start (&fi);
+  sc_flops_snap (&fi, &snapshot);
+  for (ielement = 0; ielement < num_elements; ielement++) {
+    init_linear_id_loop (&elements[ielement], ids[ielement], level);
+  }
+  sc_flops_shot (&fi, &snapshot);
+  sc_stats_set1 (&stats[0], snapshot.iwtime, "Init linear id (loop)");
+
+  sc_flops_snap (&fi, &snapshot);
+  for (ielement = 0; ielement < num_elements; ielement++) {
+    init_linear_id (&elements[ielement], ids[ielement], level);
+  }
+  sc_flops_shot (&fi, &snapshot);
+  sc_stats_set1 (&stats[1], snapshot.iwtime, "Init linear id (table)");
+
+  sc_flops_snap (&fi, &snapshot);
+  for (ielement = 0; ielement < num_elements; ielement++) {
+    checksum_loop += linear_id_loop (&elements[ielement], level);
+  }
+  sc_flops_shot (&fi, &snapshot);
+  sc_stats_set1 (&stats[2], snapshot.iwtime, "Linear id (loop)");
+
+  sc_flops_snap (&fi, &snapshot);
+  for (ielement = 0; ielement < num_elements; ielement++) {
+    checksum_lut += linear_id (&elements[ielement], level);
+  }
+  sc_flops_shot (&fi, &snapshot);
+  sc_stats_set1 (&stats[3], snapshot.iwtime, "Linear id (table)");
+
+  /* Check that both implementations agree */
+  for (ielement = 0; ielement < num_elements; ielement++) {
+    init_linear_id_loop (&element, ids[ielement], level);
+    SC_CHECK_ABORT (linear_id (&element, level) == ids[ielement],
+                    "Table driven linear id differs from reference.");
+    SC_CHECK_ABORT (linear_id_loop (&elements[ielement], level) ==
+                    ids[ielement],
+                    "Table driven init linear id differs from reference.");
+  }
+  SC_CHECK_ABORT (checksum_loop == checksum_lut,
+                  "Table driven linear id differs from reference.");
+
+  T8_FREE (elements);
+  T8_FREE (ids);
+  sc_stats_compute (sc_MPI_COMM_WORLD, 4, stats);
+  sc_stats_print (t8_get_package_id (), SC_LP_STATISTICS, 4, stats, 1, 1);
+}
+
+int
+main (int argc, char **argv)
+{
+  int                 mpiret;
+  sc_options_t       *opt;
+  int                 level, eclass_int, num_elements;
+  int                 parsed, helpme;
+
+  mpiret = sc_MPI_Init (&argc, &argv);
+  SC_CHECK_MPI (mpiret);
+
+  sc_init (sc_MPI_COMM_WORLD, 1, 1, NULL, SC_LP_ESSENTIAL);
+  t8_init (SC_LP_DEFAULT);
+
+  opt = sc_options_new (argv[0]);
+  sc_options_add_switch (opt, 'h', "help", &helpme,
+                         "Display a short help message.");
+  sc_options_add_int (opt, 'l', "level", &level, 10,
+                      "The refinement level of the elements.");
+  sc_options_add_int (opt, 'n', "num-elements", &num_elements, 1000000,
+                      "The number of elements to convert.");
+  sc_options_add_int (opt, 'e', "elements", &eclass_int, 5,
+                      "This option specifies the type of elements to use.\n"
+                      "\t\t3 - triangle\n\t\t5 - tetrahedron");
+
+  parsed =
+    sc_options_parse (t8_get_package_id (), SC_LP_ERROR, opt, argc, argv);
+  if (helpme) {
+    sc_options_print_usage (t8_get_package_id (), SC_LP_ERROR, opt, NULL);
+  }
+  else if (parsed >= 0 && num_elements > 0 && eclass_int == T8_ECLASS_TRIANGLE
+           && 0 <= level && level <= T8_DTRI_MAXLEVEL) {
+    t8_time_linear_id < t8_dtri_t > (level, T8_DTRI_DIM, num_elements,
+                                     t8_dtri_linear_id,
+                                     t8_dtri_init_linear_id,
+                                     t8_time_tri_linear_id_loop,
+                                     t8_time_tri_init_linear_id_loop);
+  }
+  else if (parsed >= 0 && num_elements > 0 && eclass_int == T8_ECLASS_TET
+           && 0 <= level && level <= T8_DTET_MAXLEVEL) {
+    t8_time_linear_id < t8_dtet_t > (level, T8_DTET_DIM, num_elements,
+                                     t8_dtet_linear_id,
+                                     t8_dtet_init_linear_id,
+                                     t8_time_tet_linear_id_loop,
+                                     t8_time_tet_init_linear_id_loop);
+  }
+  else {
+    /* wrong usage */
+    t8_global_productionf ("\n\t ERROR: Wrong usage.\n\n");
+    sc_options_print_usage (t8_get_package_id (), SC_LP_ERROR, opt, NULL);
+  }
+
+  sc_options_destroy (opt);
+  sc_finalize ();
+
+  mpiret = sc_MPI_Finalize ();
+  SC_CHECK_MPI (mpiret);
+
+  return 0;
+}
@@ -129,6 +129,9 @@ typedef enum
   T8_MPI_PARTITION_FOREST,  /**< Used for forest partitioning */
   T8_MPI_GHOST_FOREST,  /**< Used for for ghost layer creation */
   T8_MPI_GHOST_EXC_FOREST,  /**< Used for ghost data exchange */
+  T8_MPI_PARTITION_FAMILY,  /**< Used to align forest partitions with families */
+  T8_MPI_PARTITION_DATA,  /**< Used for asynchronous forest data partitioning */
+  T8_MPI_GHOST_LAYER,  /**< Used for ghost layers of width greater than one */
   T8_MPI_TAG_LAST
 }
 t8_MPI_tag_t;
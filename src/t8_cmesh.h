@@ -215,6 +215,94 @@ void                t8_cmesh_set_partition_uniform (t8_cmesh_t cmesh,
                                                     int element_level,
                                                     t8_scheme_cxx_t *ts);
 
+/** Declare if the cmesh is understood as a partitioned cmesh where the partition
+ * table is derived from a weight (cost) per tree, for example the number of
+ * elements of a forest in each tree.
+ * The cmesh must be derived from a committed cmesh via \ref t8_cmesh_set_derive.
+ * At commit each process receives an equal share of the global sum of weights.
+ * If the weights of a tree are split among several processes, this tree is
+ * shared between them.
+ * This call is only valid when the cmesh is not yet committed via a call
+ * to \ref t8_cmesh_commit.
+ * \param [in,out] cmesh        The cmesh to be updated.
+ * \param [in]     tree_weights For each local tree of the cmesh that \a cmesh
+ *                              is derived from, a non-negative weight.
+ *                              If that cmesh is partitioned and a tree is shared,
+ *                              each process gives the weight of its part of the tree
+ *                              and the weight of the tree is the sum of these.
+ *                              If that cmesh is replicated, the weights of all trees
+ *                              must be given and must be the same on each process.
+ *                              If all weights are zero, each tree is weighted by one.
+ *                              The array is not copied and must stay valid until
+ *                              \ref t8_cmesh_commit was called.
+ * \see t8_cmesh_set_partition_uniform \see t8_forest_partition_cmesh
+ */
+void                t8_cmesh_set_partition_weights (t8_cmesh_t cmesh,
+                                                    const t8_gloidx_t
+                                                    *tree_weights);
+
+/** Declare the cmesh as partitioned and describe all process local trees
+ * and ghosts at once via contiguous arrays.
+ * This is an alternative to calling \ref t8_cmesh_set_partition_range,
+ * \ref t8_cmesh_set_tree_class, \ref t8_cmesh_set_tree_vertices and
+ * \ref t8_cmesh_set_join for every tree. The arrays are used directly at
+ * \ref t8_cmesh_commit to build the local trees and ghosts without sorting
+ * or hashing the stash, which makes it suitable for very large generated meshes.
+ * The arrays are not copied, they must stay valid until \ref t8_cmesh_commit
+ * was called.
+ * Face neighbors are given as global tree ids, F = \ref t8_eclass_max_num_faces
+ * [dimension] entries per tree (unused entries for trees with fewer faces are ignored).
+ * A negative neighbor id marks a boundary face. The tree-to-face values are
+ * computed with \ref t8_cmesh_tree_to_face_encode from the neighbor's face and
+ * the orientation of the connection.
+ * Each face neighbor that is not a local tree must be listed in \a ghost_ids.
+ * \param [in,out] cmesh        The cmesh to be updated. Must not have any
+ *                              trees set via \ref t8_cmesh_set_tree_class.
+ * \param [in]     dimension    The dimension of the cmesh.
+ * \param [in]     first_local_tree The global index ID of the first tree on this process.
+ *                              If this tree is also the last tree on the previous process,
+ *                              then the argument must be -ID - 1.
+ * \param [in]     num_local_trees The number of local trees on this process.
+ * \param [in]     tree_classes The eclass of each local tree.
+ * \param [in]     tree_vertices If not NULL, for each local tree the coordinates
+ *                              of its vertices with 3 * \ref T8_ECLASS_MAX_CORNERS
+ *                              doubles per tree.
+ * \param [in]     tree_face_neighbors F global tree ids per local tree.
+ * \param [in]     tree_to_face F tree-to-face values per local tree.
+ * \param [in]     num_ghosts   The number of ghost trees on this process.
+ * \param [in]     ghost_ids    The global ids of the ghosts, sorted ascending.
+ * \param [in]     ghost_classes The eclass of each ghost.
+ * \param [in]     ghost_face_neighbors If not NULL, F global tree ids per ghost.
+ *                              Otherwise the face connections of the ghosts are derived
+ *                              from the connections to local trees and all other ghost
+ *                              faces are treated as boundary.
+ * \param [in]     ghost_to_face If \a ghost_face_neighbors is not NULL, F tree-to-face
+ *                              values per ghost.
+ * \note If you need to pass a shared first tree, \a first_local_tree must be given as -ID - 1.
+ * \note Only face knowledge 3 is supported.
+ */
+void                t8_cmesh_set_partition_bulk (t8_cmesh_t cmesh,
+                                                 int dimension,
+                                                 t8_gloidx_t
+                                                 first_local_tree,
+                                                 t8_locidx_t
+                                                 num_local_trees,
+                                                 const t8_eclass_t
+                                                 *tree_classes,
+                                                 const double *tree_vertices,
+                                                 const t8_gloidx_t
+                                                 *tree_face_neighbors,
+                                                 const int8_t *tree_to_face,
+                                                 t8_locidx_t num_ghosts,
+                                                 const t8_gloidx_t
+                                                 *ghost_ids,
+                                                 const t8_eclass_t
+                                                 *ghost_classes,
+                                                 const t8_gloidx_t
+                                                 *ghost_face_neighbors,
+                                                 const int8_t
+                                                 *ghost_to_face);
+
 /* TODO: This function is no longer needed.  Scavenge documentation if helpful. */
 #if 0
 /* TODO: Currently cmesh_from needs to be partitioned as well.
@@ -340,6 +428,29 @@ void                t8_cmesh_set_join (t8_cmesh_t cmesh, t8_gloidx_t gtree1,
 void                t8_cmesh_set_profiling (t8_cmesh_t cmesh,
                                             int set_profiling);
 
+/** Store the trees of a replicated cmesh in node-shared memory.
+ * If enabled, after commit only one process per compute node stores the trees,
+ * their face neighbors and their attributes. All other processes of that node
+ * access this memory read-only. This reduces the memory footprint of large
+ * replicated cmeshes by the number of processes per node.
+ * \param [in,out] cmesh        The cmesh to be updated.
+ * \param [in]     node_shared  If true, the trees will be stored in node-shared
+ *                              memory, if false each process stores its own copy.
+ *
+ * Node sharing is disabled by default and has no effect for partitioned cmeshes.
+ * If MPI-3 shared memory windows are not available, each process keeps a copy.
+ * If the cmesh is constructed from its trees (and not derived or refined),
+ * the memory is filled directly by one process per node. Otherwise, the trees
+ * are moved into the shared memory after they were constructed.
+ * The shared memory type of the communicator is not changed.
+ * The cmesh must not be committed before calling this function.
+ * \note Since the memory is shared, \ref t8_cmesh_destroy and the final
+ *       \ref t8_cmesh_unref must be called on all processes.
+ * \note Attributes of a node-shared cmesh must not be modified.
+ */
+void                t8_cmesh_set_node_shared (t8_cmesh_t cmesh,
+                                              int node_shared);
+
 /* returns true if cmesh_a equals cmesh_b */
 /* TODO: document
  * collective or serial */
@@ -307,6 +307,7 @@ t8_cmesh_set_partition_range (t8_cmesh_t cmesh, int set_face_knowledge,
     cmesh->tree_offsets = NULL;
   }
   cmesh->set_partition_level = -1;
+  cmesh->set_partition_weights = NULL;
 }
 
 void
@@ -328,6 +329,7 @@ t8_cmesh_set_partition_offsets (t8_cmesh_t cmesh,
     cmesh->first_tree_shared = -1;
     cmesh->num_local_trees = -1;
     cmesh->set_partition_level = -1;
+    cmesh->set_partition_weights = NULL;
   }
 }
 
@@ -346,6 +348,7 @@ t8_cmesh_set_partition_uniform (t8_cmesh_t cmesh, int element_level,
     /* We overwrite any previous partition settings */
     cmesh->first_tree = -1;
     cmesh->num_local_trees = -1;
+    cmesh->set_partition_weights = NULL;
     if (cmesh->tree_offsets != NULL) {
       t8_shmem_array_destroy (&cmesh->tree_offsets);
       cmesh->tree_offsets = NULL;
@@ -353,6 +356,74 @@ t8_cmesh_set_partition_uniform (t8_cmesh_t cmesh, int element_level,
   }
 }
 
+void
+t8_cmesh_set_partition_weights (t8_cmesh_t cmesh,
+                                const t8_gloidx_t *tree_weights)
+{
+  T8_ASSERT (t8_cmesh_is_initialized (cmesh));
+  T8_ASSERT (tree_weights != NULL);
+
+  cmesh->set_partition = 1;
+  cmesh->set_partition_weights = tree_weights;
+  /* We overwrite any previous partition settings */
+  cmesh->first_tree = -1;
+  cmesh->first_tree_shared = -1;
+  cmesh->num_local_trees = -1;
+  cmesh->set_partition_level = -1;
+  if (cmesh->tree_offsets != NULL) {
+    t8_shmem_array_destroy (&cmesh->tree_offsets);
+    cmesh->tree_offsets = NULL;
+  }
+}
+
+void
+t8_cmesh_set_partition_bulk (t8_cmesh_t cmesh, int dimension,
+                             t8_gloidx_t first_local_tree,
+                             t8_locidx_t num_local_trees,
+                             const t8_eclass_t *tree_classes,
+                             const double *tree_vertices,
+                             const t8_gloidx_t *tree_face_neighbors,
+                             const int8_t *tree_to_face,
+                             t8_locidx_t num_ghosts,
+                             const t8_gloidx_t *ghost_ids,
+                             const t8_eclass_t *ghost_classes,
+                             const t8_gloidx_t *ghost_face_neighbors,
+                             const int8_t *ghost_to_face)
+{
+  t8_cmesh_bulk_t    *bulk;
+
+  T8_ASSERT (t8_cmesh_is_initialized (cmesh));
+  T8_ASSERT (cmesh->set_from == NULL);
+  T8_ASSERT (cmesh->stash != NULL && cmesh->stash->classes.elem_count == 0);
+  T8_ASSERT (num_local_trees >= 0 && num_ghosts >= 0);
+  T8_ASSERT (num_local_trees == 0 || (tree_classes != NULL
+                                      && tree_face_neighbors != NULL
+                                      && tree_to_face != NULL));
+  T8_ASSERT (num_ghosts == 0 || (ghost_ids != NULL && ghost_classes != NULL));
+  T8_ASSERT (ghost_face_neighbors == NULL || ghost_to_face != NULL);
+
+  t8_cmesh_set_dimension (cmesh, dimension);
+  /* Set the local tree range, this also overwrites previous partition settings. */
+  t8_cmesh_set_partition_range (cmesh, 3, first_local_tree,
+                                (first_local_tree <
+                                 0 ? -first_local_tree - 1 :
+                                 first_local_tree) + num_local_trees - 1);
+
+  if (cmesh->set_bulk == NULL) {
+    cmesh->set_bulk = T8_ALLOC_ZERO (t8_cmesh_bulk_t, 1);
+  }
+  bulk = cmesh->set_bulk;
+  bulk->tree_classes = tree_classes;
+  bulk->tree_vertices = tree_vertices;
+  bulk->tree_face_neighbors = tree_face_neighbors;
+  bulk->tree_to_face = tree_to_face;
+  bulk->num_ghosts = num_ghosts;
+  bulk->ghost_ids = ghost_ids;
+  bulk->ghost_classes = ghost_classes;
+  bulk->ghost_face_neighbors = ghost_face_neighbors;
+  bulk->ghost_to_face = ghost_to_face;
+}
+
 #if 0
 /* No longer needed */
 void
@@ -790,6 +861,14 @@ t8_cmesh_set_profiling (t8_cmesh_t cmesh, int set_profiling)
   }
 }
 
+void
+t8_cmesh_set_node_shared (t8_cmesh_t cmesh, int node_shared)
+{
+  T8_ASSERT (t8_cmesh_is_initialized (cmesh));
+
+  cmesh->set_node_shared = node_shared;
+}
+
 /* returns true if cmesh_a equals cmesh_b */
 int
 t8_cmesh_is_equal (t8_cmesh_t cmesh_a, t8_cmesh_t cmesh_b)
@@ -1457,6 +1536,9 @@ t8_cmesh_reset (t8_cmesh_t *pcmesh)
   /*TODO: write this */
   if (!cmesh->committed) {
     t8_stash_destroy (&cmesh->stash);
+    if (cmesh->set_bulk != NULL) {
+      T8_FREE (cmesh->set_bulk);
+    }
     if (cmesh->set_from != NULL) {
       /* We unref our reference of set_from */
       t8_cmesh_unref (&cmesh->set_from);
@@ -112,7 +112,7 @@ t8_cmesh_add_attributes (t8_cmesh_t cmesh)
 }
 
 static void
-t8_cmesh_commit_replicated_new (t8_cmesh_t cmesh)
+t8_cmesh_commit_replicated_new (t8_cmesh_t cmesh, sc_MPI_Comm comm)
 {
   t8_stash_attribute_struct_t *attribute;
   t8_locidx_t        *face_neigh, *face_neigh2;
@@ -126,6 +126,7 @@ t8_cmesh_commit_replicated_new (t8_cmesh_t cmesh)
     sc_array_t         *class_entries = &stash->classes;
     t8_stash_class_struct_t *entry;
     t8_locidx_t         num_trees = class_entries->elem_count, ltree;
+    int                 do_write = 1;
 
     t8_cmesh_trees_init (&cmesh->trees, 1, num_trees, 0);
     t8_cmesh_trees_start_part (cmesh->trees, 0, 0, num_trees, 0, 0, 1);
@@ -149,15 +150,25 @@ t8_cmesh_commit_replicated_new (t8_cmesh_t cmesh)
     }
     /* Finish memory allocation of tree/ghost/face/attribute array
      * using the info calculated above */
-    t8_cmesh_trees_finish_part (cmesh->trees, 0);
+    if (cmesh->set_node_shared) {
+      /* Only one process per node allocates and fills the memory */
+      do_write = t8_cmesh_trees_finish_part_shmem (cmesh->trees, comm);
+    }
+    else {
+      t8_cmesh_trees_finish_part (cmesh->trees, 0);
+    }
     cmesh->num_trees = cmesh->num_local_trees = num_trees;
+    cmesh->first_tree = 0;
+    if (!do_write) {
+      /* The trees are filled by another process of this node */
+      t8_cmesh_trees_finish_shmem_writing (cmesh->trees);
+      return;
+    }
 
     /* Add attributes */
     /* TODO: currently the attributes array still has to be sorted,
      *       find a way around it */
     t8_stash_attribute_sort (cmesh->stash);
-    cmesh->num_trees = cmesh->num_local_trees = num_trees;
-    cmesh->first_tree = 0;
     t8_cmesh_add_attributes (cmesh);
 
     /* Set all face connections */
@@ -181,6 +192,9 @@ t8_cmesh_commit_replicated_new (t8_cmesh_t cmesh)
                                       (t8_locidx_t) joinface->face1,
                                       joinface->orientation);
     }
+    if (cmesh->set_node_shared) {
+      t8_cmesh_trees_finish_shmem_writing (cmesh->trees);
+    }
   }
 }
 
@@ -526,18 +540,198 @@ t8_cmesh_commit_partitioned_new (t8_cmesh_t cmesh, sc_MPI_Comm comm)
 #endif
 }
 
+/* Given a global tree id of a face neighbor in a bulk constructed cmesh,
+ * compute the local id of that neighbor. That is the local tree id for
+ * local trees and num_local_trees + local ghost id for ghosts. */
+static              t8_locidx_t
+t8_cmesh_bulk_neighbor_local_id (t8_cmesh_t cmesh, t8_gloidx_t gneighbor)
+{
+  const t8_cmesh_bulk_t *bulk = cmesh->set_bulk;
+  t8_locidx_t         low, high, mid;
+
+  if (cmesh->first_tree <= gneighbor
+      && gneighbor < cmesh->first_tree + cmesh->num_local_trees) {
+    /* The neighbor is a local tree */
+    return (t8_locidx_t) (gneighbor - cmesh->first_tree);
+  }
+  /* The neighbor must be a ghost, binary search in the sorted ghost ids */
+  low = 0;
+  high = bulk->num_ghosts - 1;
+  while (low <= high) {
+    mid = low + (high - low) / 2;
+    if (bulk->ghost_ids[mid] == gneighbor) {
+      return cmesh->num_local_trees + mid;
+    }
+    if (bulk->ghost_ids[mid] < gneighbor) {
+      low = mid + 1;
+    }
+    else {
+      high = mid - 1;
+    }
+  }
+  SC_ABORTF ("Face neighbor %lli is neither a local tree nor a ghost.\n",
+             (long long) gneighbor);
+  return -1;
+}
+
+/* Commit a partitioned cmesh whose local trees and ghosts were given via
+ * t8_cmesh_set_partition_bulk. Since all trees and ghosts are known in
+ * local order, we can fill the trees structure in one pass without
+ * sorting and hashing the stash entries. */
+static void
+t8_cmesh_commit_partitioned_bulk (t8_cmesh_t cmesh, sc_MPI_Comm comm)
+{
+  const t8_cmesh_bulk_t *bulk = cmesh->set_bulk;
+  t8_stash_attribute_struct_t attribute;
+  t8_ctree_t          tree;
+  t8_cghost_t         ghost;
+  t8_locidx_t         ltree, lghost, lneighbor, *face_neigh;
+  t8_gloidx_t         gneighbor, *gface_neigh, num_trees;
+  int8_t             *ttf, *gttf;
+  int                 iface, num_faces, F, neigh_face, orientation;
+  const size_t        vertex_stride = 3 * T8_ECLASS_MAX_CORNERS;
+  const t8_locidx_t   num_ghosts = bulk->num_ghosts;
+#ifdef T8_ENABLE_DEBUG
+  t8_locidx_t         ighost;
+#endif
+
+  T8_ASSERT (t8_cmesh_comm_is_valid (cmesh, comm));
+  T8_ASSERT (cmesh->first_tree >= 0);
+  T8_ASSERT (cmesh->first_tree_shared >= 0);
+  T8_ASSERT (cmesh->face_knowledge == 3);
+#ifdef T8_ENABLE_DEBUG
+  for (ighost = 1; ighost < num_ghosts; ighost++) {
+    /* The ghost ids must be sorted and unique */
+    T8_ASSERT (bulk->ghost_ids[ighost - 1] < bulk->ghost_ids[ighost]);
+  }
+#endif
+
+  t8_shmem_init (comm);
+  t8_cmesh_set_shmem_type (comm);
+
+  F = t8_eclass_max_num_faces[cmesh->dimension];
+  cmesh->num_ghosts = num_ghosts;
+  t8_debugf ("Init trees with %li T, %li G from bulk data\n",
+             (long) cmesh->num_local_trees, (long) cmesh->num_ghosts);
+  t8_cmesh_trees_init (&cmesh->trees, 1, cmesh->num_local_trees, num_ghosts);
+  t8_cmesh_trees_start_part (cmesh->trees, 0, 0, cmesh->num_local_trees, 0,
+                             num_ghosts, 1);
+
+  /* Add the trees and count their attribute bytes */
+  for (ltree = 0; ltree < cmesh->num_local_trees; ltree++) {
+    t8_cmesh_trees_add_tree (cmesh->trees, ltree, 0,
+                             bulk->tree_classes[ltree]);
+    cmesh->num_local_trees_per_eclass[bulk->tree_classes[ltree]]++;
+    if (bulk->tree_vertices != NULL) {
+      t8_cmesh_trees_init_attributes (cmesh->trees, ltree, 1,
+                                      3 *
+                                      t8_eclass_num_vertices
+                                      [bulk->tree_classes[ltree]] *
+                                      sizeof (double));
+    }
+  }
+  /* Add the ghosts */
+  for (lghost = 0; lghost < num_ghosts; lghost++) {
+    t8_cmesh_trees_add_ghost (cmesh->trees, lghost, bulk->ghost_ids[lghost],
+                              0, bulk->ghost_classes[lghost],
+                              cmesh->num_local_trees);
+  }
+  t8_cmesh_trees_finish_part (cmesh->trees, 0);
+  t8_cmesh_trees_set_all_boundary (cmesh, cmesh->trees);
+
+  /* Set the face connections of the local trees. If no ghost connections
+   * are given, we also set the ghost side of tree-to-ghost connections. */
+  for (ltree = 0; ltree < cmesh->num_local_trees; ltree++) {
+    tree = t8_cmesh_trees_get_tree_ext (cmesh->trees, ltree, &face_neigh,
+                                        &ttf);
+    num_faces = t8_eclass_num_faces[tree->eclass];
+    for (iface = 0; iface < num_faces; iface++) {
+      gneighbor = bulk->tree_face_neighbors[(size_t) ltree * F + iface];
+      if (gneighbor < 0) {
+        /* This face is a boundary face, it is already set */
+        continue;
+      }
+      lneighbor = t8_cmesh_bulk_neighbor_local_id (cmesh, gneighbor);
+      face_neigh[iface] = lneighbor;
+      ttf[iface] = bulk->tree_to_face[(size_t) ltree * F + iface];
+      if (lneighbor >= cmesh->num_local_trees
+          && bulk->ghost_face_neighbors == NULL) {
+        /* The neighbor is a ghost, we set the inverse connection. */
+        (void) t8_cmesh_trees_get_ghost_ext (cmesh->trees,
+                                             lneighbor -
+                                             cmesh->num_local_trees,
+                                             &gface_neigh, &gttf);
+        t8_cmesh_tree_to_face_decode (cmesh->dimension, ttf[iface],
+                                      &neigh_face, &orientation);
+        gface_neigh[neigh_face] = cmesh->first_tree + ltree;
+        gttf[neigh_face] =
+          t8_cmesh_tree_to_face_encode (cmesh->dimension, iface,
+                                        orientation);
+      }
+    }
+  }
+  if (bulk->ghost_face_neighbors != NULL) {
+    /* Copy the given face connections of the ghosts */
+    for (lghost = 0; lghost < num_ghosts; lghost++) {
+      ghost = t8_cmesh_trees_get_ghost_ext (cmesh->trees, lghost,
+                                            &gface_neigh, &gttf);
+      num_faces = t8_eclass_num_faces[ghost->eclass];
+      for (iface = 0; iface < num_faces; iface++) {
+        gneighbor = bulk->ghost_face_neighbors[(size_t) lghost * F + iface];
+        if (gneighbor >= 0) {
+          gface_neigh[iface] = gneighbor;
+          gttf[iface] = bulk->ghost_to_face[(size_t) lghost * F + iface];
+        }
+      }
+    }
+  }
+
+  /* Add the vertices as attributes. Since each tree carries exactly one
+   * attribute, the attributes are added in order. */
+  if (bulk->tree_vertices != NULL) {
+    attribute.package_id = t8_get_package_id ();
+    attribute.key = T8_CMESH_VERTICES_ATTRIBUTE_KEY;
+    attribute.is_owned = 0;
+    for (ltree = 0; ltree < cmesh->num_local_trees; ltree++) {
+      attribute.id = cmesh->first_tree + ltree;
+      attribute.attr_size = 3 * sizeof (double) *
+        t8_eclass_num_vertices[bulk->tree_classes[ltree]];
+      attribute.attr_data =
+        (void *) (bulk->tree_vertices + ltree * vertex_stride);
+      t8_cmesh_trees_add_attribute (cmesh->trees, 0, &attribute, ltree, 0);
+    }
+  }
+
+  /* Compute the global number of trees. Shared trees must not be counted. */
+  num_trees = cmesh->num_local_trees;
+  if (cmesh->first_tree_shared && num_trees > 0) {
+    num_trees--;
+  }
+  sc_MPI_Allreduce (&num_trees, &cmesh->num_trees, 1, T8_MPI_GLOIDX,
+                    sc_MPI_SUM, comm);
+
+  /* The user data is no longer needed */
+  T8_FREE (cmesh->set_bulk);
+  cmesh->set_bulk = NULL;
+}
+
 void
 t8_cmesh_commit_from_stash (t8_cmesh_t cmesh, sc_MPI_Comm comm)
 {
   T8_ASSERT (cmesh != NULL);
 
-  if (cmesh->set_partition) {
+  if (cmesh->set_bulk != NULL) {
+    /* partitioned commit from arrays, the stash is not used */
+    T8_ASSERT (cmesh->set_partition);
+    t8_cmesh_commit_partitioned_bulk (cmesh, comm);
+  }
+  else if (cmesh->set_partition) {
     /* partitioned commit */
     t8_cmesh_commit_partitioned_new (cmesh, comm);
   }
   else {
     /* replicated commit */
-    t8_cmesh_commit_replicated_new (cmesh);
+    t8_cmesh_commit_replicated_new (cmesh, comm);
   }
 }
 
@@ -666,6 +860,11 @@ t8_cmesh_commit (t8_cmesh_t cmesh, sc_MPI_Comm comm)
         if (cmesh->tree_offsets != NULL) {
           t8_cmesh_set_partition_offsets (cmesh_temp, cmesh->tree_offsets);
         }
+        else if (cmesh->set_partition_weights != NULL) {
+          t8_cmesh_set_partition_weights (cmesh_temp,
+                                          cmesh->set_partition_weights);
+          cmesh->set_partition_weights = NULL;
+        }
         else if (cmesh->set_partition_level) {
           T8_ASSERT (cmesh->set_partition_scheme != NULL);
           t8_cmesh_set_partition_uniform (cmesh_temp,
@@ -681,10 +880,11 @@ t8_cmesh_commit (t8_cmesh_t cmesh, sc_MPI_Comm comm)
           else {
             first_tree = cmesh->first_tree;
           }
+          /* The last tree of the range is inclusive */
           t8_cmesh_set_partition_range (cmesh_temp, cmesh->face_knowledge,
                                         first_tree,
-                                        cmesh->num_local_trees +
-                                        cmesh->first_tree);
+                                        cmesh->first_tree +
+                                        cmesh->num_local_trees - 1);
         }
         t8_cmesh_partition (cmesh_temp, comm);
         t8_cmesh_set_derive (cmesh, cmesh_temp);
@@ -707,6 +907,10 @@ t8_cmesh_commit (t8_cmesh_t cmesh, sc_MPI_Comm comm)
       t8_cmesh_init (&cmesh_temp);
       cmesh_temp->stash = cmesh->stash;
       cmesh->stash = NULL;
+      cmesh_temp->set_bulk = cmesh->set_bulk;
+      cmesh->set_bulk = NULL;
+      /* The dimension may have been set with the stash or the bulk arrays */
+      cmesh_temp->dimension = cmesh->dimension;
       /* TODO: This code is duplicated above and may also be shorter */
       if (cmesh->set_partition) {
         if (cmesh->tree_offsets) {
@@ -719,11 +923,19 @@ t8_cmesh_commit (t8_cmesh_t cmesh, sc_MPI_Comm comm)
                                           cmesh->set_partition_scheme);
         }
         else {
+          t8_gloidx_t         first_tree;
           T8_ASSERT (cmesh->first_tree >= 0 && cmesh->num_local_trees >= 0);
+          if (cmesh->first_tree_shared) {
+            first_tree = -cmesh->first_tree - 1;
+          }
+          else {
+            first_tree = cmesh->first_tree;
+          }
+          /* The last tree of the range is inclusive */
           t8_cmesh_set_partition_range (cmesh_temp, cmesh->face_knowledge,
-                                        cmesh->first_tree,
-                                        cmesh->num_local_trees +
-                                        cmesh->first_tree);
+                                        first_tree,
+                                        cmesh->first_tree +
+                                        cmesh->num_local_trees - 1);
         }
       }
       t8_cmesh_commit_from_stash (cmesh_temp, comm);
@@ -757,6 +969,13 @@ t8_cmesh_commit (t8_cmesh_t cmesh, sc_MPI_Comm comm)
   }
   T8_ASSERT (cmesh->set_partition || cmesh->tree_offsets == NULL);
 
+  if (!cmesh->set_partition && cmesh->set_node_shared
+      && cmesh->trees != NULL && cmesh->trees->shmem_part == NULL) {
+    /* The trees were not constructed from the stash, but derived from
+     * another cmesh. We move the replicated trees into node-shared memory. */
+    t8_cmesh_trees_to_shmem (cmesh->trees, comm);
+  }
+
 #if T8_ENABLE_DEBUG
   t8_debugf ("Cmesh is %spartitioned.\n", cmesh->set_partition ? "" : "not ");
   if (cmesh->set_partition) {
@@ -2574,6 +2574,201 @@ t8_cmesh_partition_given (t8_cmesh_t cmesh, const struct t8_cmesh *cmesh_from,
   cmesh->num_ghosts = num_ghosts;
 }
 
+/* Return the weight of local tree ltree of cmesh_from that is used for
+ * weighted partitioning. If unit_weights is true, each tree counts one;
+ * a shared first tree is then only counted on the previous process. */
+static t8_gloidx_t
+t8_cmesh_partition_tree_weight (const t8_cmesh_t cmesh_from,
+                                const t8_gloidx_t *weights,
+                                t8_locidx_t ltree, int unit_weights)
+{
+  if (unit_weights) {
+    return ltree == 0 && cmesh_from->set_partition
+      && cmesh_from->first_tree_shared ? 0 : 1;
+  }
+  T8_ASSERT (weights[ltree] >= 0);
+  return weights[ltree];
+}
+
+/* The position in the global weight sequence at which process proc starts. */
+static t8_gloidx_t
+t8_cmesh_partition_weight_split (t8_gloidx_t global_weight, int proc,
+                                 int mpisize)
+{
+  return (t8_gloidx_t) (((long double) global_weight * proc) / mpisize);
+}
+
+/* Compute the local tree range of a cmesh that is partitioned according to
+ * the tree weights set with t8_cmesh_set_partition_weights.
+ * All weights of all trees form a global sequence that is ordered by
+ * global tree id and, for shared trees, by the process in cmesh_from.
+ * Process p gets the trees that contain the positions
+ * [W * p / P, W * (p + 1) / P) in this sequence, where W is the sum of all weights.
+ * Its first tree is shared, if the position before W * p / P belongs to the same tree.
+ * Trees with zero weight are assigned to the process that owns the preceding tree.
+ * On output first_tree, first_tree_shared and num_local_trees of cmesh are set. */
+static void
+t8_cmesh_partition_weighted_bounds (t8_cmesh_t cmesh,
+                                    const t8_cmesh_t cmesh_from,
+                                    sc_MPI_Comm comm)
+{
+  const t8_gloidx_t  *weights = cmesh->set_partition_weights;
+  t8_gloidx_t         first_weighted_tree, local_weight, weight_offset;
+  t8_gloidx_t         global_weight, last_weighted_tree, prev_weighted_tree;
+  t8_gloidx_t         split, next_split, tree_start, tree_weight;
+  t8_gloidx_t        *all_last_weighted, *first_trees, *first_trees_recv;
+  int                *shared, *shared_recv;
+  t8_locidx_t         num_weights, ltree;
+  int                 mpiret, iproc, unit_weights = 0, next_nonempty;
+
+  T8_ASSERT (weights != NULL);
+  T8_ASSERT (t8_cmesh_is_committed (cmesh_from));
+
+  if (cmesh_from->set_partition) {
+    /* Each process weights its local trees */
+    num_weights = cmesh_from->num_local_trees;
+    first_weighted_tree = cmesh_from->first_tree;
+  }
+  else {
+    /* The weights are replicated, we only use the ones of rank 0 */
+    num_weights = cmesh->mpirank == 0 ? cmesh_from->num_trees : 0;
+    first_weighted_tree = 0;
+  }
+
+  /* Compute the global weight and the start of our weights */
+  local_weight = 0;
+  for (ltree = 0; ltree < num_weights; ltree++) {
+    local_weight += t8_cmesh_partition_tree_weight (cmesh_from, weights,
+                                                    ltree, 0);
+  }
+  mpiret = sc_MPI_Allreduce (&local_weight, &global_weight, 1, T8_MPI_GLOIDX,
+                             sc_MPI_SUM, comm);
+  SC_CHECK_MPI (mpiret);
+  if (global_weight == 0) {
+    /* All weights are zero, we weight each tree by one */
+    unit_weights = 1;
+    local_weight = 0;
+    for (ltree = 0; ltree < num_weights; ltree++) {
+      local_weight += t8_cmesh_partition_tree_weight (cmesh_from, weights,
+                                                      ltree, 1);
+    }
+    global_weight = cmesh_from->num_trees;
+  }
+  mpiret = sc_MPI_Scan (&local_weight, &weight_offset, 1, T8_MPI_GLOIDX,
+                        sc_MPI_SUM, comm);
+  SC_CHECK_MPI (mpiret);
+  weight_offset -= local_weight;
+
+  /* Each process needs to know the last tree with positive weight on
+   * the processes before it */
+  last_weighted_tree = -1;
+  for (ltree = num_weights - 1; ltree >= 0; ltree--) {
+    if (t8_cmesh_partition_tree_weight (cmesh_from, weights, ltree,
+                                        unit_weights) > 0) {
+      last_weighted_tree = first_weighted_tree + ltree;
+      break;
+    }
+  }
+  all_last_weighted = T8_ALLOC (t8_gloidx_t, cmesh->mpisize);
+  mpiret = sc_MPI_Allgather (&last_weighted_tree, 1, T8_MPI_GLOIDX,
+                             all_last_weighted, 1, T8_MPI_GLOIDX, comm);
+  SC_CHECK_MPI (mpiret);
+  prev_weighted_tree = -1;
+  for (iproc = 0; iproc < cmesh->mpirank; iproc++) {
+    prev_weighted_tree = SC_MAX (prev_weighted_tree, all_last_weighted[iproc]);
+  }
+  T8_FREE (all_last_weighted);
+
+  /* For each nonempty process whose split position lies in our weights,
+   * compute its first tree and whether it is shared */
+  first_trees = T8_ALLOC (t8_gloidx_t, cmesh->mpisize);
+  first_trees_recv = T8_ALLOC (t8_gloidx_t, cmesh->mpisize);
+  shared = T8_ALLOC_ZERO (int, cmesh->mpisize);
+  shared_recv = T8_ALLOC (int, cmesh->mpisize);
+  ltree = 0;
+  tree_start = weight_offset;
+  for (iproc = 0; iproc < cmesh->mpisize; iproc++) {
+    first_trees[iproc] = -1;
+    split = t8_cmesh_partition_weight_split (global_weight, iproc,
+                                             cmesh->mpisize);
+    next_split = t8_cmesh_partition_weight_split (global_weight, iproc + 1,
+                                                  cmesh->mpisize);
+    if (split == next_split || split < weight_offset
+        || split >= weight_offset + local_weight) {
+      /* This process is empty or its first tree is not in our range */
+      continue;
+    }
+    /* Find the local tree that contains the position split */
+    tree_weight = t8_cmesh_partition_tree_weight (cmesh_from, weights, ltree,
+                                                  unit_weights);
+    while (tree_start + tree_weight <= split) {
+      if (tree_weight > 0) {
+        prev_weighted_tree = first_weighted_tree + ltree;
+      }
+      tree_start += tree_weight;
+      ltree++;
+      T8_ASSERT (ltree < num_weights);
+      tree_weight = t8_cmesh_partition_tree_weight (cmesh_from, weights,
+                                                    ltree, unit_weights);
+    }
+    first_trees[iproc] = first_weighted_tree + ltree;
+    shared[iproc] = split > tree_start
+      || prev_weighted_tree == first_trees[iproc];
+  }
+  mpiret = sc_MPI_Allreduce (first_trees, first_trees_recv, cmesh->mpisize,
+                             T8_MPI_GLOIDX, sc_MPI_MAX, comm);
+  SC_CHECK_MPI (mpiret);
+  mpiret = sc_MPI_Allreduce (shared, shared_recv, cmesh->mpisize,
+                             sc_MPI_INT, sc_MPI_MAX, comm);
+  SC_CHECK_MPI (mpiret);
+
+  /* The first nonempty process starts with tree 0, in order to
+   * include leading trees without weight. */
+  iproc = 0;
+  while (iproc < cmesh->mpisize && first_trees_recv[iproc] < 0) {
+    iproc++;
+  }
+  T8_ASSERT (iproc < cmesh->mpisize);
+  first_trees_recv[iproc] = 0;
+  shared_recv[iproc] = 0;
+
+  /* Compute our local range from our first tree and the first tree
+   * of the next nonempty process */
+  next_nonempty = cmesh->mpirank + 1;
+  while (next_nonempty < cmesh->mpisize
+         && first_trees_recv[next_nonempty] < 0) {
+    next_nonempty++;
+  }
+  if (first_trees_recv[cmesh->mpirank] < 0) {
+    /* This process is empty. We store the first not shared tree of
+     * the next nonempty process. */
+    cmesh->first_tree = next_nonempty < cmesh->mpisize ?
+      first_trees_recv[next_nonempty] + shared_recv[next_nonempty] :
+      cmesh_from->num_trees;
+    cmesh->first_tree_shared = 0;
+    cmesh->num_local_trees = 0;
+  }
+  else {
+    cmesh->first_tree = first_trees_recv[cmesh->mpirank];
+    cmesh->first_tree_shared = shared_recv[cmesh->mpirank];
+    if (next_nonempty < cmesh->mpisize) {
+      /* Our last tree is the first tree of the next process if it is shared,
+       * and the tree before otherwise. */
+      cmesh->num_local_trees = first_trees_recv[next_nonempty]
+        - cmesh->first_tree + shared_recv[next_nonempty];
+    }
+    else {
+      cmesh->num_local_trees = cmesh_from->num_trees - cmesh->first_tree;
+    }
+  }
+  T8_ASSERT (cmesh->num_local_trees >= 0);
+
+  T8_FREE (first_trees);
+  T8_FREE (first_trees_recv);
+  T8_FREE (shared);
+  T8_FREE (shared_recv);
+}
+
 /* Given a cmesh which is to be partitioned, execute the partition task.
  * This includes partitioning by uniform level and partitioning from a second cmesh */
 /* TODO: Check whether the input data is consistent.
@@ -2620,6 +2815,17 @@ t8_cmesh_partition (t8_cmesh_t cmesh, sc_MPI_Comm comm)
     /* Set the tree offsets to the cmesh's offset array */
     tree_offsets = t8_shmem_array_get_gloidx_array (cmesh->tree_offsets);
   }
+  else if (cmesh->set_partition_weights != NULL) {
+    /* Compute first and last tree index from the tree weights */
+    T8_ASSERT (cmesh->tree_offsets == NULL);
+    t8_cmesh_partition_weighted_bounds (cmesh, cmesh_from, comm);
+    /* The weights are not needed anymore */
+    cmesh->set_partition_weights = NULL;
+    /* Compute the tree offset */
+    t8_cmesh_gather_treecount_nocommit (cmesh, comm);
+    /* Set the tree offsets to the cmesh's offset array */
+    tree_offsets = t8_shmem_array_get_gloidx_array (cmesh->tree_offsets);
+  }
   else {
     /* We compute the partition after a given partition table in cmesh->tree_offsets */
     T8_ASSERT (cmesh->tree_offsets != NULL);
@@ -81,6 +81,8 @@ t8_cmesh_trees_init (t8_cmesh_trees_t *ptrees, int num_procs,
   trees->tree_to_proc = T8_ALLOC_ZERO (int, num_trees);
   trees->ghost_to_proc = num_ghosts > 0 ? T8_ALLOC_ZERO (int, num_ghosts)
   :                   NULL;
+  trees->shmem_part = NULL;
+  trees->shmem_comm = sc_MPI_COMM_NULL;
   /* Initialize the global_id mempool */
   trees->global_local_mempool =
     sc_mempool_new (sizeof (t8_trees_glo_lo_hash_t));
@@ -225,47 +227,36 @@ t8_cmesh_trees_start_part (t8_cmesh_trees_t trees, int proc,
   part->first_ghost_id = lfirst_ghost;
 }
 
-/* After all classes of trees and ghosts have been set and after the
- * number of tree attributes  was set and their total size (per tree)
- * stored temporarily in the att_offset variable
- * we grow the part array by the needed amount of memory and set the
- * offsets appropiately */
-/* The workflow can be: call start_part, set tree and ghost classes maually, call
- * init_attributes, call finish_part, successively call add_attributes
- * and also set all face neighbors (TODO: write function)*/
-void
-t8_cmesh_trees_finish_part (t8_cmesh_trees_t trees, int proc)
+/* Compute the face neighbor and attribute offsets of all trees and ghosts of
+ * a part, after their classes and the number and total size of their
+ * attributes (temporarily stored in att_offset) have been set.
+ * On output first_face is the number of bytes of the trees and ghosts,
+ * face_neigh_bytes and attr_bytes the number of bytes needed for the face
+ * neighbors and attributes. The number of attributes is returned. */
+static size_t
+t8_cmesh_trees_part_set_offsets (t8_part_tree_t part, size_t *first_face,
+                                 size_t *face_neigh_bytes, size_t *attr_bytes)
 {
-  t8_part_tree_t      part;
   t8_ctree_t          tree;
   t8_cghost_t         ghost;
-  size_t              attr_bytes, face_neigh_bytes, temp_offset,
-    first_face, num_attributes;
-  t8_attribute_info_struct_t *attr;
+  size_t              temp_offset, num_attributes;
   t8_locidx_t         it;
-#ifndef SC_ENABLE_REALLOC
-  char               *temp;
-#endif
-
-  T8_ASSERT (trees != NULL);
-  part = t8_cmesh_trees_get_part (trees, proc);
-  T8_ASSERT (part != NULL);
 
-  attr_bytes = face_neigh_bytes = 0;
+  *attr_bytes = *face_neigh_bytes = 0;
   /* The offset of the first ghost */
   temp_offset = part->num_trees * sizeof (t8_ctree_struct_t);
   /* The offset of the first ghost face */
-  first_face = temp_offset + part->num_ghosts * sizeof (t8_cghost_struct_t);
+  *first_face = temp_offset + part->num_ghosts * sizeof (t8_cghost_struct_t);
   for (it = 0; it < part->num_ghosts; it++) {
     ghost = t8_part_tree_get_ghost (part, it + part->first_ghost_id);
-    ghost->neigh_offset = first_face + face_neigh_bytes - temp_offset;
+    ghost->neigh_offset = *first_face + *face_neigh_bytes - temp_offset;
     /* Add space for storing the gloid's of the neighbors plus the tree_to_face
      * values of the neighbors */
-    face_neigh_bytes += t8_eclass_num_faces[ghost->eclass] *
+    *face_neigh_bytes += t8_eclass_num_faces[ghost->eclass] *
       (sizeof (t8_gloidx_t) + sizeof (int8_t));
     /* This is for padding, such that face_neigh_bytes %4 == 0 */
-    face_neigh_bytes += T8_ADD_PADDING (face_neigh_bytes);
-    T8_ASSERT (face_neigh_bytes % T8_PADDING_SIZE == 0);
+    *face_neigh_bytes += T8_ADD_PADDING (*face_neigh_bytes);
+    T8_ASSERT (*face_neigh_bytes % T8_PADDING_SIZE == 0);
     temp_offset += sizeof (t8_cghost_struct_t);
   }
   /* TODO: passing through trees twice is not optimal. Can we do it all in one round?
@@ -275,13 +266,13 @@ t8_cmesh_trees_finish_part (t8_cmesh_trees_t trees, int proc)
   num_attributes = 0;
   for (it = 0; it < part->num_trees; it++) {
     tree = t8_part_tree_get_tree (part, it + part->first_tree_id);
-    tree->neigh_offset = first_face + face_neigh_bytes - temp_offset;
-    face_neigh_bytes += t8_eclass_num_faces[tree->eclass] *
+    tree->neigh_offset = *first_face + *face_neigh_bytes - temp_offset;
+    *face_neigh_bytes += t8_eclass_num_faces[tree->eclass] *
       (sizeof (t8_locidx_t) + sizeof (int8_t));
     num_attributes += tree->num_attributes;
-    face_neigh_bytes += T8_ADD_PADDING (face_neigh_bytes);
+    *face_neigh_bytes += T8_ADD_PADDING (*face_neigh_bytes);
     /* This is for padding, such that face_neigh_bytes %4 == 0 */
-    T8_ASSERT (face_neigh_bytes % T8_PADDING_SIZE == 0);
+    T8_ASSERT (*face_neigh_bytes % T8_PADDING_SIZE == 0);
     temp_offset += sizeof (t8_ctree_struct_t);
   }
 #if 0
@@ -292,10 +283,10 @@ t8_cmesh_trees_finish_part (t8_cmesh_trees_t trees, int proc)
   num_attributes = 0;
   for (it = 0; it < part->num_trees; it++) {
     tree = t8_part_tree_get_tree (part, it + part->first_tree_id);
-    attr_bytes += tree->att_offset;     /* att_offset stored the total size of the attributes */
+    *attr_bytes += tree->att_offset;    /* att_offset stored the total size of the attributes */
     /* The att_offset of the tree is the first_face plus the number of attribute
      * bytes used by previous trees minus the temp_offset */
-    tree->att_offset = first_face - temp_offset + face_neigh_bytes +
+    tree->att_offset = *first_face - temp_offset + *face_neigh_bytes +
       num_attributes * sizeof (t8_attribute_info_struct_t);
     num_attributes += tree->num_attributes;
     temp_offset += sizeof (t8_ctree_struct_t);
@@ -303,11 +294,57 @@ t8_cmesh_trees_finish_part (t8_cmesh_trees_t trees, int proc)
 #if 0
   num_attributes++;             /* Add one attribute at the end */
 #endif
-  attr_bytes += num_attributes * sizeof (t8_attribute_info_struct_t);
+  *attr_bytes += num_attributes * sizeof (t8_attribute_info_struct_t);
   /* Done setting all tree and ghost offsets */
+  return num_attributes;
+}
+
+/* Set the offset of the first attribute of a part whose memory is allocated. */
+static void
+t8_cmesh_trees_part_set_first_attribute (t8_part_tree_t part,
+                                         size_t first_face,
+                                         size_t face_neigh_bytes,
+                                         size_t num_attributes)
+{
+  t8_attribute_info_struct_t *attr;
+
+  /* Set attribute first offset, works even if there are no attributes */
+  /* TODO: It does not! This is a bug that should be fixed soon */
+  if (num_attributes > 0) {
+    attr = (t8_attribute_info_struct_t *) (part->first_tree + first_face
+                                           + face_neigh_bytes);
+    attr->attribute_offset =
+      num_attributes * sizeof (t8_attribute_info_struct_t);
+  }
+}
+
+/* After all classes of trees and ghosts have been set and after the
+ * number of tree attributes  was set and their total size (per tree)
+ * stored temporarily in the att_offset variable
+ * we grow the part array by the needed amount of memory and set the
+ * offsets appropiately */
+/* The workflow can be: call start_part, set tree and ghost classes maually, call
+ * init_attributes, call finish_part, successively call add_attributes
+ * and also set all face neighbors (TODO: write function)*/
+void
+t8_cmesh_trees_finish_part (t8_cmesh_trees_t trees, int proc)
+{
+  t8_part_tree_t      part;
+  size_t              attr_bytes, face_neigh_bytes, first_face,
+    num_attributes;
+#ifndef SC_ENABLE_REALLOC
+  char               *temp;
+#endif
+
+  T8_ASSERT (trees != NULL);
+  part = t8_cmesh_trees_get_part (trees, proc);
+  T8_ASSERT (part != NULL);
+
+  num_attributes = t8_cmesh_trees_part_set_offsets (part, &first_face,
+                                                    &face_neigh_bytes,
+                                                    &attr_bytes);
   /* Allocate memory, first_face + attr_bytes gives the new total byte count */
   /* TODO: Since we use realloc and padding, memcmp will not work, solved with memset */
-  first_face = part->num_trees * sizeof (t8_ctree_struct_t) + part->num_ghosts * sizeof (t8_cghost_struct_t);   /* Total number of bytes in first_tree */
 #ifdef SC_ENABLE_REALLOC
   SC_REALLOC (part->first_tree, char, first_face + attr_bytes
               + face_neigh_bytes);
@@ -318,14 +355,81 @@ t8_cmesh_trees_finish_part (t8_cmesh_trees_t trees, int proc)
   T8_FREE (part->first_tree);
   part->first_tree = temp;
 #endif
-  /* Set attribute first offset, works even if there are no attributes */
-  /* TODO: It does not! This is a bug that should be fixed soon */
-  if (num_attributes > 0) {
-    attr = (t8_attribute_info_struct_t *) (part->first_tree + first_face
-                                           + face_neigh_bytes);
-    attr->attribute_offset =
-      num_attributes * sizeof (t8_attribute_info_struct_t);
+  t8_cmesh_trees_part_set_first_attribute (part, first_face,
+                                           face_neigh_bytes, num_attributes);
+}
+
+/* Create the communicator for the node-shared memory of the trees.
+ * We duplicate comm, such that the shared memory type of comm is not
+ * changed and comm does not need to outlive the trees. */
+static void
+t8_cmesh_trees_shmem_comm_init (t8_cmesh_trees_t trees, sc_MPI_Comm comm)
+{
+  int                 mpiret;
+
+  T8_ASSERT (trees->shmem_comm == sc_MPI_COMM_NULL);
+  mpiret = sc_MPI_Comm_dup (comm, &trees->shmem_comm);
+  SC_CHECK_MPI (mpiret);
+  t8_shmem_init (trees->shmem_comm);
+  t8_shmem_set_type (trees->shmem_comm, T8_SHMEM_BEST_TYPE);
+}
+
+int
+t8_cmesh_trees_finish_part_shmem (t8_cmesh_trees_t trees, sc_MPI_Comm comm)
+{
+  t8_part_tree_t      part;
+  size_t              attr_bytes, face_neigh_bytes, first_face,
+    num_attributes;
+  char               *private_trees;
+
+  T8_ASSERT (trees != NULL);
+  T8_ASSERT (trees->shmem_part == NULL);
+  SC_CHECK_ABORT (trees->from_proc->elem_count == 1,
+                  "Node-shared trees are only possible for a single part.");
+  part = t8_cmesh_trees_get_part (trees, 0);
+  T8_ASSERT (part->num_ghosts == 0);
+  T8_ASSERT (part->num_trees > 0);
+
+  num_attributes = t8_cmesh_trees_part_set_offsets (part, &first_face,
+                                                    &face_neigh_bytes,
+                                                    &attr_bytes);
+  t8_cmesh_trees_shmem_comm_init (trees, comm);
+  /* Only one process per node allocates the memory */
+  t8_shmem_array_init (&trees->shmem_part, sizeof (char),
+                       first_face + face_neigh_bytes + attr_bytes,
+                       trees->shmem_comm);
+  private_trees = part->first_tree;
+  if (t8_shmem_array_start_writing (trees->shmem_part)) {
+    part->first_tree =
+      (char *) t8_shmem_array_index_for_writing (trees->shmem_part, 0);
+    /* Copy the trees and zero the remaining memory, such that
+     * padding bytes do not disturb memcmp */
+    memcpy (part->first_tree, private_trees, first_face);
+    memset (part->first_tree + first_face, 0, face_neigh_bytes + attr_bytes);
+    t8_cmesh_trees_part_set_first_attribute (part, first_face,
+                                             face_neigh_bytes,
+                                             num_attributes);
+    T8_FREE (private_trees);
+    return 1;
   }
+  /* This process does not write, it may only access the trees after
+   * t8_cmesh_trees_finish_shmem_writing */
+  part->first_tree = NULL;
+  T8_FREE (private_trees);
+  return 0;
+}
+
+void
+t8_cmesh_trees_finish_shmem_writing (t8_cmesh_trees_t trees)
+{
+  t8_part_tree_t      part;
+
+  T8_ASSERT (trees != NULL);
+  T8_ASSERT (trees->shmem_part != NULL);
+
+  t8_shmem_array_end_writing (trees->shmem_part);
+  part = t8_cmesh_trees_get_part (trees, 0);
+  part->first_tree = (char *) t8_shmem_array_get_array (trees->shmem_part);
 }
 
 void
@@ -1088,6 +1192,47 @@ t8_cmesh_trees_bcast (t8_cmesh_t cmesh_in, int root, sc_MPI_Comm comm)
                 comm);
 }
 
+void
+t8_cmesh_trees_to_shmem (t8_cmesh_trees_t trees, sc_MPI_Comm comm)
+{
+  t8_part_tree_t      part;
+  size_t              byte_count;
+  char               *private_trees;
+
+  T8_ASSERT (trees != NULL);
+  T8_ASSERT (trees->shmem_part == NULL);
+  SC_CHECK_ABORT (trees->from_proc->elem_count == 1,
+                  "Node-shared trees are only possible for a single part.");
+
+  part = t8_cmesh_trees_get_part (trees, 0);
+  T8_ASSERT (part->num_ghosts == 0);
+  byte_count = t8_cmesh_trees_get_part_alloc (trees, part);
+  if (byte_count == 0) {
+    /* There is nothing to share */
+    return;
+  }
+
+  t8_cmesh_trees_shmem_comm_init (trees, comm);
+  /* Only one process per node allocates the memory */
+  t8_shmem_array_init (&trees->shmem_part, sizeof (char), byte_count,
+                       trees->shmem_comm);
+  private_trees = part->first_tree;
+  if (t8_shmem_array_start_writing (trees->shmem_part)) {
+    /* All offsets in the part are relative to the trees, thus we can
+     * copy it as a whole */
+    memcpy (t8_shmem_array_index_for_writing (trees->shmem_part, 0),
+            private_trees, byte_count);
+  }
+  else {
+    /* Release the private copy of the non-writing processes already
+     * before the copy is done. */
+    T8_FREE (private_trees);
+    private_trees = NULL;
+  }
+  t8_cmesh_trees_finish_shmem_writing (trees);
+  T8_FREE (private_trees);
+}
+
 /* Check whether for each tree its neighbors are set consistently, that means that
  * if tree1 lists tree2 as neighbor at face i with ttf entries (or,face j),
  * then tree2 must list tree1 as neighbor at face j with ttf entries (or, face i).
@@ -1307,10 +1452,23 @@ t8_cmesh_trees_destroy (t8_cmesh_trees_t *ptrees)
   size_t              proc;
   t8_cmesh_trees_t    trees = *ptrees;
   t8_part_tree_t      part;
-
-  for (proc = 0; proc < trees->from_proc->elem_count; proc++) {
-    part = t8_cmesh_trees_get_part (trees, proc);
-    T8_FREE (part->first_tree);
+  int                 mpiret;
+
+  if (trees->shmem_part != NULL) {
+    /* The only part is stored in node-shared memory */
+    T8_ASSERT (trees->from_proc->elem_count == 1);
+    t8_shmem_array_destroy (&trees->shmem_part);
+    /* Free the duplicated communicator of the shared memory */
+    T8_ASSERT (trees->shmem_comm != sc_MPI_COMM_NULL);
+    t8_shmem_finalize (trees->shmem_comm);
+    mpiret = sc_MPI_Comm_free (&trees->shmem_comm);
+    SC_CHECK_MPI (mpiret);
+  }
+  else {
+    for (proc = 0; proc < trees->from_proc->elem_count; proc++) {
+      part = t8_cmesh_trees_get_part (trees, proc);
+      T8_FREE (part->first_tree);
+    }
   }
   T8_FREE (trees->ghost_to_proc);
   T8_FREE (trees->tree_to_proc);
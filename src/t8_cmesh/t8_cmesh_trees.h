@@ -554,6 +554,52 @@ int                 t8_cmesh_trees_is_equal (t8_cmesh_t cmesh,
                                              t8_cmesh_trees_t trees_a,
                                              t8_cmesh_trees_t trees_b);
 
+/** Move the memory of the trees of a replicated cmesh into a node-shared
+ * memory array. Afterwards only one process per node stores the trees, ghosts,
+ * face neighbors and attributes and all processes of that node read from it.
+ * The memory must not be modified afterwards.
+ * Since the trees are copied, each process stores them temporarily.
+ * Prefer \ref t8_cmesh_trees_finish_part_shmem where the trees are constructed.
+ * \param [in,out]  trees The trees structure of a committed, replicated cmesh.
+ *                        Must consist of exactly one part.
+ * \param [in]      comm  The MPI communicator of the cmesh. The shared memory
+ *                        uses a duplicate of it, such that its shared memory
+ *                        type is not changed.
+ * \note This function is MPI collective.
+ * \note If no MPI-3 shared memory windows are available, each process keeps
+ *       a private copy.
+ */
+void                t8_cmesh_trees_to_shmem (t8_cmesh_trees_t trees,
+                                             sc_MPI_Comm comm);
+
+/** Replacement of \ref t8_cmesh_trees_finish_part for a replicated cmesh whose
+ * trees are stored in node-shared memory.
+ * The face neighbor and attribute memory is allocated directly in a node-shared
+ * memory array, such that only one process per node stores it.
+ * If this function returns true, this process fills the trees with
+ * attributes and face neighbors. Afterwards, all processes must call
+ * \ref t8_cmesh_trees_finish_shmem_writing. Other processes must not access
+ * the trees before.
+ * \param [in,out]  trees The trees structure with exactly one part and without
+ *                        ghosts, on which \ref t8_cmesh_trees_start_part was called
+ *                        and whose tree classes and attribute sizes are set.
+ * \param [in]      comm  The MPI communicator of the cmesh. The shared memory
+ *                        uses a duplicate of it.
+ * \return               True if this process writes the trees.
+ * \note This function is MPI collective.
+ */
+int                 t8_cmesh_trees_finish_part_shmem (t8_cmesh_trees_t trees,
+                                                      sc_MPI_Comm comm);
+
+/** Finish writing the node-shared trees started with
+ * \ref t8_cmesh_trees_finish_part_shmem. Afterwards all processes can read
+ * the trees.
+ * \param [in,out]  trees The trees structure.
+ * \note This function is MPI collective.
+ */
+void                t8_cmesh_trees_finish_shmem_writing (t8_cmesh_trees_t
+                                                         trees);
+
 /** Free all memory allocated with a trees structure.
  *  This means that all coarse trees and ghosts, their face neighbor entries
  *  and attributes and the additional structures of trees are freed.
@@ -37,6 +37,7 @@
 typedef struct t8_part_tree *t8_part_tree_t;
 typedef struct t8_cmesh_trees *t8_cmesh_trees_t;
 typedef struct t8_cprofile t8_cprofile_t;       /* Defined below */
+typedef struct t8_cmesh_bulk t8_cmesh_bulk_t;   /* Defined below */
 
 /* TODO: no longer needed.
  *       User may use set_derived_from, then set_from is non-NULL.
@@ -110,6 +111,9 @@ typedef struct t8_cmesh
                                                 the scheme that describes the refinement pattern. See \ref t8_cmesh_set_partition. */
   int8_t              set_partition_level; /**< Non-negative if the cmesh should be partitioned from an already existing cmesh
                                          with an assumed \a level uniform mesh underneath. */
+  const t8_gloidx_t  *set_partition_weights; /**< If not NULL the cmesh should be partitioned from an already
+                                                  existing cmesh such that each process gets the same share of
+                                                  these tree weights. \ref t8_cmesh_set_partition_weights */
 #if 0
   t8_cmesh_from_t     from_method;      /* TODO: Document */
 #endif
@@ -155,6 +159,10 @@ typedef struct t8_cmesh
                                            check at commit if it equals the total number. */
 #endif
   t8_stash_t          stash; /**< Used as temporary storage for the trees before commit. */
+  t8_cmesh_bulk_t    *set_bulk; /**< If not NULL, the local trees and ghosts are given
+                                     as arrays and the stash is not used. \ref t8_cmesh_set_partition_bulk */
+  int                 set_node_shared; /**< If true and the cmesh is replicated, the trees are stored
+                                             in node-shared memory after commit. \ref t8_cmesh_set_node_shared */
   t8_cprofile_t      *profile; /**< Used to measure runtimes and statistics of the cmesh algorithms. */
 }
 t8_cmesh_struct_t;
@@ -243,6 +251,11 @@ typedef struct t8_attribute_info
 typedef struct t8_cmesh_trees
 {
   sc_array_t         *from_proc;        /* array of t8_part_tree, one for each process */
+  t8_shmem_array_t    shmem_part;       /* If not NULL, the memory of the only part is stored
+                                           in this node-shared array and must not be modified.
+                                           See t8_cmesh_trees_to_shmem */
+  sc_MPI_Comm         shmem_comm;       /* If not sc_MPI_COMM_NULL, the duplicated communicator
+                                           of shmem_part. */
   int                *tree_to_proc;     /* for each tree its process */
   int                *ghost_to_proc;    /* for each ghost its process */
   sc_hash_t          *ghost_globalid_to_local_id;       /* A hash table storing the map
@@ -265,6 +278,24 @@ typedef struct t8_part_tree
 }
 t8_part_tree_struct_t;
 
+/** The user provided arrays that describe the local part of a partitioned
+ * cmesh. They are stored by \ref t8_cmesh_set_partition_bulk and read at commit.
+ * The arrays are owned by the user.
+ */
+typedef struct t8_cmesh_bulk
+{
+  const t8_eclass_t  *tree_classes; /**< The eclass of each local tree. */
+  const double       *tree_vertices; /**< 3 * T8_ECLASS_MAX_CORNERS coordinates per local tree, may be NULL. */
+  const t8_gloidx_t  *tree_face_neighbors; /**< F global neighbor ids per local tree, negative for boundary. */
+  const int8_t       *tree_to_face; /**< F tree-to-face values per local tree. */
+  t8_locidx_t         num_ghosts; /**< The number of ghosts. */
+  const t8_gloidx_t  *ghost_ids; /**< The sorted global ids of the ghosts. */
+  const t8_eclass_t  *ghost_classes; /**< The eclass of each ghost. */
+  const t8_gloidx_t  *ghost_face_neighbors; /**< F global neighbor ids per ghost, may be NULL. */
+  const int8_t       *ghost_to_face; /**< F tree-to-face values per ghost, may be NULL. */
+}
+t8_cmesh_bulk_struct_t;
+
 /* TODO: Extend this structure with meaningful entries.
  *       Maybe the number of shipped trees per process is useful?
  */
@@ -305,4 +305,331 @@ t8_element_array_truncate (t8_element_array_t *element_array)
   sc_array_truncate (&element_array->array);
 }
 
+void
+t8_element_compact_array_init (t8_element_compact_array_t *compact,
+                               t8_eclass_scheme_c *scheme)
+{
+  T8_ASSERT (compact != NULL);
+  T8_ASSERT (scheme != NULL);
+
+  compact->scheme = scheme;
+  compact->count = 0;
+  sc_array_init (&compact->block_offsets, sizeof (size_t));
+  sc_array_init (&compact->packed, sizeof (char));
+}
+
+void
+t8_element_compact_array_reset (t8_element_compact_array_t *compact)
+{
+  T8_ASSERT (compact != NULL);
+
+  compact->count = 0;
+  sc_array_reset (&compact->block_offsets);
+  sc_array_reset (&compact->packed);
+}
+
+/* Return the number of elements in a block of a compact array */
+static size_t
+t8_element_compact_array_block_count (const t8_element_compact_array_t
+                                      *compact, size_t iblock)
+{
+  T8_ASSERT (iblock < compact->block_offsets.elem_count);
+  return SC_MIN (T8_ELEMENT_COMPACT_BLOCK_SIZE,
+                 compact->count - iblock * T8_ELEMENT_COMPACT_BLOCK_SIZE);
+}
+
+/* Pack a range of elements as a new block at the end of a compact array */
+static void
+t8_element_compact_array_pack_block (t8_element_compact_array_t *compact,
+                                     t8_element_array_t *element_array,
+                                     size_t offset, size_t count)
+{
+  const size_t        byte_offset = compact->packed.elem_count;
+  size_t              num_bytes;
+
+  T8_ASSERT (0 < count && count <= T8_ELEMENT_COMPACT_BLOCK_SIZE);
+  T8_ASSERT (compact->count % T8_ELEMENT_COMPACT_BLOCK_SIZE == 0);
+
+  *(size_t *) sc_array_push (&compact->block_offsets) = byte_offset;
+  sc_array_resize (&compact->packed,
+                   byte_offset + t8_element_array_pack_bound (count));
+  num_bytes =
+    t8_element_array_pack (element_array, offset, count,
+                           (char *) sc_array_index (&compact->packed,
+                                                    byte_offset));
+  sc_array_resize (&compact->packed, byte_offset + num_bytes);
+  compact->count += count;
+}
+
+/* Unpack the first count elements of a block of a compact array into
+ * the elements offset, ..., offset + count - 1 of an element array */
+static void
+t8_element_compact_array_unpack_block (t8_element_compact_array_t *compact,
+                                       size_t iblock, size_t count,
+                                       t8_element_array_t *element_array,
+                                       size_t offset)
+{
+  const size_t        byte_offset =
+    *(size_t *) sc_array_index (&compact->block_offsets, iblock);
+
+  T8_ASSERT (count <= t8_element_compact_array_block_count (compact, iblock));
+  t8_element_array_unpack (element_array, offset, count,
+                           (const char *) sc_array_index (&compact->packed,
+                                                          byte_offset));
+}
+
+void
+t8_element_compact_array_encode (t8_element_compact_array_t *compact,
+                                 t8_element_array_t *element_array)
+{
+  const size_t        num_elements =
+    t8_element_array_get_count (element_array);
+  t8_element_array_t  last_block;
+  size_t              first = 0, count, num_last, iblock, ielement;
+
+  T8_ASSERT (compact != NULL && compact->scheme != NULL);
+  T8_ASSERT (t8_element_array_is_valid (element_array));
+  T8_ASSERT (compact->scheme == element_array->scheme);
+
+  num_last = compact->count % T8_ELEMENT_COMPACT_BLOCK_SIZE;
+  if (num_last > 0 && num_elements > 0) {
+    /* The last block is not full. We unpack it, append the first new
+     * elements and pack it again. */
+    count = SC_MIN (T8_ELEMENT_COMPACT_BLOCK_SIZE - num_last, num_elements);
+    iblock = compact->block_offsets.elem_count - 1;
+    t8_element_array_init_size (&last_block, compact->scheme,
+                                num_last + count);
+    t8_element_compact_array_unpack_block (compact, iblock, num_last,
+                                           &last_block, 0);
+    for (ielement = 0; ielement < count; ielement++) {
+      compact->scheme->
+        t8_element_copy (t8_element_array_index_locidx
+                         (element_array, ielement),
+                         t8_element_array_index_locidx (&last_block,
+                                                        num_last + ielement));
+    }
+    sc_array_resize (&compact->packed,
+                     *(size_t *) sc_array_index (&compact->block_offsets,
+                                                 iblock));
+    sc_array_resize (&compact->block_offsets, iblock);
+    compact->count -= num_last;
+    t8_element_compact_array_pack_block (compact, &last_block, 0,
+                                         num_last + count);
+    t8_element_array_reset (&last_block);
+    first = count;
+  }
+  /* Pack the remaining elements in new blocks */
+  for (; first < num_elements; first += count) {
+    count = SC_MIN (T8_ELEMENT_COMPACT_BLOCK_SIZE, num_elements - first);
+    t8_element_compact_array_pack_block (compact, element_array, first,
+                                         count);
+  }
+}
+
+void
+t8_element_compact_array_index (t8_element_compact_array_t *compact,
+                                size_t index, t8_element_t *element)
+{
+  t8_element_array_t  block;
+  const size_t        iblock = index / T8_ELEMENT_COMPACT_BLOCK_SIZE;
+  const size_t        count = index % T8_ELEMENT_COMPACT_BLOCK_SIZE + 1;
+
+  T8_ASSERT (compact != NULL && compact->scheme != NULL);
+  T8_ASSERT (index < compact->count);
+
+  /* Since the elements are delta encoded, we unpack the block up to the
+   * element */
+  t8_element_array_init_size (&block, compact->scheme, count);
+  t8_element_compact_array_unpack_block (compact, iblock, count, &block, 0);
+  compact->scheme->t8_element_copy (t8_element_array_index_locidx (&block,
+                                                                   count - 1),
+                                    element);
+  t8_element_array_reset (&block);
+}
+
+void
+t8_element_compact_array_decode (t8_element_compact_array_t *compact,
+                                 size_t offset, size_t count,
+                                 t8_element_array_t *element_array)
+{
+  t8_element_array_t  block;
+  size_t              ielement, iblock, block_first, block_end, end, icopy;
+  int                 block_is_init = 0;
+
+  T8_ASSERT (compact != NULL && compact->scheme != NULL);
+  T8_ASSERT (t8_element_array_is_valid (element_array));
+  T8_ASSERT (compact->scheme == element_array->scheme);
+  T8_ASSERT (offset + count <= compact->count);
+
+  t8_element_array_resize (element_array, count);
+  end = offset + count;
+  for (ielement = offset; ielement < end; ielement = block_end) {
+    iblock = ielement / T8_ELEMENT_COMPACT_BLOCK_SIZE;
+    block_first = iblock * T8_ELEMENT_COMPACT_BLOCK_SIZE;
+    block_end =
+      block_first + t8_element_compact_array_block_count (compact, iblock);
+    if (ielement == block_first && block_end <= end) {
+      /* The range contains the whole block, we unpack it in place */
+      t8_element_compact_array_unpack_block (compact, iblock,
+                                             block_end - block_first,
+                                             element_array,
+                                             ielement - offset);
+    }
+    else {
+      /* The range contains only a part of the block, we unpack the block
+       * up to the end of the range and copy the elements in the range */
+      block_end = SC_MIN (block_end, end);
+      if (!block_is_init) {
+        t8_element_array_init_size (&block, compact->scheme,
+                                    T8_ELEMENT_COMPACT_BLOCK_SIZE);
+        block_is_init = 1;
+      }
+      t8_element_compact_array_unpack_block (compact, iblock,
+                                             block_end - block_first,
+                                             &block, 0);
+      for (icopy = ielement; icopy < block_end; icopy++) {
+        compact->scheme->
+          t8_element_copy (t8_element_array_index_locidx
+                           (&block, icopy - block_first),
+                           t8_element_array_index_locidx (element_array,
+                                                          icopy - offset));
+      }
+    }
+  }
+  if (block_is_init) {
+    t8_element_array_reset (&block);
+  }
+}
+
+size_t
+t8_element_compact_array_get_count (t8_element_compact_array_t *compact)
+{
+  T8_ASSERT (compact != NULL);
+
+  return compact->count;
+}
+
+size_t
+t8_element_compact_array_get_bytes (t8_element_compact_array_t *compact)
+{
+  T8_ASSERT (compact != NULL);
+
+  return compact->block_offsets.elem_count * compact->block_offsets.elem_size
+    + compact->packed.elem_count * compact->packed.elem_size;
+}
+
+/* The maximum number of bytes of a variable length encoded t8_linearidx_t */
+#define T8_ELEMENT_PACK_MAX_VARINT 10
+
+/* Write a variable length integer with 7 bits per byte and return the
+ * number of bytes written. */
+static size_t
+t8_element_pack_varint (t8_linearidx_t value, char *buffer)
+{
+  size_t              num_bytes = 0;
+
+  while (value >= 0x80) {
+    buffer[num_bytes++] = (char) ((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  buffer[num_bytes++] = (char) value;
+  return num_bytes;
+}
+
+/* Read a variable length integer and return the number of bytes read. */
+static size_t
+t8_element_unpack_varint (const char *buffer, t8_linearidx_t *value)
+{
+  size_t              num_bytes = 0;
+  int                 shift = 0;
+  unsigned char       byte;
+
+  *value = 0;
+  do {
+    byte = (unsigned char) buffer[num_bytes++];
+    *value |= ((t8_linearidx_t) (byte & 0x7f)) << shift;
+    shift += 7;
+  } while (byte & 0x80);
+  T8_ASSERT (num_bytes <= T8_ELEMENT_PACK_MAX_VARINT);
+  return num_bytes;
+}
+
+size_t
+t8_element_array_pack_bound (size_t count)
+{
+  /* The encoding level and for each element its level and distance */
+  return 1 + count * (1 + T8_ELEMENT_PACK_MAX_VARINT);
+}
+
+/* The stream consists of the level at which we compute the linear ids,
+ * followed by the level and the distance for each element.
+ * We use the finest level of the packed elements to compute the linear ids,
+ * such that all ids and leaf counts fit into a t8_linearidx_t. */
+size_t
+t8_element_array_pack (t8_element_array_t *element_array, size_t offset,
+                       size_t count, char *buffer)
+{
+  t8_eclass_scheme_c *ts;
+  const t8_element_t *element;
+  t8_linearidx_t      id, prev_end = 0;
+  size_t              ielement, num_bytes = 0;
+  int                 level, id_level = 0;
+
+  T8_ASSERT (t8_element_array_is_valid (element_array));
+  T8_ASSERT (offset + count <= t8_element_array_get_count (element_array));
+  ts = element_array->scheme;
+
+  for (ielement = offset; ielement < offset + count; ielement++) {
+    element = t8_element_array_index_locidx (element_array, ielement);
+    id_level = SC_MAX (id_level, ts->t8_element_level (element));
+  }
+  T8_ASSERT (id_level <= INT8_MAX);
+  buffer[num_bytes++] = (char) id_level;
+
+  for (ielement = offset; ielement < offset + count; ielement++) {
+    element = t8_element_array_index_locidx (element_array, ielement);
+    level = ts->t8_element_level (element);
+    id = ts->t8_element_get_linear_id (element, id_level);
+    T8_ASSERT (id >= prev_end);
+    buffer[num_bytes++] = (char) level;
+    num_bytes += t8_element_pack_varint (id - prev_end, buffer + num_bytes);
+    prev_end = id + ts->t8_element_count_leafs (element, id_level);
+  }
+  T8_ASSERT (num_bytes <= t8_element_array_pack_bound (count));
+  return num_bytes;
+}
+
+size_t
+t8_element_array_unpack (t8_element_array_t *element_array, size_t offset,
+                         size_t count, const char *buffer)
+{
+  t8_eclass_scheme_c *ts;
+  t8_element_t       *element;
+  t8_linearidx_t      id, distance, prev_end = 0;
+  size_t              ielement, num_bytes = 0;
+  int                 level, id_level;
+
+  T8_ASSERT (t8_element_array_is_valid (element_array));
+  T8_ASSERT (offset + count <= t8_element_array_get_count (element_array));
+  ts = element_array->scheme;
+
+  id_level = buffer[num_bytes++];
+  for (ielement = offset; ielement < offset + count; ielement++) {
+    element = t8_element_array_index_locidx (element_array, ielement);
+    level = buffer[num_bytes++];
+    num_bytes += t8_element_unpack_varint (buffer + num_bytes, &distance);
+    id = prev_end + distance;
+    /* Construct the first descendant at the id level and from it the
+     * element at its own level */
+    ts->t8_element_set_linear_id (element, id_level, id);
+    if (level < id_level) {
+      ts->t8_element_set_linear_id (element, level,
+                                    ts->t8_element_get_linear_id (element,
+                                                                  level));
+    }
+    prev_end = id + ts->t8_element_count_leafs (element, id_level);
+  }
+  return num_bytes;
+}
+
 T8_EXTERN_C_END ();
@@ -44,6 +44,26 @@ typedef struct
   sc_array_t          array;  /**< The array in which the elements are stored */
 } t8_element_array_t;
 
+/** The number of elements in each block of a \ref t8_element_compact_array_t. */
+#define T8_ELEMENT_COMPACT_BLOCK_SIZE 64
+
+/** The t8_element_compact_array_t stores leaf elements of one tree of a given
+ * eclass scheme in the packed form of \ref t8_element_array_pack.
+ * The elements are packed in blocks of \ref T8_ELEMENT_COMPACT_BLOCK_SIZE
+ * elements, such that a single element can be decoded without decoding all
+ * previous elements. For a range of elements without gaps this takes about
+ * two bytes per element independent of the scheme's element size.
+ * Use it to keep elements that are not frequently accessed, for example the
+ * elements of a forest that is stored for later use.
+ */
+typedef struct
+{
+  t8_eclass_scheme_c *scheme; /**< An eclass scheme of which elements should be stored */
+  size_t              count;  /**< The number of stored elements */
+  sc_array_t          block_offsets; /**< The offset of each block in \a packed, of type size_t */
+  sc_array_t          packed; /**< The packed elements of all blocks, of type char */
+} t8_element_compact_array_t;
+
 T8_EXTERN_C_BEGIN ();
 
 /** Creates a new array structure with 0 elements.
@@ -234,6 +254,112 @@ void                t8_element_array_reset (t8_element_array_t
 void                t8_element_array_truncate (t8_element_array_t
                                                *element_array);
 
+/** Initialize a compact element array with zero elements.
+ * \param [in,out] compact  The compact array to initialize.
+ * \param [in]     scheme   The eclass scheme of which elements should be stored.
+ */
+void                t8_element_compact_array_init (t8_element_compact_array_t
+                                                   *compact,
+                                                   t8_eclass_scheme_c
+                                                   *scheme);
+
+/** Free the memory of a compact element array and set its count to zero.
+ * \param [in,out] compact  The compact array to reset.
+ */
+void                t8_element_compact_array_reset (t8_element_compact_array_t
+                                                    *compact);
+
+/** Encode all elements of an element array and append them to a compact
+ * element array.
+ * \param [in,out] compact       The compact array.
+ * \param [in]     element_array An element array with the same scheme as \a compact.
+ *                               Its elements must be leaves of one tree in
+ *                               increasing SFC order that follow the elements
+ *                               of \a compact, as they are stored in a forest.
+ */
+void                t8_element_compact_array_encode (t8_element_compact_array_t
+                                                     *compact,
+                                                     t8_element_array_t
+                                                     *element_array);
+
+/** Decode one element of a compact element array.
+ * This decodes all previous elements of the element's block.
+ * \param [in]     compact  The compact array.
+ * \param [in]     index    The index of the element, smaller than the count of \a compact.
+ * \param [in,out] element  An allocated element of the array's scheme.
+ *                          On output the decoded element.
+ */
+void                t8_element_compact_array_index (t8_element_compact_array_t
+                                                    *compact, size_t index,
+                                                    t8_element_t *element);
+
+/** Decode a range of elements of a compact element array into an element array.
+ * \param [in]     compact       The compact array.
+ * \param [in]     offset        The index of the first element to decode.
+ * \param [in]     count         The number of elements to decode.
+ *                               \a offset + \a count must not exceed the count of \a compact.
+ * \param [in,out] element_array An element array with the same scheme as \a compact.
+ *                               On output it has \a count elements, the decoded elements.
+ */
+void                t8_element_compact_array_decode (t8_element_compact_array_t
+                                                     *compact, size_t offset,
+                                                     size_t count,
+                                                     t8_element_array_t
+                                                     *element_array);
+
+/** Return the number of elements in a compact element array.
+ * \param [in]  compact  The compact array.
+ * \return               The number of elements.
+ */
+size_t              t8_element_compact_array_get_count
+  (t8_element_compact_array_t * compact);
+
+/** Return the number of bytes that the elements of a compact element array use.
+ * \param [in]  compact  The compact array.
+ * \return               The number of bytes of the encoded elements.
+ */
+size_t              t8_element_compact_array_get_bytes
+  (t8_element_compact_array_t * compact);
+
+/** Return an upper bound for the number of bytes that
+ * \ref t8_element_array_pack writes for a given number of elements.
+ * \param [in]  count     The number of elements.
+ * \return                An upper bound for the number of packed bytes.
+ */
+size_t              t8_element_array_pack_bound (size_t count);
+
+/** Pack a range of elements of an element array into a byte stream.
+ * The elements must be leaves of one tree in increasing SFC order, as they
+ * are stored in a forest or ghost tree.
+ * Each element is encoded by its level and the distance of its first
+ * descendant to the end of the previous element as a variable length integer.
+ * For a range of elements without gaps this takes about two bytes per element.
+ * \param [in]  element_array The element array.
+ * \param [in]  offset        The index of the first element to pack.
+ * \param [in]  count         The number of elements to pack.
+ * \param [out] buffer        A buffer of at least \ref t8_element_array_pack_bound
+ *                            bytes. On output the packed elements.
+ * \return                    The number of bytes written to \a buffer.
+ */
+size_t              t8_element_array_pack (t8_element_array_t
+                                           *element_array, size_t offset,
+                                           size_t count, char *buffer);
+
+/** Unpack elements that were packed with \ref t8_element_array_pack.
+ * \param [in,out] element_array An element array of the same scheme as the
+ *                            packed elements with at least \a offset + \a count
+ *                            elements. On output the elements \a offset, ...,
+ *                            \a offset + \a count - 1 are the unpacked elements.
+ * \param [in]  offset        The index of the first element to unpack to.
+ * \param [in]  count         The number of packed elements.
+ * \param [in]  buffer        The packed elements.
+ * \return                    The number of bytes read from \a buffer.
+ */
+size_t              t8_element_array_unpack (t8_element_array_t
+                                             *element_array, size_t offset,
+                                             size_t count,
+                                             const char *buffer);
+
 T8_EXTERN_C_END ();
 
 #endif /* !T8_CONTAINERS_HXX */
@@ -0,0 +1,134 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+#include <t8_data/t8_neighbor_comm.h>
+
+int
+t8_neighbor_comm_is_available (void)
+{
+#ifdef T8_ENABLE_NEIGHBOR_COMM
+  return 1;
+#else
+  return 0;
+#endif
+}
+
+sc_MPI_Comm
+t8_neighbor_comm_create (sc_MPI_Comm comm, int num_sources,
+                         const int *sources, int num_dests, const int *dests)
+{
+#ifdef T8_ENABLE_NEIGHBOR_COMM
+  sc_MPI_Comm         neighbor_comm;
+  int                 mpiret;
+
+  T8_ASSERT (comm != sc_MPI_COMM_NULL);
+  T8_ASSERT (num_sources >= 0 && num_dests >= 0);
+  T8_ASSERT (num_sources == 0 || sources != NULL);
+  T8_ASSERT (num_dests == 0 || dests != NULL);
+
+  /* We do not allow reordering, since the ranks of the graph communicator
+   * must match the ranks of comm. */
+  mpiret = MPI_Dist_graph_create_adjacent (comm, num_sources, sources,
+                                           MPI_UNWEIGHTED, num_dests, dests,
+                                           MPI_UNWEIGHTED, MPI_INFO_NULL, 0,
+                                           &neighbor_comm);
+  SC_CHECK_MPI (mpiret);
+  return neighbor_comm;
+#else
+  SC_ABORT ("Neighborhood collectives require an MPI-3 library.");
+  return sc_MPI_COMM_NULL;
+#endif
+}
+
+void
+t8_neighbor_comm_destroy (sc_MPI_Comm *pcomm)
+{
+#ifdef T8_ENABLE_NEIGHBOR_COMM
+  int                 mpiret;
+
+  T8_ASSERT (pcomm != NULL);
+  if (*pcomm != sc_MPI_COMM_NULL) {
+    mpiret = sc_MPI_Comm_free (pcomm);
+    SC_CHECK_MPI (mpiret);
+  }
+#endif
+  *pcomm = sc_MPI_COMM_NULL;
+}
+
+char               *
+t8_neighbor_comm_alltoallv (sc_MPI_Comm neighbor_comm, int num_dests,
+                            char *const *send_buffers, const int *send_bytes,
+                            int num_sources, int *recv_bytes,
+                            int *recv_offsets)
+{
+#ifdef T8_ENABLE_NEIGHBOR_COMM
+  int                 mpiret, idest, isource;
+  int                *send_offsets;
+  size_t              total_send = 0, total_recv = 0;
+  char               *send_buffer, *recv_buffer;
+
+  T8_ASSERT (neighbor_comm != sc_MPI_COMM_NULL);
+
+  /* Exchange the message sizes. MPI requires valid buffers even if
+   * a process has no neighbors. */
+  mpiret = MPI_Neighbor_alltoall ((void *) send_bytes, 1, sc_MPI_INT,
+                                  recv_bytes, 1, sc_MPI_INT, neighbor_comm);
+  SC_CHECK_MPI (mpiret);
+
+  /* Concatenate the messages into one send buffer */
+  send_offsets = T8_ALLOC (int, num_dests + 1);
+  for (idest = 0; idest < num_dests; idest++) {
+    send_offsets[idest] = (int) total_send;
+    total_send += send_bytes[idest];
+  }
+  SC_CHECK_ABORT (total_send <= INT_MAX,
+                  "Neighborhood message exceeds the maximum MPI count.");
+  send_buffer = T8_ALLOC (char, total_send + 1);
+  for (idest = 0; idest < num_dests; idest++) {
+    if (send_bytes[idest] > 0) {
+      memcpy (send_buffer + send_offsets[idest], send_buffers[idest],
+              send_bytes[idest]);
+    }
+  }
+
+  for (isource = 0; isource < num_sources; isource++) {
+    recv_offsets[isource] = (int) total_recv;
+    total_recv += recv_bytes[isource];
+  }
+  SC_CHECK_ABORT (total_recv <= INT_MAX,
+                  "Neighborhood message exceeds the maximum MPI count.");
+  recv_buffer = T8_ALLOC (char, total_recv + 1);
+
+  mpiret = MPI_Neighbor_alltoallv (send_buffer, (int *) send_bytes,
+                                   send_offsets, sc_MPI_BYTE, recv_buffer,
+                                   recv_bytes, recv_offsets, sc_MPI_BYTE,
+                                   neighbor_comm);
+  SC_CHECK_MPI (mpiret);
+
+  T8_FREE (send_buffer);
+  T8_FREE (send_offsets);
+  return recv_buffer;
+#else
+  SC_ABORT ("Neighborhood collectives require an MPI-3 library.");
+  return NULL;
+#endif
+}
@@ -0,0 +1,100 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/** \file t8_neighbor_comm.h
+ * Sparse message exchange with MPI-3 neighborhood collectives.
+ * A distributed graph communicator is built from the ranks that a process
+ * sends to and receives from. All messages are then exchanged with one
+ * call to MPI_Neighbor_alltoallv instead of matching point-to-point messages.
+ */
+
+#ifndef T8_NEIGHBOR_COMM_H
+#define T8_NEIGHBOR_COMM_H
+
+#include <t8.h>
+
+/* Neighborhood collectives were introduced with MPI 3.0 */
+#if T8_ENABLE_MPI && defined (MPI_VERSION) && MPI_VERSION >= 3
+#define T8_ENABLE_NEIGHBOR_COMM 1
+#endif
+
+T8_EXTERN_C_BEGIN ();
+
+/** Query whether neighborhood collectives are available.
+ * \return True if t8code was configured with an MPI library that
+ *         supports MPI-3 neighborhood collectives.
+ */
+int                 t8_neighbor_comm_is_available (void);
+
+/** Create a distributed graph communicator from the ranks that this process
+ * receives from and sends to.
+ * This function is collective over \a comm. If a process lists rank q as
+ * destination, q must list this process as source.
+ * \param [in]  comm        The MPI communicator.
+ * \param [in]  num_sources The number of ranks that we receive from.
+ * \param [in]  sources     The ranks that we receive from, in the order in
+ *                          which the messages are received.
+ * \param [in]  num_dests   The number of ranks that we send to.
+ * \param [in]  dests       The ranks that we send to, in the order in which
+ *                          the messages are sent.
+ * \return                  The graph communicator. Must be freed with
+ *                          \ref t8_neighbor_comm_destroy.
+ * \note Aborts if \ref t8_neighbor_comm_is_available returns false.
+ */
+sc_MPI_Comm         t8_neighbor_comm_create (sc_MPI_Comm comm,
+                                             int num_sources,
+                                             const int *sources,
+                                             int num_dests,
+                                             const int *dests);
+
+/** Free a graph communicator created with \ref t8_neighbor_comm_create.
+ * \param [in,out] pcomm    The communicator. Set to sc_MPI_COMM_NULL on output.
+ */
+void                t8_neighbor_comm_destroy (sc_MPI_Comm *pcomm);
+
+/** Send one message to each destination and receive one message from each
+ * source of a graph communicator.
+ * This function is collective over \a neighbor_comm.
+ * \param [in]  neighbor_comm The graph communicator.
+ * \param [in]  num_dests   The number of destinations of \a neighbor_comm.
+ * \param [in]  send_buffers For each destination the message to send.
+ * \param [in]  send_bytes  For each destination the number of bytes to send.
+ * \param [in]  num_sources The number of sources of \a neighbor_comm.
+ * \param [out] recv_bytes  Array of length \a num_sources. On output the
+ *                          number of bytes received from each source.
+ * \param [out] recv_offsets Array of length \a num_sources. On output the
+ *                          offset of each source's message in the returned buffer.
+ * \return                  The received messages, allocated with T8_ALLOC.
+ *                          Must be freed with T8_FREE. May be NULL if
+ *                          nothing was received.
+ */
+char               *t8_neighbor_comm_alltoallv (sc_MPI_Comm neighbor_comm,
+                                                int num_dests,
+                                                char *const *send_buffers,
+                                                const int *send_bytes,
+                                                int num_sources,
+                                                int *recv_bytes,
+                                                int *recv_offsets);
+
+T8_EXTERN_C_END ();
+
+#endif /* !T8_NEIGHBOR_COMM_H */
@@ -78,6 +78,8 @@ t8_eclass_t;
 #define T8_ECLASS_MAX_CORNERS 8
 /** The maximal possible dimension for an eclass */
 #define T8_ECLASS_MAX_DIM 3
+/** The maximum number of children an element of any class can have. */
+#define T8_ECLASS_MAX_CHILDREN 10
 
 /** Map each of the element classes to its dimension. */
 extern const int    t8_eclass_to_dimension[T8_ECLASS_COUNT];
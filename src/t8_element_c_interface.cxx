@@ -477,3 +477,12 @@ t8_element_destroy (t8_eclass_scheme_c *ts, int length, t8_element_t **elems)
 
   ts->t8_element_destroy (length, elems);
 }
+
+void
+t8_element_new_in_buffer (t8_eclass_scheme_c *ts, int length, void *buffer,
+                          t8_element_t **elems)
+{
+  T8_ASSERT (ts != NULL);
+
+  ts->t8_element_new_in_buffer (length, buffer, elems);
+}
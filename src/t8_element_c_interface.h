@@ -737,6 +737,17 @@ void                t8_element_new (t8_eclass_scheme_c *ts, int length,
 void                t8_element_destroy (t8_eclass_scheme_c *ts, int length,
                                         t8_element_t **elems);
 
+/** Initialize an array of elements in caller provided memory.
+ * \param [in] ts             Implementation of a class scheme.
+ * \param [in] length         The number of elements.
+ * \param [in,out] buffer     Memory of at least \a length * \ref t8_element_size bytes.
+ * \param [out] elems         Array of \a length element pointers into \a buffer.
+ * \see t8_eclass_scheme::t8_element_new_in_buffer
+ */
+void                t8_element_new_in_buffer (t8_eclass_scheme_c *ts,
+                                              int length, void *buffer,
+                                              t8_element_t **elems);
+
 T8_EXTERN_C_END ();
 
 #endif /* !T8_ELEMENT_C_INTERFACE_H */
@@ -56,8 +56,168 @@ t8_eclass_scheme::t8_element_size ()
 {
   return element_size;
 }
+
+/* Default implementation for the element initialization in a buffer */
+void
+t8_eclass_scheme::t8_element_new_in_buffer (int length, void *buffer,
+                                            t8_element_t **elem)
+{
+  int                 ielem;
+
+  T8_ASSERT (0 <= length);
+  T8_ASSERT (length == 0 || buffer != NULL);
+  T8_ASSERT (length == 0 || elem != NULL);
+
+  for (ielem = 0; ielem < length; ielem++) {
+    elem[ielem] =
+      (t8_element_t *) ((char *) buffer + ielem * t8_element_size ());
+  }
+  if (length > 0) {
+    t8_element_init (length, (t8_element_t *) buffer, 0);
+  }
+}
 /* *INDENT-ON* */
 
+void
+t8_element_sfc_iterator_init (t8_element_sfc_iterator_t *iter,
+                              t8_eclass_scheme_c *scheme, int level,
+                              t8_linearidx_t first_id)
+{
+  int                 ilevel;
+
+  T8_ASSERT (iter != NULL);
+  T8_ASSERT (scheme != NULL);
+  T8_ASSERT (0 <= level && level <= scheme->t8_element_maxlevel ());
+
+  iter->scheme = scheme;
+  iter->level = level;
+  iter->ancestors = T8_ALLOC (t8_element_t *, level + 1);
+  iter->child_ids = T8_ALLOC_ZERO (int, level + 1);
+  iter->num_children = T8_ALLOC_ZERO (int, level + 1);
+  iter->buffer = T8_ALLOC (char, (level + 1) * scheme->t8_element_size ());
+  scheme->t8_element_new_in_buffer (level + 1, iter->buffer,
+                                    iter->ancestors);
+
+  /* Build the first element and all its ancestors */
+  scheme->t8_element_set_linear_id (iter->ancestors[level], level, first_id);
+  for (ilevel = level; ilevel > 0; ilevel--) {
+    iter->child_ids[ilevel] =
+      scheme->t8_element_child_id (iter->ancestors[ilevel]);
+    scheme->t8_element_parent (iter->ancestors[ilevel],
+                               iter->ancestors[ilevel - 1]);
+    iter->num_children[ilevel - 1] =
+      scheme->t8_element_num_children (iter->ancestors[ilevel - 1]);
+  }
+}
+
+const t8_element_t *
+t8_element_sfc_iterator_current (const t8_element_sfc_iterator_t *iter)
+{
+  T8_ASSERT (iter != NULL && iter->ancestors != NULL);
+  return iter->ancestors[iter->level];
+}
+
+int
+t8_element_sfc_iterator_next (t8_element_sfc_iterator_t *iter)
+{
+  t8_eclass_scheme_c *scheme;
+  int                 ilevel, jlevel;
+
+  T8_ASSERT (iter != NULL && iter->ancestors != NULL);
+  scheme = iter->scheme;
+  /* Find the finest ancestor that is not the last child of its parent */
+  ilevel = iter->level;
+  while (ilevel > 0
+         && iter->child_ids[ilevel] == iter->num_children[ilevel - 1] - 1) {
+    ilevel--;
+  }
+  if (ilevel == 0) {
+    /* The current element is the last element in the root */
+    return 0;
+  }
+  /* Advance this ancestor to its next sibling and descend along the
+   * first children to the iterated level */
+  iter->child_ids[ilevel]++;
+  for (jlevel = ilevel; jlevel <= iter->level; jlevel++) {
+    scheme->t8_element_child (iter->ancestors[jlevel - 1],
+                              iter->child_ids[jlevel],
+                              iter->ancestors[jlevel]);
+    if (jlevel < iter->level) {
+      iter->child_ids[jlevel + 1] = 0;
+      iter->num_children[jlevel] =
+        scheme->t8_element_num_children (iter->ancestors[jlevel]);
+    }
+  }
+  return 1;
+}
+
+void
+t8_element_sfc_iterator_fill (t8_element_sfc_iterator_t *iter, size_t count,
+                              t8_element_t *elements)
+{
+  const size_t        size = iter->scheme->t8_element_size ();
+  size_t              ielem;
+  int                 has_next;
+
+  T8_ASSERT (iter != NULL && iter->ancestors != NULL);
+  for (ielem = 0; ielem < count; ielem++) {
+    if (ielem > 0) {
+      has_next = t8_element_sfc_iterator_next (iter);
+      SC_CHECK_ABORT (has_next, "Not enough elements to fill the array.");
+    }
+    iter->scheme->t8_element_copy (iter->ancestors[iter->level],
+                                   (t8_element_t *) ((char *) elements +
+                                                     ielem * size));
+  }
+}
+
+void
+t8_element_sfc_iterator_reset (t8_element_sfc_iterator_t *iter)
+{
+  T8_ASSERT (iter != NULL);
+  T8_FREE (iter->ancestors);
+  T8_FREE (iter->child_ids);
+  T8_FREE (iter->num_children);
+  T8_FREE (iter->buffer);
+  iter->ancestors = NULL;
+  iter->child_ids = NULL;
+  iter->num_children = NULL;
+  iter->buffer = NULL;
+}
+
+t8_element_t      **
+t8_element_buffer_init (t8_element_buffer_t *buffer,
+                        t8_eclass_scheme_c *scheme, int length)
+{
+  const size_t        size = scheme->t8_element_size ();
+  void               *memory;
+
+  T8_ASSERT (buffer != NULL);
+  T8_ASSERT (scheme != NULL);
+  T8_ASSERT (0 <= length && length <= T8_ECLASS_MAX_CHILDREN);
+
+  if (size <= T8_ELEMENT_BUFFER_MAX_SIZE) {
+    buffer->heap = NULL;
+    memory = buffer->stack.bytes;
+  }
+  else {
+    buffer->heap = T8_ALLOC (char, length * size);
+    memory = buffer->heap;
+  }
+  scheme->t8_element_new_in_buffer (length, memory, buffer->elems);
+  return buffer->elems;
+}
+
+void
+t8_element_buffer_reset (t8_element_buffer_t *buffer)
+{
+  T8_ASSERT (buffer != NULL);
+  if (buffer->heap != NULL) {
+    T8_FREE (buffer->heap);
+    buffer->heap = NULL;
+  }
+}
+
 /* Default implementation for array_index */
 t8_element_t       *
 t8_eclass_scheme::t8_element_array_index (sc_array_t *array, size_t it)
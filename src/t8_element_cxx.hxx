@@ -719,12 +719,149 @@ public:
    */
   virtual void        t8_element_destroy (int length,
                                           t8_element_t **elem) = 0;
+
+  /** Initialize an array of elements in caller provided memory.
+   * In contrast to \ref t8_element_new no memory is taken from the scheme.
+   * Thus, this function may be called concurrently for the same scheme.
+   * The elements must not be passed to \ref t8_element_destroy, they become
+   * invalid when \a buffer is freed or goes out of scope.
+   * \param [in] length      The number of elements.
+   * \param [in,out] buffer  Memory of at least \a length * \ref t8_element_size bytes,
+   *                         for example an array on the stack.
+   *                         On output the initialized elements.
+   * \param [out] elem       Array of \a length element pointers. On output the
+   *                         i-th pointer points to the i-th element in \a buffer.
+   * \note The default implementation calls \ref t8_element_init.
+   * \note The temporary elements of search, face iteration, half face neighbors
+   * and ghost creation use this function, mostly via \ref t8_element_buffer_init.
+   * Other forest functions still take their elements from the scheme's memory
+   * pool and thus must not be called concurrently for the same scheme. These
+   * are in particular t8_forest_leaf_face_neighbors, whose neighbors are returned
+   * to the caller, the owner searches t8_forest_element_find_owner and
+   * t8_forest_element_owners_at_face, and t8_forest_element_has_leaf_desc,
+   * which is used by balance.
+   */
+  virtual void        t8_element_new_in_buffer (int length, void *buffer,
+                                                t8_element_t **elem);
 };
 
 /** Destroy an implementation of a particular element class. 
   * param [in] scheme           Defines the implementation of the element class. */
 void                t8_scheme_cxx_destroy (t8_scheme_cxx_t *s);
 
+/** An iterator over the consecutive elements of one refinement level in
+ * space-filling curve order.
+ * The iterator stores the current element together with all its ancestors
+ * and their child ids. Advancing to the next element only recomputes those
+ * ancestors that change, which are amortized constantly many.
+ * It thus replaces repeated calls to \ref t8_element_successor.
+ */
+typedef struct t8_element_sfc_iterator
+{
+  t8_eclass_scheme_c *scheme;   /**< The scheme of the elements. */
+  int                 level;    /**< The level of the iterated elements. */
+  t8_element_t      **ancestors;        /**< The ancestors at levels 0 to \a level,
+                                             ancestors[level] is the current element. */
+  int                *child_ids;        /**< The child id of each ancestor. */
+  int                *num_children;     /**< The number of children of each ancestor. */
+  void               *buffer;   /**< Memory for the ancestors. */
+} t8_element_sfc_iterator_t;
+
+/** Initialize an iterator at the element with a given linear id.
+ * \param [in,out] iter  The iterator to initialize.
+ * \param [in] scheme    The scheme of the elements.
+ * \param [in] level     The refinement level of the iterated elements.
+ * \param [in] first_id  The linear id of the first element at \a level.
+ * \note The iterator must be cleaned up with \ref t8_element_sfc_iterator_reset.
+ */
+void                t8_element_sfc_iterator_init (t8_element_sfc_iterator_t
+                                                  *iter,
+                                                  t8_eclass_scheme_c *scheme,
+                                                  int level,
+                                                  t8_linearidx_t first_id);
+
+/** Return the current element of an iterator.
+ * \param [in] iter      An initialized iterator.
+ * \return               The current element. It is changed by
+ *                       \ref t8_element_sfc_iterator_next.
+ */
+const t8_element_t *t8_element_sfc_iterator_current (const
+                                                     t8_element_sfc_iterator_t
+                                                     *iter);
+
+/** Advance an iterator to the successor of its current element.
+ * \param [in,out] iter  An initialized iterator.
+ * \return               True if the iterator was advanced, false if the
+ *                       current element was the last element of the root.
+ *                       In that case the iterator is not changed.
+ */
+int                 t8_element_sfc_iterator_next (t8_element_sfc_iterator_t
+                                                  *iter);
+
+/** Copy consecutive elements into an array and advance the iterator.
+ * \param [in,out] iter  An initialized iterator. On output the current
+ *                       element is the last element that was copied.
+ * \param [in] count     The number of elements to copy. There must be at
+ *                       least this many elements starting at the current one.
+ * \param [in,out] elements Memory for \a count consecutive elements of
+ *                       the iterator's scheme, for example the data of a
+ *                       \ref t8_element_array_t.
+ */
+void                t8_element_sfc_iterator_fill (t8_element_sfc_iterator_t
+                                                  *iter, size_t count,
+                                                  t8_element_t *elements);
+
+/** Free the memory of an iterator.
+ * \param [in,out] iter  An initialized iterator.
+ */
+void                t8_element_sfc_iterator_reset (t8_element_sfc_iterator_t
+                                                   *iter);
+
+/** The maximum size in bytes of an element that fits into the stack memory
+ * of a \ref t8_element_buffer_t. It is large enough for the elements of all
+ * default schemes. */
+#define T8_ELEMENT_BUFFER_MAX_SIZE 64
+
+/** Memory for up to \ref T8_ECLASS_MAX_CHILDREN temporary elements, for
+ * example the children or half face neighbors of an element.
+ * If the elements fit into the stack memory of the buffer, initializing and
+ * resetting the buffer neither allocates memory nor uses the scheme's memory
+ * pool. Larger elements are allocated on the heap.
+ */
+typedef struct t8_element_buffer
+{
+  union
+  {
+    char                bytes[T8_ECLASS_MAX_CHILDREN *
+                              T8_ELEMENT_BUFFER_MAX_SIZE];      /**< The element memory. */
+    double              align_double;   /**< Aligns \a bytes for doubles. */
+    void               *align_pointer;  /**< Aligns \a bytes for pointers. */
+  } stack;                              /**< Memory for elements of at most
+                                             \ref T8_ELEMENT_BUFFER_MAX_SIZE bytes. */
+  void               *heap;     /**< Memory for larger elements, NULL if \a stack is used. */
+  t8_element_t       *elems[T8_ECLASS_MAX_CHILDREN];    /**< Pointers to the elements. */
+} t8_element_buffer_t;
+
+/** Initialize elements in an element buffer.
+ * \param [in,out] buffer  An uninitialized buffer.
+ * \param [in] scheme      The scheme of the elements.
+ * \param [in] length      The number of elements, at most \ref T8_ECLASS_MAX_CHILDREN.
+ * \return                 The array of \a length initialized elements.
+ *                         They become invalid when \a buffer goes out of scope
+ *                         or is reset.
+ * \note The buffer must be cleaned up with \ref t8_element_buffer_reset.
+ * \note Since the scheme's memory pool is not used, this function may be
+ *       called concurrently for the same scheme.
+ */
+t8_element_t      **t8_element_buffer_init (t8_element_buffer_t *buffer,
+                                            t8_eclass_scheme_c *scheme,
+                                            int length);
+
+/** Free the heap memory of an element buffer, if any.
+ * \param [in,out] buffer  An initialized buffer.
+ */
+void                t8_element_buffer_reset (t8_element_buffer_t *buffer);
+
 #if 0
 /* TODO: These functions defined for the deprecated t8_scheme_t and t8_eclass_t
  * do not yet exist for t8_eclass_scheme_c class */
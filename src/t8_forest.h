@@ -247,6 +247,10 @@ void                t8_forest_set_copy (t8_forest_t forest,
  * \note This setting can be combined with \ref t8_forest_set_partition and \ref
  * t8_forest_set_balance. The order in which these operations are executed is always
  * 1) Adapt 2) Balance 3) Partition
+ * \note If adaptation is not recursive and \b set_from is not referenced by anyone
+ * else, the element arrays of \b set_from are reused for \b forest. They are changed
+ * after the adapt function was called for all elements, so the adapt function may
+ * still access all elements of \b set_from.
  * \note This setting may not be combined with \ref t8_forest_set_copy and overwrites
  * this setting.
  */
@@ -304,9 +308,12 @@ t8_generic_function_pointer t8_forest_get_user_function (t8_forest_t forest);
  *                          referencing \b set_from.
  *                          If NULL, a previously (or later) set forest will
  *                          be taken (\ref t8_forest_set_adapt, \ref t8_forest_set_balance).
- * \param [in]      set_for_coarsening CURRENTLY DISABLED. If true, then the partitions
+ * \param [in]      set_for_coarsening If true, then the partitions
  *                          are choose such that coarsening an element once is a process local
- *                          operation.
+ *                          operation. To this end each process boundary that would split a
+ *                          family of leaf elements is moved to the closer end of that family.
+ *                          Thus, the number of elements per process may differ by up to
+ *                          \ref T8_ECLASS_MAX_CHILDREN from the equal distribution.
  * \note This setting can be combined with \ref t8_forest_set_adapt and \ref
  * t8_forest_set_balance. The order in which these operations are executed is always
  * 1) Adapt 2) Balance 3) Partition
@@ -353,21 +360,64 @@ void                t8_forest_set_balance (t8_forest_t forest,
  * \param [in]      ghost_type Controls which neighbors count as ghost elements,
  *                             currently only T8_GHOST_FACES is supported. This value
  *                             is ignored if \a do_ghost = 0.
+ * \note If the forest is only adapted from a forest with ghost layer, the
+ * ghost layer is updated from the ghost layer of that forest instead of being
+ * created anew.
  */
 void                t8_forest_set_ghost (t8_forest_t forest, int do_ghost,
                                          t8_ghost_type_t ghost_type);
 
 /** Like \ref t8_forest_set_ghost but with the additional options to change the
- * ghost algorithm. This is used for debugging and timing the algorithm.
- * An application should almost always use \ref t8_forest_set_ghost.
+ * ghost algorithm and the width of the ghost layer.
+ * Changing the algorithm is used for debugging and timing.
+ * An application should almost always use \ref t8_forest_set_ghost, unless
+ * it needs more than one layer of ghost elements.
  * \param [in]      ghost_version If 1, the iterative ghost algorithm for balanced forests is used.
  *                                If 2, the iterativ algorithm for unbalanced forests.
  *                                If 3, the top-down search algorithm for unbalanced forests.
+ * \param [in]      ghost_width   The number of element layers in the ghost layer, at least 1.
+ *                                With width k, an element is a ghost if it can be reached
+ *                                from a local element by at most k steps across faces.
+ *                                The additional layers are computed by repeatedly extending
+ *                                the remote elements with their face neighbors.
+ * \note \ref t8_forest_ghost_exchange_data exchanges the data of all layers.
+ * \note Ghost layers of width greater than 1 are always created anew and never
+ * updated incrementally.
  * \see t8_forest_set_ghost
  */
 void                t8_forest_set_ghost_ext (t8_forest_t forest, int do_ghost,
                                              t8_ghost_type_t ghost_type,
-                                             int ghost_version);
+                                             int ghost_version,
+                                             int ghost_width);
+
+/** Set whether the forest stores the geometry of its elements in a cache.
+ * If enabled, the centroids, volumes, face areas and face normals of all local
+ * and ghost elements are computed once in \ref t8_forest_commit and can be
+ * accessed via \ref t8_forest_get_geometry_cache.
+ * The cache is not inherited by forests derived from \a forest.
+ * \param [in, out] forest      The forest.
+ * \param [in]      do_cache    If true, the geometry cache is built on commit.
+ * \note Set the ghost layer with \ref t8_forest_set_ghost to also cache the ghost
+ *       elements' geometry.
+ * \note This setting may be specified at any time before \ref t8_forest_commit.
+ */
+void                t8_forest_set_geometry_cache (t8_forest_t forest,
+                                                  int do_cache);
+
+/** Like \ref t8_forest_set_geometry_cache but with the additional option to
+ * compute the volumes and face areas with quadrature rules.
+ * \param [in]      quadrature_points If 0, the volumes and face areas are computed
+ *                                    with \ref t8_forest_element_volume and
+ *                                    \ref t8_forest_element_face_area.
+ *                                    If positive, they are computed with
+ *                                    \ref t8_forest_element_volume_quadrature and
+ *                                    \ref t8_forest_element_face_area_quadrature
+ *                                    using this many points per direction.
+ * \see t8_forest_set_geometry_cache
+ */
+void                t8_forest_set_geometry_cache_ext (t8_forest_t forest,
+                                                      int do_cache,
+                                                      int quadrature_points);
 
 /* TODO: use assertions and document that the forest_set (..., from) and
  *       set_load are mutually exclusive. */
@@ -382,6 +432,12 @@ void                t8_forest_comm_global_num_elements (t8_forest_t forest);
 
 /** After allocating and adding properties to a forest, commit the changes.
  * This call sets up the internal state of the forest.
+ * If several of adapt, partition and balance are set, they are carried out
+ * one after the other on intermediate forests. Each intermediate forest and
+ * the source forest (if not referenced elsewhere) are released as soon as
+ * the next stage is done with them. The ghost layer is only created for the
+ * final forest. With profiling, the runtime of each stage is reported
+ * separately, see \ref t8_forest_print_profile.
  * \param [in,out] forest       Must be created with \ref t8_forest_init and
  *                              specialized with t8_forest_set_* calls first.
  */
@@ -496,6 +552,8 @@ t8_ctree_t          t8_forest_get_coarse_tree (t8_forest_t forest,
  * and *pelement_indices = NULL on output.
  * \note Currently \a forest must be balanced.
  * \note \a forest must be committed before calling this function.
+ * \note The neighbor leafs are allocated from the scheme's memory pool.
+ *       Thus, this function must not be called concurrently for the same scheme.
  */
 void                t8_forest_leaf_face_neighbors (t8_forest_t forest,
                                                    t8_locidx_t ltreeid,
@@ -520,6 +578,9 @@ void                t8_forest_leaf_face_neighbors (t8_forest_t forest,
  *                         the corresponding owning process.
  * \note This function is collective and hence must be called by all processes in the forest's
  *       MPI Communicator.
+ * \note If neighborhood collectives are enabled with \ref t8_forest_set_neighbor_collectives,
+ *       the exchange is a collective over the ghost graph communicator. Every process
+ *       must call this function then, also processes without local elements or ghosts.
  */
 /* TODO: In \ref t8_forest_ghost_cxx we already implemented a begin and end function
  *       that allow for overlapping communication and computation. We will make them
@@ -540,6 +601,73 @@ void                t8_forest_ghost_exchange_data (t8_forest_t forest,
 void                t8_forest_set_profiling (t8_forest_t forest,
                                              int set_profiling);
 
+/** Enable or disable packing of elements in the messages of partition and
+ * ghost creation. If enabled, elements are not sent as raw structs but
+ * delta encoded via their level and linear id, \see t8_element_array_pack.
+ * This reduces the message sizes by a large factor at the cost of encoding
+ * and decoding the elements.
+ * \param [in,out] forest        The forest to be updated.
+ * \param [in]     compress      If true, elements are packed.
+ *
+ * Packing is disabled by default.
+ * The forest must not be committed before calling this function.
+ * With profiling enabled, the reduced message sizes are reported as
+ * partition_bytes_sent.
+ */
+void                t8_forest_set_compress_messages (t8_forest_t forest,
+                                                     int compress);
+
+/** Select the communication backend of partition and ghost.
+ * If enabled, a distributed graph communicator is built from the ranks that
+ * exchange messages and all messages are exchanged with one
+ * MPI_Neighbor_alltoallv, instead of probing for and receiving one
+ * point-to-point message per rank. The graph communicator of the ghost layer
+ * is reused by \ref t8_forest_ghost_exchange_data.
+ * \param [in,out] forest        The forest to be updated.
+ * \param [in]     use_neighbor  If true, neighborhood collectives are used.
+ *
+ * Neighborhood collectives are disabled by default. They require an MPI-3
+ * library, otherwise this setting is ignored.
+ * The forest must not be committed before calling this function.
+ */
+void                t8_forest_set_neighbor_collectives (t8_forest_t forest,
+                                                        int use_neighbor);
+
+/** Enable or disable asynchronous construction of the ghost layer.
+ * If enabled, \ref t8_forest_commit only starts sending the ghost elements
+ * and returns with the ghost layer pending. \ref t8_forest_ghost_wait
+ * must be called to receive the ghost elements before the ghost layer
+ * is used. In between, the local elements may be worked on while the ghost
+ * messages are in flight.
+ * \param [in,out] forest        The forest to be updated.
+ * \param [in]     async         If true, the ghost layer is constructed asynchronously.
+ *
+ * Asynchronous construction is disabled by default and has no effect if no
+ * ghost layer is created or neighborhood collectives are used,
+ * \see t8_forest_set_neighbor_collectives.
+ * If a geometry cache is set, it is created in \ref t8_forest_ghost_wait.
+ * A pending ghost layer is also completed when the forest is destroyed or
+ * another forest is committed from it, but the geometry cache is only created
+ * in \ref t8_forest_ghost_wait.
+ * Only one ghost layer per communicator may be pending at a time.
+ * The forest must not be committed before calling this function.
+ */
+void                t8_forest_set_ghost_async (t8_forest_t forest,
+                                               int async);
+
+/** Complete the construction of a pending ghost layer.
+ * Receives the ghost elements and waits until all ghost elements of this
+ * process were sent. Afterwards, a geometry cache that was postponed until
+ * the ghost layer is complete is created.
+ * Does nothing if the ghost layer of \a forest is not pending and no
+ * geometry cache is postponed.
+ * \param [in,out] forest        The committed forest.
+ * \see t8_forest_set_ghost_async
+ * \note With profiling enabled, the time spent in this function is reported
+ *       as ghost wait time, \see t8_forest_profile_get_ghostexchange_waittime.
+ */
+void                t8_forest_ghost_wait (t8_forest_t forest);
+
 /* TODO: document */
 void                t8_forest_compute_profile (t8_forest_t forest);
 
@@ -633,6 +761,10 @@ void                t8_forest_ghost_print (t8_forest_t forest);
 
 /** Change the cmesh associated to a forest to a partitioned cmesh that
  * is partitioned according to the tree distribution in the forest.
+ * If the cmesh of a forest is partitioned, this function is called in
+ * \ref t8_forest_commit whenever the forest was partitioned, either via
+ * \ref t8_forest_set_partition or via \ref t8_forest_set_balance with repartitioning.
+ * Thus, each process only stores the trees of its elements.
  * \param [in,out]   forest The forest.
  * \param [in]       comm   The MPI communicator that is used to partition
  *                          and commit the cmesh.
@@ -925,6 +1057,41 @@ void                t8_forest_element_coordinate (t8_forest_t forest,
                                                   int corner_number,
                                                   double *coordinates);
 
+/** Compute the coordinates of all vertices of an element if a geometry
+ * for this tree is registered in the forest's cmesh.
+ * All vertices are mapped with one call to \ref t8_geometry_evaluate_batch,
+ * which is faster than calling \ref t8_forest_element_coordinate for each vertex.
+ * \param [in]      forest     The forest.
+ * \param [in]      ltree_id   The forest local id of the tree in which the element is.
+ * \param [in]      element    The element.
+ * \param [out]     coordinates On input an allocated array to store 3 doubles for
+ *                             each corner of \a element. On output the x, y and z
+ *                             coordinates of the vertices in Z-order.
+ */
+void                t8_forest_element_coordinates (t8_forest_t forest,
+                                                   t8_locidx_t ltree_id,
+                                                   const t8_element_t
+                                                   *element,
+                                                   double *coordinates);
+
+/** Compute the coordinates of all vertices of all elements of a local tree.
+ * The vertices of each chunk of elements are mapped with one call to
+ * \ref t8_geometry_evaluate_batch.
+ * \param [in]      forest     The committed forest.
+ * \param [in]      ltree_id   The forest local id of a tree.
+ * \param [out]     coordinates On input an allocated array of
+ *                             3 * N * \a num_elements doubles, where N is the number
+ *                             of vertices of the tree's eclass and \a num_elements
+ *                             the number of elements in the tree. On output entry
+ *                             3 * (N * i + j) + k is the k-th coordinate of the j-th vertex
+ *                             of the i-th element. If an element has fewer vertices than
+ *                             the tree (tets in pyramid trees), the remaining
+ *                             entries repeat its first vertex.
+ */
+void                t8_forest_tree_element_coordinates (t8_forest_t forest,
+                                                        t8_locidx_t ltree_id,
+                                                        double *coordinates);
+
 /** Compute the coordinates of the centroid of an element if a geometry
  * for this tree is registered in the forest's cmesh.
  * The centroid is the sum of all corner vertices divided by the number of corners.
@@ -986,6 +1153,92 @@ double              t8_forest_element_face_area (t8_forest_t forest,
                                                  const t8_element_t *element,
                                                  int face);
 
+/** Compute the volume of an element with a quadrature rule.
+ * In contrast to \ref t8_forest_element_volume the element is not assumed
+ * to be d-linear. The volume is integrated over the image of the element
+ * under the tree's geometry and is exact for polynomial maps of sufficiently
+ * low degree.
+ * \param [in]      forest        The forest.
+ * \param [in]      ltree_id      The forest local id of the tree in which the element is.
+ * \param [in]      element       The element.
+ * \param [in]      num_points_1d The number of quadrature points per direction, at least 1.
+ * \return                        The volume of the element.
+ * \note                          The geometry of the tree must implement the jacobian.
+ *                                \a forest must be committed when calling this function.
+ */
+double              t8_forest_element_volume_quadrature (t8_forest_t forest,
+                                                         t8_locidx_t ltreeid,
+                                                         const t8_element_t
+                                                         *element,
+                                                         int num_points_1d);
+
+/** Compute the area of an element's face with a quadrature rule.
+ * \param [in]      forest        The forest.
+ * \param [in]      ltree_id      The forest local id of the tree in which the element is.
+ * \param [in]      element       The element.
+ * \param [in]      face          A face of \a element.
+ * \param [in]      num_points_1d The number of quadrature points per direction, at least 1.
+ * \return                        The area of \a face.
+ * \note                          The geometry of the tree must implement the jacobian.
+ *                                \a forest must be committed when calling this function.
+ */
+double              t8_forest_element_face_area_quadrature (t8_forest_t
+                                                            forest,
+                                                            t8_locidx_t
+                                                            ltreeid,
+                                                            const
+                                                            t8_element_t
+                                                            *element,
+                                                            int face,
+                                                            int
+                                                            num_points_1d);
+
+/** Compute the volumes of all elements of a local tree with a quadrature rule.
+ * This is equivalent to calling \ref t8_forest_element_volume_quadrature for
+ * each element, but the quadrature rules and the tree's geometry data are
+ * only set up once.
+ * \param [in]      forest        The forest.
+ * \param [in]      ltree_id      The forest local id of a tree.
+ * \param [in]      num_points_1d The number of quadrature points per direction, at least 1.
+ * \param [out]     volumes       Array with one entry per element of the tree.
+ *                                On output the element volumes.
+ * \a forest must be committed when calling this function.
+ */
+void                t8_forest_tree_element_volumes_quadrature (t8_forest_t
+                                                               forest,
+                                                               t8_locidx_t
+                                                               ltreeid,
+                                                               int
+                                                               num_points_1d,
+                                                               double
+                                                               *volumes);
+
+/** Compute the face areas of all elements of a local tree with a quadrature rule.
+ * This is equivalent to calling \ref t8_forest_element_face_area_quadrature for
+ * each face of each element, but the quadrature rules of the face shapes and the
+ * tree's geometry data are only set up once.
+ * \param [in]      forest        The forest.
+ * \param [in]      ltree_id      The forest local id of a tree.
+ * \param [in]      num_points_1d The number of quadrature points per direction, at least 1.
+ * \param [in]      max_num_faces The number of entries per element in \a areas, at least
+ *                                the number of faces of each element of the tree.
+ * \param [out]     areas         Array with \a max_num_faces entries per element of the tree.
+ *                                On output entry \a max_num_faces * i + f is the area of
+ *                                face f of the i-th element. Entries of non-existing faces are
+ *                                not changed.
+ * \a forest must be committed when calling this function.
+ */
+void                t8_forest_tree_element_face_areas_quadrature (t8_forest_t
+                                                                  forest,
+                                                                  t8_locidx_t
+                                                                  ltreeid,
+                                                                  int
+                                                                  num_points_1d,
+                                                                  int
+                                                                  max_num_faces,
+                                                                  double
+                                                                  *areas);
+
 /** Compute the vertex coordinates of the centroid of an element's face if a geometry
  * for this tree is registered in the forest's cmesh.
  * \param [in]      forest     The forest.
@@ -1017,8 +1270,10 @@ void                t8_forest_element_face_normal (t8_forest_t forest,
                                                    *element, int face,
                                                    double normal[3]);
 
-/** Query whether a given point lies inside an element or not. For bilinearly interpolated elements.
- * \note For 2D quadrilateral elements this function is only an approximation. It is correct
+/** Query whether a given point lies inside an element or not.
+ * For trees with linear geometry the test uses the planar faces of the element.
+ * For all other geometries \ref t8_forest_element_points_reference_coords is used.
+ * \note For 2D quadrilateral elements with linear geometry this function is only an approximation. It is correct
  *  if the four vertices lie in the same plane, but it may produce only approximate results if 
  *  the vertices do not lie in the same plane.
  * \param [in]      forest     The forest.
@@ -1041,6 +1296,72 @@ int                 t8_forest_element_point_inside (t8_forest_t forest,
                                                     const double point[3],
                                                     const double tolerance);
 
+/** Compute an axis-aligned bounding box of an element.
+ * For elements of trees with linear geometry the box is the bounding box of
+ * the element's vertices and contains the element.
+ * For other geometries the box of the vertices is enlarged by the distance
+ * that the element may bulge out of it: each coordinate of the image of the
+ * element's centroid plus and minus the radius of the element (in the tree's
+ * reference coordinates) times the norm of the coordinate's gradient.
+ * The gradient norm is the maximum over the jacobians at the vertices and the
+ * centroid, thus the box contains the element unless the gradient is larger
+ * elsewhere in the element. For these geometries the jacobian must be implemented.
+ * \param [in]      forest     The forest.
+ * \param [in]      ltree_id   The forest local id of the tree in which the element is.
+ * \param [in]      element    The element.
+ * \param [out]     bounds     On output the box [bounds[0], bounds[1]] x [bounds[2], bounds[3]]
+ *                             x [bounds[4], bounds[5]].
+ * \a forest must be committed when calling this function.
+ */
+void                t8_forest_element_bounding_box (t8_forest_t forest,
+                                                    t8_locidx_t ltreeid,
+                                                    const t8_element_t
+                                                    *element,
+                                                    double bounds[6]);
+
+/** Compute the reference coordinates of points with respect to an element
+ * and query whether the points lie inside of the element.
+ * In contrast to \ref t8_forest_element_point_inside this works for any geometry
+ * that implements the jacobian. The points are first tested against the
+ * element's bounding box (\ref t8_forest_element_bounding_box). For the remaining
+ * points the geometry is inverted with a Gauss-Newton iteration.
+ * \param [in]      forest     The forest.
+ * \param [in]      ltree_id   The forest local id of the tree in which the element is.
+ * \param [in]      element    The element.
+ * \param [in]      points     Array of 3 * \a num_points coordinates, the i-th point
+ *                             starts at entry 3*i.
+ * \param [in]      num_points The number of points.
+ * \param [in]      tolerance  The distance that a point may have to the element.
+ * \param [out]     ref_coords Array of 3 * \a num_points entries. On output the
+ *                             coordinates of the points in the reference element of the
+ *                             element's shape, unused coordinates are 0.
+ *                             Entries of points that are not inside are undefined.
+ * \param [out]     is_inside  Array of \a num_points entries. On output true (non-zero)
+ *                             if and only if the corresponding point lies inside \a element
+ *                             or within \a tolerance of its boundary.
+ * \note The reference element of a triangle is 0 <= y <= x <= 1, of a tet
+ *       0 <= y <= z <= x <= 1, of a prism the triangle times [0,1] and of a pyramid
+ *       0 <= z <= x, y <= 1. Lines, quads and hexes use the unit cube.
+ * \a forest must be committed when calling this function.
+ */
+void                t8_forest_element_points_reference_coords (t8_forest_t
+                                                               forest,
+                                                               t8_locidx_t
+                                                               ltreeid,
+                                                               const
+                                                               t8_element_t
+                                                               *element,
+                                                               const double
+                                                               *points,
+                                                               int
+                                                               num_points,
+                                                               const double
+                                                               tolerance,
+                                                               double
+                                                               *ref_coords,
+                                                               int
+                                                               *is_inside);
+
 /* TODO: if set level and partition/adapt/balance all give NULL, then
  * refine uniformly and partition/adapt/balance the unfiform forest. */
 /** Build a uniformly refined forest on a coarse mesh.
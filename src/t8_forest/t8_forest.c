@@ -32,6 +32,7 @@
 #include <t8_forest/t8_forest_vtk.h>
 #include <t8_cmesh/t8_cmesh_offset.h>
 #include <t8_cmesh/t8_cmesh_trees.h>
+#include <t8_data/t8_neighbor_comm.h>
 #include<t8_element_c_interface.h>
 
 void
@@ -46,6 +47,7 @@ t8_forest_init (t8_forest_t *pforest)
 
   /* sensible (hard error) defaults */
   forest->mpicomm = sc_MPI_COMM_NULL;
+  forest->ghost_comm = sc_MPI_COMM_NULL;
   forest->dimension = -1;
   forest->from_method = T8_FOREST_FROM_LAST;
 
@@ -56,6 +58,7 @@ t8_forest_init (t8_forest_t *pforest)
   forest->set_adapt_recursive = -1;
   forest->set_balance = -1;
   forest->maxlevel_existing = -1;
+  forest->ghost_width = 1;
   forest->stats_computed = 0;
 }
 
@@ -243,7 +246,8 @@ t8_forest_set_balance (t8_forest_t forest, const t8_forest_t set_from,
 
 void
 t8_forest_set_ghost_ext (t8_forest_t forest, int do_ghost,
-                         t8_ghost_type_t ghost_type, int ghost_version)
+                         t8_ghost_type_t ghost_type, int ghost_version,
+                         int ghost_width)
 {
   T8_ASSERT (t8_forest_is_initialized (forest));
   /* We currently only support face ghosts */
@@ -251,6 +255,8 @@ t8_forest_set_ghost_ext (t8_forest_t forest, int do_ghost,
                   "Ghost neighbors other than face-neighbors are not supported.\n");
   SC_CHECK_ABORT (1 <= ghost_version && ghost_version <= 3,
                   "Invalid choice for ghost version. Choose 1, 2, or 3.\n");
+  SC_CHECK_ABORT (ghost_width >= 1,
+                  "Invalid choice for ghost width. Must be at least 1.\n");
 
   if (ghost_type == T8_GHOST_NONE) {
     /* none type disables ghost */
@@ -262,15 +268,35 @@ t8_forest_set_ghost_ext (t8_forest_t forest, int do_ghost,
   if (forest->do_ghost) {
     forest->ghost_type = ghost_type;
     forest->ghost_algorithm = ghost_version;
+    forest->ghost_width = ghost_width;
   }
 }
 
+void
+t8_forest_set_geometry_cache_ext (t8_forest_t forest, int do_cache,
+                                  int quadrature_points)
+{
+  T8_ASSERT (t8_forest_is_initialized (forest));
+  SC_CHECK_ABORT (quadrature_points >= 0,
+                  "The number of quadrature points must not be negative.\n");
+
+  forest->set_geometry_cache = (do_cache != 0);
+  forest->set_geometry_cache_quadrature = quadrature_points;
+}
+
+void
+t8_forest_set_geometry_cache (t8_forest_t forest, int do_cache)
+{
+  /* Use the d-linear approximations of volumes and face areas. */
+  t8_forest_set_geometry_cache_ext (forest, do_cache, 0);
+}
+
 void
 t8_forest_set_ghost (t8_forest_t forest, int do_ghost,
                      t8_ghost_type_t ghost_type)
 {
   /* Use ghost version 3, top-down search and for unbalanced forests. */
-  t8_forest_set_ghost_ext (forest, do_ghost, ghost_type, 3);
+  t8_forest_set_ghost_ext (forest, do_ghost, ghost_type, 3, 1);
 }
 
 void
@@ -368,7 +394,7 @@ t8_forest_comm_global_num_elements (t8_forest_t forest)
  *                          pointer to one element.
  * \return                  Always return 1, to refine every element
  */
-static int
+int
 t8_forest_refine_everything (t8_forest_t forest, t8_forest_t forest_from,
                              t8_locidx_t which_tree, t8_locidx_t lelement_id,
                              t8_eclass_scheme_c *ts, const int is_family,
@@ -451,8 +477,8 @@ t8_forest_populate_irregular (t8_forest_t forest)
     t8_forest_commit (forest_tmp_partition);
     forest_zero = forest_tmp_partition;
   }
-  /* Copy all elements over to the original forest. */
-  t8_forest_copy_trees (forest, forest_zero, 1);
+  /* Move all elements over to the original forest. */
+  t8_forest_move_trees (forest, forest_zero);
   t8_forest_unref (&forest_tmp_partition);
 }
 
@@ -462,6 +488,7 @@ t8_forest_commit (t8_forest_t forest)
   int                 mpiret;
   int                 partitioned = 0;
   sc_MPI_Comm         comm_dup;
+  t8_forest_t         forest_ghost_from = NULL;     /* If not NULL, the forest from which we update the ghost layer */
 
   T8_ASSERT (forest != NULL);
   T8_ASSERT (forest->rc.refcount > 0);
@@ -507,6 +534,11 @@ t8_forest_commit (t8_forest_t forest)
   }
   else {                        /* set_from != NULL */
     t8_forest_t         forest_from = forest->set_from; /* temporarily store set_from, since we may overwrite it */
+    int                 own_forest_from = 1;    /* False, if we passed our reference of forest_from to an intermediate forest */
+
+    /* The ghost layer of forest_from must be complete before we start
+     * new communication. */
+    t8_forest_ghost_complete (forest_from);
 
     T8_ASSERT (forest->mpicomm == sc_MPI_COMM_NULL);
     T8_ASSERT (forest->cmesh == NULL);
@@ -515,7 +547,6 @@ t8_forest_commit (t8_forest_t forest)
     T8_ASSERT (forest->from_method >= T8_FOREST_FROM_FIRST &&
                forest->from_method < T8_FOREST_FROM_LAST);
 
-    /* TODO: optimize all this when forest->set_from has reference count one */
     /* TODO: Get rid of duping the communicator */
     /* we must prevent the case that set_from frees the source communicator */
     if (!forest->set_from->do_dup) {
@@ -560,10 +591,15 @@ t8_forest_commit (t8_forest_t forest)
         /* The forest should also be partitioned/balanced.
          * We first adapt the forest, then balance and then partition */
         t8_forest_t         forest_adapt;
+        void               *user_data_from =
+          t8_forest_get_user_data (forest_from);
 
         t8_forest_init (&forest_adapt);
-        /* forest_adapt should not change ownership of forest->set_from */
-        t8_forest_ref (forest->set_from);
+        /* We pass our reference of forest->set_from to forest_adapt, such that
+         * it is released as soon as forest_adapt is committed. If we held the
+         * only reference, the elements are even adapted in place. */
+        T8_ASSERT (forest->set_from == forest_from);
+        own_forest_from = 0;
         /* set user data of forest to forest_adapt */
         t8_forest_set_user_data (forest_adapt,
                                  t8_forest_get_user_data (forest));
@@ -573,12 +609,17 @@ t8_forest_commit (t8_forest_t forest)
                              forest->set_adapt_recursive);
         /* Set profiling if enabled */
         t8_forest_set_profiling (forest_adapt, forest->profile != NULL);
+        if (forest->from_method & T8_FOREST_FROM_PARTITION) {
+          /* forest_adapt is only partitioned. Partition computes the element
+           * offsets of forest_adapt itself and needs no other offsets, so we
+           * do not compute them in the commit of forest_adapt. */
+          forest_adapt->skip_offsets = 1;
+        }
         t8_forest_commit (forest_adapt);
         /* The new forest will be partitioned/balanced from forest_adapt */
         forest->set_from = forest_adapt;
         /* Set the user data of forest_from to forest_adapt */
-        t8_forest_set_user_data (forest_adapt,
-                                 t8_forest_get_user_data (forest_from));
+        t8_forest_set_user_data (forest_adapt, user_data_from);
         /* If profiling is enabled copy the runtime of adapt. */
         if (forest->profile != NULL) {
           forest->profile->adapt_runtime =
@@ -589,6 +630,11 @@ t8_forest_commit (t8_forest_t forest)
         /* This forest should only be adapted */
         t8_forest_copy_trees (forest, forest->set_from, 0);
         t8_forest_adapt (forest);
+        if (forest->do_ghost && forest->mpisize > 1) {
+          /* Since the partition did not change, we try to update the
+           * ghost layer of forest_from instead of creating a new one. */
+          forest_ghost_from = forest_from;
+        }
       }
     }
     if (forest->from_method & T8_FOREST_FROM_PARTITION) {
@@ -602,13 +648,18 @@ t8_forest_commit (t8_forest_t forest)
 
         t8_forest_init (&forest_partition);
         if (forest_from == forest->set_from) {
-          /* forest_partition should not change ownership of forest->set_from */
-          t8_forest_ref (forest->set_from);
+          /* We pass our reference of forest->set_from to forest_partition,
+           * such that it is released as soon as it is partitioned. */
+          own_forest_from = 0;
         }
         t8_forest_set_partition (forest_partition, forest->set_from,
                                  forest->set_for_coarsening);
         /* activate profiling, if this forest has profiling */
         t8_forest_set_profiling (forest_partition, forest->profile != NULL);
+        t8_forest_set_compress_messages (forest_partition,
+                                         forest->set_compress_messages);
+        t8_forest_set_neighbor_collectives (forest_partition,
+                                            forest->set_neighbor_collectives);
         /* Commit the partitioned forest */
         t8_forest_commit (forest_partition);
         forest->set_from = forest_partition;
@@ -641,7 +692,11 @@ t8_forest_commit (t8_forest_t forest)
        * nothing should be left todo */
       T8_ASSERT (forest->from_method == 0);
 
-      /* This forest should only be balanced */
+      /* This forest should only be balanced.
+       * Balance takes over our reference of forest->set_from. */
+      if (forest->set_from == forest_from) {
+        own_forest_from = 0;
+      }
       if (forest->set_balance == T8_FOREST_BALANCE_NO_REPART) {
         /* balance without repartition */
         t8_forest_balance (forest, 0);
@@ -649,17 +704,24 @@ t8_forest_commit (t8_forest_t forest)
       else {
         /* balance with repartition */
         t8_forest_balance (forest, 1);
+        /* The trees of the forest may now be distributed differently
+         * than the trees of its cmesh */
+        partitioned = 1;
       }
     }
 
-    if (forest_from != forest->set_from) {
+    if (forest->set_from != NULL && forest_from != forest->set_from) {
       /* decrease reference count of intermediate input forest, possibly destroying it */
       t8_forest_unref (&forest->set_from);
     }
-    /* reset forest->set_from */
-    forest->set_from = forest_from;
-    /* decrease reference count of input forest, possibly destroying it */
-    t8_forest_unref (&forest->set_from);
+    if (own_forest_from && forest_ghost_from == NULL) {
+      /* reset forest->set_from */
+      forest->set_from = forest_from;
+      /* decrease reference count of input forest, possibly destroying it */
+      t8_forest_unref (&forest->set_from);
+    }
+    /* If we update the ghost layer of forest_from, we keep our reference
+     * of forest_from until then. */
   }                             /* end set_from != NULL */
 
   /* Compute the element offset of the trees */
@@ -687,17 +749,21 @@ t8_forest_commit (t8_forest_t forest)
   T8_ASSERT (forest->tree_offsets == NULL);
   T8_ASSERT (forest->global_first_desc == NULL);
 #else
-  if (forest->tree_offsets == NULL) {
-    /* Compute the tree offset array */
-    t8_forest_partition_create_tree_offsets (forest);
-  }
-  if (forest->element_offsets == NULL) {
-    /* Compute element offsets */
-    t8_forest_partition_create_offsets (forest);
-  }
-  if (forest->global_first_desc == NULL) {
-    /* Compute global first desc array */
-    t8_forest_partition_create_first_desc (forest);
+  /* Intermediate forests of t8_forest_commit that are only partitioned
+   * afterwards do not need the offsets. */
+  if (!forest->skip_offsets) {
+    if (forest->tree_offsets == NULL) {
+      /* Compute the tree offset array */
+      t8_forest_partition_create_tree_offsets (forest);
+    }
+    if (forest->element_offsets == NULL) {
+      /* Compute element offsets */
+      t8_forest_partition_create_offsets (forest);
+    }
+    if (forest->global_first_desc == NULL) {
+      /* Compute global first desc array */
+      t8_forest_partition_create_first_desc (forest);
+    }
   }
 #endif
 
@@ -709,7 +775,8 @@ t8_forest_commit (t8_forest_t forest)
 
   /* From here on, the forest passes the t8_forest_is_committed check */
 
-  /* re-partition the cmesh */
+  /* re-partition the cmesh, such that each process only stores
+   * the trees of its elements */
   if (forest->cmesh->set_partition && partitioned) {
     t8_forest_partition_cmesh (forest, forest->mpicomm,
                                forest->profile != NULL);
@@ -717,7 +784,10 @@ t8_forest_commit (t8_forest_t forest)
 
   if (forest->mpisize > 1) {
     /* Construct a ghost layer, if desired */
-    if (forest->do_ghost) {
+    if (forest->do_ghost && (forest_ghost_from == NULL ||
+                             !t8_forest_ghost_create_incremental (forest,
+                                                                  forest_ghost_from)))
+    {
       /* TODO: ghost type */
       switch (forest->ghost_algorithm) {
       case 1:
@@ -735,6 +805,17 @@ t8_forest_commit (t8_forest_t forest)
     }
     forest->do_ghost = 0;
   }
+  if (forest_ghost_from != NULL) {
+    /* decrease reference count of the input forest, possibly destroying it */
+    t8_forest_unref (&forest_ghost_from);
+  }
+
+  /* Compute the geometry of all local and ghost elements, if desired.
+   * If the ghost layer is pending, this happens in t8_forest_ghost_wait. */
+  if (forest->set_geometry_cache && !t8_forest_ghost_is_pending (forest)) {
+    t8_forest_geometry_cache_create (forest);
+    forest->set_geometry_cache = 0;
+  }
 }
 
 t8_locidx_t
@@ -1264,6 +1345,35 @@ t8_forest_set_profiling (t8_forest_t forest, int set_profiling)
   }
 }
 
+void
+t8_forest_set_compress_messages (t8_forest_t forest, int compress)
+{
+  T8_ASSERT (t8_forest_is_initialized (forest));
+
+  forest->set_compress_messages = compress;
+}
+
+void
+t8_forest_set_ghost_async (t8_forest_t forest, int async)
+{
+  T8_ASSERT (t8_forest_is_initialized (forest));
+
+  forest->set_ghost_async = async != 0;
+}
+
+void
+t8_forest_set_neighbor_collectives (t8_forest_t forest, int use_neighbor)
+{
+  T8_ASSERT (t8_forest_is_initialized (forest));
+
+  if (use_neighbor && !t8_neighbor_comm_is_available ()) {
+    t8_global_errorf ("WARNING: Neighborhood collectives require an MPI-3"
+                      " library. Using point-to-point messages instead.\n");
+    use_neighbor = 0;
+  }
+  forest->set_neighbor_collectives = use_neighbor != 0;
+}
+
 void
 t8_forest_compute_profile (t8_forest_t forest)
 {
@@ -1644,6 +1754,10 @@ t8_forest_reset (t8_forest_t *pforest)
     T8_ASSERT (forest->set_from == NULL);
   }
 
+  /* Free the ghost graph communicator before its parent communicator */
+  if (forest->ghost_comm != sc_MPI_COMM_NULL) {
+    t8_neighbor_comm_destroy (&forest->ghost_comm);
+  }
   /* undup communicator if necessary */
   if (forest->committed) {
     if (forest->do_dup) {
@@ -1657,6 +1771,10 @@ t8_forest_reset (t8_forest_t *pforest)
   if (forest->ghosts != NULL) {
     t8_forest_ghost_unref (&forest->ghosts);
   }
+  /* Destroy the geometry cache if it exists */
+  if (forest->geometry_cache != NULL) {
+    t8_forest_geometry_cache_destroy (&forest->geometry_cache);
+  }
   /* we have taken ownership on calling t8_forest_set_* */
   if (forest->scheme_cxx != NULL) {
     t8_scheme_cxx_unref (&forest->scheme_cxx);
@@ -1700,6 +1818,11 @@ t8_forest_unref (t8_forest_t *pforest)
   forest = *pforest;
   T8_ASSERT (forest->rc.refcount > 0);
   T8_ASSERT (forest != NULL);
+  if (t8_refcount_is_last (&forest->rc)) {
+    /* Complete the communication of a pending ghost layer before
+     * the forest is destroyed */
+    t8_forest_ghost_complete (forest);
+  }
   if (t8_refcount_unref (&forest->rc)) {
     t8_forest_reset (pforest);
   }
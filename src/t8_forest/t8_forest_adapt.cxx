@@ -22,6 +22,7 @@
 
 #include <t8_forest/t8_forest_adapt.h>
 #include <t8_forest/t8_forest_types.h>
+#include <t8_forest/t8_forest_private.h>
 #include <t8_forest.h>
 #include <t8_data/t8_containers.h>
 #include <t8_element_cxx.hxx>
@@ -179,7 +180,164 @@ t8_forest_adapt_refine_recursive (t8_forest_t forest, t8_locidx_t ltreeid,
   }
 }
 
-/* TODO: optimize this when we own forest_from */
+/* Refine all elements of a tree whose elements all have the same level
+ * smaller than maxlevel. The children of consecutive elements are
+ * consecutive elements of the next level, so we can generate them with an
+ * SFC iterator instead of calling the adapt callback for each element.
+ * Return the number of inserted elements or -1 if the tree is not uniform. */
+static              t8_locidx_t
+t8_forest_adapt_refine_uniform_tree (t8_forest_t forest,
+                                     t8_eclass_scheme_c *tscheme,
+                                     t8_element_array_t *telements_from,
+                                     t8_element_array_t *telements)
+{
+  const t8_locidx_t   num_el_from =
+    (t8_locidx_t) t8_element_array_get_count (telements_from);
+  const t8_element_t *first_element_from =
+    t8_element_array_index_locidx (telements_from, 0);
+  const int           level = tscheme->t8_element_level (first_element_from);
+  t8_element_sfc_iterator_t iter;
+  t8_locidx_t         ielement, num_inserted = 0;
+
+  if (level >= forest->maxlevel) {
+    return -1;
+  }
+  for (ielement = 0; ielement < num_el_from; ielement++) {
+    const t8_element_t *element =
+      t8_element_array_index_locidx (telements_from, ielement);
+    if (tscheme->t8_element_level (element) != level) {
+      return -1;
+    }
+    num_inserted += tscheme->t8_element_num_children (element);
+  }
+  /* The first child of the first element has the linear id of the first
+   * element at the next level. */
+  t8_element_sfc_iterator_init (&iter, tscheme, level + 1,
+                                tscheme->t8_element_get_linear_id
+                                (first_element_from, level + 1));
+  t8_element_array_resize (telements, num_inserted);
+  t8_element_sfc_iterator_fill (&iter, num_inserted,
+                                t8_element_array_index_locidx (telements, 0));
+  t8_element_sfc_iterator_reset (&iter);
+  return num_inserted;
+}
+
+/* Apply the adaptation of a tree in place. This is used if the source
+ * forest is exclusively owned by the new forest and will be destroyed
+ * after adaptation, so we can reuse its element array instead of copying
+ * all unchanged elements into a new one.
+ * The element array of \a tree_from is moved to \a tree.
+ * \param [in,out] tree     The new tree, its element array must be empty.
+ * \param [in,out] tree_from The tree of the source forest. On output its
+ *                          element array is empty.
+ * \param [in] ts           The scheme for this tree.
+ * \param [in,out] marks    For each element of \a tree_from the decision
+ *                          of the adapt callback: 1 to refine, 0 to keep
+ *                          and -1 for all elements of a family that is
+ *                          to be coarsened. Overwritten on output.
+ * \return                  The number of elements in \a tree.
+ */
+static              t8_locidx_t
+t8_forest_adapt_tree_in_place (t8_tree_t tree, t8_tree_t tree_from,
+                               t8_eclass_scheme_c *ts, int8_t *marks)
+{
+  t8_element_array_t *telements = &tree->elements;
+  const size_t        element_size = ts->t8_element_size ();
+  t8_locidx_t         num_el_from, num_kept, num_new;
+  t8_locidx_t         iread, iwrite, run;
+  t8_element_t       *parent, *buffer;
+  t8_element_t       *children[T8_ECLASS_MAX_CHILDREN];
+  int                 num_children, num_siblings, ichild;
+
+  /* Steal the element array of the old tree */
+  T8_ASSERT (t8_element_array_get_count (telements) == 0);
+  t8_element_array_reset (telements);
+  *telements = tree_from->elements;
+  t8_element_array_init (&tree_from->elements, ts);
+  num_el_from = (t8_locidx_t) t8_element_array_get_count (telements);
+
+  /* Replace each family that is to be coarsened by its parent and shift
+   * the elements in between to the front. Since this only shrinks the array,
+   * the write position is never behind the read position. */
+  num_new = 0;
+  iread = iwrite = 0;
+  while (iread < num_el_from) {
+    /* Find the run of elements that are kept or refined */
+    for (run = 0; iread + run < num_el_from && marks[iread + run] >= 0;
+         run++) {
+      if (marks[iread + run] > 0) {
+        num_new += ts->t8_element_num_children
+          (t8_element_array_index_locidx (telements, iread + run)) - 1;
+      }
+    }
+    if (run > 0 && iwrite != iread) {
+      memmove (t8_element_array_index_locidx (telements, iwrite),
+               t8_element_array_index_locidx (telements, iread),
+               run * element_size);
+      memmove (marks + iwrite, marks + iread, run);
+    }
+    iread += run;
+    iwrite += run;
+    if (iread < num_el_from) {
+      /* The element at iread is the first element of a family
+       * that is to be coarsened */
+      T8_ASSERT (marks[iread] < 0);
+      parent = t8_element_array_index_locidx (telements, iread);
+      num_siblings = ts->t8_element_num_siblings (parent);
+      T8_ASSERT (ts->t8_element_child_id (parent) == 0);
+      ts->t8_element_parent (parent,
+                             t8_element_array_index_locidx (telements,
+                                                            iwrite));
+      marks[iwrite] = 0;
+      iread += num_siblings;
+      iwrite++;
+    }
+  }
+  num_kept = iwrite;
+  num_new += num_kept;
+
+  /* Replace each element that is to be refined by its children and shift
+   * the elements in between to the back. Since this only enlarges the array,
+   * we go backwards and the write position is never before the read position. */
+  t8_element_array_resize (telements, num_new);
+  if (num_new > num_kept) {
+    ts->t8_element_new (1, &buffer);
+    iread = num_kept;
+    iwrite = num_new;
+    while (iwrite > iread) {
+      /* Find the run of elements that are kept */
+      for (run = 0; run < iread && marks[iread - run - 1] == 0; run++) {
+      }
+      iread -= run;
+      iwrite -= run;
+      if (run > 0) {
+        memmove (t8_element_array_index_locidx (telements, iwrite),
+                 t8_element_array_index_locidx (telements, iread),
+                 run * element_size);
+      }
+      if (iread > 0) {
+        /* The element before iread is to be refined. Its children may
+         * overwrite it, so we copy it first. */
+        iread--;
+        T8_ASSERT (marks[iread] > 0);
+        ts->t8_element_copy (t8_element_array_index_locidx (telements, iread),
+                             buffer);
+        num_children = ts->t8_element_num_children (buffer);
+        iwrite -= num_children;
+        T8_ASSERT (iwrite >= iread);
+        for (ichild = 0; ichild < num_children; ichild++) {
+          children[ichild] =
+            t8_element_array_index_locidx (telements, iwrite + ichild);
+        }
+        ts->t8_element_children (buffer, num_children, children);
+      }
+    }
+    T8_ASSERT (iwrite == iread);
+    ts->t8_element_destroy (1, &buffer);
+  }
+  return num_new;
+}
+
 void
 t8_forest_adapt (t8_forest_t forest)
 {
@@ -200,6 +358,8 @@ t8_forest_adapt (t8_forest_t forest)
   int                 refine;
   int                 ci;
   int                 is_family;
+  int                 in_place;
+  int8_t             *marks = NULL, *tree_in_place = NULL;
 
   T8_ASSERT (forest != NULL);
   T8_ASSERT (forest->set_from != NULL);
@@ -227,6 +387,18 @@ t8_forest_adapt (t8_forest_t forest)
   if (forest->set_adapt_recursive) {
     refine_list = sc_list_new (NULL);
   }
+  /* If forest_from is only referenced by forest, it will be destroyed after
+   * adaptation. In this case we do not build new element arrays, but only
+   * record the decisions of the adapt callback and then change the element
+   * arrays of forest_from in place, once all callbacks were called.
+   * With recursive adaptation the callback is called for newly created
+   * elements, so we always build new element arrays there. */
+  in_place = !forest->set_adapt_recursive
+    && t8_refcount_is_last (&forest_from->rc);
+  if (in_place) {
+    marks = T8_ALLOC (int8_t, forest_from->local_num_elements);
+    tree_in_place = T8_ALLOC_ZERO (int8_t, forest_from->trees->elem_count);
+  }
   forest->local_num_elements = 0;
   el_offset = 0;
   num_trees = t8_forest_get_num_local_trees (forest);
@@ -260,6 +432,21 @@ t8_forest_adapt (t8_forest_t forest)
     elements = T8_ALLOC (t8_element_t *, num_children);
     /* Buffer for a family of old elements */
     elements_from = T8_ALLOC (t8_element_t *, curr_size_elements_from);
+    if (forest->set_adapt_fn == t8_forest_refine_everything
+        && !forest->set_adapt_recursive && num_el_from > 0) {
+      /* Every element is refined. If the tree is uniform, we generate
+       * the children in bulk and skip the loop below. */
+      const t8_locidx_t   num_refined =
+        t8_forest_adapt_refine_uniform_tree (forest, tscheme, telements_from,
+                                             telements);
+      if (num_refined >= 0) {
+        el_inserted = num_refined;
+        el_considered = num_el_from;
+      }
+    }
+    if (in_place && el_considered < num_el_from) {
+      tree_in_place[ltree_id] = 1;
+    }
     /* We now iterate over all elements in this tree and check them for refinement/coarsening. */
     while (el_considered < num_el_from) {
       int                 num_elements_to_adapt_callback;
@@ -328,6 +515,20 @@ t8_forest_adapt (t8_forest_t forest)
         /* Only refine an element if it does not exceed the maximum level */
         refine = 0;
       }
+      if (in_place) {
+        /* Only record the decision, the elements are changed after
+         * all callbacks were called. */
+        if (refine < 0) {
+          memset (marks + tree_from->elements_offset + el_considered, -1,
+                  num_siblings);
+          el_considered += num_siblings;
+        }
+        else {
+          marks[tree_from->elements_offset + el_considered] = refine > 0;
+          el_considered++;
+        }
+        continue;
+      }
       if (refine > 0) {
         /* The first element is to be refined */
         num_children = tscheme->t8_element_num_children (elements_from[0]);
@@ -440,6 +641,31 @@ t8_forest_adapt (t8_forest_t forest)
     /* clean up */
     sc_list_destroy (refine_list);
   }
+  if (in_place) {
+    /* All callbacks were called, we can now change the elements of
+     * forest_from and recompute the element offsets. */
+    forest->local_num_elements = 0;
+    el_offset = 0;
+    for (ltree_id = 0; ltree_id < num_trees; ltree_id++) {
+      tree = t8_forest_get_tree (forest, ltree_id);
+      if (tree_in_place[ltree_id]) {
+        tree_from = t8_forest_get_tree (forest_from, ltree_id);
+        tscheme = t8_forest_get_eclass_scheme (forest_from, tree->eclass);
+        el_inserted =
+          t8_forest_adapt_tree_in_place (tree, tree_from, tscheme,
+                                         marks + tree_from->elements_offset);
+      }
+      else {
+        el_inserted =
+          (t8_locidx_t) t8_element_array_get_count (&tree->elements);
+      }
+      tree->elements_offset = el_offset;
+      el_offset += el_inserted;
+      forest->local_num_elements += el_inserted;
+    }
+    T8_FREE (marks);
+    T8_FREE (tree_in_place);
+  }
 
   /* We now adapted all local trees */
   /* Compute the new global number of elements */
@@ -50,6 +50,7 @@ t8_forest_balance_adapt (t8_forest_t forest, t8_forest_t forest_from,
   t8_eclass_t         neigh_class;
   t8_eclass_scheme_c *neigh_scheme;
   t8_element_t       *element = elements[0], **half_neighbors;
+  t8_element_buffer_t half_neighbors_buffer;
 
   /* We only need to check an element, if its level is smaller then the maximum
    * level in the forest minus 2.
@@ -70,10 +71,12 @@ t8_forest_balance_adapt (t8_forest_t forest, t8_forest_t forest_from,
                                                        ltree_id, element,
                                                        iface);
       neigh_scheme = t8_forest_get_eclass_scheme (forest_from, neigh_class);
-      /* Allocate memory for the number of half face neighbors */
+      /* The half neighbors live in a local buffer and not in the scheme's
+       * memory pool. */
       num_half_neighbors = ts->t8_element_num_face_children (element, iface);
-      half_neighbors = T8_ALLOC (t8_element_t *, num_half_neighbors);
-      neigh_scheme->t8_element_new (num_half_neighbors, half_neighbors);
+      half_neighbors =
+        t8_element_buffer_init (&half_neighbors_buffer, neigh_scheme,
+                                num_half_neighbors);
       /* Compute the half face neighbors of element at this face */
       neighbor_tree = t8_forest_element_half_face_neighbors (forest_from,
                                                              ltree_id,
@@ -94,16 +97,13 @@ t8_forest_balance_adapt (t8_forest_t forest, t8_forest_t forest_from,
             /* This element should be refined */
             *pdone = 0;
             /* clean-up */
-            neigh_scheme->t8_element_destroy (num_half_neighbors,
-                                              half_neighbors);
-            T8_FREE (half_neighbors);
+            t8_element_buffer_reset (&half_neighbors_buffer);
             return 1;
           }
         }
       }
       /* clean-up */
-      neigh_scheme->t8_element_destroy (num_half_neighbors, half_neighbors);
-      T8_FREE (half_neighbors);
+      t8_element_buffer_reset (&half_neighbors_buffer);
     }
   }
 
@@ -184,13 +184,14 @@ t8_forest_balance (t8_forest_t forest, int repartition)
                          forest->set_from->maxlevel_existing);
   /* Use set_from as the first forest to adapt */
   forest_from = forest->set_from;
-  /* This function is reference neutral regarding forest_from */
-  t8_forest_ref (forest_from);
 
   if (forest->set_from->ghosts == NULL) {
     forest->set_from->ghost_type = T8_GHOST_FACES;
     t8_forest_ghost_create_topdown (forest->set_from);
   }
+  /* We pass our reference of set_from on to the first round, such that
+   * it can be released as soon as it is not needed anymore. */
+  forest->set_from = NULL;
   while (!done_global) {
     done = 1;
 
@@ -204,6 +205,10 @@ t8_forest_balance (t8_forest_t forest, int repartition)
                          0);
     if (!repartition) {
       t8_forest_set_ghost (forest_temp, 1, T8_GHOST_FACES);
+      t8_forest_set_compress_messages (forest_temp,
+                                       forest->set_compress_messages);
+      t8_forest_set_neighbor_collectives (forest_temp,
+                                          forest->set_neighbor_collectives);
     }
     forest_temp->t8code_data = &done;
     /* If profiling is enabled, measure ghost/adapt rumtimes */
@@ -254,6 +259,10 @@ t8_forest_balance (t8_forest_t forest, int repartition)
       forest_partition->maxlevel_existing = forest_temp->maxlevel_existing;
       t8_forest_set_partition (forest_partition, forest_temp, 0);
       t8_forest_set_ghost (forest_partition, 1, T8_GHOST_FACES);
+      t8_forest_set_compress_messages (forest_partition,
+                                       forest->set_compress_messages);
+      t8_forest_set_neighbor_collectives (forest_partition,
+                                          forest->set_neighbor_collectives);
       /* If profiling is enabled, measure partition rumtimes */
       if (forest->profile != NULL) {
         t8_forest_set_profiling (forest_partition, 1);
@@ -281,8 +290,8 @@ t8_forest_balance (t8_forest_t forest, int repartition)
   }
 
   T8_ASSERT (t8_forest_is_balanced (forest_temp));
-  /* Forest_temp is now balanced, we copy its trees and elements to forest */
-  t8_forest_copy_trees (forest, forest_temp, 1);
+  /* Forest_temp is now balanced, we move its trees and elements to forest */
+  t8_forest_move_trees (forest, forest_temp);
   /* TODO: Also copy ghost elements if ghost creation is set */
 
   t8_log_indent_pop ();
@@ -37,6 +37,10 @@ T8_EXTERN_C_BEGIN ();
 
 /* TODO: document
  * only temporary and will be replaced in future */
+/* Balance forest->set_from and store the result in forest.
+ * We take over the reference of forest->set_from, such that it may already
+ * be destroyed after the first balance round. On output forest->set_from
+ * is NULL. */
 void                t8_forest_balance (t8_forest_t forest, int repartition);
 
 /* Check whether the local elements of a forest are balanced. */
@@ -34,9 +34,9 @@
 #include <t8_cmesh/t8_cmesh_trees.h>
 #include <t8_cmesh/t8_cmesh_offset.h>
 #include <t8_geometry/t8_geometry_base.hxx>
-#if T8_ENABLE_DEBUG
+#include <t8_geometry/t8_geometry_helpers.h>
+#include <t8_geometry/t8_geometry_quadrature.h>
 #include <t8_geometry/t8_geometry_implementations/t8_geometry_linear.h>
-#endif
 
 /* We want to export the whole implementation to be callable from "C" */
 T8_EXTERN_C_BEGIN ();
@@ -222,6 +222,92 @@ t8_forest_element_coordinate (t8_forest_t forest, t8_locidx_t ltree_id,
   t8_geometry_evaluate (cmesh, gtreeid, vertex_coords, coordinates);
 }
 
+/* Compute the coordinates of all corners of an element with one
+ * batched geometry evaluation. */
+void
+t8_forest_element_coordinates (t8_forest_t forest, t8_locidx_t ltree_id,
+                               const t8_element_t *element,
+                               double *coordinates)
+{
+  double              vertex_coords[3 * T8_ECLASS_MAX_CORNERS];
+  t8_eclass_scheme_c *ts;
+  t8_eclass_t         tree_class;
+  int                 num_corners, icorner;
+
+  T8_ASSERT (forest != NULL);
+  T8_ASSERT (forest->scheme_cxx != NULL);
+  tree_class = t8_forest_get_tree_class (forest, ltree_id);
+  ts = t8_forest_get_eclass_scheme (forest, tree_class);
+  num_corners = ts->t8_element_num_corners (element);
+  for (icorner = 0; icorner < num_corners; icorner++) {
+    ts->t8_element_vertex_reference_coords (element, icorner,
+                                            vertex_coords + 3 * icorner);
+  }
+  t8_geometry_evaluate_batch (t8_forest_get_cmesh (forest),
+                              t8_forest_global_tree_id (forest, ltree_id),
+                              vertex_coords, num_corners, coordinates);
+}
+
+/* The number of elements whose corners are mapped in one batch in
+ * t8_forest_tree_element_coordinates. */
+#define T8_FOREST_COORDINATES_CHUNK 64
+
+void
+t8_forest_tree_element_coordinates (t8_forest_t forest, t8_locidx_t ltree_id,
+                                    double *coordinates)
+{
+  double              vertex_coords[3 * T8_ECLASS_MAX_CORNERS
+                                    * T8_FOREST_COORDINATES_CHUNK];
+  const t8_element_t *element;
+  t8_eclass_scheme_c *ts;
+  t8_eclass_t         tree_class;
+  t8_gloidx_t         gtreeid;
+  t8_cmesh_t          cmesh;
+  t8_locidx_t         num_elements, ielement, chunk_begin, chunk_end;
+  int                 num_tree_corners, num_corners, icorner;
+  size_t              offset;
+
+  T8_ASSERT (t8_forest_is_committed (forest));
+  T8_ASSERT (0 <= ltree_id
+             && ltree_id < t8_forest_get_num_local_trees (forest));
+
+  tree_class = t8_forest_get_tree_class (forest, ltree_id);
+  ts = t8_forest_get_eclass_scheme (forest, tree_class);
+  num_tree_corners = t8_eclass_num_vertices[tree_class];
+  num_elements = t8_forest_get_tree_num_elements (forest, ltree_id);
+  gtreeid = t8_forest_global_tree_id (forest, ltree_id);
+  cmesh = t8_forest_get_cmesh (forest);
+
+  for (chunk_begin = 0; chunk_begin < num_elements;
+       chunk_begin += T8_FOREST_COORDINATES_CHUNK) {
+    chunk_end = SC_MIN (chunk_begin + T8_FOREST_COORDINATES_CHUNK,
+                        num_elements);
+    /* Collect the reference coordinates of all corners in this chunk. */
+    for (ielement = chunk_begin; ielement < chunk_end; ielement++) {
+      element = t8_forest_get_element_in_tree (forest, ltree_id, ielement);
+      num_corners = ts->t8_element_num_corners (element);
+      offset = 3 * num_tree_corners * (ielement - chunk_begin);
+      for (icorner = 0; icorner < num_corners; icorner++) {
+        ts->t8_element_vertex_reference_coords (element, icorner,
+                                                vertex_coords + offset +
+                                                3 * icorner);
+      }
+      /* Elements with fewer corners than the tree (tets in a pyramid tree)
+       * repeat their first corner in the remaining slots. */
+      for (; icorner < num_tree_corners; icorner++) {
+        memcpy (vertex_coords + offset + 3 * icorner, vertex_coords + offset,
+                3 * sizeof (double));
+      }
+    }
+    /* Map them with one call to the geometry. */
+    t8_geometry_evaluate_batch (cmesh, gtreeid, vertex_coords,
+                                (size_t) num_tree_corners * (chunk_end -
+                                                             chunk_begin),
+                                coordinates +
+                                3 * (size_t) num_tree_corners * chunk_begin);
+  }
+}
+
 /* Compute the diameter of an element. */
 double
 t8_forest_element_diam (t8_forest_t forest, t8_locidx_t ltreeid,
@@ -267,7 +353,7 @@ void
 t8_forest_element_centroid (t8_forest_t forest, t8_locidx_t ltreeid,
                             const t8_element_t *element, double *coordinates)
 {
-  double              corner_coords[3];
+  double              corner_coords[3 * T8_ECLASS_MAX_CORNERS];
   int                 num_corners, icorner;
   t8_eclass_t         tree_class;
   t8_eclass_scheme_c *ts;
@@ -283,12 +369,11 @@ t8_forest_element_centroid (t8_forest_t forest, t8_locidx_t ltreeid,
   memset (coordinates, 0, 3 * sizeof (double));
   /* get the number of corners of element */
   num_corners = ts->t8_element_num_corners (element);
+  /* Compute all corner coordinates at once */
+  t8_forest_element_coordinates (forest, ltreeid, element, corner_coords);
   for (icorner = 0; icorner < num_corners; icorner++) {
-    /* For each corner, add its coordinates to the centroids coordinates. */
-    t8_forest_element_coordinate (forest, ltreeid, element, icorner,
-                                  corner_coords);
     /* coordinates = coordinates + corner_coords */
-    t8_vec_axpy (corner_coords, coordinates, 1);
+    t8_vec_axpy (corner_coords + 3 * icorner, coordinates, 1);
   }
   /* Divide each coordinate by num_corners */
   t8_vec_ax (coordinates, 1. / num_corners);
@@ -657,6 +742,339 @@ t8_forest_element_face_area (t8_forest_t forest, t8_locidx_t ltreeid,
   return -1;                    /* default return prevents compiler warning */
 }
 
+/* Compute the d-dimensional measure of the parallelotope spanned by the
+ * first dim columns of a jacobian. */
+static double
+t8_forest_jacobian_measure (const double *jacobian, int dim)
+{
+  double              cross[3];
+
+  switch (dim) {
+  case 0:
+    return 0;
+  case 1:
+    return t8_vec_norm (jacobian);
+  case 2:
+    t8_vec_cross (jacobian, jacobian + 3, cross);
+    return t8_vec_norm (cross);
+  case 3:
+    t8_vec_cross (jacobian, jacobian + 3, cross);
+    return fabs (t8_vec_dot (cross, jacobian + 6));
+  default:
+    SC_ABORT_NOT_REACHED ();
+  }
+  return -1;                    /* default return prevents compiler warning */
+}
+
+/* Map a point of a linear cell of a tree to physical space.
+ * The cell has the shape \a shape and its corners are given in the reference
+ * coordinates of the tree. We chain the linear map from the reference element
+ * of \a shape into the tree with the tree's geometry.
+ * If \a out_coords is not NULL, the mapped point is stored in it.
+ * If \a jacobian is not NULL, the jacobian of the chained map is stored in it,
+ * column i starts at entry 3 * i. */
+static void
+t8_forest_cell_map (t8_geometry_context_t *context, t8_gloidx_t gtreeid,
+                    int tree_dim, t8_element_shape_t shape,
+                    const double *corners, const double *ref_coords,
+                    double *out_coords, double *jacobian)
+{
+  double              tree_coords[3];
+  double              jacobian_cell[9], jacobian_tree[9];
+  const int           cell_dim = t8_eclass_to_dimension[shape];
+  int                 i, j, k;
+
+  /* The point in the reference coordinates of the tree */
+  t8_geom_compute_linear_geometry (shape, corners, ref_coords, tree_coords);
+  if (out_coords != NULL) {
+    t8_geometry_context_evaluate (context, gtreeid, tree_coords, 1,
+                                  out_coords);
+  }
+  if (jacobian != NULL) {
+    t8_geom_compute_linear_jacobian (shape, corners, ref_coords,
+                                     jacobian_cell);
+    t8_geometry_context_jacobian (context, gtreeid, tree_coords,
+                                  jacobian_tree);
+    /* Chain rule, column i of the result is J_tree * (column i of J_cell) */
+    for (i = 0; i < cell_dim; i++) {
+      for (j = 0; j < 3; j++) {
+        jacobian[3 * i + j] = 0;
+        for (k = 0; k < tree_dim; k++) {
+          jacobian[3 * i + j] +=
+            jacobian_tree[3 * k + j] * jacobian_cell[3 * i + k];
+        }
+      }
+    }
+  }
+}
+
+/* Integrate the measure of the image of a linear cell of a tree under the
+ * tree's geometry, see \ref t8_forest_cell_map.
+ * The quadrature rule lives on the reference element of \a shape. */
+static double
+t8_forest_quadrature_measure (t8_geometry_context_t *context,
+                              t8_gloidx_t gtreeid, int tree_dim,
+                              t8_element_shape_t shape,
+                              const double *corners, int num_points,
+                              const double *points, const double *weights)
+{
+  double              jacobian[9];
+  double              measure = 0;
+  const int           cell_dim = t8_eclass_to_dimension[shape];
+  int                 ipoint;
+
+  for (ipoint = 0; ipoint < num_points; ipoint++) {
+    t8_forest_cell_map (context, gtreeid, tree_dim, shape, corners,
+                        points + 3 * ipoint, NULL, jacobian);
+    measure += weights[ipoint]
+      * t8_forest_jacobian_measure (jacobian, cell_dim);
+  }
+  return measure;
+}
+
+/* Compute an element's volume with a quadrature rule */
+double
+t8_forest_element_volume_quadrature (t8_forest_t forest, t8_locidx_t ltreeid,
+                                     const t8_element_t *element,
+                                     int num_points_1d)
+{
+  double              corners[3 * T8_ECLASS_MAX_CORNERS] = { 0 };
+  double             *points, *weights;
+  double              volume;
+  t8_geometry_context_t context;
+  t8_eclass_scheme_c *ts;
+  t8_eclass_t         tree_class;
+  t8_element_shape_t  shape;
+  int                 icorner, num_points;
+
+  T8_ASSERT (t8_forest_is_committed (forest));
+  T8_ASSERT (num_points_1d > 0);
+
+  tree_class = t8_forest_get_tree_class (forest, ltreeid);
+  ts = t8_forest_get_eclass_scheme (forest, tree_class);
+  shape = ts->t8_element_shape (element);
+  if (shape == T8_ECLASS_VERTEX) {
+    /* vertices do not have any volume */
+    return 0;
+  }
+  for (icorner = 0; icorner < t8_eclass_num_vertices[shape]; icorner++) {
+    ts->t8_element_vertex_reference_coords (element, icorner,
+                                            corners + 3 * icorner);
+  }
+
+  num_points = t8_geom_quadrature_num_points (shape, num_points_1d);
+  points = T8_ALLOC (double, 3 * num_points);
+  weights = T8_ALLOC (double, num_points);
+  t8_geom_quadrature_rule (shape, num_points_1d, points, weights);
+
+  t8_geometry_context_init (&context, t8_forest_get_cmesh (forest));
+  volume = t8_forest_quadrature_measure (&context,
+                                         t8_forest_global_tree_id (forest,
+                                                                   ltreeid),
+                                         t8_eclass_to_dimension[tree_class],
+                                         shape, corners, num_points, points,
+                                         weights);
+  T8_FREE (points);
+  T8_FREE (weights);
+  return volume;
+}
+
+/* Compute the area of an element's face with a quadrature rule */
+double
+t8_forest_element_face_area_quadrature (t8_forest_t forest,
+                                        t8_locidx_t ltreeid,
+                                        const t8_element_t *element,
+                                        int face, int num_points_1d)
+{
+  double              corners[3 * T8_ECLASS_MAX_CORNERS] = { 0 };
+  double             *points, *weights;
+  double              area;
+  t8_geometry_context_t context;
+  t8_eclass_scheme_c *ts;
+  t8_eclass_t         tree_class;
+  t8_element_shape_t  face_shape;
+  int                 icorner, element_corner, num_points;
+
+  T8_ASSERT (t8_forest_is_committed (forest));
+  T8_ASSERT (num_points_1d > 0);
+
+  tree_class = t8_forest_get_tree_class (forest, ltreeid);
+  ts = t8_forest_get_eclass_scheme (forest, tree_class);
+  face_shape = ts->t8_element_face_shape (element, face);
+  if (face_shape == T8_ECLASS_VERTEX) {
+    /* vertices do not have volume */
+    return 0;
+  }
+  /* The face corners are ordered such that they match the
+   * corners of the reference element of the face shape. */
+  for (icorner = 0; icorner < t8_eclass_num_vertices[face_shape]; icorner++) {
+    element_corner = ts->t8_element_get_face_corner (element, face, icorner);
+    ts->t8_element_vertex_reference_coords (element, element_corner,
+                                            corners + 3 * icorner);
+  }
+
+  num_points = t8_geom_quadrature_num_points (face_shape, num_points_1d);
+  points = T8_ALLOC (double, 3 * num_points);
+  weights = T8_ALLOC (double, num_points);
+  t8_geom_quadrature_rule (face_shape, num_points_1d, points, weights);
+
+  t8_geometry_context_init (&context, t8_forest_get_cmesh (forest));
+  area = t8_forest_quadrature_measure (&context,
+                                       t8_forest_global_tree_id (forest,
+                                                                 ltreeid),
+                                       t8_eclass_to_dimension[tree_class],
+                                       face_shape, corners, num_points,
+                                       points, weights);
+  T8_FREE (points);
+  T8_FREE (weights);
+  return area;
+}
+
+void
+t8_forest_tree_element_volumes_quadrature (t8_forest_t forest,
+                                           t8_locidx_t ltreeid,
+                                           int num_points_1d,
+                                           double *volumes)
+{
+  double              corners[3 * T8_ECLASS_MAX_CORNERS] = { 0 };
+  double             *points[T8_ECLASS_COUNT] = { NULL };
+  double             *weights[T8_ECLASS_COUNT] = { NULL };
+  int                 num_points[T8_ECLASS_COUNT] = { 0 };
+  const t8_element_t *element;
+  t8_geometry_context_t context;
+  t8_eclass_scheme_c *ts;
+  t8_eclass_t         tree_class;
+  t8_element_shape_t  shape;
+  t8_gloidx_t         gtreeid;
+  t8_locidx_t         ielement, num_elements;
+  int                 icorner, ishape, tree_dim;
+
+  T8_ASSERT (t8_forest_is_committed (forest));
+  T8_ASSERT (0 <= ltreeid && ltreeid < t8_forest_get_num_local_trees (forest));
+  T8_ASSERT (num_points_1d > 0);
+
+  tree_class = t8_forest_get_tree_class (forest, ltreeid);
+  ts = t8_forest_get_eclass_scheme (forest, tree_class);
+  tree_dim = t8_eclass_to_dimension[tree_class];
+  gtreeid = t8_forest_global_tree_id (forest, ltreeid);
+  num_elements = t8_forest_get_tree_num_elements (forest, ltreeid);
+  /* All elements of the tree share one context, thus the tree's geometry
+   * data is only loaded once. */
+  t8_geometry_context_init (&context, t8_forest_get_cmesh (forest));
+
+  for (ielement = 0; ielement < num_elements; ielement++) {
+    element = t8_forest_get_element_in_tree (forest, ltreeid, ielement);
+    shape = ts->t8_element_shape (element);
+    if (shape == T8_ECLASS_VERTEX) {
+      volumes[ielement] = 0;
+      continue;
+    }
+    if (points[shape] == NULL) {
+      /* Compute the rule for this shape on first use */
+      num_points[shape] = t8_geom_quadrature_num_points (shape,
+                                                         num_points_1d);
+      points[shape] = T8_ALLOC (double, 3 * num_points[shape]);
+      weights[shape] = T8_ALLOC (double, num_points[shape]);
+      t8_geom_quadrature_rule (shape, num_points_1d, points[shape],
+                               weights[shape]);
+    }
+    for (icorner = 0; icorner < t8_eclass_num_vertices[shape]; icorner++) {
+      ts->t8_element_vertex_reference_coords (element, icorner,
+                                              corners + 3 * icorner);
+    }
+    volumes[ielement] =
+      t8_forest_quadrature_measure (&context, gtreeid, tree_dim, shape,
+                                    corners, num_points[shape],
+                                    points[shape], weights[shape]);
+  }
+
+  for (ishape = 0; ishape < T8_ECLASS_COUNT; ishape++) {
+    T8_FREE (points[ishape]);
+    T8_FREE (weights[ishape]);
+  }
+}
+
+void
+t8_forest_tree_element_face_areas_quadrature (t8_forest_t forest,
+                                              t8_locidx_t ltreeid,
+                                              int num_points_1d,
+                                              int max_num_faces,
+                                              double *areas)
+{
+  double              corners[3 * T8_ECLASS_MAX_CORNERS] = { 0 };
+  double             *points[T8_ECLASS_COUNT] = { NULL };
+  double             *weights[T8_ECLASS_COUNT] = { NULL };
+  int                 num_points[T8_ECLASS_COUNT] = { 0 };
+  const t8_element_t *element;
+  t8_geometry_context_t context;
+  t8_eclass_scheme_c *ts;
+  t8_eclass_t         tree_class;
+  t8_element_shape_t  face_shape;
+  t8_gloidx_t         gtreeid;
+  t8_locidx_t         ielement, num_elements;
+  int                 icorner, element_corner, ishape, tree_dim;
+  int                 iface, num_faces;
+
+  T8_ASSERT (t8_forest_is_committed (forest));
+  T8_ASSERT (0 <= ltreeid && ltreeid < t8_forest_get_num_local_trees (forest));
+  T8_ASSERT (num_points_1d > 0);
+
+  tree_class = t8_forest_get_tree_class (forest, ltreeid);
+  ts = t8_forest_get_eclass_scheme (forest, tree_class);
+  tree_dim = t8_eclass_to_dimension[tree_class];
+  gtreeid = t8_forest_global_tree_id (forest, ltreeid);
+  num_elements = t8_forest_get_tree_num_elements (forest, ltreeid);
+  /* All faces of the tree share one context, thus the tree's geometry
+   * data is only loaded once. */
+  t8_geometry_context_init (&context, t8_forest_get_cmesh (forest));
+
+  for (ielement = 0; ielement < num_elements; ielement++) {
+    element = t8_forest_get_element_in_tree (forest, ltreeid, ielement);
+    num_faces = ts->t8_element_num_faces (element);
+    T8_ASSERT (num_faces <= max_num_faces);
+    for (iface = 0; iface < num_faces; iface++) {
+      double             *area =
+        areas + (size_t) ielement * max_num_faces + iface;
+
+      face_shape = ts->t8_element_face_shape (element, iface);
+      if (face_shape == T8_ECLASS_VERTEX) {
+        /* vertices do not have volume */
+        *area = 0;
+        continue;
+      }
+      if (points[face_shape] == NULL) {
+        /* Compute the rule for this face shape on first use */
+        num_points[face_shape] =
+          t8_geom_quadrature_num_points (face_shape, num_points_1d);
+        points[face_shape] = T8_ALLOC (double, 3 * num_points[face_shape]);
+        weights[face_shape] = T8_ALLOC (double, num_points[face_shape]);
+        t8_geom_quadrature_rule (face_shape, num_points_1d,
+                                 points[face_shape], weights[face_shape]);
+      }
+      /* The face corners are ordered such that they match the
+       * corners of the reference element of the face shape. */
+      for (icorner = 0; icorner < t8_eclass_num_vertices[face_shape];
+           icorner++) {
+        element_corner =
+          ts->t8_element_get_face_corner (element, iface, icorner);
+        ts->t8_element_vertex_reference_coords (element, element_corner,
+                                                corners + 3 * icorner);
+      }
+      *area =
+        t8_forest_quadrature_measure (&context, gtreeid, tree_dim,
+                                      face_shape, corners,
+                                      num_points[face_shape],
+                                      points[face_shape],
+                                      weights[face_shape]);
+    }
+  }
+
+  for (ishape = 0; ishape < T8_ECLASS_COUNT; ishape++) {
+    T8_FREE (points[ishape]);
+    T8_FREE (weights[ishape]);
+  }
+}
+
 void
 t8_forest_element_face_centroid (t8_forest_t forest, t8_locidx_t ltreeid,
                                  const t8_element_t *element, int face,
@@ -1032,10 +1450,373 @@ t8_triangle_point_inside (const double p_0[3], const double p_1[3],
   return 1;
 }
 
+int
+t8_forest_tree_is_linear (t8_forest_t forest, t8_locidx_t ltreeid)
+{
+  const t8_cmesh_t    cmesh = t8_forest_get_cmesh (forest);
+  const t8_locidx_t   cltreeid =
+    t8_forest_ltreeid_to_cmesh_ltreeid (forest, ltreeid);
+  const t8_gloidx_t   cgtreeid = t8_cmesh_get_global_id (cmesh, cltreeid);
+
+  return t8_geom_is_linear (t8_cmesh_get_tree_geometry (cmesh, cgtreeid));
+}
+
+void
+t8_forest_element_bounding_box (t8_forest_t forest, t8_locidx_t ltreeid,
+                                const t8_element_t *element,
+                                double bounds[6])
+{
+  t8_forest_element_bounding_box_ext (forest, ltreeid, element, bounds,
+                                      t8_forest_tree_is_linear (forest,
+                                                                ltreeid));
+}
+
+void
+t8_forest_element_bounding_box_ext (t8_forest_t forest, t8_locidx_t ltreeid,
+                                    const t8_element_t *element,
+                                    double bounds[6], int tree_is_linear)
+{
+  double              coords[3 * (T8_ECLASS_MAX_CORNERS + 1)];
+  double              ref_coords[3 * (T8_ECLASS_MAX_CORNERS + 1)] = { 0 };
+  double              jacobian[9], gradient_norm[3], radius, dist;
+  t8_geometry_context_t context;
+  t8_eclass_scheme_c *ts;
+  t8_eclass_t         tree_class;
+  t8_gloidx_t         gtreeid;
+  int                 num_corners, icorner, ipoint, idim, jdim, tree_dim;
+
+  T8_ASSERT (t8_forest_is_committed (forest));
+  T8_ASSERT (tree_is_linear == t8_forest_tree_is_linear (forest, ltreeid));
+
+  tree_class = t8_forest_get_tree_class (forest, ltreeid);
+  ts = t8_forest_get_eclass_scheme (forest, tree_class);
+  gtreeid = t8_forest_global_tree_id (forest, ltreeid);
+  num_corners = ts->t8_element_num_corners (element);
+  for (icorner = 0; icorner < num_corners; icorner++) {
+    ts->t8_element_vertex_reference_coords (element, icorner,
+                                            ref_coords + 3 * icorner);
+  }
+  t8_geometry_context_init (&context, t8_forest_get_cmesh (forest));
+  t8_geometry_context_evaluate (&context, gtreeid, ref_coords, num_corners,
+                                coords);
+
+  /* The box of the corners */
+  for (idim = 0; idim < 3; idim++) {
+    bounds[2 * idim] = bounds[2 * idim + 1] = coords[idim];
+  }
+  for (ipoint = 1; ipoint < num_corners; ipoint++) {
+    for (idim = 0; idim < 3; idim++) {
+      bounds[2 * idim] = SC_MIN (bounds[2 * idim], coords[3 * ipoint + idim]);
+      bounds[2 * idim + 1] =
+        SC_MAX (bounds[2 * idim + 1], coords[3 * ipoint + idim]);
+    }
+  }
+  if (tree_is_linear) {
+    /* A linear element is the convex hull of its corners */
+    return;
+  }
+
+  /* A curved element may bulge out of the box of its corners.
+   * In the reference space of the tree, the element lies inside the ball
+   * around the centroid c of its corners, whose radius r is the largest
+   * distance of c to a corner. By the mean value theorem each coordinate
+   * f_j of the image differs from f_j (c) by at most r times the maximum
+   * norm of its gradient, which we take over the jacobians at the corners
+   * and the centroid. */
+  tree_dim = t8_eclass_to_dimension[tree_class];
+  for (idim = 0; idim < 3; idim++) {
+    ref_coords[3 * num_corners + idim] = 0;
+    for (icorner = 0; icorner < num_corners; icorner++) {
+      ref_coords[3 * num_corners + idim] += ref_coords[3 * icorner + idim];
+    }
+    ref_coords[3 * num_corners + idim] /= num_corners;
+    gradient_norm[idim] = 0;
+  }
+  radius = 0;
+  for (icorner = 0; icorner < num_corners; icorner++) {
+    dist = t8_vec_dist (ref_coords + 3 * icorner,
+                        ref_coords + 3 * num_corners);
+    radius = SC_MAX (radius, dist);
+  }
+  for (ipoint = 0; ipoint <= num_corners; ipoint++) {
+    t8_geometry_context_jacobian (&context, gtreeid,
+                                  ref_coords + 3 * ipoint, jacobian);
+    for (idim = 0; idim < 3; idim++) {
+      double              norm = 0;
+      /* Row idim of the jacobian is the gradient of f_idim,
+       * column jdim starts at entry 3 * jdim. */
+      for (jdim = 0; jdim < tree_dim; jdim++) {
+        norm += jacobian[3 * jdim + idim] * jacobian[3 * jdim + idim];
+      }
+      gradient_norm[idim] = SC_MAX (gradient_norm[idim], sqrt (norm));
+    }
+  }
+  t8_geometry_context_evaluate (&context, gtreeid,
+                                ref_coords + 3 * num_corners, 1, coords);
+  for (idim = 0; idim < 3; idim++) {
+    bounds[2 * idim] = SC_MIN (bounds[2 * idim],
+                               coords[idim] - radius * gradient_norm[idim]);
+    bounds[2 * idim + 1] = SC_MAX (bounds[2 * idim + 1],
+                                   coords[idim] +
+                                   radius * gradient_norm[idim]);
+  }
+}
+
+/* The centroids of the reference elements. They are the initial guess
+ * of the point inversion. */
+static const double t8_forest_reference_centroid[T8_ECLASS_COUNT][3] = {
+  {0, 0, 0},                    /* vertex */
+  {0.5, 0, 0},                  /* line */
+  {0.5, 0.5, 0},                /* quad */
+  {2. / 3, 1. / 3, 0},          /* triangle */
+  {0.5, 0.5, 0.5},              /* hex */
+  {0.75, 0.25, 0.5},            /* tet */
+  {2. / 3, 1. / 3, 0.5},        /* prism */
+  {0.625, 0.625, 0.25}          /* pyramid */
+};
+
+/* Check whether reference coordinates lie in the reference element
+ * of a shape up to a tolerance. */
+static int
+t8_forest_reference_coords_inside (t8_element_shape_t shape,
+                                   const double ref_coords[3],
+                                   const double tolerance)
+{
+  const double        x = ref_coords[0];
+  const double        y = ref_coords[1];
+  const double        z = ref_coords[2];
+  const double        tol = tolerance;
+
+  switch (shape) {
+  case T8_ECLASS_VERTEX:
+    return 1;
+  case T8_ECLASS_LINE:
+    return -tol <= x && x <= 1 + tol;
+  case T8_ECLASS_QUAD:
+    return -tol <= x && x <= 1 + tol && -tol <= y && y <= 1 + tol;
+  case T8_ECLASS_TRIANGLE:
+    /* 0 <= y <= x <= 1 */
+    return -tol <= y && y <= x + tol && x <= 1 + tol;
+  case T8_ECLASS_HEX:
+    return -tol <= x && x <= 1 + tol && -tol <= y && y <= 1 + tol
+      && -tol <= z && z <= 1 + tol;
+  case T8_ECLASS_TET:
+    /* 0 <= y <= z <= x <= 1 */
+    return -tol <= y && y <= z + tol && z <= x + tol && x <= 1 + tol;
+  case T8_ECLASS_PRISM:
+    return -tol <= y && y <= x + tol && x <= 1 + tol
+      && -tol <= z && z <= 1 + tol;
+  case T8_ECLASS_PYRAMID:
+    /* 0 <= z <= x, y <= 1 */
+    return -tol <= z && z <= x + tol && z <= y + tol
+      && x <= 1 + tol && y <= 1 + tol;
+  default:
+    SC_ABORT_NOT_REACHED ();
+  }
+  return 0;                     /* default return prevents compiler warning */
+}
+
+/* Solve the least squares problem J x = r with the normal equations
+ * J^T J x = J^T r. J has dim columns, column i starts at entry 3 * i.
+ * For dim = 3 this is the solution of J x = r.
+ * Returns false if J is (numerically) rank deficient. */
+static int
+t8_forest_solve_normal_equations (const double *jacobian, const double r[3],
+                                  int dim, double x[3])
+{
+  double              A[3][3], b[3], factor, trace = 0;
+  int                 i, j, k, pivot;
+
+  for (i = 0; i < dim; i++) {
+    b[i] = t8_vec_dot (jacobian + 3 * i, r);
+    for (j = 0; j < dim; j++) {
+      A[i][j] = t8_vec_dot (jacobian + 3 * i, jacobian + 3 * j);
+    }
+    trace += A[i][i];
+  }
+  /* Gaussian elimination with partial pivoting */
+  for (k = 0; k < dim; k++) {
+    pivot = k;
+    for (i = k + 1; i < dim; i++) {
+      if (fabs (A[i][k]) > fabs (A[pivot][k])) {
+        pivot = i;
+      }
+    }
+    if (fabs (A[pivot][k]) <= 1e-14 * trace) {
+      return 0;
+    }
+    if (pivot != k) {
+      for (j = 0; j < dim; j++) {
+        factor = A[k][j];
+        A[k][j] = A[pivot][j];
+        A[pivot][j] = factor;
+      }
+      factor = b[k];
+      b[k] = b[pivot];
+      b[pivot] = factor;
+    }
+    for (i = k + 1; i < dim; i++) {
+      factor = A[i][k] / A[k][k];
+      for (j = k; j < dim; j++) {
+        A[i][j] -= factor * A[k][j];
+      }
+      b[i] -= factor * b[k];
+    }
+  }
+  for (i = dim - 1; i >= 0; i--) {
+    x[i] = b[i];
+    for (j = i + 1; j < dim; j++) {
+      x[i] -= A[i][j] * x[j];
+    }
+    x[i] /= A[i][i];
+  }
+  return 1;
+}
+
+/* Compute the reference coordinates of a point in a linear cell of a tree,
+ * see \ref t8_forest_cell_map, with a Gauss-Newton iteration.
+ * Returns true if the iteration found reference coordinates inside the
+ * reference element whose image is within \a tolerance of \a point. */
+static int
+t8_forest_cell_invert_point (t8_geometry_context_t *context,
+                             t8_gloidx_t gtreeid, int tree_dim,
+                             t8_element_shape_t shape, const double *corners,
+                             const double point[3], const double tolerance,
+                             double ref_coords[3])
+{
+  const int           dim = t8_eclass_to_dimension[shape];
+  const int           max_iterations = 20;
+  double              mapped[3], residual[3], jacobian[9], step[3];
+  double              residual_norm, max_step, length = 0;
+  int                 iteration, idim, step_converged = 0;
+
+  memcpy (ref_coords, t8_forest_reference_centroid[shape],
+          3 * sizeof (double));
+  for (iteration = 0;; iteration++) {
+    t8_forest_cell_map (context, gtreeid, tree_dim, shape, corners,
+                        ref_coords, mapped, dim > 0 ? jacobian : NULL);
+    /* residual = point - mapped */
+    t8_vec_axpyz (mapped, point, residual, -1);
+    residual_norm = t8_vec_norm (residual);
+    if (residual_norm <= 1e-3 * tolerance || step_converged
+        || iteration == max_iterations
+        || !t8_forest_solve_normal_equations (jacobian, residual, dim,
+                                              step)) {
+      break;
+    }
+    max_step = 0;
+    for (idim = 0; idim < dim; idim++) {
+      /* Keep the iterate close to the reference element, the
+       * geometry may not be defined far away from it. */
+      ref_coords[idim] = SC_MAX (-0.5, SC_MIN (ref_coords[idim] + step[idim],
+                                               1.5));
+      max_step = SC_MAX (max_step, fabs (step[idim]));
+    }
+    if (shape == T8_ECLASS_PYRAMID) {
+      /* The linear pyramid geometry is singular for z = 1. */
+      ref_coords[2] = SC_MIN (ref_coords[2], 1 - 1e-10);
+    }
+    step_converged = max_step < 1e-13;
+  }
+  if (residual_norm > tolerance) {
+    return 0;
+  }
+  /* Scale the tolerance to the reference element with the
+   * length of the element's longest edge direction. */
+  for (idim = 0; idim < dim; idim++) {
+    length = SC_MAX (length, t8_vec_norm (jacobian + 3 * idim));
+  }
+  return t8_forest_reference_coords_inside (shape, ref_coords,
+                                            length >
+                                            0 ? tolerance / length : 0);
+}
+
+void
+t8_forest_element_points_reference_coords (t8_forest_t forest,
+                                           t8_locidx_t ltreeid,
+                                           const t8_element_t *element,
+                                           const double *points,
+                                           int num_points,
+                                           const double tolerance,
+                                           double *ref_coords,
+                                           int *is_inside)
+{
+  double              bounds[6];
+
+  t8_forest_element_bounding_box (forest, ltreeid, element, bounds);
+  t8_forest_element_points_reference_coords_ext (forest, ltreeid, element,
+                                                 points, num_points,
+                                                 tolerance, ref_coords,
+                                                 is_inside, bounds);
+}
+
+void
+t8_forest_element_points_reference_coords_ext (t8_forest_t forest,
+                                               t8_locidx_t ltreeid,
+                                               const t8_element_t *element,
+                                               const double *points,
+                                               int num_points,
+                                               const double tolerance,
+                                               double *ref_coords,
+                                               int *is_inside,
+                                               const double *bounds)
+{
+  double              corners[3 * T8_ECLASS_MAX_CORNERS] = { 0 };
+  t8_geometry_context_t context;
+  t8_eclass_scheme_c *ts;
+  t8_eclass_t         tree_class;
+  t8_element_shape_t  shape;
+  t8_gloidx_t         gtreeid;
+  const double       *point;
+  int                 ipoint, icorner, idim, in_box;
+
+  T8_ASSERT (t8_forest_is_committed (forest));
+  T8_ASSERT (tolerance >= 0);
+
+  tree_class = t8_forest_get_tree_class (forest, ltreeid);
+  ts = t8_forest_get_eclass_scheme (forest, tree_class);
+  shape = ts->t8_element_shape (element);
+  gtreeid = t8_forest_global_tree_id (forest, ltreeid);
+  for (icorner = 0; icorner < t8_eclass_num_vertices[shape]; icorner++) {
+    ts->t8_element_vertex_reference_coords (element, icorner,
+                                            corners + 3 * icorner);
+  }
+  t8_geometry_context_init (&context, t8_forest_get_cmesh (forest));
+
+  for (ipoint = 0; ipoint < num_points; ipoint++) {
+    point = points + 3 * ipoint;
+    /* Points outside of the element's bounding box are rejected
+     * without running the Newton iteration. */
+    in_box = 1;
+    for (idim = 0; idim < 3 && in_box && bounds != NULL; idim++) {
+      in_box = bounds[2 * idim] - tolerance <= point[idim]
+        && point[idim] <= bounds[2 * idim + 1] + tolerance;
+    }
+    is_inside[ipoint] = in_box
+      && t8_forest_cell_invert_point (&context, gtreeid,
+                                      t8_eclass_to_dimension[tree_class],
+                                      shape, corners, point, tolerance,
+                                      ref_coords + 3 * ipoint);
+  }
+}
+
 int
 t8_forest_element_point_inside (t8_forest_t forest, t8_locidx_t ltreeid,
                                 const t8_element_t *element,
                                 const double point[3], const double tolerance)
+{
+  return t8_forest_element_point_inside_ext (forest, ltreeid, element, point,
+                                             tolerance,
+                                             t8_forest_tree_is_linear (forest,
+                                                                       ltreeid));
+}
+
+int
+t8_forest_element_point_inside_ext (t8_forest_t forest, t8_locidx_t ltreeid,
+                                    const t8_element_t *element,
+                                    const double point[3],
+                                    const double tolerance,
+                                    int tree_is_linear)
 {
   const t8_eclass_t   tree_class = t8_forest_get_tree_class (forest, ltreeid);
   t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, tree_class);
@@ -1047,16 +1828,20 @@ t8_forest_element_point_inside (t8_forest_t forest, t8_locidx_t ltreeid,
   double              dot_product;
   double              point_on_face[3];
 
-#if T8_ENABLE_DEBUG
-  /* Check whether the provided geometry is linear */
-  const t8_cmesh_t    cmesh = t8_forest_get_cmesh (forest);
-  const t8_locidx_t   cltreeid =
-    t8_forest_ltreeid_to_cmesh_ltreeid (forest, ltreeid);
-  const t8_gloidx_t   cgtreeid = t8_cmesh_get_global_id (cmesh, cltreeid);
-  const t8_geometry_c *geometry =
-    t8_cmesh_get_tree_geometry (cmesh, cgtreeid);
-  T8_ASSERT (t8_geom_is_linear (geometry));
-#endif
+  T8_ASSERT (tree_is_linear == t8_forest_tree_is_linear (forest, ltreeid));
+  if (!tree_is_linear) {
+    /* The faces of curved elements are not planar, we invert the
+     * geometry instead. */
+    double              ref_coords[3], bounds[6];
+    int                 is_inside;
+
+    t8_forest_element_bounding_box_ext (forest, ltreeid, element, bounds, 0);
+    t8_forest_element_points_reference_coords_ext (forest, ltreeid, element,
+                                                   point, 1, tolerance,
+                                                   ref_coords, &is_inside,
+                                                   bounds);
+    return is_inside;
+  }
 
   switch (element_shape) {
   case T8_ECLASS_VERTEX:
@@ -1265,9 +2050,9 @@ t8_forest_populate (t8_forest_t forest)
   t8_locidx_t         num_tree_elements;
   t8_locidx_t         num_local_trees;
   t8_gloidx_t         jt, first_ctree;
-  t8_gloidx_t         start, end, et;
+  t8_gloidx_t         start, end;
   t8_tree_t           tree;
-  t8_element_t       *element, *element_succ;
+  t8_element_sfc_iterator_t iter;
   t8_element_array_t *telements;
   t8_eclass_t         tree_class;
   t8_eclass_scheme_c *eclass_scheme;
@@ -1335,17 +2120,14 @@ t8_forest_populate (t8_forest_t forest)
       /* Allocate elements for this processor. */
       t8_element_array_init_size (telements, eclass_scheme,
                                   num_tree_elements);
-      element = t8_element_array_index_locidx (telements, 0);
-      eclass_scheme->t8_element_set_linear_id (element, forest->set_level,
-                                               start);
-      count_elements++;
-      for (et = start + 1; et < end; et++, count_elements++) {
-        element_succ = t8_element_array_index_locidx (telements, et - start);
-        eclass_scheme->t8_element_successor (element, element_succ,
-                                             forest->set_level);
-        /* TODO: process elements here */
-        element = element_succ;
-      }
+      /* Fill the elements in SFC order, starting at the element with id start */
+      t8_element_sfc_iterator_init (&iter, eclass_scheme, forest->set_level,
+                                    start);
+      t8_element_sfc_iterator_fill (&iter, num_tree_elements,
+                                    t8_element_array_index_locidx (telements,
+                                                                   0));
+      t8_element_sfc_iterator_reset (&iter);
+      count_elements += num_tree_elements;
     }
   }
   forest->local_num_elements = count_elements;
@@ -1487,13 +2269,46 @@ t8_forest_copy_trees (t8_forest_t forest, t8_forest_t from, int copy_elements)
   }
 }
 
-/* Search for a linear element id (at forest->maxlevel) in a sorted array of
- * elements. If the element does not exist, return the largest index i
- * such that the element at position i has a smaller id than the given one.
- * If no such i exists, return -1.
- */
+/* Set the trees of forest as in from and move the elements of from to forest
+ * if from is only referenced once. Otherwise, copy the elements. */
+void
+t8_forest_move_trees (t8_forest_t forest, t8_forest_t from)
+{
+  t8_tree_t           tree, fromtree;
+  t8_locidx_t         jt, number_of_trees;
+
+  T8_ASSERT (forest != NULL);
+  T8_ASSERT (from != NULL);
+  T8_ASSERT (!forest->committed);
+  T8_ASSERT (from->committed);
+
+  if (!t8_refcount_is_last (&from->rc)) {
+    /* Someone else may still use the elements of from */
+    t8_forest_copy_trees (forest, from, 1);
+    return;
+  }
+  number_of_trees = from->trees->elem_count;
+  forest->trees =
+    sc_array_new_size (sizeof (t8_tree_struct_t), number_of_trees);
+  /* This copies the element arrays and descendants of from by reference */
+  sc_array_copy (forest->trees, from->trees);
+  for (jt = 0; jt < number_of_trees; jt++) {
+    tree = (t8_tree_t) t8_sc_array_index_locidx (forest->trees, jt);
+    fromtree = (t8_tree_t) t8_sc_array_index_locidx (from->trees, jt);
+    /* from gives up its elements and descendants */
+    t8_element_array_init (&fromtree->elements,
+                           forest->scheme_cxx->eclass_schemes[tree->eclass]);
+    fromtree->first_desc = NULL;
+    fromtree->last_desc = NULL;
+  }
+  forest->first_local_tree = from->first_local_tree;
+  forest->last_local_tree = from->last_local_tree;
+  forest->local_num_elements = from->local_num_elements;
+  forest->global_num_elements = from->global_num_elements;
+}
+
 /* TODO: should return t8_locidx_t */
-static t8_locidx_t
+t8_locidx_t
 t8_forest_bin_search_lower (t8_element_array_t *elements,
                             t8_linearidx_t element_id, int maxlevel)
 {
@@ -1730,6 +2545,7 @@ t8_forest_element_half_face_neighbors (t8_forest_t forest,
   t8_tree_t           tree;
   t8_eclass_t         eclass;
   t8_element_t      **children_at_face;
+  t8_element_buffer_t children_buffer;
   t8_gloidx_t         neighbor_tree = -1;
 #ifdef T8_ENABLE_DEBUG
   t8_gloidx_t         last_neighbor_tree = -1;
@@ -1749,9 +2565,10 @@ t8_forest_element_half_face_neighbors (t8_forest_t forest,
   /* The number of children of elem at face */
   T8_ASSERT (num_neighs == ts->t8_element_num_face_children (elem, face));
   num_children_at_face = num_neighs;
-  /* Allocate memory for the children of elem that share a face with face. */
-  children_at_face = T8_ALLOC (t8_element_t *, num_children_at_face);
-  ts->t8_element_new (num_children_at_face, children_at_face);
+  /* The children of elem that share a face with face live in a local
+   * buffer and not in the scheme's memory pool. */
+  children_at_face =
+    t8_element_buffer_init (&children_buffer, ts, num_children_at_face);
 
   /* Construct the children of elem at face
    *
@@ -1788,8 +2605,7 @@ t8_forest_element_half_face_neighbors (t8_forest_t forest,
 #endif
   }
   /* Clean-up the memory */
-  ts->t8_element_destroy (num_children_at_face, children_at_face);
-  T8_FREE (children_at_face);
+  t8_element_buffer_reset (&children_buffer);
   return neighbor_tree;
 }
 
@@ -2826,6 +3642,7 @@ t8_forest_element_owners_at_neigh_face (t8_forest_t forest,
   t8_eclass_scheme_c *neigh_scheme;
   t8_eclass_t         neigh_class;
   t8_element_t       *face_neighbor;
+  t8_element_buffer_t face_neighbor_buffer;
   int                 dual_face;
   t8_gloidx_t         neigh_tree;
 
@@ -2835,7 +3652,8 @@ t8_forest_element_owners_at_neigh_face (t8_forest_t forest,
     t8_forest_element_neighbor_eclass (forest, ltreeid, element, face);
   T8_ASSERT (T8_ECLASS_ZERO <= neigh_class && neigh_class < T8_ECLASS_COUNT);
   neigh_scheme = t8_forest_get_eclass_scheme (forest, neigh_class);
-  neigh_scheme->t8_element_new (1, &face_neighbor);
+  face_neighbor =
+    t8_element_buffer_init (&face_neighbor_buffer, neigh_scheme, 1)[0];
   neigh_tree =
     t8_forest_element_face_neighbor (forest, ltreeid, element, face_neighbor,
                                      neigh_scheme, face, &dual_face);
@@ -2849,7 +3667,7 @@ t8_forest_element_owners_at_neigh_face (t8_forest_t forest,
      * array to 0 */
     sc_array_resize (owners, 0);
   }
-  neigh_scheme->t8_element_destroy (1, &face_neighbor);
+  t8_element_buffer_reset (&face_neighbor_buffer);
 }
 
 void
@@ -2862,6 +3680,7 @@ t8_forest_element_owners_at_neigh_face_bounds (t8_forest_t forest,
   t8_eclass_scheme_c *neigh_scheme;
   t8_eclass_t         neigh_class;
   t8_element_t       *face_neighbor;
+  t8_element_buffer_t face_neighbor_buffer;
   int                 dual_face;
   t8_gloidx_t         neigh_tree;
 
@@ -2874,7 +3693,8 @@ t8_forest_element_owners_at_neigh_face_bounds (t8_forest_t forest,
   neigh_class =
     t8_forest_element_neighbor_eclass (forest, ltreeid, element, face);
   neigh_scheme = t8_forest_get_eclass_scheme (forest, neigh_class);
-  neigh_scheme->t8_element_new (1, &face_neighbor);
+  face_neighbor =
+    t8_element_buffer_init (&face_neighbor_buffer, neigh_scheme, 1)[0];
   neigh_tree =
     t8_forest_element_face_neighbor (forest, ltreeid, element, face_neighbor,
                                      neigh_scheme, face, &dual_face);
@@ -2889,7 +3709,7 @@ t8_forest_element_owners_at_neigh_face_bounds (t8_forest_t forest,
     *lower = 1;
     *upper = 0;
   }
-  neigh_scheme->t8_element_destroy (1, &face_neighbor);
+  t8_element_buffer_reset (&face_neighbor_buffer);
 }
 
 int
@@ -0,0 +1,214 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+#include <t8_forest/t8_forest_geometry_cache.h>
+#include <t8_forest/t8_forest_types.h>
+#include <t8_forest/t8_forest_private.h>
+#include <t8_element_cxx.hxx>
+
+/* The number of doubles that we store per element. */
+static size_t
+t8_forest_geometry_cache_record_size (const t8_forest_geometry_cache_t
+                                      *cache)
+{
+  /* centroid, volume, face areas and face normals */
+  return 3 + 1 + 4 * (size_t) cache->max_num_faces;
+}
+
+/* Copy the data of element \a ielement from the cache into a record
+ * of doubles or vice versa. */
+static void
+t8_forest_geometry_cache_pack (t8_forest_geometry_cache_t *cache,
+                               t8_locidx_t ielement, double *record,
+                               int unpack)
+{
+  const int           F = cache->max_num_faces;
+  double             *entries[4 + 4 * T8_ECLASS_MAX_FACES];
+  int                 ientry, iface, idim;
+
+  /* Collect the addresses of all entries of this element. */
+  ientry = 0;
+  for (idim = 0; idim < 3; idim++) {
+    entries[ientry++] = cache->centroid[idim] + ielement;
+  }
+  entries[ientry++] = cache->volume + ielement;
+  for (iface = 0; iface < F; iface++) {
+    entries[ientry++] = cache->face_area + (size_t) ielement * F + iface;
+    for (idim = 0; idim < 3; idim++) {
+      entries[ientry++] =
+        cache->face_normal[idim] + (size_t) ielement * F + iface;
+    }
+  }
+  T8_ASSERT ((size_t) ientry == t8_forest_geometry_cache_record_size (cache));
+  for (ientry--; ientry >= 0; ientry--) {
+    if (unpack) {
+      *entries[ientry] = record[ientry];
+    }
+    else {
+      record[ientry] = *entries[ientry];
+    }
+  }
+}
+
+/* Compute the geometry of all elements of a local tree and store it
+ * in the cache. */
+static void
+t8_forest_geometry_cache_fill_tree (t8_forest_t forest, t8_locidx_t itree,
+                                    t8_forest_geometry_cache_t *cache)
+{
+  const int           F = cache->max_num_faces;
+  const t8_eclass_t   tree_class = t8_forest_get_tree_class (forest, itree);
+  t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, tree_class);
+  const t8_locidx_t   offset = t8_forest_get_tree_element_offset (forest,
+                                                                  itree);
+  const t8_locidx_t   num_elements =
+    t8_forest_get_tree_num_elements (forest, itree);
+  t8_locidx_t         ielement, index;
+  double              centroid[3], normal[3];
+  int                 iface, num_faces, idim;
+
+  if (cache->quadrature_points > 0) {
+    /* The volumes and face areas of a whole tree share the quadrature rules. */
+    t8_forest_tree_element_volumes_quadrature (forest, itree,
+                                               cache->quadrature_points,
+                                               cache->volume + offset);
+    t8_forest_tree_element_face_areas_quadrature (forest, itree,
+                                                  cache->quadrature_points, F,
+                                                  cache->face_area +
+                                                  (size_t) offset * F);
+  }
+  for (ielement = 0; ielement < num_elements; ielement++) {
+    const t8_element_t *element =
+      t8_forest_get_element_in_tree (forest, itree, ielement);
+    index = offset + ielement;
+
+    t8_forest_element_centroid (forest, itree, element, centroid);
+    for (idim = 0; idim < 3; idim++) {
+      cache->centroid[idim][index] = centroid[idim];
+    }
+    if (cache->quadrature_points <= 0) {
+      cache->volume[index] =
+        t8_forest_element_volume (forest, itree, element);
+    }
+    num_faces = ts->t8_element_num_faces (element);
+    T8_ASSERT (num_faces <= F);
+    for (iface = 0; iface < num_faces; iface++) {
+      const size_t        face_index = (size_t) index * F + iface;
+      if (cache->quadrature_points <= 0) {
+        cache->face_area[face_index] =
+          t8_forest_element_face_area (forest, itree, element, iface);
+      }
+      t8_forest_element_face_normal (forest, itree, element, iface, normal);
+      for (idim = 0; idim < 3; idim++) {
+        cache->face_normal[idim][face_index] = normal[idim];
+      }
+    }
+  }
+}
+
+void
+t8_forest_geometry_cache_create (t8_forest_t forest)
+{
+  t8_forest_geometry_cache_t *cache;
+  t8_locidx_t         itree, ielement, num_elements;
+  size_t              num_face_entries;
+  int                 idim;
+
+  T8_ASSERT (t8_forest_is_committed (forest));
+  T8_ASSERT (forest->geometry_cache == NULL);
+
+  cache = T8_ALLOC (t8_forest_geometry_cache_t, 1);
+  cache->num_local_elements = t8_forest_get_local_num_elements (forest);
+  cache->num_ghosts = t8_forest_get_num_ghosts (forest);
+  cache->max_num_faces = t8_eclass_max_num_faces[forest->dimension];
+  cache->quadrature_points = forest->set_geometry_cache_quadrature;
+  num_elements = cache->num_local_elements + cache->num_ghosts;
+  num_face_entries = (size_t) num_elements * cache->max_num_faces;
+
+  /* Faces that an element does not have keep the value zero. */
+  for (idim = 0; idim < 3; idim++) {
+    cache->centroid[idim] = T8_ALLOC (double, num_elements);
+    cache->face_normal[idim] = T8_ALLOC_ZERO (double, num_face_entries);
+  }
+  cache->volume = T8_ALLOC (double, num_elements);
+  cache->face_area = T8_ALLOC_ZERO (double, num_face_entries);
+
+  /* Compute the local elements tree by tree. */
+  for (itree = 0; itree < t8_forest_get_num_local_trees (forest); itree++) {
+    t8_forest_geometry_cache_fill_tree (forest, itree, cache);
+  }
+
+  if (forest->ghosts != NULL || forest->ghost_comm != sc_MPI_COMM_NULL) {
+    /* The owners of the ghost elements have already computed their geometry.
+     * We pack each element's data into one record, such that we
+     * need only one ghost exchange, and unpack the ghosts' records.
+     * With neighborhood collectives the exchange is collective over
+     * forest->ghost_comm, thus we take part even without ghosts. */
+    const size_t        record_size =
+      t8_forest_geometry_cache_record_size (cache);
+    sc_array_t         *records =
+      sc_array_new_count (record_size * sizeof (double), num_elements);
+
+    for (ielement = 0; ielement < cache->num_local_elements; ielement++) {
+      t8_forest_geometry_cache_pack (cache, ielement,
+                                     (double *) sc_array_index_int (records,
+                                                                    ielement),
+                                     0);
+    }
+    t8_forest_ghost_exchange_data (forest, records);
+    for (ielement = cache->num_local_elements; ielement < num_elements;
+         ielement++) {
+      t8_forest_geometry_cache_pack (cache, ielement,
+                                     (double *) sc_array_index_int (records,
+                                                                    ielement),
+                                     1);
+    }
+    sc_array_destroy (records);
+  }
+  forest->geometry_cache = cache;
+}
+
+void
+t8_forest_geometry_cache_destroy (t8_forest_geometry_cache_t **pcache)
+{
+  t8_forest_geometry_cache_t *cache;
+  int                 idim;
+
+  T8_ASSERT (pcache != NULL && *pcache != NULL);
+  cache = *pcache;
+  for (idim = 0; idim < 3; idim++) {
+    T8_FREE (cache->centroid[idim]);
+    T8_FREE (cache->face_normal[idim]);
+  }
+  T8_FREE (cache->volume);
+  T8_FREE (cache->face_area);
+  T8_FREE (cache);
+  *pcache = NULL;
+}
+
+const t8_forest_geometry_cache_t *
+t8_forest_get_geometry_cache (t8_forest_t forest)
+{
+  T8_ASSERT (t8_forest_is_committed (forest));
+
+  return forest->geometry_cache;
+}
@@ -0,0 +1,88 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/** \file t8_forest_geometry_cache.h
+ * A forest may store the centroids, volumes, face areas and face normals
+ * of its local and ghost elements in a geometry cache.
+ * The cache is built in \ref t8_forest_commit if it was enabled with
+ * \ref t8_forest_set_geometry_cache. Since a forest does not change after
+ * commit, the cache stays valid for the lifetime of the forest.
+ * A forest derived from it does not inherit the cache.
+ */
+
+#ifndef T8_FOREST_GEOMETRY_CACHE_H
+#define T8_FOREST_GEOMETRY_CACHE_H
+
+#include <t8.h>
+#include <t8_forest.h>
+
+/** The geometry cache of a forest.
+ * All quantities are stored in structure-of-arrays layout.
+ * Elements are indexed by their local index, the local elements
+ * come first, followed by the ghost elements. That is the same
+ * indexing as in \ref t8_forest_ghost_exchange_data.
+ * Face quantities of element i and face f are stored at index
+ * i * \a max_num_faces + f. Entries of faces that an element does not
+ * have are zero.
+ */
+typedef struct t8_forest_geometry_cache
+{
+  t8_locidx_t         num_local_elements;       /**< The number of local elements. */
+  t8_locidx_t         num_ghosts;       /**< The number of ghost elements. */
+  int                 max_num_faces;    /**< The maximum number of faces of an element of the forest's dimension. */
+  int                 quadrature_points;        /**< If positive, volumes and face areas were computed with this many
+                                                     quadrature points per direction, otherwise with d-linear approximations. */
+  double             *centroid[3];      /**< centroid[d][i] is the d-th coordinate of the centroid of element i. */
+  double             *volume;   /**< volume[i] is the volume of element i. */
+  double             *face_area;        /**< face_area[i * max_num_faces + f] is the area of face f of element i. */
+  double             *face_normal[3];   /**< face_normal[d][i * max_num_faces + f] is the d-th coordinate
+                                             of the outward normal of face f of element i. */
+} t8_forest_geometry_cache_t;
+
+T8_EXTERN_C_BEGIN ();
+
+/** Build the geometry cache of a committed forest.
+ * The quantities of the local elements are computed tree by tree.
+ * If the forest has a ghost layer, the ghosts' quantities are communicated
+ * from their owners. This function is collective.
+ * It is called from \ref t8_forest_commit and should not be called directly.
+ * \param [in,out] forest     A committed forest without geometry cache.
+ */
+void                t8_forest_geometry_cache_create (t8_forest_t forest);
+
+/** Free the memory of a geometry cache.
+ * \param [in,out] pcache     Pointer to a geometry cache. Set to NULL on output.
+ */
+void                t8_forest_geometry_cache_destroy (t8_forest_geometry_cache_t
+                                                      **pcache);
+
+/** Return the geometry cache of a forest.
+ * \param [in]     forest     A committed forest.
+ * \return                    The forest's geometry cache or NULL if the forest
+ *                            was committed without \ref t8_forest_set_geometry_cache.
+ */
+const t8_forest_geometry_cache_t *t8_forest_get_geometry_cache (t8_forest_t
+                                                                 forest);
+
+T8_EXTERN_C_END ();
+
+#endif /* !T8_FOREST_GEOMETRY_CACHE_H */
@@ -29,6 +29,8 @@
 #include <t8_cmesh/t8_cmesh_trees.h>
 #include <t8_element_cxx.hxx>
 #include <t8_data/t8_containers.h>
+#include <t8_data/t8_neighbor_comm.h>
+#include <t8_forest/t8_forest_geometry_cache.h>
 #include <sc_statistics.h>
 
 /* We want to export the whole implementation to be callable from "C" */
@@ -45,6 +47,16 @@ typedef struct
   char               *buffer;   /* The send buffer. */
 } t8_ghost_mpi_send_info_t;
 
+/* The communication of a ghost layer that is still being received.
+ * See t8_forest_set_ghost_async. */
+typedef struct
+{
+  t8_ghost_mpi_send_info_t *send_info;  /* The send buffers */
+  sc_MPI_Request     *requests; /* The send requests */
+  t8_forest_ghost_t   ghost_from;       /* If not NULL, the messages are relative to
+                                           this ghost structure. We hold a reference. */
+} t8_forest_ghost_pending_t;
+
 /* The information stored for the ghost trees */
 typedef struct
 {
@@ -1038,6 +1050,38 @@ t8_forest_ghost_fill_remote_v3 (t8_forest_t forest)
 #endif
 }
 
+/* Add an element as a remote element to all owners of its face neighbor
+ * across a given face that are not the current rank.
+ * owners must be an empty array of integers, it is used as temporary storage. */
+static void
+t8_forest_ghost_add_remote_at_face (t8_forest_t forest,
+                                    t8_forest_ghost_t ghost,
+                                    t8_locidx_t ltreeid,
+                                    const t8_element_t *elem,
+                                    t8_locidx_t element_index, int face,
+                                    sc_array_t *owners)
+{
+  size_t              iowner;
+  int                 owner;
+
+  T8_ASSERT (owners->elem_count == 0);
+  /* Construct the owners at the face of the neighbor element */
+  t8_forest_element_owners_at_neigh_face (forest, ltreeid, elem, face,
+                                          owners);
+  /* Iterate over all owners and if any is not the current process,
+   * add this element as remote */
+  for (iowner = 0; iowner < owners->elem_count; iowner++) {
+    owner = *(int *) sc_array_index (owners, iowner);
+    T8_ASSERT (0 <= owner && owner < forest->mpisize);
+    if (owner != forest->mpirank) {
+      /* Add the element as a remote element */
+      t8_ghost_add_remote (forest, ghost, owner, ltreeid, elem,
+                           element_index);
+    }
+  }
+  sc_array_truncate (owners);
+}
+
 /* Fill the remote ghosts of a ghost structure.
  * We iterate through all elements and check if their neighbors
  * lie on remote processes. If so, we add the element to the
@@ -1052,12 +1096,13 @@ t8_forest_ghost_fill_remote (t8_forest_t forest, t8_forest_ghost_t ghost,
                              int ghost_method)
 {
   t8_element_t       *elem, **half_neighbors = NULL;
+  t8_element_buffer_t half_neighbors_buffer;
   t8_locidx_t         num_local_trees, num_tree_elems;
   t8_locidx_t         itree, ielem;
   t8_tree_t           tree;
   t8_eclass_t         tree_class, neigh_class, last_class;
   t8_gloidx_t         neighbor_tree;
-  t8_eclass_scheme_c *ts, *neigh_scheme = NULL, *prev_neigh_scheme = NULL;
+  t8_eclass_scheme_c *ts, *neigh_scheme = NULL;
 
   int                 iface, num_faces;
   int                 num_face_children, max_num_face_children = 0;
@@ -1115,16 +1160,15 @@ t8_forest_ghost_fill_remote (t8_forest_t forest, t8_forest_ghost_t ghost,
               last_class != neigh_class) {
             if (max_num_face_children > 0) {
               /* Clean-up memory */
-              prev_neigh_scheme->t8_element_destroy (max_num_face_children,
-                                                     half_neighbors);
-              T8_FREE (half_neighbors);
+              t8_element_buffer_reset (&half_neighbors_buffer);
             }
-            half_neighbors = T8_ALLOC (t8_element_t *, num_face_children);
-            /* Allocate memory for the half size face neighbors */
-            neigh_scheme->t8_element_new (num_face_children, half_neighbors);
+            /* The half size face neighbors live in a local buffer and not
+             * in the scheme's memory pool. */
+            half_neighbors =
+              t8_element_buffer_init (&half_neighbors_buffer, neigh_scheme,
+                                      num_face_children);
             max_num_face_children = num_face_children;
             last_class = neigh_class;
-            prev_neigh_scheme = neigh_scheme;
           }
           if (!is_atom) {
             /* Construct each half size neighbor */
@@ -1162,22 +1206,8 @@ t8_forest_ghost_fill_remote (t8_forest_t forest, t8_forest_ghost_t ghost,
           }
         }                       /* end ghost_method 0 */
         else {
-          size_t              iowner;
-          /* Construc the owners at the face of the neighbor element */
-          t8_forest_element_owners_at_neigh_face (forest, itree, elem, iface,
-                                                  &owners);
-          T8_ASSERT (owners.elem_count >= 0);
-          /* Iterate over all owners and if any is not the current process,
-           * add this element as remote */
-          for (iowner = 0; iowner < owners.elem_count; iowner++) {
-            owner = *(int *) sc_array_index (&owners, iowner);
-            T8_ASSERT (0 <= owner && owner < forest->mpisize);
-            if (owner != forest->mpirank) {
-              /* Add the element as a remote element */
-              t8_ghost_add_remote (forest, ghost, owner, itree, elem, ielem);
-            }
-          }
-          sc_array_truncate (&owners);
+          t8_forest_ghost_add_remote_at_face (forest, ghost, itree, elem,
+                                              ielem, iface, &owners);
         }
       }                         /* end face loop */
     }                           /* end element loop */
@@ -1190,9 +1220,7 @@ t8_forest_ghost_fill_remote (t8_forest_t forest, t8_forest_ghost_t ghost,
   /* Clean-up memory */
   if (ghost_method == 0) {
     if (half_neighbors != NULL) {
-      neigh_scheme->t8_element_destroy (max_num_face_children,
-                                        half_neighbors);
-      T8_FREE (half_neighbors);
+      t8_element_buffer_reset (&half_neighbors_buffer);
     }
   }
   else {
@@ -1201,12 +1229,204 @@ t8_forest_ghost_fill_remote (t8_forest_t forest, t8_forest_ghost_t ghost,
   }
 }
 
+/* Compare two elements of the same tree in linear order. Other than
+ * t8_element_compare, an ancestor and its first descendant are not equal,
+ * the ancestor comes first. */
+static int
+t8_forest_ghost_element_compare (t8_eclass_scheme_c *ts,
+                                 const t8_element_t *elem_a,
+                                 const t8_element_t *elem_b)
+{
+  const int           compare = ts->t8_element_compare (elem_a, elem_b);
+
+  if (compare != 0) {
+    return compare;
+  }
+  return ts->t8_element_level (elem_a) - ts->t8_element_level (elem_b);
+}
+
+/* Return true if an element is an ancestor of another element
+ * or the element itself. */
+static int
+t8_forest_ghost_element_is_ancestor (t8_eclass_scheme_c *ts,
+                                     const t8_element_t *ancestor,
+                                     const t8_element_t *elem)
+{
+  const int           level = ts->t8_element_level (ancestor);
+
+  return level <= ts->t8_element_level (elem)
+    && ts->t8_element_get_linear_id (ancestor, level) ==
+    ts->t8_element_get_linear_id (elem, level);
+}
+
+/* A remote element of the forest that we update the ghost layer from */
+typedef struct
+{
+  t8_locidx_t         ltreeid;  /* The local tree of the element */
+  t8_locidx_t         element_index;    /* The tree local index of the element */
+  int                 remote_rank;      /* A rank that this element is a remote of */
+  const t8_element_t *element;  /* The element's copy in the remote tree */
+} t8_forest_ghost_old_remote_t;
+
+/* Sort old remotes by tree, then by element index and then by rank */
+static int
+t8_forest_ghost_old_remote_compare (const void *remote_a,
+                                    const void *remote_b)
+{
+  const t8_forest_ghost_old_remote_t *A =
+    (const t8_forest_ghost_old_remote_t *) remote_a;
+  const t8_forest_ghost_old_remote_t *B =
+    (const t8_forest_ghost_old_remote_t *) remote_b;
+
+  if (A->ltreeid != B->ltreeid) {
+    return A->ltreeid < B->ltreeid ? -1 : 1;
+  }
+  if (A->element_index != B->element_index) {
+    return A->element_index < B->element_index ? -1 : 1;
+  }
+  return A->remote_rank - B->remote_rank;
+}
+
+/* Fill the remote ghosts of a ghost structure of a forest that was adapted
+ * from forest_from, reusing the remote ghosts of forest_from.
+ * Since adapt does not change the regions that the processes own, an element
+ * that did not change keeps its remote ranks. An element that does not
+ * overlap any remote element of forest_from cannot touch another process.
+ * Thus we only need to compute the face owners of elements that were refined
+ * or coarsened from remote elements. */
+static void
+t8_forest_ghost_fill_remote_incremental (t8_forest_t forest,
+                                         t8_forest_ghost_t ghost,
+                                         t8_forest_t forest_from)
+{
+  sc_array_t          old_remotes, owners;
+  t8_forest_ghost_old_remote_t *old_remote;
+  t8_ghost_remote_t  *remote_entry;
+  t8_ghost_remote_tree_t *remote_tree;
+  t8_tree_t           tree;
+  t8_eclass_scheme_c *ts;
+  t8_element_t       *elem;
+  t8_locidx_t         itree, ielem, num_tree_elems, element_index;
+  size_t              iremote, iremote_tree, iold, ielem_remote;
+  int                 iface, num_faces, overlap;
+
+  T8_ASSERT (forest->first_local_tree == forest_from->first_local_tree);
+
+  /* Collect all remote elements of forest_from, sorted by tree and index */
+  sc_array_init (&old_remotes, sizeof (t8_forest_ghost_old_remote_t));
+  if (forest_from->ghosts != NULL) {
+    for (iremote = 0;
+         iremote < forest_from->ghosts->remote_ghosts->a.elem_count;
+         iremote++) {
+      remote_entry = (t8_ghost_remote_t *)
+        sc_array_index (&forest_from->ghosts->remote_ghosts->a, iremote);
+      for (iremote_tree = 0;
+           iremote_tree < remote_entry->remote_trees.elem_count;
+           iremote_tree++) {
+        remote_tree = (t8_ghost_remote_tree_t *)
+          sc_array_index (&remote_entry->remote_trees, iremote_tree);
+        for (ielem_remote = 0;
+             ielem_remote <
+             t8_element_array_get_count (&remote_tree->elements);
+             ielem_remote++) {
+          old_remote =
+            (t8_forest_ghost_old_remote_t *) sc_array_push (&old_remotes);
+          old_remote->ltreeid =
+            remote_tree->global_id - forest_from->first_local_tree;
+          old_remote->element_index = *(t8_locidx_t *)
+            sc_array_index (&remote_tree->element_indices, ielem_remote);
+          old_remote->remote_rank = remote_entry->remote_rank;
+          old_remote->element =
+            t8_element_array_index_locidx (&remote_tree->elements,
+                                           ielem_remote);
+        }
+      }
+    }
+  }
+  sc_array_sort (&old_remotes, t8_forest_ghost_old_remote_compare);
+
+  sc_array_init (&owners, sizeof (int));
+  iold = 0;
+  for (itree = 0; itree < t8_forest_get_num_local_trees (forest); itree++) {
+    tree = t8_forest_get_tree (forest, itree);
+    ts = t8_forest_get_eclass_scheme (forest, tree->eclass);
+    num_tree_elems = t8_forest_get_tree_element_count (tree);
+    /* Skip the old remotes of previous trees */
+    while (iold < old_remotes.elem_count &&
+           ((t8_forest_ghost_old_remote_t *)
+            sc_array_index (&old_remotes, iold))->ltreeid < itree) {
+      iold++;
+    }
+    for (ielem = 0; ielem < num_tree_elems; ielem++) {
+      elem = t8_forest_get_tree_element (tree, ielem);
+      /* Skip all old remotes that lie before elem and do not overlap it */
+      overlap = 0;
+      while (iold < old_remotes.elem_count) {
+        old_remote = (t8_forest_ghost_old_remote_t *)
+          sc_array_index (&old_remotes, iold);
+        if (old_remote->ltreeid != itree) {
+          break;
+        }
+        if (t8_forest_ghost_element_is_ancestor (ts, old_remote->element,
+                                                 elem)
+            || t8_forest_ghost_element_is_ancestor (ts, elem,
+                                                    old_remote->element)) {
+          overlap = 1;
+          break;
+        }
+        if (t8_forest_ghost_element_compare (ts, old_remote->element,
+                                             elem) > 0) {
+          break;
+        }
+        iold++;
+      }
+      if (!overlap) {
+        /* elem does not overlap a remote element of forest_from and has
+         * only local face neighbors */
+        continue;
+      }
+      if (t8_forest_ghost_element_compare (ts, old_remote->element, elem)
+          == 0) {
+        /* elem did not change, it is a remote of the same ranks as before */
+        element_index = old_remote->element_index;
+        while (iold < old_remotes.elem_count &&
+               old_remote->ltreeid == itree &&
+               old_remote->element_index == element_index) {
+          t8_ghost_add_remote (forest, ghost, old_remote->remote_rank, itree,
+                               elem, ielem);
+          if (++iold < old_remotes.elem_count) {
+            old_remote = (t8_forest_ghost_old_remote_t *)
+              sc_array_index (&old_remotes, iold);
+          }
+        }
+      }
+      else {
+        /* elem was refined or coarsened, we compute its face owners */
+        num_faces = ts->t8_element_num_faces (elem);
+        for (iface = 0; iface < num_faces; iface++) {
+          t8_forest_ghost_add_remote_at_face (forest, ghost, itree, elem,
+                                              ielem, iface, &owners);
+        }
+      }
+    }
+  }
+
+  if (forest->profile != NULL) {
+    /* If profiling is enabled, we count the number of remote processes. */
+    forest->profile->ghosts_remotes = ghost->remote_processes->elem_count;
+  }
+  sc_array_reset (&owners);
+  sc_array_reset (&old_remotes);
+}
+
 /* Begin sending the ghost elements from the remote ranks
  * using non-blocking communication.
  * Afterward
  *  t8_forest_ghost_send_end
  * must be called to end the communication.
  * Returns an array of mpi_send_info_t, one for each remote rank.
+ * If requests is NULL, the send buffers are only filled and no messages are
+ * posted, see t8_forest_ghost_neighbor_exchange.
  */
 static t8_ghost_mpi_send_info_t *
 t8_forest_ghost_send_start (t8_forest_t forest, t8_forest_ghost_t ghost,
@@ -1230,7 +1450,9 @@ t8_forest_ghost_send_start (t8_forest_t forest, t8_forest_ghost_t ghost,
   /* Allocate a send_buffer for each remote rank */
   num_remotes = ghost->remote_processes->elem_count;
   send_info = T8_ALLOC (t8_ghost_mpi_send_info_t, num_remotes);
-  *requests = T8_ALLOC (sc_MPI_Request, num_remotes);
+  if (requests != NULL) {
+    *requests = T8_ALLOC (sc_MPI_Request, num_remotes);
+  }
 
   /* Loop over all remote processes */
   for (proc_index = 0; proc_index < (int) ghost->remote_processes->elem_count;
@@ -1243,7 +1465,8 @@ t8_forest_ghost_send_start (t8_forest_t forest, t8_forest_ghost_t ghost,
     /* initialize the send_info for the current rank */
     current_send_info->recv_rank = remote_rank;
     current_send_info->num_bytes = 0;
-    current_send_info->request = *requests + proc_index;
+    current_send_info->request =
+      requests != NULL ? *requests + proc_index : NULL;
     /* Lookup the ghost elements for the first tree of this remote */
     remote_entry = t8_forest_ghost_get_remote (forest, remote_rank);
     T8_ASSERT (remote_entry->remote_rank == remote_rank);
@@ -1275,7 +1498,13 @@ t8_forest_ghost_send_start (t8_forest_t forest, t8_forest_ghost_t ghost,
       /* The byte count of the elements */
       element_size = t8_element_array_get_size (&remote_tree->elements);
       element_count = t8_element_array_get_count (&remote_tree->elements);
-      element_bytes = element_size * element_count;
+      if (forest->set_compress_messages) {
+        /* We do not know the packed size yet, so we use its upper bound */
+        element_bytes = t8_element_array_pack_bound (element_count);
+      }
+      else {
+        element_bytes = element_size * element_count;
+      }
       /* We will store the number of elements */
       current_send_info->num_bytes += sizeof (size_t);
       /* add padding before the elements */
@@ -1328,13 +1557,22 @@ t8_forest_ghost_send_start (t8_forest_t forest, t8_forest_ghost_t ghost,
               sizeof (size_t));
       bytes_written += sizeof (size_t);
       bytes_written += T8_ADD_PADDING (bytes_written);
-      /* The byte count of the elements */
-      element_size = t8_element_array_get_size (&remote_tree->elements);
-      element_bytes = element_size * element_count;
-      /* Copy the elements into the send buffer */
-      memcpy (current_buffer + bytes_written,
-              t8_element_array_get_data (&remote_tree->elements),
-              element_bytes);
+      if (forest->set_compress_messages) {
+        /* Pack the elements into the send buffer */
+        element_bytes = t8_element_array_pack (&remote_tree->elements, 0,
+                                               element_count,
+                                               current_buffer +
+                                               bytes_written);
+      }
+      else {
+        /* The byte count of the elements */
+        element_size = t8_element_array_get_size (&remote_tree->elements);
+        element_bytes = element_size * element_count;
+        /* Copy the elements into the send buffer */
+        memcpy (current_buffer + bytes_written,
+                t8_element_array_get_data (&remote_tree->elements),
+                element_bytes);
+      }
       bytes_written += element_bytes;
       /* add padding after the elements */
       bytes_written += T8_ADD_PADDING (bytes_written);
@@ -1346,17 +1584,248 @@ t8_forest_ghost_send_start (t8_forest_t forest, t8_forest_ghost_t ghost,
 #endif
     }                           /* End tree loop */
 
-    T8_ASSERT (bytes_written == current_send_info->num_bytes);
-    /* We can now post the MPI_Isend for the remote process */
-    mpiret =
-      sc_MPI_Isend (current_buffer, bytes_written, sc_MPI_BYTE, remote_rank,
-                    T8_MPI_GHOST_FOREST, forest->mpicomm,
-                    *requests + proc_index);
-    SC_CHECK_MPI (mpiret);
+    T8_ASSERT (bytes_written == current_send_info->num_bytes
+               || (forest->set_compress_messages
+                   && bytes_written < current_send_info->num_bytes));
+    /* Packed elements may use less bytes than we allocated */
+    current_send_info->num_bytes = bytes_written;
+    if (requests != NULL) {
+      /* We can now post the MPI_Isend for the remote process */
+      mpiret =
+        sc_MPI_Isend (current_buffer, bytes_written, sc_MPI_BYTE,
+                      remote_rank, T8_MPI_GHOST_FOREST, forest->mpicomm,
+                      *requests + proc_index);
+      SC_CHECK_MPI (mpiret);
+    }
   }                             /* end process loop */
   return send_info;
 }
 
+/* Return the remote struct of a given remote rank of a ghost structure or
+ * NULL if the rank is not a remote of the ghost structure. */
+static t8_ghost_remote_t *
+t8_forest_ghost_lookup_remote (t8_forest_ghost_t ghost, int remote)
+{
+  t8_ghost_remote_t   remote_search;
+  size_t              index;
+
+  if (ghost == NULL) {
+    return NULL;
+  }
+  remote_search.remote_rank = remote;
+  if (!sc_hash_array_lookup (ghost->remote_ghosts, &remote_search, &index)) {
+    return NULL;
+  }
+  return (t8_ghost_remote_t *) sc_array_index (&ghost->remote_ghosts->a,
+                                               index);
+}
+
+/* Append data to a message and pad the message afterwards.
+ * data may be NULL if num_bytes is 0. */
+static void
+t8_forest_ghost_message_push (sc_array_t *message, const void *data,
+                              size_t num_bytes)
+{
+  const size_t        padding =
+    T8_ADD_PADDING (message->elem_count + num_bytes);
+  char               *dest;
+
+  if (num_bytes + padding == 0) {
+    return;
+  }
+  dest = (char *) sc_array_push_count (message, num_bytes + padding);
+  if (num_bytes > 0) {
+    memcpy (dest, data, num_bytes);
+  }
+  memset (dest + num_bytes, 0, padding);
+}
+
+/* Add an element to the runs of a delta message.
+ * first is the rank local index of the element in the ghosts of the receiver's
+ * old forest, or -1 if the element is new. */
+static void
+t8_forest_ghost_push_run (sc_array_t *runs, t8_locidx_t first)
+{
+  t8_locidx_t        *run;
+
+  if (runs->elem_count > 0) {
+    run = (t8_locidx_t *) sc_array_index (runs, runs->elem_count - 2);
+    if ((first < 0 && run[0] < 0)
+        || (first >= 0 && run[0] >= 0 && run[0] + run[1] == first)) {
+      /* The element continues the last run */
+      run[1]++;
+      return;
+    }
+  }
+  run = (t8_locidx_t *) sc_array_push_count (runs, 2);
+  run[0] = first < 0 ? -1 : first;
+  run[1] = 1;
+}
+
+/* Begin sending the ghost elements from the remote ranks as in
+ * t8_forest_ghost_send_start, but relative to the remote elements of the
+ * ghost structure ghost_from, for example the ghosts of the source forest.
+ * Remote elements that the receiver already has as ghosts in ghost_from are
+ * not sent again, only their position.
+ * See t8_forest_ghost_parse_received_message for the message layout.
+ * If requests is NULL, no messages are posted. */
+static t8_ghost_mpi_send_info_t *
+t8_forest_ghost_send_start_delta (t8_forest_t forest,
+                                  t8_forest_ghost_t ghost_from,
+                                  t8_forest_ghost_t ghost,
+                                  sc_MPI_Request ** requests)
+{
+  int                 proc_index, remote_rank, num_remotes, mpiret;
+  size_t              remote_index, old_tree_index, element_count,
+    old_count, num_runs, irun, iold, inew, offset;
+  t8_locidx_t         old_position, first, count;
+  t8_ghost_remote_t  *remote_entry, *old_entry;
+  t8_ghost_remote_tree_t *remote_tree, *old_tree;
+  t8_ghost_mpi_send_info_t *send_info, *current_send_info;
+  t8_eclass_scheme_c *ts;
+  sc_array_t          message, runs;
+  int                 compare;
+
+  num_remotes = ghost->remote_processes->elem_count;
+  send_info = T8_ALLOC (t8_ghost_mpi_send_info_t, num_remotes);
+  if (requests != NULL) {
+    *requests = T8_ALLOC (sc_MPI_Request, num_remotes);
+  }
+  sc_array_init (&message, 1);
+  sc_array_init (&runs, sizeof (t8_locidx_t));
+
+  for (proc_index = 0; proc_index < num_remotes; proc_index++) {
+    current_send_info = send_info + proc_index;
+    remote_rank = *(int *) sc_array_index_int (ghost->remote_processes,
+                                               proc_index);
+    current_send_info->recv_rank = remote_rank;
+    current_send_info->request =
+      requests != NULL ? *requests + proc_index : NULL;
+    remote_entry = t8_forest_ghost_get_remote (forest, remote_rank);
+    /* The elements that we sent to this rank for ghost_from */
+    old_entry = t8_forest_ghost_lookup_remote (ghost_from, remote_rank);
+    old_tree_index = 0;
+    old_position = 0;
+
+    sc_array_truncate (&message);
+    t8_forest_ghost_message_push (&message,
+                                  &remote_entry->remote_trees.elem_count,
+                                  sizeof (size_t));
+    for (remote_index = 0;
+         remote_index < remote_entry->remote_trees.elem_count;
+         remote_index++) {
+      remote_tree = (t8_ghost_remote_tree_t *)
+        sc_array_index (&remote_entry->remote_trees, remote_index);
+      ts = t8_element_array_get_scheme (&remote_tree->elements);
+      element_count = t8_element_array_get_count (&remote_tree->elements);
+      /* Find the old remote tree with the same global id. Remote trees
+       * are sorted by their global id. */
+      old_tree = NULL;
+      while (old_entry != NULL &&
+             old_tree_index < old_entry->remote_trees.elem_count) {
+        old_tree = (t8_ghost_remote_tree_t *)
+          sc_array_index (&old_entry->remote_trees, old_tree_index);
+        if (old_tree->global_id >= remote_tree->global_id) {
+          break;
+        }
+        old_position += t8_element_array_get_count (&old_tree->elements);
+        old_tree = NULL;
+        old_tree_index++;
+      }
+      if (old_tree != NULL && old_tree->global_id != remote_tree->global_id) {
+        old_tree = NULL;
+      }
+      old_count =
+        old_tree != NULL ? t8_element_array_get_count (&old_tree->elements) :
+        0;
+
+      /* Merge the old and new remote elements of this tree into runs */
+      sc_array_truncate (&runs);
+      iold = 0;
+      for (inew = 0; inew < element_count; inew++) {
+        first = -1;
+        while (iold < old_count) {
+          compare = t8_forest_ghost_element_compare (ts,
+                                                     t8_element_array_index_locidx
+                                                     (&old_tree->elements,
+                                                      iold),
+                                                     t8_element_array_index_locidx
+                                                     (&remote_tree->elements,
+                                                      inew));
+          if (compare >= 0) {
+            if (compare == 0) {
+              first = old_position + iold;
+              iold++;
+            }
+            break;
+          }
+          iold++;
+        }
+        t8_forest_ghost_push_run (&runs, first);
+      }
+      if (old_tree != NULL) {
+        old_position += old_count;
+        old_tree_index++;
+      }
+      num_runs = runs.elem_count / 2;
+
+      /* Write the tree info and the runs */
+      t8_forest_ghost_message_push (&message, &remote_tree->global_id,
+                                    sizeof (t8_gloidx_t));
+      t8_forest_ghost_message_push (&message, &remote_tree->eclass,
+                                    sizeof (t8_eclass_t));
+      t8_forest_ghost_message_push (&message, &element_count,
+                                    sizeof (size_t));
+      t8_forest_ghost_message_push (&message, &num_runs, sizeof (size_t));
+      t8_forest_ghost_message_push (&message, runs.array,
+                                    runs.elem_count * sizeof (t8_locidx_t));
+      /* Write the new elements */
+      inew = 0;
+      for (irun = 0; irun < num_runs; irun++) {
+        first = *(t8_locidx_t *) sc_array_index (&runs, 2 * irun);
+        count = *(t8_locidx_t *) sc_array_index (&runs, 2 * irun + 1);
+        if (first < 0) {
+          offset = message.elem_count;
+          if (forest->set_compress_messages) {
+            sc_array_resize (&message,
+                             offset + t8_element_array_pack_bound (count));
+            sc_array_resize (&message, offset +
+                             t8_element_array_pack (&remote_tree->elements,
+                                                    inew, count,
+                                                    message.array + offset));
+          }
+          else {
+            sc_array_resize (&message, offset + count * ts->t8_element_size ());
+            memcpy (message.array + offset,
+                    t8_element_array_index_locidx (&remote_tree->elements,
+                                                   inew),
+                    count * ts->t8_element_size ());
+          }
+        }
+        inew += count;
+      }
+      t8_forest_ghost_message_push (&message, NULL, 0);
+
+      ghost->num_remote_elements += element_count;
+    }
+
+    /* Copy the message to the send buffer and post the send */
+    current_send_info->num_bytes = message.elem_count;
+    current_send_info->buffer = T8_ALLOC (char, message.elem_count);
+    memcpy (current_send_info->buffer, message.array, message.elem_count);
+    if (requests != NULL) {
+      mpiret = sc_MPI_Isend (current_send_info->buffer,
+                             current_send_info->num_bytes, sc_MPI_BYTE,
+                             remote_rank, T8_MPI_GHOST_FOREST,
+                             forest->mpicomm, *requests + proc_index);
+      SC_CHECK_MPI (mpiret);
+    }
+  }
+  sc_array_reset (&message);
+  sc_array_reset (&runs);
+  return send_info;
+}
+
 static void
 t8_forest_ghost_send_end (t8_forest_t forest, t8_forest_ghost_t ghost,
                           t8_ghost_mpi_send_info_t *send_info,
@@ -1409,6 +1878,111 @@ t8_forest_ghost_receive_message (int recv_rank, sc_MPI_Comm comm,
   return recv_buffer;
 }
 
+/* A cursor into the ghost elements that a forest received from one rank.
+ * It is used to look up the ghosts by their rank local index in increasing order. */
+typedef struct
+{
+  t8_forest_ghost_t   ghost;    /* The ghost structure, NULL if there are no ghosts of the rank */
+  size_t              tree_index;       /* The index of the current ghost tree */
+  t8_locidx_t         tree_element;     /* The index in the current ghost tree of the element at position */
+  t8_locidx_t         position; /* A rank local index */
+} t8_forest_ghost_old_cursor_t;
+
+/* Initialize a cursor to the first ghost element of a rank in a ghost
+ * structure, which may be NULL. */
+static void
+t8_forest_ghost_old_cursor_init (t8_forest_ghost_t ghost, int rank,
+                                 t8_forest_ghost_old_cursor_t *cursor)
+{
+  t8_ghost_process_hash_t proc_hash_search, **pproc_hash_found;
+
+  cursor->ghost = NULL;
+  cursor->tree_index = 0;
+  cursor->tree_element = 0;
+  cursor->position = 0;
+  if (ghost == NULL) {
+    return;
+  }
+  proc_hash_search.mpirank = rank;
+  if (sc_hash_lookup (ghost->process_offsets, &proc_hash_search,
+                      (void ***) &pproc_hash_found)) {
+    cursor->ghost = ghost;
+    cursor->tree_index = (*pproc_hash_found)->tree_index;
+    cursor->tree_element = (*pproc_hash_found)->first_element;
+  }
+}
+
+/* Return the ghost element at a rank local index. The index must not be
+ * smaller than the index of the previous call. */
+static const t8_element_t *
+t8_forest_ghost_old_cursor_get (t8_forest_ghost_old_cursor_t *cursor,
+                                t8_locidx_t position)
+{
+  t8_ghost_tree_t    *ghost_tree;
+  t8_locidx_t         remaining;
+
+  T8_ASSERT (cursor->ghost != NULL);
+  T8_ASSERT (position >= cursor->position);
+  for (;;) {
+    ghost_tree = (t8_ghost_tree_t *) sc_array_index (cursor->ghost->ghost_trees,
+                                                     cursor->tree_index);
+    remaining = t8_element_array_get_count (&ghost_tree->elements)
+      - cursor->tree_element;
+    if (position - cursor->position < remaining) {
+      return t8_element_array_index_locidx (&ghost_tree->elements,
+                                            cursor->tree_element + position -
+                                            cursor->position);
+    }
+    /* The element lies in one of the next trees */
+    cursor->position += remaining;
+    cursor->tree_index++;
+    cursor->tree_element = 0;
+  }
+}
+
+/* Fill the elements of a ghost tree from the runs of a delta message.
+ * The elements are inserted starting at index offset.
+ * Returns the number of bytes of new elements read from buffer. */
+static size_t
+t8_forest_ghost_parse_runs (t8_forest_t forest,
+                            t8_element_array_t *elements, size_t offset,
+                            size_t num_runs, const t8_locidx_t *runs,
+                            t8_forest_ghost_old_cursor_t *old_cursor,
+                            const char *buffer)
+{
+  t8_eclass_scheme_c *ts = t8_element_array_get_scheme (elements);
+  const size_t        element_size = ts->t8_element_size ();
+  size_t              irun, bytes_read = 0;
+  t8_locidx_t         first, count, ielement;
+
+  for (irun = 0; irun < num_runs; irun++) {
+    first = runs[2 * irun];
+    count = runs[2 * irun + 1];
+    if (first >= 0) {
+      /* Copy the elements from the ghosts of the old forest */
+      for (ielement = 0; ielement < count; ielement++) {
+        ts->t8_element_copy (t8_forest_ghost_old_cursor_get (old_cursor,
+                                                             first +
+                                                             ielement),
+                             t8_element_array_index_locidx (elements,
+                                                            offset +
+                                                            ielement));
+      }
+    }
+    else if (forest->set_compress_messages) {
+      bytes_read += t8_element_array_unpack (elements, offset, count,
+                                             buffer + bytes_read);
+    }
+    else {
+      memcpy (t8_element_array_index_locidx (elements, offset),
+              buffer + bytes_read, count * element_size);
+      bytes_read += count * element_size;
+    }
+    offset += count;
+  }
+  return bytes_read;
+}
+
 /* Parse a message from a remote process and correctly include the received
  * elements in the ghost structure.
  * The message looks like:
@@ -1420,15 +1994,30 @@ t8_forest_ghost_receive_message (int recv_rank, sc_MPI_Comm comm,
  * current_element_offset is updated in each step to store the element offset
  * of the next ghost tree to be inserted.
  * When called with the first message, current_element_offset must be set to 0.
+ *
+ * If ghost_from is not NULL, the message was sent by t8_forest_ghost_send_start_delta
+ * and the elements of each tree are given as runs relative to the ghosts in
+ * ghost_from:
+ * ... | num_elems 0 | pad | num_runs 0 | pad | runs | pad | new elements | pad | treeid 1 | ...
+ *       size_t      |     | size_t     |     | 2 * t8_locidx_t per run
+ * A run (first, count) with first >= 0 copies count ghosts in ghost_from that
+ * were received from the same rank, starting at the rank local index first.
+ * A run with first < 0 takes the next count elements of the new elements.
+ *
+ * The message buffer is not freed.
  */
 /* Currently we expect that the messages arrive in order of the sender's rank. */
 static void
 t8_forest_ghost_parse_received_message (t8_forest_t forest,
                                         t8_forest_ghost_t ghost,
+                                        t8_forest_ghost_t ghost_from,
                                         t8_locidx_t *current_element_offset,
                                         int recv_rank, char *recv_buffer,
                                         int recv_bytes)
 {
+  t8_forest_ghost_old_cursor_t old_cursor;
+  size_t              num_runs = 0;
+  const t8_locidx_t  *runs = NULL;
   size_t              bytes_read, first_tree_index = 0, first_element_index =
     0;
   t8_locidx_t         num_trees, itree;
@@ -1444,6 +2033,10 @@ t8_forest_ghost_parse_received_message (t8_forest_t forest,
   int                 added_process;
 #endif
 
+  if (ghost_from != NULL) {
+    t8_forest_ghost_old_cursor_init (ghost_from, recv_rank, &old_cursor);
+  }
+
   bytes_read = 0;
   /* read the number of trees */
   num_trees = *(size_t *) recv_buffer;
@@ -1477,6 +2070,15 @@ t8_forest_ghost_parse_received_message (t8_forest_t forest,
 
     bytes_read += sizeof (size_t);
     bytes_read += T8_ADD_PADDING (bytes_read);
+    if (ghost_from != NULL) {
+      /* read the runs */
+      num_runs = *(size_t *) (recv_buffer + bytes_read);
+      bytes_read += sizeof (size_t);
+      bytes_read += T8_ADD_PADDING (bytes_read);
+      runs = (const t8_locidx_t *) (recv_buffer + bytes_read);
+      bytes_read += 2 * num_runs * sizeof (t8_locidx_t);
+      bytes_read += T8_ADD_PADDING (bytes_read);
+    }
     /* Search for the tree in the ghost_trees array */
     tree_hash =
       (t8_ghost_gtree_hash_t *) sc_mempool_alloc (ghost->glo_tree_mempool);
@@ -1534,15 +2136,26 @@ t8_forest_ghost_parse_received_message (t8_forest_t forest,
       first_element_index = old_elem_count;
     }
     /* Insert the new elements */
-    memcpy (element_insert, recv_buffer + bytes_read,
-            num_elements * ts->t8_element_size ());
-
-    bytes_read += num_elements * ts->t8_element_size ();
+    if (ghost_from != NULL) {
+      bytes_read +=
+        t8_forest_ghost_parse_runs (forest, &ghost_tree->elements,
+                                    old_elem_count, num_runs, runs,
+                                    &old_cursor, recv_buffer + bytes_read);
+    }
+    else if (forest->set_compress_messages) {
+      bytes_read += t8_element_array_unpack (&ghost_tree->elements,
+                                             old_elem_count, num_elements,
+                                             recv_buffer + bytes_read);
+    }
+    else {
+      memcpy (element_insert, recv_buffer + bytes_read,
+              num_elements * ts->t8_element_size ());
+      bytes_read += num_elements * ts->t8_element_size ();
+    }
     bytes_read += T8_ADD_PADDING (bytes_read);
     *current_element_offset += num_elements;
   }
   T8_ASSERT (bytes_read == (size_t) recv_bytes);
-  T8_FREE (recv_buffer);
 
   /* At last we add the receiving rank to the ghosts process_offset hash table */
   process_hash =
@@ -1593,9 +2206,12 @@ t8_recv_list_entry_equal (const void *v1, const void *v2, const void *u)
 
 /* Probe for all incoming messages from the remote ranks and receive them.
  * We receive the message in the order in which they arrive. To achieve this,
- * we have to use polling. */
+ * we have to use polling.
+ * If ghost_from is not NULL, the messages were sent by
+ * t8_forest_ghost_send_start_delta. */
 static void
-t8_forest_ghost_receive (t8_forest_t forest, t8_forest_ghost_t ghost)
+t8_forest_ghost_receive (t8_forest_t forest, t8_forest_ghost_t ghost,
+                         t8_forest_ghost_t ghost_from)
 {
   int                 num_remotes;
   int                 proc_pos;
@@ -1749,10 +2365,11 @@ t8_forest_ghost_receive (t8_forest_t forest, t8_forest_ghost_t ghost)
            received_flag[parse_it] == 1; parse_it++) {
         recv_rank =
           *(int *) sc_array_index_int (ghost->remote_processes, parse_it);
-        t8_forest_ghost_parse_received_message (forest, ghost,
+        t8_forest_ghost_parse_received_message (forest, ghost, ghost_from,
                                                 &current_element_offset,
                                                 recv_rank, buffer[parse_it],
                                                 recv_bytes[parse_it]);
+        T8_FREE (buffer[parse_it]);
         last_rank_parsed++;
       }
 
@@ -1795,10 +2412,11 @@ t8_forest_ghost_receive (t8_forest_t forest, t8_forest_ghost_t ghost)
          received_flag[parse_it] == 1; parse_it++) {
       recv_rank =
         *(int *) sc_array_index_int (ghost->remote_processes, parse_it);
-      t8_forest_ghost_parse_received_message (forest, ghost,
+      t8_forest_ghost_parse_received_message (forest, ghost, ghost_from,
                                               &current_element_offset,
                                               recv_rank, buffer[parse_it],
                                               recv_bytes[parse_it]);
+      T8_FREE (buffer[parse_it]);
       last_rank_parsed++;
     }
 #endif
@@ -1844,6 +2462,557 @@ t8_forest_ghost_receive (t8_forest_t forest, t8_forest_ghost_t ghost)
 #endif
 }
 
+/* Store the send information of a ghost layer whose messages are
+ * received later in t8_forest_ghost_complete.
+ * If ghost_from is not NULL, it is referenced. */
+static void
+t8_forest_ghost_set_pending (t8_forest_ghost_t ghost,
+                             t8_ghost_mpi_send_info_t *send_info,
+                             sc_MPI_Request * requests,
+                             t8_forest_ghost_t ghost_from)
+{
+  t8_forest_ghost_pending_t *pending;
+
+  T8_ASSERT (ghost->pending == NULL);
+  pending = T8_ALLOC (t8_forest_ghost_pending_t, 1);
+  pending->send_info = send_info;
+  pending->requests = requests;
+  pending->ghost_from = ghost_from;
+  if (ghost_from != NULL) {
+    t8_forest_ghost_ref (ghost_from);
+  }
+  ghost->pending = pending;
+}
+
+int
+t8_forest_ghost_is_pending (t8_forest_t forest)
+{
+  T8_ASSERT (forest != NULL);
+  return forest->ghosts != NULL && forest->ghosts->pending != NULL;
+}
+
+void
+t8_forest_ghost_complete (t8_forest_t forest)
+{
+  t8_forest_ghost_t   ghost;
+  t8_forest_ghost_pending_t *pending;
+
+  T8_ASSERT (forest != NULL);
+  if (!t8_forest_ghost_is_pending (forest)) {
+    /* There is nothing to do */
+    return;
+  }
+  ghost = forest->ghosts;
+  pending = (t8_forest_ghost_pending_t *) ghost->pending;
+
+  if (forest->profile != NULL) {
+    /* Measure the time that we wait for the ghost elements */
+    forest->profile->ghost_waittime = -sc_MPI_Wtime ();
+  }
+  /* Receive the ghost elements from the remote processes */
+  t8_forest_ghost_receive (forest, ghost, pending->ghost_from);
+  /* End sending the remote elements */
+  t8_forest_ghost_send_end (forest, ghost, pending->send_info,
+                            pending->requests);
+  if (pending->ghost_from != NULL) {
+    t8_forest_ghost_unref (&pending->ghost_from);
+  }
+  T8_FREE (pending);
+  ghost->pending = NULL;
+  if (forest->profile != NULL) {
+    forest->profile->ghost_waittime += sc_MPI_Wtime ();
+    forest->profile->ghosts_received = ghost->num_ghosts_elements;
+  }
+}
+
+void
+t8_forest_ghost_wait (t8_forest_t forest)
+{
+  T8_ASSERT (forest != NULL);
+
+  t8_forest_ghost_complete (forest);
+  /* Compute the geometry cache, which was postponed until the
+   * ghost layer was complete */
+  if (forest->set_geometry_cache) {
+    t8_forest_geometry_cache_create (forest);
+    forest->set_geometry_cache = 0;
+  }
+}
+
+/* Exchange the ghost messages with neighborhood collectives instead of
+ * point-to-point messages and parse them.
+ * The send buffers must have been filled by t8_forest_ghost_send_start or
+ * t8_forest_ghost_send_start_delta in the order of the sorted remote processes.
+ * The graph communicator is stored in forest->ghost_comm, such that it can be
+ * reused by t8_forest_ghost_exchange_data.
+ * This function is collective. Processes without local elements call it with
+ * ghost = NULL and send_info = NULL. */
+static void
+t8_forest_ghost_neighbor_exchange (t8_forest_t forest,
+                                   t8_forest_ghost_t ghost,
+                                   t8_forest_ghost_t ghost_from,
+                                   t8_ghost_mpi_send_info_t *send_info)
+{
+  int                 num_remotes, iremote;
+  const int          *remotes;
+  char              **send_buffers, *recv_buffer;
+  int                *send_bytes, *recv_bytes, *recv_offsets;
+  t8_locidx_t         current_element_offset = 0;
+
+  T8_ASSERT (forest->ghost_comm == sc_MPI_COMM_NULL);
+  T8_ASSERT ((ghost == NULL) == (send_info == NULL));
+
+  num_remotes = ghost != NULL ? ghost->remote_processes->elem_count : 0;
+  remotes = num_remotes > 0 ? (int *) ghost->remote_processes->array : NULL;
+  /* The face neighbor relation is symmetric, we receive from exactly the
+   * processes that we send to. */
+  forest->ghost_comm = t8_neighbor_comm_create (forest->mpicomm, num_remotes,
+                                                remotes, num_remotes,
+                                                remotes);
+
+  send_buffers = T8_ALLOC (char *, num_remotes + 1);
+  send_bytes = T8_ALLOC (int, num_remotes + 1);
+  recv_bytes = T8_ALLOC (int, num_remotes + 1);
+  recv_offsets = T8_ALLOC (int, num_remotes + 1);
+  for (iremote = 0; iremote < num_remotes; iremote++) {
+    T8_ASSERT (send_info[iremote].recv_rank == remotes[iremote]);
+    send_buffers[iremote] = send_info[iremote].buffer;
+    send_bytes[iremote] = send_info[iremote].num_bytes;
+  }
+  recv_buffer =
+    t8_neighbor_comm_alltoallv (forest->ghost_comm, num_remotes,
+                                send_buffers, send_bytes, num_remotes,
+                                recv_bytes, recv_offsets);
+
+  /* Parse the messages in order of the sender's rank */
+  for (iremote = 0; iremote < num_remotes; iremote++) {
+    t8_forest_ghost_parse_received_message (forest, ghost, ghost_from,
+                                            &current_element_offset,
+                                            remotes[iremote],
+                                            recv_buffer +
+                                            recv_offsets[iremote],
+                                            recv_bytes[iremote]);
+    T8_FREE (send_info[iremote].buffer);
+  }
+
+  T8_FREE (recv_buffer);
+  T8_FREE (send_buffers);
+  T8_FREE (send_bytes);
+  T8_FREE (recv_bytes);
+  T8_FREE (recv_offsets);
+  T8_FREE (send_info);
+}
+
+/* A local element that is a remote element of another process.
+ * Used to construct ghost layers of width greater than one. */
+typedef struct
+{
+  int                 remote_rank;      /* The process that needs the element as ghost. */
+  t8_locidx_t         ltreeid;  /* The local tree of the element. */
+  t8_locidx_t         element_index;    /* The tree local index of the element. */
+} t8_forest_ghost_layer_entry_t;
+
+/* A ghost element that is a face neighbor of a remote element.
+ * It is sent to the owner of the ghost element, which then adds it as
+ * a remote element of remote_rank. */
+typedef struct
+{
+  t8_gloidx_t         gtreeid;  /* The global tree of the element. */
+  t8_linearidx_t      linear_id;        /* The linear id of the element at the forest's maxlevel. */
+  int                 level;    /* The refinement level of the element. */
+  int                 remote_rank;      /* The process that needs the element as ghost. */
+} t8_forest_ghost_layer_notify_t;
+
+/* Compare two layer entries by remote rank, local tree and element index. */
+static int
+t8_forest_ghost_layer_entry_compare (const void *entry_a, const void *entry_b)
+{
+  const t8_forest_ghost_layer_entry_t *a =
+    (const t8_forest_ghost_layer_entry_t *) entry_a;
+  const t8_forest_ghost_layer_entry_t *b =
+    (const t8_forest_ghost_layer_entry_t *) entry_b;
+
+  if (a->remote_rank != b->remote_rank) {
+    return a->remote_rank < b->remote_rank ? -1 : 1;
+  }
+  if (a->ltreeid != b->ltreeid) {
+    return a->ltreeid < b->ltreeid ? -1 : 1;
+  }
+  if (a->element_index != b->element_index) {
+    return a->element_index < b->element_index ? -1 : 1;
+  }
+  return 0;
+}
+
+/* Find the leaves in a sorted array of leaves that touch a face of an element
+ * from inside. These are either a single leaf that is the element or one of
+ * its ancestors, or descendants of the element at the face.
+ * The latter are found by a top-down search along the face children.
+ * The array indices of the found leaves are pushed to leaf_indices.
+ * leaves may be the elements of a local tree or of a ghost tree. */
+static void
+t8_forest_ghost_layer_leaves_at_face (t8_forest_t forest,
+                                      t8_element_array_t *leaves,
+                                      const t8_element_t *elem, int face,
+                                      sc_array_t *leaf_indices)
+{
+  t8_eclass_scheme_c *ts;
+  t8_element_t       *desc, **children;
+  t8_element_buffer_t buffer;
+  t8_linearidx_t      first_id, last_id, leaf_id;
+  t8_locidx_t         num_leaves, lower, inside;
+  int                 num_children, ichild;
+
+  num_leaves = t8_element_array_get_count (leaves);
+  if (num_leaves == 0) {
+    return;
+  }
+  ts = t8_element_array_get_scheme (leaves);
+
+  /* The temporary elements live in a local buffer and not in the scheme's
+   * memory pool. It holds the descendant or the face children.
+   * Compute the range of linear ids of the descendants of elem. */
+  desc = t8_element_buffer_init (&buffer, ts, 1)[0];
+  ts->t8_element_first_descendant (elem, desc, forest->maxlevel);
+  first_id = ts->t8_element_get_linear_id (desc, forest->maxlevel);
+  ts->t8_element_last_descendant (elem, desc, forest->maxlevel);
+  last_id = ts->t8_element_get_linear_id (desc, forest->maxlevel);
+
+  lower = t8_forest_bin_search_lower (leaves, first_id, forest->maxlevel);
+  if (lower >= 0 && t8_forest_ghost_element_is_ancestor (ts,
+                                                         t8_element_array_index_locidx
+                                                         (leaves, lower),
+                                                         elem)) {
+    /* The element or one of its ancestors is a leaf */
+    *(t8_locidx_t *) sc_array_push (leaf_indices) = lower;
+    t8_element_buffer_reset (&buffer);
+    return;
+  }
+  /* Check whether any leaf is a descendant of elem */
+  inside = lower + 1;
+  if (lower >= 0) {
+    leaf_id =
+      ts->t8_element_get_linear_id (t8_element_array_index_locidx
+                                    (leaves, lower), forest->maxlevel);
+    if (leaf_id == first_id) {
+      inside = lower;
+    }
+  }
+  if (inside >= num_leaves) {
+    t8_element_buffer_reset (&buffer);
+    return;
+  }
+  leaf_id =
+    ts->t8_element_get_linear_id (t8_element_array_index_locidx
+                                  (leaves, inside), forest->maxlevel);
+  if (leaf_id > last_id) {
+    /* There are no leaves inside elem */
+    t8_element_buffer_reset (&buffer);
+    return;
+  }
+  T8_ASSERT (ts->t8_element_level (elem) < forest->maxlevel);
+
+  /* Descend to the children of elem at the face */
+  num_children = ts->t8_element_num_face_children (elem, face);
+  T8_ASSERT (num_children <= T8_ECLASS_MAX_CHILDREN);
+  t8_element_buffer_reset (&buffer);
+  children = t8_element_buffer_init (&buffer, ts, num_children);
+  ts->t8_element_children_at_face (elem, face, children, num_children, NULL);
+  for (ichild = 0; ichild < num_children; ichild++) {
+    t8_forest_ghost_layer_leaves_at_face (forest, leaves, children[ichild],
+                                          ts->t8_element_face_child_face
+                                          (elem, face, ichild), leaf_indices);
+  }
+  t8_element_buffer_reset (&buffer);
+}
+
+/* Compute the local face neighbor leaves of the elements in frontier.
+ * Local neighbors are added to candidates as remote elements of the same
+ * process as the frontier element. Ghost neighbors that are not owned by this
+ * process are added to the notify array of their owner. */
+static void
+t8_forest_ghost_layer_extend (t8_forest_t forest, sc_array_t *frontier,
+                              sc_array_t *candidates, sc_array_t *notify)
+{
+  t8_forest_ghost_layer_entry_t *entry, *candidate;
+  t8_forest_ghost_layer_notify_t *message;
+  t8_element_array_t *leaves;
+  t8_element_t       *elem, *neigh;
+  t8_element_buffer_t neigh_buffer;
+  const t8_element_t *leaf;
+  t8_eclass_scheme_c *ts, *neigh_scheme;
+  t8_eclass_t         neigh_class;
+  t8_gloidx_t         gneigh_tree;
+  t8_locidx_t         lneigh_tree, lghost_tree, leaf_index;
+  sc_array_t          leaf_indices;
+  size_t              ientry, ileaf;
+  ssize_t             remote_index;
+  int                 iface, num_faces, neigh_face, owner;
+
+  sc_array_init (&leaf_indices, sizeof (t8_locidx_t));
+  for (ientry = 0; ientry < frontier->elem_count; ientry++) {
+    entry = (t8_forest_ghost_layer_entry_t *) sc_array_index (frontier, ientry);
+    ts = t8_forest_get_eclass_scheme (forest,
+                                      t8_forest_get_tree_class (forest,
+                                                                entry->ltreeid));
+    elem = t8_forest_get_element_in_tree (forest, entry->ltreeid,
+                                          entry->element_index);
+    num_faces = ts->t8_element_num_faces (elem);
+    for (iface = 0; iface < num_faces; iface++) {
+      /* Construct the same level face neighbor of the element */
+      neigh_class =
+        t8_forest_element_neighbor_eclass (forest, entry->ltreeid, elem,
+                                           iface);
+      neigh_scheme = t8_forest_get_eclass_scheme (forest, neigh_class);
+      neigh = t8_element_buffer_init (&neigh_buffer, neigh_scheme, 1)[0];
+      gneigh_tree =
+        t8_forest_element_face_neighbor (forest, entry->ltreeid, elem, neigh,
+                                         neigh_scheme, iface, &neigh_face);
+      if (gneigh_tree >= 0) {
+        /* Local leaves at the face are remote elements of the same process */
+        lneigh_tree = t8_forest_get_local_id (forest, gneigh_tree);
+        if (lneigh_tree >= 0) {
+          leaves = t8_forest_get_tree_element_array (forest, lneigh_tree);
+          t8_forest_ghost_layer_leaves_at_face (forest, leaves, neigh,
+                                                neigh_face, &leaf_indices);
+          for (ileaf = 0; ileaf < leaf_indices.elem_count; ileaf++) {
+            candidate =
+              (t8_forest_ghost_layer_entry_t *) sc_array_push (candidates);
+            candidate->remote_rank = entry->remote_rank;
+            candidate->ltreeid = lneigh_tree;
+            candidate->element_index =
+              *(t8_locidx_t *) sc_array_index (&leaf_indices, ileaf);
+          }
+          sc_array_truncate (&leaf_indices);
+        }
+        /* Ghost leaves at the face are sent to their owners */
+        lghost_tree = t8_forest_ghost_get_ghost_treeid (forest, gneigh_tree);
+        if (lghost_tree >= 0) {
+          leaves = t8_forest_ghost_get_tree_elements (forest, lghost_tree);
+          t8_forest_ghost_layer_leaves_at_face (forest, leaves, neigh,
+                                                neigh_face, &leaf_indices);
+          for (ileaf = 0; ileaf < leaf_indices.elem_count; ileaf++) {
+            leaf_index =
+              *(t8_locidx_t *) sc_array_index (&leaf_indices, ileaf);
+            leaf = t8_element_array_index_locidx (leaves, leaf_index);
+            owner = t8_forest_element_find_owner (forest, gneigh_tree,
+                                                  (t8_element_t *) leaf,
+                                                  neigh_class);
+            T8_ASSERT (owner != forest->mpirank);
+            if (owner == entry->remote_rank) {
+              /* The process owns this neighbor */
+              continue;
+            }
+            /* The owner of a ghost is always a remote process of the
+             * first layer. */
+            remote_index =
+              sc_array_bsearch (forest->ghosts->remote_processes, &owner,
+                                sc_int_compare);
+            T8_ASSERT (remote_index >= 0);
+            message = (t8_forest_ghost_layer_notify_t *)
+              sc_array_push (&notify[remote_index]);
+            message->gtreeid = gneigh_tree;
+            message->linear_id =
+              neigh_scheme->t8_element_get_linear_id (leaf, forest->maxlevel);
+            message->level = neigh_scheme->t8_element_level (leaf);
+            message->remote_rank = entry->remote_rank;
+          }
+          sc_array_truncate (&leaf_indices);
+        }
+      }
+      t8_element_buffer_reset (&neigh_buffer);
+    }
+  }
+  sc_array_reset (&leaf_indices);
+}
+
+/* Send the ghost neighbors of the remote elements to their owners and
+ * receive the local elements that other processes found as neighbors of
+ * their remote elements. The received elements are added to candidates.
+ * We communicate with the remote processes of the first layer, since these
+ * are exactly the owners of our ghosts and of the elements that have our
+ * elements as ghosts. */
+static void
+t8_forest_ghost_layer_notify (t8_forest_t forest, sc_array_t *notify,
+                              sc_array_t *candidates)
+{
+  sc_array_t         *remote_processes = forest->ghosts->remote_processes;
+  const int           num_remotes = remote_processes->elem_count;
+  t8_forest_ghost_layer_notify_t *message;
+  t8_forest_ghost_layer_entry_t *candidate;
+  sc_MPI_Request     *requests;
+  sc_MPI_Status       status;
+  sc_array_t          recv_messages;
+  t8_element_array_t *leaves;
+  t8_locidx_t         ltreeid;
+  size_t              imessage;
+  int                 iremote, remote, recv_bytes, mpiret;
+
+  requests = T8_ALLOC (sc_MPI_Request, num_remotes);
+  for (iremote = 0; iremote < num_remotes; iremote++) {
+    remote = *(int *) sc_array_index_int (remote_processes, iremote);
+    mpiret = sc_MPI_Isend (notify[iremote].array,
+                           (int) (notify[iremote].elem_count
+                                  * sizeof (t8_forest_ghost_layer_notify_t)),
+                           sc_MPI_BYTE, remote, T8_MPI_GHOST_LAYER,
+                           forest->mpicomm, requests + iremote);
+    SC_CHECK_MPI (mpiret);
+  }
+
+  sc_array_init (&recv_messages, sizeof (t8_forest_ghost_layer_notify_t));
+  for (iremote = 0; iremote < num_remotes; iremote++) {
+    remote = *(int *) sc_array_index_int (remote_processes, iremote);
+    mpiret = sc_MPI_Probe (remote, T8_MPI_GHOST_LAYER, forest->mpicomm,
+                           &status);
+    SC_CHECK_MPI (mpiret);
+    mpiret = sc_MPI_Get_count (&status, sc_MPI_BYTE, &recv_bytes);
+    SC_CHECK_MPI (mpiret);
+    T8_ASSERT (recv_bytes % sizeof (t8_forest_ghost_layer_notify_t) == 0);
+    sc_array_resize (&recv_messages,
+                     recv_bytes / sizeof (t8_forest_ghost_layer_notify_t));
+    mpiret = sc_MPI_Recv (recv_messages.array, recv_bytes, sc_MPI_BYTE,
+                          remote, T8_MPI_GHOST_LAYER, forest->mpicomm,
+                          sc_MPI_STATUS_IGNORE);
+    SC_CHECK_MPI (mpiret);
+
+    /* Look up the local elements and add them as remote elements */
+    for (imessage = 0; imessage < recv_messages.elem_count; imessage++) {
+      message = (t8_forest_ghost_layer_notify_t *)
+        sc_array_index (&recv_messages, imessage);
+      ltreeid = t8_forest_get_local_id (forest, message->gtreeid);
+      T8_ASSERT (0 <= ltreeid);
+      leaves = t8_forest_get_tree_element_array (forest, ltreeid);
+      candidate = (t8_forest_ghost_layer_entry_t *) sc_array_push (candidates);
+      candidate->remote_rank = message->remote_rank;
+      candidate->ltreeid = ltreeid;
+      candidate->element_index =
+        t8_forest_bin_search_lower (leaves, message->linear_id,
+                                    forest->maxlevel);
+      T8_ASSERT (candidate->element_index >= 0);
+      T8_ASSERT (t8_element_array_get_scheme (leaves)->t8_element_level
+                 (t8_element_array_index_locidx
+                  (leaves, candidate->element_index)) == message->level);
+    }
+  }
+  sc_array_reset (&recv_messages);
+
+  mpiret = sc_MPI_Waitall (num_remotes, requests, sc_MPI_STATUSES_IGNORE);
+  SC_CHECK_MPI (mpiret);
+  T8_FREE (requests);
+}
+
+/* Extend a ghost layer of width 1 to forest->ghost_width layers.
+ * In each round, the face neighbors of the remote elements that were added
+ * in the previous round become remote elements of the same process, unless
+ * that process owns them. Since a face neighbor may be owned by a third
+ * process, the neighbors that are ghosts are sent to their owners.
+ * On input, forest->ghosts must be a complete ghost layer of width 1.
+ * On output, forest->ghosts is replaced by a new ghost structure that
+ * stores the remote elements of all layers, but no ghost elements yet. */
+static void
+t8_forest_ghost_add_layers (t8_forest_t forest)
+{
+  t8_forest_ghost_t   ghost = forest->ghosts;
+  t8_ghost_remote_t  *remote_entry;
+  t8_ghost_remote_tree_t *remote_tree;
+  t8_forest_ghost_layer_entry_t *entry;
+  sc_array_t          entries, frontier, candidates, *notify;
+  const t8_gloidx_t   first_tree = t8_forest_get_first_local_tree_id (forest);
+  size_t              iremote, itree, ielem, ientry, num_remotes;
+  int                 ilayer;
+
+  T8_ASSERT (forest->ghost_width > 1);
+  T8_ASSERT (ghost != NULL);
+
+  /* Collect the remote elements of the first layer */
+  sc_array_init (&entries, sizeof (t8_forest_ghost_layer_entry_t));
+  for (iremote = 0; iremote < ghost->remote_ghosts->a.elem_count; iremote++) {
+    remote_entry = (t8_ghost_remote_t *)
+      sc_array_index (&ghost->remote_ghosts->a, iremote);
+    for (itree = 0; itree < remote_entry->remote_trees.elem_count; itree++) {
+      remote_tree = (t8_ghost_remote_tree_t *)
+        sc_array_index (&remote_entry->remote_trees, itree);
+      for (ielem = 0; ielem < remote_tree->element_indices.elem_count;
+           ielem++) {
+        entry = (t8_forest_ghost_layer_entry_t *) sc_array_push (&entries);
+        entry->remote_rank = remote_entry->remote_rank;
+        entry->ltreeid = remote_tree->global_id - first_tree;
+        entry->element_index = *(t8_locidx_t *)
+          sc_array_index (&remote_tree->element_indices, ielem);
+      }
+    }
+  }
+  sc_array_sort (&entries, t8_forest_ghost_layer_entry_compare);
+  sc_array_init (&frontier, sizeof (t8_forest_ghost_layer_entry_t));
+  sc_array_copy (&frontier, &entries);
+  sc_array_init (&candidates, sizeof (t8_forest_ghost_layer_entry_t));
+
+  /* We look up the owners of our ghosts in the remote processes */
+  sc_array_sort (ghost->remote_processes, sc_int_compare);
+  num_remotes = ghost->remote_processes->elem_count;
+  notify = T8_ALLOC (sc_array_t, num_remotes);
+  for (iremote = 0; iremote < num_remotes; iremote++) {
+    sc_array_init (&notify[iremote], sizeof (t8_forest_ghost_layer_notify_t));
+  }
+
+  for (ilayer = 1; ilayer < forest->ghost_width; ilayer++) {
+    /* Find the face neighbors of the last layer */
+    t8_forest_ghost_layer_extend (forest, &frontier, &candidates, notify);
+    t8_forest_ghost_layer_notify (forest, notify, &candidates);
+    for (iremote = 0; iremote < num_remotes; iremote++) {
+      sc_array_truncate (&notify[iremote]);
+    }
+    /* The new layer consists of all candidates that are not remote already */
+    sc_array_sort (&candidates, t8_forest_ghost_layer_entry_compare);
+    sc_array_uniq (&candidates, t8_forest_ghost_layer_entry_compare);
+    sc_array_truncate (&frontier);
+    for (ientry = 0; ientry < candidates.elem_count; ientry++) {
+      entry = (t8_forest_ghost_layer_entry_t *)
+        sc_array_index (&candidates, ientry);
+      if (sc_array_bsearch (&entries, entry,
+                            t8_forest_ghost_layer_entry_compare) < 0) {
+        *(t8_forest_ghost_layer_entry_t *) sc_array_push (&frontier) = *entry;
+      }
+    }
+    sc_array_truncate (&candidates);
+    for (ientry = 0; ientry < frontier.elem_count; ientry++) {
+      *(t8_forest_ghost_layer_entry_t *) sc_array_push (&entries) =
+        *(t8_forest_ghost_layer_entry_t *) sc_array_index (&frontier,
+                                                           ientry);
+    }
+    sc_array_sort (&entries, t8_forest_ghost_layer_entry_compare);
+  }
+
+  /* Replace the ghost structure by one that stores the remote elements
+   * of all layers. The entries are sorted by element for each process,
+   * as required by t8_ghost_add_remote. */
+  t8_forest_ghost_unref (&forest->ghosts);
+  t8_forest_ghost_init (&forest->ghosts, forest->ghost_type);
+  for (ientry = 0; ientry < entries.elem_count; ientry++) {
+    entry = (t8_forest_ghost_layer_entry_t *) sc_array_index (&entries,
+                                                              ientry);
+    t8_ghost_add_remote (forest, forest->ghosts, entry->remote_rank,
+                         entry->ltreeid,
+                         t8_forest_get_element_in_tree (forest,
+                                                        entry->ltreeid,
+                                                        entry->element_index),
+                         entry->element_index);
+  }
+  if (forest->profile != NULL) {
+    /* If profiling is enabled, we count the number of remote processes. */
+    forest->profile->ghosts_remotes =
+      forest->ghosts->remote_processes->elem_count;
+  }
+
+  for (iremote = 0; iremote < num_remotes; iremote++) {
+    sc_array_reset (&notify[iremote]);
+  }
+  T8_FREE (notify);
+  sc_array_reset (&entries);
+  sc_array_reset (&frontier);
+  sc_array_reset (&candidates);
+}
+
 /* Create one layer of ghost elements, following the algorithm
  * in: p4est: Scalable Algorithms For Parallel Adaptive
  *     Mesh Refinement On Forests of Octrees
@@ -1855,11 +3024,16 @@ t8_forest_ghost_receive (t8_forest_t forest, t8_forest_ghost_t ghost)
  *
  * verion 3 with top-down search
  * for unbalanced_version = -1
+ *
+ * If forest->ghost_width is greater than 1, the first layer is extended
+ * by t8_forest_ghost_add_layers. The ghosts of all layers are then exchanged
+ * relative to the ghosts of the first layer, such that only the elements of
+ * the added layers are sent.
  */
 void
 t8_forest_ghost_create_ext (t8_forest_t forest, int unbalanced_version)
 {
-  t8_forest_ghost_t   ghost = NULL;
+  t8_forest_ghost_t   ghost = NULL, first_layer = NULL;
   t8_ghost_mpi_send_info_t *send_info;
   sc_MPI_Request     *requests;
   int                 create_tree_array = 0, create_gfirst_desc_array = 0;
@@ -1918,15 +3092,59 @@ t8_forest_ghost_create_ext (t8_forest_t forest, int unbalanced_version)
       t8_forest_ghost_fill_remote (forest, ghost, unbalanced_version != 0);
     }
 
-    /* Start sending the remote elements */
-    send_info = t8_forest_ghost_send_start (forest, ghost, &requests);
-
-    /* Reveive the ghost elements from the remote processes */
-    t8_forest_ghost_receive (forest, ghost);
+    if (forest->ghost_width > 1) {
+      /* We need the ghosts of the first layer to find the face neighbors
+       * of our remote elements on other processes. */
+      send_info = t8_forest_ghost_send_start (forest, ghost, &requests);
+      t8_forest_ghost_receive (forest, ghost, NULL);
+      t8_forest_ghost_send_end (forest, ghost, send_info, requests);
+      /* Compute the remote elements of all layers. We keep the ghosts of
+       * the first layer, such that only the elements of the added layers
+       * are sent. */
+      first_layer = ghost;
+      t8_forest_ghost_ref (first_layer);
+      t8_forest_ghost_add_layers (forest);
+      ghost = forest->ghosts;
+    }
 
-    /* End sending the remote elements */
-    t8_forest_ghost_send_end (forest, ghost, send_info, requests);
+    if (forest->set_neighbor_collectives) {
+      /* Fill the send buffers in order of the remote ranks */
+      sc_array_sort (ghost->remote_processes, sc_int_compare);
+      send_info = first_layer != NULL ?
+        t8_forest_ghost_send_start_delta (forest, first_layer, ghost, NULL) :
+        t8_forest_ghost_send_start (forest, ghost, NULL);
+      /* Exchange and receive the ghost elements */
+      t8_forest_ghost_neighbor_exchange (forest, ghost, first_layer,
+                                         send_info);
+    }
+    else {
+      /* Start sending the remote elements */
+      send_info = first_layer != NULL ?
+        t8_forest_ghost_send_start_delta (forest, first_layer, ghost,
+                                          &requests) :
+        t8_forest_ghost_send_start (forest, ghost, &requests);
+
+      if (forest->set_ghost_async) {
+        /* The ghosts are received in t8_forest_ghost_wait */
+        t8_forest_ghost_set_pending (ghost, send_info, requests,
+                                     first_layer);
+      }
+      else {
+        /* Reveive the ghost elements from the remote processes */
+        t8_forest_ghost_receive (forest, ghost, first_layer);
 
+        /* End sending the remote elements */
+        t8_forest_ghost_send_end (forest, ghost, send_info, requests);
+      }
+    }
+    if (first_layer != NULL) {
+      t8_forest_ghost_unref (&first_layer);
+    }
+  }
+  else if (forest->set_neighbor_collectives
+           && forest->ghost_type != T8_GHOST_NONE) {
+    /* We have no remote processes, but take part in the collective exchange */
+    t8_forest_ghost_neighbor_exchange (forest, NULL, NULL, NULL);
   }
 
   if (create_element_array) {
@@ -1978,6 +3196,153 @@ t8_forest_ghost_create (t8_forest_t forest)
   }
 }
 
+/* Return true if the ghost layer of forest can be updated from the ghost
+ * layer of forest_from. This is the case if both forests have the same
+ * process regions, both ghost layers have width 1, and all processes with
+ * local elements in forest_from have constructed ghosts.
+ * This function is collective and returns the same value on all processes. */
+static int
+t8_forest_ghost_can_update (t8_forest_t forest, t8_forest_t forest_from)
+{
+  int                 can_update, mpiret;
+
+  T8_ASSERT (t8_forest_is_committed (forest));
+  if (forest_from == NULL || !t8_forest_is_committed (forest_from)
+      || forest->ghost_type != T8_GHOST_FACES
+      || forest_from->ghost_type != T8_GHOST_FACES
+      || forest->ghost_width != 1 || forest_from->ghost_width != 1
+      || forest->mpisize != forest_from->mpisize
+      || forest->tree_offsets == NULL || forest_from->tree_offsets == NULL
+      || forest->global_first_desc == NULL
+      || forest_from->global_first_desc == NULL) {
+    return 0;
+  }
+  /* The process regions must not have changed. These arrays are the same
+   * on all processes. */
+  T8_ASSERT (t8_shmem_array_get_elem_count (forest->tree_offsets)
+             == t8_shmem_array_get_elem_count (forest_from->tree_offsets));
+  if (memcmp (t8_shmem_array_get_array (forest->tree_offsets),
+              t8_shmem_array_get_array (forest_from->tree_offsets),
+              t8_shmem_array_get_elem_count (forest->tree_offsets)
+              * sizeof (t8_gloidx_t))
+      || memcmp (t8_shmem_array_get_array (forest->global_first_desc),
+                 t8_shmem_array_get_array (forest_from->global_first_desc),
+                 t8_shmem_array_get_elem_count (forest->global_first_desc)
+                 * sizeof (t8_linearidx_t))) {
+    return 0;
+  }
+  /* All processes need the ghosts of forest_from */
+  can_update = forest_from->ghosts != NULL
+    || t8_forest_get_local_num_elements (forest_from) == 0;
+  mpiret = sc_MPI_Allreduce (sc_MPI_IN_PLACE, &can_update, 1, sc_MPI_INT,
+                             sc_MPI_LAND, forest->mpicomm);
+  SC_CHECK_MPI (mpiret);
+  return can_update;
+}
+
+int
+t8_forest_ghost_create_incremental (t8_forest_t forest,
+                                    t8_forest_t forest_from)
+{
+  t8_forest_ghost_t   ghost = NULL;
+  t8_ghost_mpi_send_info_t *send_info;
+  sc_MPI_Request     *requests;
+
+  T8_ASSERT (t8_forest_is_committed (forest));
+  T8_ASSERT (forest->ghosts == NULL);
+
+  if (forest->mpisize == 1 || !t8_forest_ghost_can_update (forest,
+                                                           forest_from)) {
+    return 0;
+  }
+
+  t8_global_productionf ("Into t8_forest_ghost_create_incremental with %i"
+                         " local elements.\n",
+                         t8_forest_get_local_num_elements (forest));
+
+  if (forest->profile != NULL) {
+    /* If profiling is enabled, we measure the runtime of ghost_create */
+    forest->profile->ghost_runtime = -sc_MPI_Wtime ();
+    /* DO NOT DELETE THE FOLLOWING line.
+     * even if you do not want this output. It fixes a bug that occured on JUQUEEN, where the
+     * runtimes were computed to 0.
+     * Only delete the line, if you know what you are doing. */
+    t8_global_productionf ("Start ghost at %f  %f\n", sc_MPI_Wtime (),
+                           forest->profile->ghost_runtime);
+  }
+
+  if (t8_forest_get_local_num_elements (forest) > 0) {
+    /* Initialize the ghost structure */
+    t8_forest_ghost_init (&forest->ghosts, forest->ghost_type);
+    ghost = forest->ghosts;
+
+    /* Update the remote elements and processes */
+    t8_forest_ghost_fill_remote_incremental (forest, ghost, forest_from);
+    T8_ASSERT (forest_from->ghosts != NULL);
+
+    if (forest->set_neighbor_collectives) {
+      /* Fill the send buffers in order of the remote ranks */
+      sc_array_sort (ghost->remote_processes, sc_int_compare);
+      send_info =
+        t8_forest_ghost_send_start_delta (forest, forest_from->ghosts, ghost,
+                                          NULL);
+      /* Exchange the changes and build the ghosts from the old ghosts */
+      t8_forest_ghost_neighbor_exchange (forest, ghost, forest_from->ghosts,
+                                         send_info);
+    }
+    else {
+      /* Start sending the changes of the remote elements */
+      send_info =
+        t8_forest_ghost_send_start_delta (forest, forest_from->ghosts, ghost,
+                                          &requests);
+
+      if (forest->set_ghost_async) {
+        /* The ghosts are received in t8_forest_ghost_wait, until then
+         * we need the old ghosts. */
+        t8_forest_ghost_set_pending (ghost, send_info, requests,
+                                     forest_from->ghosts);
+      }
+      else {
+        /* Receive the changes and build the ghosts from the old ghosts */
+        t8_forest_ghost_receive (forest, ghost, forest_from->ghosts);
+
+        /* End sending the remote elements */
+        t8_forest_ghost_send_end (forest, ghost, send_info, requests);
+      }
+    }
+  }
+  else if (forest->set_neighbor_collectives) {
+    /* We have no remote processes, but take part in the collective exchange */
+    t8_forest_ghost_neighbor_exchange (forest, NULL, NULL, NULL);
+  }
+
+  if (forest->profile != NULL) {
+    /* If profiling is enabled, we measure the runtime of ghost_create */
+    forest->profile->ghost_runtime += sc_MPI_Wtime ();
+    /* We also store the number of ghosts and remotes */
+    if (ghost != NULL) {
+      forest->profile->ghosts_received = ghost->num_ghosts_elements;
+      forest->profile->ghosts_shipped = ghost->num_remote_elements;
+    }
+    else {
+      forest->profile->ghosts_received = 0;
+      forest->profile->ghosts_shipped = 0;
+    }
+    /* DO NOT DELETE THE FOLLOWING line.
+     * even if you do not want this output. It fixes a bug that occured on JUQUEEN, where the
+     * runtimes were computed to 0.
+     * Only delete the line, if you know what you are doing. */
+    t8_global_productionf ("End ghost at %f  %f\n", sc_MPI_Wtime (),
+                           forest->profile->ghost_runtime);
+  }
+
+  t8_global_productionf ("Done t8_forest_ghost_create_incremental with %i"
+                         " local elements and %i ghost elements.\n",
+                         t8_forest_get_local_num_elements (forest),
+                         t8_forest_get_num_ghosts (forest));
+  return 1;
+}
+
 void
 t8_forest_ghost_create_balanced_only (t8_forest_t forest)
 {
@@ -2287,6 +3652,74 @@ t8_forest_ghost_exchange_end (t8_ghost_data_exchange_t *data_exchange)
   T8_FREE (data_exchange);
 }
 
+/* Exchange the ghost data with neighborhood collectives over the graph
+ * communicator of the ghost layer.
+ * This function is collective, also processes without ghosts take part. */
+static void
+t8_forest_ghost_exchange_data_neighbor (t8_forest_t forest,
+                                        sc_array_t *element_data)
+{
+  t8_forest_ghost_t   ghost = forest->ghosts;
+  int                 num_remotes, iremote;
+  const int          *remotes;
+  char              **send_buffers, *recv_buffer;
+  int                *send_bytes, *recv_bytes, *recv_offsets;
+  size_t              ghost_start;
+  t8_ghost_process_hash_t lookup_proc, **pfound;
+#ifdef T8_ENABLE_DEBUG
+  int                 ret;
+#endif
+
+  T8_ASSERT (forest->ghost_comm != sc_MPI_COMM_NULL);
+  T8_ASSERT ((t8_locidx_t) element_data->elem_count ==
+             t8_forest_get_local_num_elements (forest)
+             + t8_forest_get_num_ghosts (forest));
+
+  num_remotes = ghost != NULL ? ghost->remote_processes->elem_count : 0;
+  remotes = num_remotes > 0 ? (int *) ghost->remote_processes->array : NULL;
+  send_buffers = T8_ALLOC (char *, num_remotes + 1);
+  send_bytes = T8_ALLOC (int, num_remotes + 1);
+  recv_bytes = T8_ALLOC (int, num_remotes + 1);
+  recv_offsets = T8_ALLOC (int, num_remotes + 1);
+  /* Fill the send buffers in the order of the graph communicator */
+  for (iremote = 0; iremote < num_remotes; iremote++) {
+    send_bytes[iremote] =
+      t8_forest_ghost_exchange_fill_send_buffer (forest, remotes[iremote],
+                                                 send_buffers + iremote,
+                                                 element_data);
+  }
+  recv_buffer =
+    t8_neighbor_comm_alltoallv (forest->ghost_comm, num_remotes,
+                                send_buffers, send_bytes, num_remotes,
+                                recv_bytes, recv_offsets);
+
+  /* Copy the received data to the ghost entries of element_data */
+  ghost_start = t8_forest_get_local_num_elements (forest);
+  for (iremote = 0; iremote < num_remotes; iremote++) {
+    lookup_proc.mpirank = remotes[iremote];
+#ifdef T8_ENABLE_DEBUG
+    ret =
+#else
+    (void)
+#endif
+      sc_hash_lookup (ghost->process_offsets, &lookup_proc,
+                      (void ***) &pfound);
+    T8_ASSERT (ret);
+    if (recv_bytes[iremote] > 0) {
+      memcpy (sc_array_index (element_data,
+                              ghost_start + (*pfound)->ghost_offset),
+              recv_buffer + recv_offsets[iremote], recv_bytes[iremote]);
+    }
+    T8_FREE (send_buffers[iremote]);
+  }
+
+  T8_FREE (recv_buffer);
+  T8_FREE (send_buffers);
+  T8_FREE (send_bytes);
+  T8_FREE (recv_bytes);
+  T8_FREE (recv_offsets);
+}
+
 void
 t8_forest_ghost_exchange_data (t8_forest_t forest, sc_array_t *element_data)
 {
@@ -2294,6 +3727,22 @@ t8_forest_ghost_exchange_data (t8_forest_t forest, sc_array_t *element_data)
 
   t8_debugf ("Entering ghost_exchange_data\n");
   T8_ASSERT (t8_forest_is_committed (forest));
+  T8_ASSERT (!t8_forest_ghost_is_pending (forest));
+
+  if (forest->ghost_comm != sc_MPI_COMM_NULL) {
+    /* The ghost layer was created with neighborhood collectives, all
+     * processes take part in the exchange. */
+    T8_ASSERT (element_data != NULL);
+    if (forest->profile != NULL) {
+      forest->profile->ghost_waittime = -sc_MPI_Wtime ();
+    }
+    t8_forest_ghost_exchange_data_neighbor (forest, element_data);
+    if (forest->profile != NULL) {
+      forest->profile->ghost_waittime += sc_MPI_Wtime ();
+    }
+    t8_debugf ("Finished ghost_exchange_data\n");
+    return;
+  }
 
   if (forest->ghosts == NULL) {
     /* This process has no ghosts */
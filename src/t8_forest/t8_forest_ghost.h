@@ -178,6 +178,41 @@ void                t8_forest_ghost_create_balanced_only (t8_forest_t forest);
 /* experimental version using the ghost_v3 algorithm */
 void                t8_forest_ghost_create_topdown (t8_forest_t forest);
 
+/** Create one layer of ghost elements for a forest that was adapted from
+ * another forest, by updating the ghost layer of that forest.
+ * Only the remote elements that changed during adapt are recomputed and only
+ * the changed ghost elements are sent, the others are copied from the ghosts
+ * of \a forest_from.
+ * This is only possible if the process regions of both forests are the same,
+ * thus not after partition. In this case nothing is done and the ghost layer
+ * has to be created with \ref t8_forest_ghost_create.
+ * This function is collective.
+ * \param [in,out]    forest      The committed forest. Must not have ghosts yet.
+ * \param [in]        forest_from The committed forest from which \a forest was
+ *                                adapted. Should have a ghost layer.
+ * \return            True if the ghost layer of \a forest was created,
+ *                    false otherwise.
+ */
+int                 t8_forest_ghost_create_incremental (t8_forest_t forest,
+                                                        t8_forest_t
+                                                        forest_from);
+
+/** Query whether the ghost layer of a forest is still being received.
+ * \param [in]        forest      The forest.
+ * \return            True if \a forest has a pending ghost layer,
+ *                    \see t8_forest_set_ghost_async.
+ */
+int                 t8_forest_ghost_is_pending (t8_forest_t forest);
+
+/** Complete the communication of a pending ghost layer.
+ * In contrast to \ref t8_forest_ghost_wait, a postponed geometry cache is not
+ * created. Use this function if the forest is destroyed or only used as the
+ * source of another forest.
+ * Does nothing if the ghost layer of \a forest is not pending.
+ * \param [in,out]    forest      The committed forest.
+ */
+void                t8_forest_ghost_complete (t8_forest_t forest);
+
 T8_EXTERN_C_END ();
 
 #endif /* !T8_FOREST_GHOST_H! */
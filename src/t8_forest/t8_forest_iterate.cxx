@@ -22,6 +22,7 @@
 
 #include <t8_forest/t8_forest_iterate.h>
 #include <t8_forest/t8_forest_types.h>
+#include <t8_forest/t8_forest_private.h>
 #include <t8_forest.h>
 #include <t8_element_cxx.hxx>
 
@@ -93,8 +94,10 @@ t8_forest_iterate_faces (t8_forest_t forest, t8_locidx_t ltreeid,
   t8_eclass_t         eclass;
   t8_element_t       *leaf, **face_children;
   int                 child_face, num_face_children, iface;
-  int                *child_indices;
-  size_t             *split_offsets, indexa, indexb, elem_count;
+  int                 child_indices[T8_ECLASS_MAX_CHILDREN];
+  size_t              split_offsets[T8_ECLASS_MAX_CHILDREN + 1];
+  size_t              indexa, indexb, elem_count;
+  t8_element_buffer_t face_children_buffer;
   t8_element_array_t  face_child_leafs;
 
   T8_ASSERT (t8_forest_is_committed (forest));
@@ -137,13 +140,11 @@ t8_forest_iterate_faces (t8_forest_t forest, t8_locidx_t ltreeid,
      * call iterate_faces */
     /* allocate the memory to store the face children */
     num_face_children = ts->t8_element_num_face_children (element, face);
-    face_children = T8_ALLOC (t8_element_t *, num_face_children);
-    ts->t8_element_new (num_face_children, face_children);
-    /* Memory for the child indices of the face children */
-    child_indices = T8_ALLOC (int, num_face_children);
-    /* Memory for the indices that split the leaf_elements array */
-    split_offsets =
-      T8_ALLOC (size_t, ts->t8_element_num_children (element) + 1);
+    T8_ASSERT (num_face_children <= T8_ECLASS_MAX_CHILDREN);
+    /* The face children live in a local buffer and not in the scheme's
+     * memory pool. */
+    face_children =
+      t8_element_buffer_init (&face_children_buffer, ts, num_face_children);
     /* Compute the face children */
     ts->t8_element_children_at_face (element, face, face_children,
                                      num_face_children, child_indices);
@@ -168,10 +169,7 @@ t8_forest_iterate_faces (t8_forest_t forest, t8_locidx_t ltreeid,
       }
     }
     /* clean-up */
-    ts->t8_element_destroy (num_face_children, face_children);
-    T8_FREE (face_children);
-    T8_FREE (child_indices);
-    T8_FREE (split_offsets);
+    t8_element_buffer_reset (&face_children_buffer);
   }
 }
 
@@ -196,11 +194,13 @@ t8_forest_search_recursion (t8_forest_t forest, t8_locidx_t ltreeid,
                             t8_locidx_t tree_lindex_of_first_leaf,
                             t8_forest_search_query_fn search_fn,
                             t8_forest_search_query_fn query_fn,
-                            sc_array_t *queries, sc_array_t *active_queries)
+                            sc_array_t *queries, sc_array_t *active_queries,
+                            char *children_buffer)
 {
-  t8_element_t       *leaf, **children;
+  t8_element_t       *leaf, *children[T8_ECLASS_MAX_CHILDREN];
   int                 num_children, ichild;
-  size_t             *split_offsets, indexa, indexb;
+  size_t              split_offsets[T8_ECLASS_MAX_CHILDREN + 1];
+  size_t              indexa, indexb;
   t8_element_array_t  child_leafs;
   size_t              elem_count;
   size_t              num_active;
@@ -288,12 +288,14 @@ t8_forest_search_recursion (t8_forest_t forest, t8_locidx_t ltreeid,
   /* Enter the recursion (the element is definitely not a leaf at this point) */
   /* We compute all children of E, compute their leaf arrays and
    * call search_recursion */
-  /* allocate the memory to store the children */
+  /* The children are stored in the part of the buffer that belongs to the
+   * element's level. Deeper levels of the recursion use the following parts. */
   num_children = ts->t8_element_num_children (element);
-  children = T8_ALLOC (t8_element_t *, num_children);
-  ts->t8_element_new (num_children, children);
-  /* Memory for the indices that split the leaf_elements array */
-  split_offsets = T8_ALLOC (size_t, num_children + 1);
+  T8_ASSERT (num_children <= T8_ECLASS_MAX_CHILDREN);
+  ts->t8_element_new_in_buffer (num_children, children_buffer
+                                + (size_t) ts->t8_element_level (element)
+                                * T8_ECLASS_MAX_CHILDREN
+                                * ts->t8_element_size (), children);
   /* Compute the children */
   ts->t8_element_children (element, num_children, children);
   /* Split the leafs array in portions belonging to the children of element */
@@ -312,13 +314,10 @@ t8_forest_search_recursion (t8_forest_t forest, t8_locidx_t ltreeid,
                                   ts, &child_leafs,
                                   indexa + tree_lindex_of_first_leaf,
                                   search_fn, query_fn, queries,
-                                  new_active_queries);
+                                  new_active_queries, children_buffer);
     }
   }
   /* clean-up */
-  ts->t8_element_destroy (num_children, children);
-  T8_FREE (children);
-  T8_FREE (split_offsets);
   if (num_active > 0) {
     sc_array_destroy (new_active_queries);
   }
@@ -336,6 +335,8 @@ t8_forest_search_tree (t8_forest_t forest, t8_locidx_t ltreeid,
   t8_element_t       *nca, *first_el, *last_el;
   t8_element_array_t *leaf_elements;
   sc_array_t         *active_queries = NULL;
+  char               *buffer;
+  size_t              buffer_size;
 
   /* Get the element class, scheme and leaf elements of this tree */
   eclass = t8_forest_get_eclass (forest, ltreeid);
@@ -350,8 +351,14 @@ t8_forest_search_tree (t8_forest_t forest, t8_locidx_t ltreeid,
     t8_element_array_index_locidx (leaf_elements,
                                    t8_element_array_get_count (leaf_elements)
                                    - 1);
+  /* All elements of the search live in one buffer, such that the search does
+   * not allocate elements from the scheme. The first element is the nearest
+   * common ancestor, followed by the children of one element for each level. */
+  buffer_size = (1 + (size_t) (ts->t8_element_maxlevel () + 1)
+                 * T8_ECLASS_MAX_CHILDREN) * ts->t8_element_size ();
+  buffer = T8_ALLOC (char, buffer_size);
   /* Compute their nearest common ancestor */
-  ts->t8_element_new (1, &nca);
+  ts->t8_element_new_in_buffer (1, buffer, &nca);
   ts->t8_element_nca (first_el, last_el, nca);
 
   /* If we have queries build a list of all active queries,
@@ -369,12 +376,14 @@ t8_forest_search_tree (t8_forest_t forest, t8_locidx_t ltreeid,
   /* Start the top-down search */
   t8_forest_search_recursion (forest, ltreeid, eclass, nca, ts, leaf_elements,
                               0, search_fn, query_fn, queries,
-                              active_queries);
+                              active_queries,
+                              buffer + ts->t8_element_size ());
 
   /* Clean up the array of active queries */
   if (queries != NULL) {
     sc_array_destroy (active_queries);
   }
+  T8_FREE (buffer);
 }
 
 void
@@ -389,6 +398,118 @@ t8_forest_search (t8_forest_t forest, t8_forest_search_query_fn search_fn,
   }
 }
 
+/* The state of t8_forest_locate_points that is passed to the search
+ * callbacks as the forest's user data. */
+typedef struct
+{
+  double              tolerance;        /* The tolerance for the inside test. */
+  t8_locidx_t        *element_index;    /* For each point the index of its element or -1. */
+  double             *ref_coords;       /* For each point its reference coordinates. */
+  double              bounds[6];        /* The bounding box of the current element. */
+  t8_locidx_t         ltreeid;  /* The tree of the current element. */
+  int                 tree_is_linear;   /* True if the current tree has a linear geometry. */
+} t8_forest_locate_points_t;
+
+/* Compute the bounding box of each element of the search, the
+ * query function tests all active points against it.
+ * Whether the geometry of the tree is linear is only queried once per tree. */
+static int
+t8_forest_locate_points_search (t8_forest_t forest, t8_locidx_t ltreeid,
+                                const t8_element_t *element,
+                                const int is_leaf,
+                                t8_element_array_t *leaf_elements,
+                                t8_locidx_t tree_leaf_index, void *query,
+                                size_t query_index)
+{
+  t8_forest_locate_points_t *locate =
+    (t8_forest_locate_points_t *) t8_forest_get_user_data (forest);
+
+  if (ltreeid != locate->ltreeid) {
+    /* We entered a new tree */
+    locate->ltreeid = ltreeid;
+    locate->tree_is_linear = t8_forest_tree_is_linear (forest, ltreeid);
+  }
+  t8_forest_element_bounding_box_ext (forest, ltreeid, element,
+                                      locate->bounds, locate->tree_is_linear);
+  return 1;
+}
+
+static int
+t8_forest_locate_points_query (t8_forest_t forest, t8_locidx_t ltreeid,
+                               const t8_element_t *element,
+                               const int is_leaf,
+                               t8_element_array_t *leaf_elements,
+                               t8_locidx_t tree_leaf_index, void *query,
+                               size_t query_index)
+{
+  t8_forest_locate_points_t *locate =
+    (t8_forest_locate_points_t *) t8_forest_get_user_data (forest);
+  const double       *point = (const double *) query;
+  int                 idim, is_inside;
+
+  if (locate->element_index[query_index] >= 0) {
+    /* The point was already found in another element. */
+    return 0;
+  }
+  for (idim = 0; idim < 3; idim++) {
+    if (point[idim] < locate->bounds[2 * idim] - locate->tolerance
+        || point[idim] > locate->bounds[2 * idim + 1] + locate->tolerance) {
+      return 0;
+    }
+  }
+  if (!is_leaf) {
+    /* Continue the search for this point in the children. */
+    return 1;
+  }
+  /* The point is inside the element's bounding box, we directly
+   * invert the geometry. */
+  t8_forest_element_points_reference_coords_ext (forest, ltreeid, element,
+                                                 point, 1, locate->tolerance,
+                                                 locate->ref_coords +
+                                                 3 * query_index, &is_inside,
+                                                 NULL);
+  if (is_inside) {
+    locate->element_index[query_index] =
+      t8_forest_get_tree_element_offset (forest, ltreeid) + tree_leaf_index;
+  }
+  return is_inside;
+}
+
+void
+t8_forest_locate_points (t8_forest_t forest, const double *points,
+                         size_t num_points, double tolerance,
+                         t8_locidx_t *element_index, double *ref_coords)
+{
+  t8_forest_locate_points_t locate;
+  sc_array_t          queries;
+  void               *user_data;
+  size_t              ipoint;
+
+  T8_ASSERT (t8_forest_is_committed (forest));
+
+  for (ipoint = 0; ipoint < num_points; ipoint++) {
+    element_index[ipoint] = -1;
+  }
+  if (num_points == 0) {
+    return;
+  }
+  locate.tolerance = tolerance;
+  locate.element_index = element_index;
+  locate.ref_coords = ref_coords;
+  locate.ltreeid = -1;
+  locate.tree_is_linear = 0;
+  /* The points are the queries of the search. */
+  sc_array_init_data (&queries, (void *) points, 3 * sizeof (double),
+                      num_points);
+  /* We pass our state as the forest's user data and restore the
+   * user's data afterwards. */
+  user_data = t8_forest_get_user_data (forest);
+  t8_forest_set_user_data (forest, &locate);
+  t8_forest_search (forest, t8_forest_locate_points_search,
+                    t8_forest_locate_points_query, &queries);
+  t8_forest_set_user_data (forest, user_data);
+}
+
 void
 t8_forest_iterate_replace (t8_forest_t forest_new,
                            t8_forest_t forest_old,
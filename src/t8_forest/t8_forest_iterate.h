@@ -103,6 +103,32 @@ void                t8_forest_search (t8_forest_t forest,
                                       t8_forest_search_query_fn query_fn,
                                       sc_array_t *queries);
 
+/** Find the local leaf elements that contain given points.
+ * This is a \ref t8_forest_search with the points as queries.
+ * The bounding boxes of the elements (\ref t8_forest_element_bounding_box)
+ * restrict the search to the elements that may contain a point.
+ * For the leaf elements the geometry is inverted with
+ * \ref t8_forest_element_points_reference_coords. Thus, points can be located
+ * in forests with curved geometries.
+ * \param [in]  forest        A committed forest.
+ * \param [in]  points        Array of 3 * \a num_points coordinates, the i-th point
+ *                            starts at entry 3*i.
+ * \param [in]  num_points    The number of points.
+ * \param [in]  tolerance     The distance that a point may have to an element.
+ * \param [out] element_index Array of \a num_points entries. On output the local index
+ *                            of the first leaf element that contains the point, or -1
+ *                            if no local element contains it.
+ * \param [out] ref_coords    Array of 3 * \a num_points entries. On output the reference
+ *                            coordinates of each found point in its element.
+ * \note The forest's user data is used during the search and restored afterwards.
+ */
+void                t8_forest_locate_points (t8_forest_t forest,
+                                             const double *points,
+                                             size_t num_points,
+                                             double tolerance,
+                                             t8_locidx_t *element_index,
+                                             double *ref_coords);
+
 /** Given two forest where the elemnts in one forest are either direct children or
  * parents of the elements in the other forest
  * compare the two forests and for each refined element or coarsened
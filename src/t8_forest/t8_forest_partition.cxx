@@ -25,6 +25,7 @@
 #include <t8_forest/t8_forest_private.h>
 #include <t8_forest.h>
 #include <t8_cmesh/t8_cmesh_offset.h>
+#include <t8_data/t8_neighbor_comm.h>
 #include <t8_element_cxx.hxx>
 
 /* We want to export the whole implementation to be callable from "C" */
@@ -325,15 +326,334 @@ t8_forest_partition_create_tree_offsets (t8_forest_t forest)
   }
 }
 
+/* Find the owner of a given element.
+ */
+static int
+t8_forest_partition_owner_of_element (int mpisize, t8_gloidx_t gelement,
+                                      const t8_gloidx_t *offset)
+{
+  /* Tree offsets are stored similar enough that we can exploit their function */
+  /* In the element offset logic, an element cannot be owned by more than one
+   * process, thus any owner must be the unique owner. */
+  return t8_offset_any_owner_of_tree (mpisize, gelement, offset);
+}
+
+/* The information about an element that we need to decide whether a
+ * partition boundary splits a family of elements. */
+typedef struct
+{
+  t8_gloidx_t         gtree_id; /* The global id of the element's tree */
+  int8_t              level;    /* The refinement level of the element */
+  int8_t              child_id; /* The child id of the element */
+  int8_t              num_siblings;     /* The number of siblings of the element */
+} t8_forest_partition_family_info_t;
+
+/* Fill the family information of a local element of a committed forest. */
+static void
+t8_forest_partition_family_info (t8_forest_t forest, t8_locidx_t lelement,
+                                 t8_forest_partition_family_info_t *info)
+{
+  t8_locidx_t         ltreeid;
+  t8_element_t       *element;
+  t8_eclass_scheme_c *ts;
+
+  element = t8_forest_get_element (forest, lelement, &ltreeid);
+  T8_ASSERT (element != NULL);
+  ts = t8_forest_get_eclass_scheme (forest,
+                                    t8_forest_get_tree_class (forest,
+                                                              ltreeid));
+  /* Clear the padding bytes, since we send the struct as raw bytes. */
+  memset (info, 0, sizeof (*info));
+  info->gtree_id = t8_forest_global_tree_id (forest, ltreeid);
+  info->level = ts->t8_element_level (element);
+  if (info->level > 0) {
+    info->child_id = ts->t8_element_child_id (element);
+    info->num_siblings = ts->t8_element_num_siblings (element);
+  }
+}
+
+/* Given the new element offsets, return the smallest index i in
+ * {1, ..., mpisize} with offset_new[i] >= gelement. */
+static int
+t8_forest_partition_first_boundary (const t8_gloidx_t *offset_new,
+                                    int mpisize, t8_gloidx_t gelement)
+{
+  int                 low = 1, high = mpisize, mid;
+
+  while (low < high) {
+    mid = low + (high - low) / 2;
+    if (offset_new[mid] < gelement) {
+      low = mid + 1;
+    }
+    else {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+/* Return true if at least one of the inner boundaries offset_new[1], ...,
+ * offset_new[mpisize - 1] is an element of rank in the old partition. */
+static int
+t8_forest_partition_owns_boundary (const t8_gloidx_t *offset_old,
+                                   const t8_gloidx_t *offset_new,
+                                   int mpisize, int rank)
+{
+  int                 first;
+
+  if (t8_forest_partition_empty (offset_old, rank)) {
+    return 0;
+  }
+  first = t8_forest_partition_first_boundary (offset_new, mpisize,
+                                              offset_old[rank]);
+  return first < mpisize && offset_new[first] < offset_old[rank + 1];
+}
+
+/* The family information of a rank that owns partition boundaries.
+ * Elements outside of the local range are received from the neighbors
+ * and stored in low and high. */
+typedef struct
+{
+  t8_forest_t         forest;   /* The forest to be partitioned */
+  t8_gloidx_t         first_local;      /* The first local element */
+  t8_gloidx_t         end_local;        /* One after the last local element */
+  t8_gloidx_t         first_halo;       /* The first element stored in low */
+  t8_forest_partition_family_info_t low[T8_ECLASS_MAX_CHILDREN];
+  t8_forest_partition_family_info_t high[T8_ECLASS_MAX_CHILDREN];
+} t8_forest_partition_family_halo_t;
+
+/* Get the family information of a global element that is either local
+ * or in the halo. */
+static void
+t8_forest_partition_family_halo_get (t8_forest_partition_family_halo_t *halo,
+                                     t8_gloidx_t gelement,
+                                     t8_forest_partition_family_info_t *info)
+{
+  if (gelement < halo->first_local) {
+    T8_ASSERT (halo->first_halo <= gelement);
+    *info = halo->low[gelement - halo->first_halo];
+  }
+  else if (gelement >= halo->end_local) {
+    T8_ASSERT (gelement - halo->end_local < T8_ECLASS_MAX_CHILDREN);
+    *info = halo->high[gelement - halo->end_local];
+  }
+  else {
+    t8_forest_partition_family_info (halo->forest,
+                                     gelement - halo->first_local, info);
+  }
+}
+
+/* Given a partition boundary, that is the first element of a process,
+ * return the closest position that does not split a family of elements.
+ * The family of the boundary element consists of the num_siblings
+ * elements starting at boundary - child_id. Since the leaf elements are
+ * ordered along the space-filling curve, these elements form a family
+ * precisely if they are in the same tree, have the same level and the
+ * child ids 0, 1, ..., num_siblings - 1. This also holds for pyramids
+ * whose families consist of pyramids and tetrahedra. */
+static t8_gloidx_t
+t8_forest_partition_align_boundary (t8_forest_partition_family_halo_t *halo,
+                                    t8_gloidx_t boundary,
+                                    t8_gloidx_t global_num_elements)
+{
+  t8_forest_partition_family_info_t info, sibling;
+  t8_gloidx_t         first_sibling;
+  int                 isibling;
+
+  t8_forest_partition_family_halo_get (halo, boundary, &info);
+  if (info.level == 0 || info.child_id == 0) {
+    /* The boundary element is the first of its family or has none */
+    return boundary;
+  }
+  first_sibling = boundary - info.child_id;
+  if (first_sibling < 0
+      || first_sibling + info.num_siblings > global_num_elements) {
+    return boundary;
+  }
+  for (isibling = 0; isibling < info.num_siblings; isibling++) {
+    t8_forest_partition_family_halo_get (halo, first_sibling + isibling,
+                                         &sibling);
+    if (sibling.gtree_id != info.gtree_id || sibling.level != info.level
+        || sibling.child_id != isibling) {
+      /* The siblings are not all leaves, we cannot coarsen here */
+      return boundary;
+    }
+  }
+  /* The boundary splits a family, we move it to the start or the end of
+   * the family, whichever is closer. */
+  if (boundary - first_sibling <= first_sibling + info.num_siblings - boundary) {
+    return first_sibling;
+  }
+  return first_sibling + info.num_siblings;
+}
+
+/* Move each inner boundary of the new element offsets to the closest
+ * start of a family, such that each family of leaf elements is owned by
+ * a single process after partitioning. Each boundary is handled by the
+ * process that owns its element in forest_from. This process receives
+ * the information of the up to T8_ECLASS_MAX_CHILDREN - 1 elements before
+ * and after its local elements from its neighbors.
+ * This function is collective. */
+static void
+t8_forest_partition_align_families (t8_forest_t forest_from,
+                                    t8_gloidx_t *offset_new)
+{
+  t8_forest_partition_family_halo_t halo;
+  t8_forest_partition_family_info_t *send_buffer;
+  sc_MPI_Comm         comm = forest_from->mpicomm;
+  sc_MPI_Request     *requests;
+  const int           mpisize = forest_from->mpisize;
+  const int           mpirank = forest_from->mpirank;
+  const t8_gloidx_t   num_elements = forest_from->global_num_elements;
+  const t8_gloidx_t   max_shift = T8_ECLASS_MAX_CHILDREN - 1;
+  const t8_gloidx_t  *offset_old;
+  t8_gloidx_t        *aligned, *local_aligned, halo_end, first, end;
+  t8_gloidx_t         gelement;
+  int                *counts, *displs;
+  int                 iproc, first_proc, last_proc, iboundary, irank;
+  int                 num_requests = 0, num_sends = 0, mpiret;
+  int                 num_aligned = 0;
+
+  offset_old = t8_shmem_array_get_gloidx_array (forest_from->element_offsets);
+  halo.forest = forest_from;
+  halo.first_local = offset_old[mpirank];
+  halo.end_local = offset_old[mpirank + 1];
+  halo.first_halo = SC_MAX (halo.first_local - max_shift, 0);
+
+  /* We receive from at most max_shift processes on each side and send to
+   * at most max_shift processes on each side, each of them at most max_shift
+   * elements. */
+  requests = T8_ALLOC (sc_MPI_Request, 4 * max_shift);
+  send_buffer = T8_ALLOC (t8_forest_partition_family_info_t,
+                          2 * max_shift * max_shift);
+
+  /* Post the receives for the halo of our boundaries */
+  if (t8_forest_partition_owns_boundary (offset_old, offset_new, mpisize,
+                                         mpirank)) {
+    halo_end = SC_MIN (halo.end_local + max_shift, num_elements);
+    first_proc = t8_forest_partition_owner_of_element (mpisize,
+                                                       halo.first_halo,
+                                                       offset_old);
+    last_proc = t8_forest_partition_owner_of_element (mpisize, halo_end - 1,
+                                                      offset_old);
+    for (iproc = first_proc; iproc <= last_proc; iproc++) {
+      if (iproc == mpirank || t8_forest_partition_empty (offset_old, iproc)) {
+        continue;
+      }
+      first = SC_MAX (halo.first_halo, offset_old[iproc]);
+      end = SC_MIN (halo_end, offset_old[iproc + 1]);
+      T8_ASSERT (first < end);
+      mpiret = sc_MPI_Irecv (iproc < mpirank ?
+                             &halo.low[first - halo.first_halo] :
+                             &halo.high[first - halo.end_local],
+                             (end - first) *
+                             sizeof (t8_forest_partition_family_info_t),
+                             sc_MPI_BYTE, iproc, T8_MPI_PARTITION_FAMILY,
+                             comm, requests + num_requests++);
+      SC_CHECK_MPI (mpiret);
+    }
+  }
+
+  /* Send our elements to the processes in whose halo they are */
+  if (!t8_forest_partition_empty (offset_old, mpirank)) {
+    first_proc = t8_forest_partition_owner_of_element (mpisize,
+                                                       SC_MAX
+                                                       (halo.first_local -
+                                                        max_shift, 0),
+                                                       offset_old);
+    last_proc = t8_forest_partition_owner_of_element (mpisize,
+                                                      SC_MIN (halo.end_local
+                                                              - 1 +
+                                                              max_shift,
+                                                              num_elements -
+                                                              1), offset_old);
+    for (iproc = first_proc; iproc <= last_proc; iproc++) {
+      if (iproc == mpirank
+          || !t8_forest_partition_owns_boundary (offset_old, offset_new,
+                                                 mpisize, iproc)) {
+        continue;
+      }
+      /* Intersect the halo of iproc with our elements */
+      first = SC_MAX (offset_old[iproc] - max_shift, halo.first_local);
+      end = SC_MIN (offset_old[iproc + 1] + max_shift, halo.end_local);
+      T8_ASSERT (first < end && end - first <= max_shift);
+      for (gelement = first; gelement < end; gelement++) {
+        t8_forest_partition_family_info (forest_from,
+                                         gelement - halo.first_local,
+                                         send_buffer + num_sends
+                                         + (gelement - first));
+      }
+      mpiret = sc_MPI_Isend (send_buffer + num_sends, (end - first) *
+                             sizeof (t8_forest_partition_family_info_t),
+                             sc_MPI_BYTE, iproc, T8_MPI_PARTITION_FAMILY,
+                             comm, requests + num_requests++);
+      SC_CHECK_MPI (mpiret);
+      num_sends += end - first;
+      T8_ASSERT (num_sends <= 2 * max_shift * max_shift);
+    }
+  }
+  mpiret = sc_MPI_Waitall (num_requests, requests, sc_MPI_STATUSES_IGNORE);
+  SC_CHECK_MPI (mpiret);
+
+  /* Count the boundaries of each process. Since the offsets are sorted,
+   * the boundaries of the processes are in process order. */
+  counts = T8_ALLOC_ZERO (int, mpisize);
+  displs = T8_ALLOC (int, mpisize);
+  for (iboundary = 1, irank = 0; iboundary < mpisize; iboundary++) {
+    while (offset_new[iboundary] >= offset_old[irank + 1]) {
+      irank++;
+    }
+    counts[irank]++;
+  }
+  displs[0] = 0;
+  for (irank = 1; irank < mpisize; irank++) {
+    displs[irank] = displs[irank - 1] + counts[irank - 1];
+  }
+  T8_ASSERT (displs[mpisize - 1] + counts[mpisize - 1] == mpisize - 1);
+
+  /* Align our boundaries */
+  local_aligned = T8_ALLOC (t8_gloidx_t, counts[mpirank] + 1);
+  for (iboundary = 0; iboundary < counts[mpirank]; iboundary++) {
+    const t8_gloidx_t   boundary = offset_new[1 + displs[mpirank] + iboundary];
+    local_aligned[iboundary] =
+      t8_forest_partition_align_boundary (&halo, boundary, num_elements);
+    if (local_aligned[iboundary] != boundary) {
+      num_aligned++;
+    }
+  }
+  t8_debugf ("Moved %i partition boundaries to family starts.\n",
+             num_aligned);
+
+  /* Gather all aligned boundaries */
+  aligned = T8_ALLOC (t8_gloidx_t, mpisize - 1);
+  mpiret = sc_MPI_Allgatherv (local_aligned, counts[mpirank],
+                              T8_MPI_GLOIDX, aligned, counts, displs,
+                              T8_MPI_GLOIDX, comm);
+  SC_CHECK_MPI (mpiret);
+  for (iboundary = 1; iboundary < mpisize; iboundary++) {
+    offset_new[iboundary] = aligned[iboundary - 1];
+    T8_ASSERT (offset_new[iboundary - 1] <= offset_new[iboundary]);
+  }
+
+  T8_FREE (aligned);
+  T8_FREE (local_aligned);
+  T8_FREE (counts);
+  T8_FREE (displs);
+  T8_FREE (send_buffer);
+  T8_FREE (requests);
+}
+
 /* Calculate the new element_offset for forest from
  * the element in forest->set_from assuming a partition without
- * element weights */
+ * element weights.
+ * If forest->set_for_coarsening is true, the offsets are moved such
+ * that no family of elements is split between processes. */
 static void
 t8_forest_partition_compute_new_offset (t8_forest_t forest)
 {
   t8_forest_t         forest_from;
   sc_MPI_Comm         comm;
-  t8_gloidx_t         new_first_element_id;
+  t8_gloidx_t        *new_offsets;
   int                 i, mpiret, mpisize;
 
   T8_ASSERT (t8_forest_is_initialized (forest));
@@ -343,43 +663,41 @@ t8_forest_partition_compute_new_offset (t8_forest_t forest)
   comm = forest->mpicomm;
 
   T8_ASSERT (forest->element_offsets == NULL);
+  mpiret = sc_MPI_Comm_size (comm, &mpisize);
+  SC_CHECK_MPI (mpiret);
+
+  new_offsets = T8_ALLOC (t8_gloidx_t, mpisize + 1);
+  for (i = 0; i < mpisize; i++) {
+    /* Calculate the first element index for each process. We convert to doubles to
+     * prevent overflow */
+    new_offsets[i] =
+      (((double) i *
+        (long double) forest_from->global_num_elements) / (double) mpisize);
+    T8_ASSERT (0 <= new_offsets[i] &&
+               new_offsets[i] < forest_from->global_num_elements);
+  }
+  new_offsets[mpisize] = forest_from->global_num_elements;
+
+  if (forest->set_for_coarsening && mpisize > 1
+      && forest_from->global_num_elements > 0) {
+    /* Move the boundaries such that all families are process local */
+    t8_forest_partition_align_families (forest_from, new_offsets);
+  }
+
   /* Set the shmem array type to comm */
   t8_shmem_init (comm);
   t8_shmem_set_type (comm, T8_SHMEM_BEST_TYPE);
   /* Initialize the shmem array */
   t8_shmem_array_init (&forest->element_offsets, sizeof (t8_gloidx_t),
                        forest->mpisize + 1, comm);
-  mpiret = sc_MPI_Comm_size (comm, &mpisize);
-  SC_CHECK_MPI (mpiret);
-
   if (t8_shmem_array_start_writing (forest->element_offsets)) {
     t8_gloidx_t        *element_offsets =
       t8_shmem_array_get_gloidx_array_for_writing (forest->element_offsets);
-    for (i = 0; i < mpisize; i++) {
-      /* Calculate the first element index for each process. We convert to doubles to
-       * prevent overflow */
-      new_first_element_id =
-        (((double) i *
-          (long double) forest_from->global_num_elements) / (double) mpisize);
-      T8_ASSERT (0 <= new_first_element_id &&
-                 new_first_element_id < forest_from->global_num_elements);
-      element_offsets[i] = new_first_element_id;
-    }
-    element_offsets[forest->mpisize] = forest->global_num_elements;
+    memcpy (element_offsets, new_offsets,
+            (mpisize + 1) * sizeof (t8_gloidx_t));
   }
   t8_shmem_array_end_writing (forest->element_offsets);
-}
-
-/* Find the owner of a given element.
- */
-static int
-t8_forest_partition_owner_of_element (int mpisize, t8_gloidx_t gelement,
-                                      const t8_gloidx_t *offset)
-{
-  /* Tree offsets are stored similar enough that we can exploit their function */
-  /* In the element offset logic, an element cannot be owned by more than one
-   * process, thus any owner must be the unique owner. */
-  return t8_offset_any_owner_of_tree (mpisize, gelement, offset);
+  T8_FREE (new_offsets);
 }
 
 /* Compute the first and last rank that we need to receive elements from */
@@ -506,10 +824,14 @@ t8_forest_partition_tree_first_last_el (t8_tree_t tree,
  *                              we would send elements from to the next process.
  * \param [in]  first_element_send The local id of the first element that we need to send.
  * \param [in]  last_element_send The local id of the last element that we need to send.
+ * \param [in]  compress        If true, the elements are packed with \ref t8_element_array_pack.
  */
 /* The send buffer will look like this:
  *
  * | number of trees | padding | tree_1 info | ... | tree_n info | tree_1 elements | ... | tree_n elements |
+ *
+ * If compress is true, the elements of each tree are packed and the buffer
+ * may be larger than buffer_alloc.
  */
 /* If send_data is true, data must be an array of length forest_from->num_local elements
  * and instead of shipping the elements of forest_from, we ship the data entries. */
@@ -518,7 +840,8 @@ t8_forest_partition_fill_buffer (t8_forest_t forest_from,
                                  char **send_buffer, int *buffer_alloc,
                                  t8_locidx_t *current_tree,
                                  t8_locidx_t first_element_send,
-                                 t8_locidx_t last_element_send)
+                                 t8_locidx_t last_element_send,
+                                 const int compress)
 {
   t8_locidx_t         num_elements_send;
   t8_tree_t           tree;
@@ -549,8 +872,13 @@ t8_forest_partition_fill_buffer (t8_forest_t forest_from,
     /* We now know how many elements this tree will send */
     num_elements_send = last_tree_element - first_tree_element + 1;
     T8_ASSERT (num_elements_send > 0);
-    elem_size = t8_element_array_get_size (&tree->elements);
-    element_alloc += num_elements_send * elem_size;
+    if (compress) {
+      element_alloc += t8_element_array_pack_bound (num_elements_send);
+    }
+    else {
+      elem_size = t8_element_array_get_size (&tree->elements);
+      element_alloc += num_elements_send * elem_size;
+    }
     current_element += num_elements_send;
     num_trees_send++;
     tree_id++;
@@ -601,6 +929,13 @@ t8_forest_partition_fill_buffer (t8_forest_t forest_from,
     tree_info->num_elements = num_elements_send;
     tree_info_pos += sizeof (t8_forest_partition_tree_info_t);
     /* We can now fill the send buffer with all elements of that tree */
+    if (compress) {
+      element_pos += t8_element_array_pack (&tree->elements,
+                                            first_tree_element,
+                                            num_elements_send,
+                                            *send_buffer + element_pos);
+      continue;
+    }
     pfirst_element =
       t8_element_array_index_locidx (&tree->elements, first_tree_element);
     elem_size = t8_element_array_get_size (&tree->elements);
@@ -608,8 +943,10 @@ t8_forest_partition_fill_buffer (t8_forest_t forest_from,
             num_elements_send * elem_size);
     element_pos += num_elements_send * elem_size;
   }
+  T8_ASSERT (element_pos <= byte_alloc);
   *current_tree += num_trees_send - 1 + last_element_is_last_tree_element;
-  *buffer_alloc = byte_alloc;
+  /* We only send the bytes that we actually wrote */
+  *buffer_alloc = element_pos;
   t8_debugf ("Post send of %i trees\n", num_trees_send);
 }
 
@@ -651,13 +988,15 @@ t8_forest_partition_fill_buffer_data (t8_forest_t forest_from,
 /* Carry out all sending of elements */
 /* If send_data is true, the elements are not send but element data
  * stored in an sc_array of length forest->set_from->num_local_elements.
+ * If send_bytes is not NULL, the messages are not posted but only the
+ * send buffers are filled and their sizes stored in send_bytes.
  * Returns true if we sent to ourselves. */
 static int
 t8_forest_partition_sendloop (t8_forest_t forest, const int send_first,
                               const int send_last, sc_MPI_Request ** requests,
                               int *num_request_alloc, char ***send_buffer,
                               const int send_data, const sc_array_t *data_in,
-                              size_t *byte_to_self)
+                              size_t *byte_to_self, int *send_bytes)
 {
   int                 iproc, mpiret;
   t8_gloidx_t         gfirst_element_send, glast_element_send;
@@ -754,7 +1093,8 @@ t8_forest_partition_sendloop (t8_forest_t forest, const int send_first,
         t8_forest_partition_fill_buffer (forest_from,
                                          buffer, &buffer_alloc,
                                          &current_tree, first_element_send,
-                                         last_element_send);
+                                         last_element_send,
+                                         forest->set_compress_messages);
       }
       else {
         T8_ASSERT (send_data);
@@ -764,9 +1104,13 @@ t8_forest_partition_sendloop (t8_forest_t forest, const int send_first,
                                               first_element_send,
                                               last_element_send, data_in);
       }
+      if (send_bytes != NULL) {
+        /* The message is sent later by a neighborhood collective */
+        send_bytes[iproc - send_first] = buffer_alloc;
+      }
       /* Post the MPI Send.
        * TODO: This will also send to ourselves if proc==mpirank */
-      if (iproc != forest->mpirank) {
+      if (iproc != forest->mpirank && send_bytes == NULL) {
         t8_debugf ("Post send of %li elements (%i bytes) to process %i\n",
                    (long) num_elements_send, buffer_alloc, iproc);
         mpiret = sc_MPI_Isend (*buffer, buffer_alloc, sc_MPI_BYTE, iproc,
@@ -775,7 +1119,9 @@ t8_forest_partition_sendloop (t8_forest_t forest, const int send_first,
         SC_CHECK_MPI (mpiret);
       }
       else {
-        *byte_to_self = buffer_alloc;
+        if (iproc == forest->mpirank) {
+          *byte_to_self = buffer_alloc;
+        }
         *(*requests + iproc - send_first) = sc_MPI_REQUEST_NULL;
       }
       if (!send_data && forest->profile != NULL) {
@@ -805,14 +1151,15 @@ t8_forest_partition_sendloop (t8_forest_t forest, const int send_first,
  * \param [in]  forest      The new forest.
  * \param [in]  comm        The MPI communicator.
  * \param [in]  proc        The rank from which we receive.
- * \param [in]  status      MPI status with which we probed for the message.
+ * \param [in]  status      MPI status with which we probed for the message,
+ *                          or NULL if the message was already received.
  * \param [in,out] last_loc_elem_recv On input the local index of the last element
  *                          that was received by this rank. Updated on output.
  * \param [out] data_out    The received data.
- * \param [in]  sent_to_self If proc equals the rank of this process, the message
- *                          should be passed as this parameter.
- * \param [in]  byte_to_self If proc equals the rank of this process, the number of
- *                          bytes in the message.
+ * \param [in]  sent_to_self If proc equals the rank of this process or \a status
+ *                          is NULL, the message should be passed as this parameter.
+ * \param [in]  byte_to_self If proc equals the rank of this process or \a status
+ *                          is NULL, the number of bytes in the message.
  * It is important, that we receive the messages in order to properly fill the
  * data_out array.
  */
@@ -827,6 +1174,8 @@ t8_forest_partition_recv_message_data (t8_forest_t forest, sc_MPI_Comm comm,
   int                 mpiret, recv_bytes;
   char               *recv_buffer;
   size_t              data_offset;
+  const int           message_given = status == NULL
+    || proc == forest->mpirank;
 
   /* data_out must have the correct dimensions */
   T8_ASSERT (data_out != NULL);
@@ -836,7 +1185,7 @@ t8_forest_partition_recv_message_data (t8_forest_t forest, sc_MPI_Comm comm,
    *       Put duplicated code in function */
   /* further assertions */
 
-  if (proc != forest->mpirank) {
+  if (!message_given) {
     T8_ASSERT (proc == status->MPI_SOURCE);
     T8_ASSERT (status->MPI_TAG == T8_MPI_PARTITION_FOREST);
 
@@ -867,7 +1216,7 @@ t8_forest_partition_recv_message_data (t8_forest_t forest, sc_MPI_Comm comm,
   T8_ASSERT (recv_bytes % data_out->elem_size == 0);
   *last_loc_elem_recvd += recv_bytes / data_out->elem_size;
 
-  if (proc != forest->mpirank) {
+  if (!message_given) {
     /* free the receive buffer */
     T8_FREE (recv_buffer);
   }
@@ -877,12 +1226,13 @@ t8_forest_partition_recv_message_data (t8_forest_t forest, sc_MPI_Comm comm,
  * \param [in]  forest      The new forest.
  * \param [in]  comm        The MPI communicator.
  * \param [in]  proc        The rank from which we receive.
- * \param [in]  status      MPI status with which we probed for the message.
+ * \param [in]  status      MPI status with which we probed for the message,
+ *                          or NULL if the message was already received.
  * \param [in]  prev_recvd  The count of messages that we already received.
- * \param [in]  sent_to_self If proc equals the rank of this process, the message
- *                          should be passed as this parameter.
- * \param [in]  byte_to_self If proc equals the rank of this process, the number of
- *                          bytes in the message.
+ * \param [in]  sent_to_self If proc equals the rank of this process or \a status
+ *                          is NULL, the message should be passed as this parameter.
+ * \param [in]  byte_to_self If proc equals the rank of this process or \a status
+ *                          is NULL, the number of bytes in the message.
  * It is important, that we receive the messages in order to properly fill the
  * forest->trees array.
  */
@@ -898,14 +1248,16 @@ t8_forest_partition_recv_message (t8_forest_t forest, sc_MPI_Comm comm,
   t8_locidx_t         num_trees, itree;
   t8_locidx_t         num_elements_recv;
   t8_locidx_t         old_num_elements, new_num_elements;
-  size_t              tree_cursor, element_cursor;
+  size_t              tree_cursor, element_cursor, tree_bytes;
   t8_forest_partition_tree_info_t *tree_info;
   t8_tree_t           tree, last_tree;
   size_t              element_size;
   void               *first_new_element;
   t8_eclass_scheme_c *eclass_scheme;
+  const int           message_given = status == NULL
+    || proc == forest->mpirank;
 
-  if (proc != forest->mpirank) {
+  if (!message_given) {
     T8_ASSERT (proc == status->MPI_SOURCE);
     T8_ASSERT (status->MPI_TAG == T8_MPI_PARTITION_FOREST);
     /* Get the number of bytes to receive */
@@ -918,7 +1270,7 @@ t8_forest_partition_recv_message (t8_forest_t forest, sc_MPI_Comm comm,
   t8_debugf ("Receiving message of %i bytes from process %i\n", recv_bytes,
              proc);
 
-  if (proc != forest->mpirank) {
+  if (!message_given) {
     /* allocate the receive buffer */
     recv_buffer = T8_ALLOC (char, recv_bytes);
     /* receive the message */
@@ -978,13 +1330,24 @@ t8_forest_partition_recv_message (t8_forest_t forest, sc_MPI_Comm comm,
         t8_forest_get_eclass_scheme (forest->set_from, tree->eclass);
       element_size = eclass_scheme->t8_element_size ();
       /* initialize the elements array and copy the elements from the receive buffer */
-      T8_ASSERT (element_cursor + tree_info->num_elements * element_size <=
-                 (size_t) recv_bytes);
+      T8_ASSERT (forest->set_compress_messages
+                 || element_cursor + tree_info->num_elements * element_size
+                 <= (size_t) recv_bytes);
       t8_debugf ("[H} init array for tree %i\n", itree);
-      t8_element_array_init_copy (&tree->elements, eclass_scheme,
-                                  (t8_element_t *) (recv_buffer +
-                                                    element_cursor),
-                                  tree_info->num_elements);
+      if (forest->set_compress_messages) {
+        t8_element_array_init_size (&tree->elements, eclass_scheme,
+                                    tree_info->num_elements);
+        tree_bytes = t8_element_array_unpack (&tree->elements, 0,
+                                              tree_info->num_elements,
+                                              recv_buffer + element_cursor);
+      }
+      else {
+        t8_element_array_init_copy (&tree->elements, eclass_scheme,
+                                    (t8_element_t *) (recv_buffer +
+                                                      element_cursor),
+                                    tree_info->num_elements);
+        tree_bytes = tree_info->num_elements * element_size;
+      }
 #if 0
       /* Debugging output */
       t8_debugf ("receive %li elements for tree %lli\n",
@@ -1020,9 +1383,18 @@ t8_forest_partition_recv_message (t8_forest_t forest, sc_MPI_Comm comm,
         t8_forest_get_eclass_scheme (forest->set_from, tree->eclass);
       element_size = eclass_scheme->t8_element_size ();
       T8_ASSERT (element_size == t8_element_array_get_size (&tree->elements));
-      /* Copy the elements from the receive buffer to the elements array */
-      memcpy (first_new_element, recv_buffer + element_cursor,
-              tree_info->num_elements * element_size);
+      if (forest->set_compress_messages) {
+        tree_bytes = t8_element_array_unpack (&tree->elements,
+                                              old_num_elements,
+                                              tree_info->num_elements,
+                                              recv_buffer + element_cursor);
+      }
+      else {
+        /* Copy the elements from the receive buffer to the elements array */
+        memcpy (first_new_element, recv_buffer + element_cursor,
+                tree_info->num_elements * element_size);
+        tree_bytes = tree_info->num_elements * element_size;
+      }
     }
 
     /* compute the new number of local elements */
@@ -1030,13 +1402,14 @@ t8_forest_partition_recv_message (t8_forest_t forest, sc_MPI_Comm comm,
     /* Set the new last local tree */
     forest->last_local_tree = tree_info->gtree_id;
     /* advance the element cursor */
-    element_cursor += element_size * tree_info->num_elements;
+    element_cursor += tree_bytes;
+    T8_ASSERT (element_cursor <= (size_t) recv_bytes);
     /* Advance to the next tree_info entry in the recv buffer */
     tree_cursor += sizeof (t8_forest_partition_tree_info_t);
     tree_info += 1;
   }
 
-  if (proc != forest->mpirank) {
+  if (!message_given) {
     T8_FREE (recv_buffer);
   }
   if (forest->profile != NULL) {
@@ -1118,6 +1491,114 @@ t8_forest_partition_recvloop (t8_forest_t forest, int recv_first,
   }
 }
 
+/* Exchange the elements (or element data) with neighborhood collectives
+ * instead of the probe and receive loop of t8_forest_partition_recvloop.
+ * The send buffers and their sizes must have been filled by
+ * t8_forest_partition_sendloop with send_bytes != NULL.
+ * The messages are received in order of the sending rank.
+ * If recv_last < recv_first, we do not receive anything but still take part
+ * in the collective communication.
+ */
+static void
+t8_forest_partition_neighbor_exchange (t8_forest_t forest,
+                                       const int send_first,
+                                       const int send_last,
+                                       char **send_buffer,
+                                       const int *send_bytes,
+                                       const int recv_first,
+                                       const int recv_last,
+                                       const int recv_data,
+                                       sc_array_t *data_out,
+                                       char *sent_to_self,
+                                       size_t byte_to_self)
+{
+  int                 iproc, num_dests = 0, num_sources = 0, isource;
+  int                *dests, *sources, *dest_bytes, *recv_bytes,
+    *recv_offsets;
+  char              **dest_buffers, *recv_buffer, *message;
+  int                 prev_recvd = 0, message_bytes;
+  t8_locidx_t         last_received_local_element = 0;
+  sc_MPI_Comm         neighbor_comm;
+
+  T8_ASSERT (recv_data || t8_forest_is_initialized (forest));
+  T8_ASSERT (!recv_data || t8_forest_is_committed (forest));
+  const t8_gloidx_t  *offset_from =
+    t8_shmem_array_get_gloidx_array (forest->set_from->element_offsets);
+
+  /* Collect the ranks that we send to and receive from, without ourselves */
+  dests = T8_ALLOC (int, SC_MAX (send_last - send_first + 1, 1));
+  dest_bytes = T8_ALLOC (int, SC_MAX (send_last - send_first + 1, 1));
+  dest_buffers = T8_ALLOC (char *, SC_MAX (send_last - send_first + 1, 1));
+  for (iproc = send_first; iproc <= send_last; iproc++) {
+    if (iproc != forest->mpirank && send_buffer[iproc - send_first] != NULL) {
+      dests[num_dests] = iproc;
+      dest_bytes[num_dests] = send_bytes[iproc - send_first];
+      dest_buffers[num_dests] = send_buffer[iproc - send_first];
+      num_dests++;
+    }
+  }
+  sources = T8_ALLOC (int, SC_MAX (recv_last - recv_first + 1, 1));
+  for (iproc = recv_first; iproc <= recv_last; iproc++) {
+    if (iproc != forest->mpirank
+        && !t8_forest_partition_empty (offset_from, iproc)) {
+      sources[num_sources++] = iproc;
+    }
+  }
+  recv_bytes = T8_ALLOC (int, num_sources + 1);
+  recv_offsets = T8_ALLOC (int, num_sources + 1);
+
+  /****     Actual communication    ****/
+  neighbor_comm = t8_neighbor_comm_create (forest->mpicomm, num_sources,
+                                           sources, num_dests, dests);
+  recv_buffer = t8_neighbor_comm_alltoallv (neighbor_comm, num_dests,
+                                            dest_buffers, dest_bytes,
+                                            num_sources, recv_bytes,
+                                            recv_offsets);
+  t8_neighbor_comm_destroy (&neighbor_comm);
+
+  /* Insert the messages in order of their ranks */
+  if (!recv_data) {
+    forest->local_num_elements = 0;
+  }
+  isource = 0;
+  for (iproc = recv_first; iproc <= recv_last; iproc++) {
+    if (t8_forest_partition_empty (offset_from, iproc)) {
+      continue;
+    }
+    if (iproc == forest->mpirank) {
+      message = sent_to_self;
+      message_bytes = byte_to_self;
+    }
+    else {
+      T8_ASSERT (sources[isource] == iproc);
+      message = recv_buffer + recv_offsets[isource];
+      message_bytes = recv_bytes[isource];
+      isource++;
+    }
+    if (!recv_data) {
+      t8_forest_partition_recv_message (forest, forest->mpicomm, iproc, NULL,
+                                        prev_recvd, message, message_bytes);
+    }
+    else {
+      t8_forest_partition_recv_message_data (forest, forest->mpicomm, iproc,
+                                             NULL,
+                                             &last_received_local_element,
+                                             data_out, message,
+                                             message_bytes);
+    }
+    prev_recvd++;
+  }
+  T8_ASSERT (isource == num_sources);
+
+  T8_FREE (recv_buffer);
+  T8_FREE (recv_bytes);
+  T8_FREE (recv_offsets);
+  T8_FREE (sources);
+  T8_FREE (dests);
+  T8_FREE (dest_bytes);
+  T8_FREE (dest_buffers);
+}
+
 /* Partition a forest from forest->set_from and the element offsets
  * set in forest->element_offsets
  */
@@ -1130,6 +1611,7 @@ t8_forest_partition_given (t8_forest_t forest, const int send_data,
   int                 num_request_alloc;        /* The count of elements in the request array */
   char              **send_buffer, *sent_to_self;
   int                 mpiret, i, to_self;
+  int                *send_bytes = NULL;
   t8_locidx_t         num_new_elements;
   size_t              byte_to_self = 0;
 
@@ -1143,11 +1625,15 @@ t8_forest_partition_given (t8_forest_t forest, const int send_data,
   t8_debugf ("send_first = %i\n", send_first);
   t8_debugf ("send_last = %i\n", send_last);
 
+  if (forest->set_neighbor_collectives) {
+    /* The messages are sent in one collective after the send loop */
+    send_bytes = T8_ALLOC_ZERO (int, SC_MAX (send_last - send_first + 1, 1));
+  }
   /* Send all elements to other ranks */
   to_self =
     t8_forest_partition_sendloop (forest, send_first, send_last, &requests,
                                   &num_request_alloc, &send_buffer, send_data,
-                                  data_in, &byte_to_self);
+                                  data_in, &byte_to_self, send_bytes);
   if (to_self) {
     /* We have sent data to ourselves. */
     sent_to_self = *(send_buffer + forest->mpirank - send_first);
@@ -1167,12 +1653,30 @@ t8_forest_partition_given (t8_forest_t forest, const int send_data,
   }
 
   if (num_new_elements > 0) {
-    /* Receive all element from other ranks */
+    /* Compute the ranks that we receive from */
     t8_forest_partition_recvrange (forest, &recv_first, &recv_last);
+  }
+  else {
+    /* We do not receive anything */
+    recv_first = 0;
+    recv_last = -1;
+  }
+  if (forest->set_neighbor_collectives) {
+    /* Exchange all elements in one collective, also if we
+     * do not receive anything. */
+    t8_forest_partition_neighbor_exchange (forest, send_first, send_last,
+                                           send_buffer, send_bytes,
+                                           recv_first, recv_last, send_data,
+                                           data_out, sent_to_self,
+                                           byte_to_self);
+    T8_FREE (send_bytes);
+  }
+  else if (num_new_elements > 0) {
+    /* Receive all element from other ranks */
     t8_forest_partition_recvloop (forest, recv_first, recv_last, send_data,
                                   data_out, sent_to_self, byte_to_self);
   }
-  else if (!send_data) {
+  if (num_new_elements == 0 && !send_data) {
     /* This forest is empty, set first and last local tree such
      * that t8_forest_get_num_local_trees return 0 */
     forest->first_local_tree = 0;
@@ -1303,4 +1807,440 @@ t8_forest_partition_data (t8_forest_t forest_from, t8_forest_t forest_to,
   t8_global_productionf ("Done forest partition data.\n");
 }
 
+void
+t8_forest_partition_data_variable (t8_forest_t forest_from,
+                                   t8_forest_t forest_to,
+                                   const sc_array_t *data_in,
+                                   const sc_array_t *sizes_in,
+                                   sc_array_t *data_out,
+                                   sc_array_t *offsets_out)
+{
+  t8_forest_t         save_set_from;
+  sc_MPI_Comm         comm;
+  sc_MPI_Request     *requests;
+  sc_MPI_Status       status;
+  const t8_gloidx_t  *offset_from, *offset_to;
+  const size_t       *sizes;
+  size_t             *offsets, *recv_sizes;
+  size_t              num_bytes, header_bytes, data_bytes;
+  char              **send_buffers, *buffer, *self_buffer = NULL;
+  t8_gloidx_t         first, last, first_local_from, first_local_to;
+  t8_locidx_t         num_send, num_recv, ielement, num_received = 0;
+  int                 send_first, send_last, recv_first, recv_last;
+  int                 iproc, mpiret, recv_bytes, num_requests = 0;
+
+  t8_global_productionf ("Enter forest partition data variable.\n");
+  t8_log_indent_push ();
+
+  T8_ASSERT (t8_forest_is_committed (forest_from));
+  T8_ASSERT (t8_forest_is_committed (forest_to));
+  T8_ASSERT (data_in != NULL && sizes_in != NULL);
+  T8_ASSERT (data_out != NULL && offsets_out != NULL);
+  T8_ASSERT (data_in->elem_size == 1 && data_out->elem_size == 1);
+  T8_ASSERT (sizes_in->elem_size == sizeof (size_t));
+  T8_ASSERT (offsets_out->elem_size == sizeof (size_t));
+  T8_ASSERT (sizes_in->elem_count ==
+             (size_t) forest_from->local_num_elements);
+
+  /* Create partition tables if not existent yet */
+  if (forest_from->element_offsets == NULL) {
+    t8_forest_partition_create_offsets (forest_from);
+  }
+  if (forest_to->element_offsets == NULL) {
+    t8_forest_partition_create_offsets (forest_to);
+  }
+  comm = forest_to->mpicomm;
+  offset_from = t8_shmem_array_get_gloidx_array (forest_from->element_offsets);
+  offset_to = t8_shmem_array_get_gloidx_array (forest_to->element_offsets);
+  first_local_from = offset_from[forest_to->mpirank];
+  first_local_to = offset_to[forest_to->mpirank];
+
+  /* Compute the offsets of the element data in data_in */
+  sizes = (const size_t *) sizes_in->array;
+  offsets = T8_ALLOC (size_t, forest_from->local_num_elements + 1);
+  offsets[0] = 0;
+  for (ielement = 0; ielement < forest_from->local_num_elements; ielement++) {
+    offsets[ielement + 1] = offsets[ielement] + sizes[ielement];
+  }
+  T8_ASSERT (offsets[forest_from->local_num_elements] ==
+             data_in->elem_count);
+
+  /* We use the same send and receive ranges as for the elements */
+  save_set_from = forest_to->set_from;
+  forest_to->set_from = forest_from;
+  t8_forest_partition_sendrange (forest_to, &send_first, &send_last);
+  if (forest_to->local_num_elements > 0) {
+    t8_forest_partition_recvrange (forest_to, &recv_first, &recv_last);
+  }
+  else {
+    recv_first = 0;
+    recv_last = -1;
+  }
+  forest_to->set_from = save_set_from;
+
+  /* Send to each process the sizes of the elements it receives from us,
+   * followed by their data. */
+  requests = T8_ALLOC (sc_MPI_Request, SC_MAX (send_last - send_first + 1, 0));
+  send_buffers = T8_ALLOC_ZERO (char *, SC_MAX (send_last - send_first + 1, 0));
+  for (iproc = send_first; iproc <= send_last; iproc++) {
+    if (t8_forest_partition_empty (offset_to, iproc)) {
+      continue;
+    }
+    first = SC_MAX (offset_to[iproc], first_local_from) - first_local_from;
+    last = SC_MIN (offset_to[iproc + 1],
+                   offset_from[forest_to->mpirank + 1]) - first_local_from;
+    T8_ASSERT (first < last);
+    num_send = last - first;
+    header_bytes = num_send * sizeof (size_t);
+    data_bytes = offsets[last] - offsets[first];
+    num_bytes = header_bytes + data_bytes;
+    SC_CHECK_ABORT (num_bytes <= INT_MAX,
+                    "Element data message exceeds the maximum MPI count.");
+    buffer = send_buffers[iproc - send_first] = T8_ALLOC (char, num_bytes);
+    memcpy (buffer, sizes + first, header_bytes);
+    memcpy (buffer + header_bytes, data_in->array + offsets[first],
+            data_bytes);
+    if (iproc == forest_to->mpirank) {
+      self_buffer = buffer;
+      continue;
+    }
+    t8_debugf ("Sending %zu bytes of element data to process %i\n",
+               num_bytes, iproc);
+    mpiret = sc_MPI_Isend (buffer, (int) num_bytes, sc_MPI_BYTE, iproc,
+                           T8_MPI_PARTITION_FOREST, comm,
+                           requests + num_requests++);
+    SC_CHECK_MPI (mpiret);
+  }
+
+  /* Receive the sizes and data in the order of the processes, such that
+   * the output is packed in the order of the elements. */
+  sc_array_resize (offsets_out, forest_to->local_num_elements + 1);
+  *(size_t *) sc_array_index (offsets_out, 0) = 0;
+  sc_array_resize (data_out, 0);
+  for (iproc = recv_first; iproc <= recv_last; iproc++) {
+    if (t8_forest_partition_empty (offset_from, iproc)) {
+      continue;
+    }
+    first = SC_MAX (offset_from[iproc], first_local_to);
+    last = SC_MIN (offset_from[iproc + 1],
+                   offset_to[forest_to->mpirank + 1]);
+    T8_ASSERT (first < last);
+    num_recv = last - first;
+    if (iproc != forest_to->mpirank) {
+      mpiret = sc_MPI_Probe (iproc, T8_MPI_PARTITION_FOREST, comm, &status);
+      SC_CHECK_MPI (mpiret);
+      mpiret = sc_MPI_Get_count (&status, sc_MPI_BYTE, &recv_bytes);
+      SC_CHECK_MPI (mpiret);
+      buffer = T8_ALLOC (char, recv_bytes);
+      mpiret = sc_MPI_Recv (buffer, recv_bytes, sc_MPI_BYTE, iproc,
+                            T8_MPI_PARTITION_FOREST, comm,
+                            sc_MPI_STATUS_IGNORE);
+      SC_CHECK_MPI (mpiret);
+    }
+    else {
+      T8_ASSERT (self_buffer != NULL);
+      buffer = self_buffer;
+    }
+    header_bytes = num_recv * sizeof (size_t);
+    recv_sizes = (size_t *) buffer;
+    data_bytes = 0;
+    for (ielement = 0; ielement < num_recv; ielement++) {
+      data_bytes += recv_sizes[ielement];
+      *(size_t *) sc_array_index (offsets_out, num_received + ielement + 1) =
+        data_bytes + data_out->elem_count;
+    }
+    T8_ASSERT (iproc == forest_to->mpirank
+               || (size_t) recv_bytes == header_bytes + data_bytes);
+    /* Append the data to the output */
+    memcpy (sc_array_push_count (data_out, data_bytes),
+            buffer + header_bytes, data_bytes);
+    num_received += num_recv;
+    if (iproc != forest_to->mpirank) {
+      T8_FREE (buffer);
+    }
+  }
+  T8_ASSERT (num_received == forest_to->local_num_elements);
+
+  /* Wait for all sends to complete */
+  mpiret = sc_MPI_Waitall (num_requests, requests, sc_MPI_STATUSES_IGNORE);
+  SC_CHECK_MPI (mpiret);
+  for (iproc = 0; iproc < send_last - send_first + 1; iproc++) {
+    T8_FREE (send_buffers[iproc]);
+  }
+  T8_FREE (send_buffers);
+  T8_FREE (requests);
+  T8_FREE (offsets);
+
+  t8_log_indent_pop ();
+  t8_global_productionf ("Done forest partition data variable.\n");
+}
+
+/* The state of an asynchronous partition of element data */
+struct t8_forest_partition_data_context
+{
+  sc_MPI_Comm         comm;     /* The communicator of the forests */
+  int                 num_fields;       /* The number of data arrays */
+  sc_array_t        **data_out;  /* The output arrays, one per field */
+  int                 num_sends;        /* The number of messages we send */
+  sc_MPI_Request     *send_requests;    /* The requests of the sends */
+  char              **send_buffers;     /* The buffers of the sends */
+  int                 num_ranges;       /* The number of ranges of local elements that we receive, one per process */
+  t8_locidx_t        *range_first;      /* The first local element of each range */
+  t8_locidx_t        *range_end;        /* One after the last local element of each range */
+  int                *range_valid;      /* True if the data of a range has arrived */
+  sc_MPI_Request     *recv_requests;    /* The request of each range, sc_MPI_REQUEST_NULL if valid */
+  char              **recv_buffers;     /* Receive buffers of each range if num_fields > 1 */
+  int                 num_valid;        /* The number of valid ranges */
+};
+
+/* Copy the received data of a range from its receive buffer into the
+ * output arrays. */
+static void
+t8_forest_partition_data_unpack (t8_forest_partition_data_context_t context,
+                                 int irange)
+{
+  const t8_locidx_t   first = context->range_first[irange];
+  const t8_locidx_t   num_elements = context->range_end[irange] - first;
+  char               *buffer = context->recv_buffers[irange];
+  size_t              field_bytes;
+  int                 ifield;
+
+  if (buffer != NULL) {
+    for (ifield = 0; ifield < context->num_fields; ifield++) {
+      field_bytes = num_elements * context->data_out[ifield]->elem_size;
+      memcpy (t8_sc_array_index_locidx (context->data_out[ifield], first),
+              buffer, field_bytes);
+      buffer += field_bytes;
+    }
+    T8_FREE (context->recv_buffers[irange]);
+  }
+  context->range_valid[irange] = 1;
+  context->num_valid++;
+}
+
+t8_forest_partition_data_context_t
+t8_forest_partition_data_begin (t8_forest_t forest_from,
+                                t8_forest_t forest_to, int num_fields,
+                                const sc_array_t **data_in,
+                                sc_array_t **data_out)
+{
+  t8_forest_partition_data_context_t context;
+  t8_forest_t         save_set_from;
+  const t8_gloidx_t  *offset_from, *offset_to;
+  t8_gloidx_t         first_local_from, first_local_to, first, end;
+  size_t              element_bytes = 0, num_bytes, field_bytes;
+  char               *buffer;
+  int                 send_first, send_last, recv_first, recv_last;
+  int                 iproc, ifield, irange, mpiret;
+
+  T8_ASSERT (t8_forest_is_committed (forest_from));
+  T8_ASSERT (t8_forest_is_committed (forest_to));
+  T8_ASSERT (num_fields > 0 && data_in != NULL && data_out != NULL);
+  for (ifield = 0; ifield < num_fields; ifield++) {
+    T8_ASSERT (data_in[ifield]->elem_size == data_out[ifield]->elem_size);
+    T8_ASSERT (data_in[ifield]->elem_count ==
+               (size_t) forest_from->local_num_elements);
+    T8_ASSERT (data_out[ifield]->elem_count ==
+               (size_t) forest_to->local_num_elements);
+    element_bytes += data_in[ifield]->elem_size;
+  }
+
+  /* Create partition tables if not existent yet */
+  if (forest_from->element_offsets == NULL) {
+    t8_forest_partition_create_offsets (forest_from);
+  }
+  if (forest_to->element_offsets == NULL) {
+    t8_forest_partition_create_offsets (forest_to);
+  }
+  offset_from = t8_shmem_array_get_gloidx_array (forest_from->element_offsets);
+  offset_to = t8_shmem_array_get_gloidx_array (forest_to->element_offsets);
+  first_local_from = offset_from[forest_to->mpirank];
+  first_local_to = offset_to[forest_to->mpirank];
+
+  /* We use the same send and receive ranges as for the elements */
+  save_set_from = forest_to->set_from;
+  forest_to->set_from = forest_from;
+  t8_forest_partition_sendrange (forest_to, &send_first, &send_last);
+  if (forest_to->local_num_elements > 0) {
+    t8_forest_partition_recvrange (forest_to, &recv_first, &recv_last);
+  }
+  else {
+    recv_first = 0;
+    recv_last = -1;
+  }
+  forest_to->set_from = save_set_from;
+
+  context = T8_ALLOC_ZERO (struct t8_forest_partition_data_context, 1);
+  context->comm = forest_to->mpicomm;
+  context->num_fields = num_fields;
+  context->data_out = T8_ALLOC (sc_array_t *, num_fields);
+  memcpy (context->data_out, data_out, num_fields * sizeof (sc_array_t *));
+
+  /* Post the receives. We receive directly into the output array if there
+   * is only one field. */
+  context->num_ranges = SC_MAX (recv_last - recv_first + 1, 0);
+  context->range_first = T8_ALLOC (t8_locidx_t, context->num_ranges);
+  context->range_end = T8_ALLOC (t8_locidx_t, context->num_ranges);
+  context->range_valid = T8_ALLOC_ZERO (int, context->num_ranges);
+  context->recv_requests = T8_ALLOC (sc_MPI_Request, context->num_ranges);
+  context->recv_buffers = T8_ALLOC_ZERO (char *, context->num_ranges);
+  irange = 0;
+  for (iproc = recv_first; iproc <= recv_last; iproc++) {
+    if (t8_forest_partition_empty (offset_from, iproc)) {
+      continue;
+    }
+    first = SC_MAX (offset_from[iproc], first_local_to);
+    end = SC_MIN (offset_from[iproc + 1], offset_to[forest_to->mpirank + 1]);
+    T8_ASSERT (first < end);
+    context->range_first[irange] = first - first_local_to;
+    context->range_end[irange] = end - first_local_to;
+    context->recv_requests[irange] = sc_MPI_REQUEST_NULL;
+    if (iproc != forest_to->mpirank) {
+      num_bytes = (end - first) * element_bytes;
+      SC_CHECK_ABORT (num_bytes <= INT_MAX,
+                      "Element data message exceeds the maximum MPI count.");
+      if (num_fields == 1) {
+        buffer = (char *) t8_sc_array_index_locidx (data_out[0],
+                                                    first - first_local_to);
+      }
+      else {
+        buffer = context->recv_buffers[irange] = T8_ALLOC (char, num_bytes);
+      }
+      mpiret = sc_MPI_Irecv (buffer, (int) num_bytes, sc_MPI_BYTE, iproc,
+                             T8_MPI_PARTITION_DATA, context->comm,
+                             context->recv_requests + irange);
+      SC_CHECK_MPI (mpiret);
+    }
+    irange++;
+  }
+  context->num_ranges = irange;
+
+  /* Send the data. Data that stays on this process is copied directly. */
+  context->send_requests =
+    T8_ALLOC (sc_MPI_Request, SC_MAX (send_last - send_first + 1, 0));
+  context->send_buffers =
+    T8_ALLOC (char *, SC_MAX (send_last - send_first + 1, 0));
+  for (iproc = send_first; iproc <= send_last; iproc++) {
+    if (t8_forest_partition_empty (offset_to, iproc)) {
+      continue;
+    }
+    first = SC_MAX (offset_to[iproc], first_local_from) - first_local_from;
+    end = SC_MIN (offset_to[iproc + 1],
+                  offset_from[forest_to->mpirank + 1]) - first_local_from;
+    T8_ASSERT (first < end);
+    if (iproc == forest_to->mpirank) {
+      const t8_locidx_t   first_to =
+        first + first_local_from - first_local_to;
+      for (ifield = 0; ifield < num_fields; ifield++) {
+        memcpy (t8_sc_array_index_locidx (data_out[ifield], first_to),
+                t8_sc_array_index_locidx ((sc_array_t *) data_in[ifield],
+                                          first),
+                (end - first) * data_in[ifield]->elem_size);
+      }
+      continue;
+    }
+    num_bytes = (end - first) * element_bytes;
+    buffer = T8_ALLOC (char, num_bytes);
+    context->send_buffers[context->num_sends] = buffer;
+    for (ifield = 0; ifield < num_fields; ifield++) {
+      field_bytes = (end - first) * data_in[ifield]->elem_size;
+      memcpy (buffer,
+              t8_sc_array_index_locidx ((sc_array_t *) data_in[ifield],
+                                        first), field_bytes);
+      buffer += field_bytes;
+    }
+    mpiret = sc_MPI_Isend (context->send_buffers[context->num_sends],
+                           (int) num_bytes, sc_MPI_BYTE, iproc,
+                           T8_MPI_PARTITION_DATA, context->comm,
+                           context->send_requests + context->num_sends);
+    SC_CHECK_MPI (mpiret);
+    context->num_sends++;
+  }
+
+  /* The range that stayed on this process is valid now */
+  for (irange = 0; irange < context->num_ranges; irange++) {
+    if (context->recv_requests[irange] == sc_MPI_REQUEST_NULL) {
+      t8_forest_partition_data_unpack (context, irange);
+    }
+  }
+  return context;
+}
+
+int
+t8_forest_partition_data_test (t8_forest_partition_data_context_t context)
+{
+  int                 irange, flag, mpiret;
+
+  T8_ASSERT (context != NULL);
+  for (irange = 0; irange < context->num_ranges; irange++) {
+    if (!context->range_valid[irange]) {
+      mpiret = sc_MPI_Test (context->recv_requests + irange, &flag,
+                            sc_MPI_STATUS_IGNORE);
+      SC_CHECK_MPI (mpiret);
+      if (flag) {
+        t8_forest_partition_data_unpack (context, irange);
+      }
+    }
+  }
+  return context->num_valid == context->num_ranges;
+}
+
+int
+t8_forest_partition_data_num_ranges (t8_forest_partition_data_context_t
+                                     context)
+{
+  T8_ASSERT (context != NULL);
+  return context->num_ranges;
+}
+
+int
+t8_forest_partition_data_get_range (t8_forest_partition_data_context_t
+                                    context, int irange, t8_locidx_t *first,
+                                    t8_locidx_t *end)
+{
+  T8_ASSERT (context != NULL);
+  T8_ASSERT (0 <= irange && irange < context->num_ranges);
+  *first = context->range_first[irange];
+  *end = context->range_end[irange];
+  return context->range_valid[irange];
+}
+
+void
+t8_forest_partition_data_end (t8_forest_partition_data_context_t *pcontext)
+{
+  t8_forest_partition_data_context_t context;
+  int                 irange, isend, mpiret;
+
+  T8_ASSERT (pcontext != NULL && *pcontext != NULL);
+  context = *pcontext;
+
+  /* Wait for all receives and copy their data */
+  for (irange = 0; irange < context->num_ranges; irange++) {
+    if (!context->range_valid[irange]) {
+      mpiret = sc_MPI_Wait (context->recv_requests + irange,
+                            sc_MPI_STATUS_IGNORE);
+      SC_CHECK_MPI (mpiret);
+      t8_forest_partition_data_unpack (context, irange);
+    }
+  }
+  /* Wait for all sends to complete */
+  mpiret = sc_MPI_Waitall (context->num_sends, context->send_requests,
+                           sc_MPI_STATUSES_IGNORE);
+  SC_CHECK_MPI (mpiret);
+  for (isend = 0; isend < context->num_sends; isend++) {
+    T8_FREE (context->send_buffers[isend]);
+  }
+
+  T8_FREE (context->send_buffers);
+  T8_FREE (context->send_requests);
+  T8_FREE (context->recv_buffers);
+  T8_FREE (context->recv_requests);
+  T8_FREE (context->range_valid);
+  T8_FREE (context->range_end);
+  T8_FREE (context->range_first);
+  T8_FREE (context->data_out);
+  T8_FREE (context);
+  *pcontext = NULL;
+}
+
 T8_EXTERN_C_END ();
@@ -78,6 +78,105 @@ void                t8_forest_partition_data (t8_forest_t forest_from,
                                               const sc_array_t *data_in,
                                               sc_array_t *data_out);
 
+/** Partition element data of variable size from one forest to another.
+ * This works like \ref t8_forest_partition_data, but each element may
+ * carry a different number of bytes.
+ * \param [in] forest_from The forest before partitioning.
+ * \param [in] forest_to   The partitioned forest.
+ * \param [in] data_in     The packed data of the local elements of \a forest_from
+ *                         as an array of bytes. The data of the elements is stored
+ *                         one after the other in the order of the elements.
+ * \param [in] sizes_in    For each local element of \a forest_from the number of
+ *                         its bytes in \a data_in, as size_t.
+ * \param [in,out] data_out An initialized array with element size 1. On output
+ *                         it holds the packed data of the local elements of
+ *                         \a forest_to.
+ * \param [in,out] offsets_out An initialized array with element size
+ *                         sizeof (size_t). On output it has length
+ *                         local number of elements of \a forest_to plus one and
+ *                         the data of local element i is stored in \a data_out
+ *                         from byte offsets_out[i] to offsets_out[i + 1] - 1.
+ * \note This function is collective over the communicator of the forests.
+ */
+void                t8_forest_partition_data_variable (t8_forest_t
+                                                       forest_from,
+                                                       t8_forest_t forest_to,
+                                                       const sc_array_t
+                                                       *data_in,
+                                                       const sc_array_t
+                                                       *sizes_in,
+                                                       sc_array_t *data_out,
+                                                       sc_array_t
+                                                       *offsets_out);
+
+/** The state of an asynchronous partition of element data started with
+ * \ref t8_forest_partition_data_begin. */
+typedef struct t8_forest_partition_data_context
+  *t8_forest_partition_data_context_t;
+
+/** Start to partition element data from one forest to another without
+ * waiting for the data to arrive. The data of all fields is sent in one
+ * message per process.
+ * The data of the elements that stay on this process is copied immediately,
+ * all other data is only valid after it was reported as such by
+ * \ref t8_forest_partition_data_test and \ref t8_forest_partition_data_get_range
+ * or after \ref t8_forest_partition_data_end.
+ * \param [in] forest_from The forest before partitioning.
+ * \param [in] forest_to   The partitioned forest.
+ * \param [in] num_fields  The number of data arrays.
+ * \param [in] data_in     For each field an array of length local number of
+ *                         elements of \a forest_from. Must not be changed until
+ *                         \ref t8_forest_partition_data_end is called.
+ * \param [in,out] data_out For each field an array of length local number of
+ *                         elements of \a forest_to with the same element size as
+ *                         the corresponding array in \a data_in.
+ * \return                 The context of this transfer, which must be passed
+ *                         to \ref t8_forest_partition_data_end.
+ * \note This function is collective. Only one asynchronous transfer may be
+ * active on a communicator at a time.
+ */
+t8_forest_partition_data_context_t
+t8_forest_partition_data_begin (t8_forest_t forest_from,
+                                t8_forest_t forest_to, int num_fields,
+                                const sc_array_t **data_in,
+                                sc_array_t **data_out);
+
+/** Check for arrived data of an asynchronous partition without blocking.
+ * \param [in,out] context The context of the transfer.
+ * \return                 True if all data has arrived.
+ */
+int                 t8_forest_partition_data_test
+  (t8_forest_partition_data_context_t context);
+
+/** Return the number of ranges of local elements of the new forest in which
+ * data arrives. There is one range for each process that we receive from,
+ * including this process.
+ * \param [in] context     The context of the transfer.
+ * \return                 The number of ranges.
+ */
+int                 t8_forest_partition_data_num_ranges
+  (t8_forest_partition_data_context_t context);
+
+/** Query a range of local elements of the new forest.
+ * \param [in] context     The context of the transfer.
+ * \param [in] irange      The index of the range,
+ *                         0 <= \a irange < \ref t8_forest_partition_data_num_ranges.
+ * \param [out] first      The first local element of the range.
+ * \param [out] end        One after the last local element of the range.
+ * \return                 True if the data of this range has arrived.
+ *                         Call \ref t8_forest_partition_data_test to update this state.
+ */
+int                 t8_forest_partition_data_get_range
+  (t8_forest_partition_data_context_t context, int irange,
+   t8_locidx_t *first, t8_locidx_t *end);
+
+/** Wait for all data of an asynchronous partition to arrive and free
+ * the context.
+ * \param [in,out] pcontext The context of the transfer. Set to NULL on output.
+ */
+void                t8_forest_partition_data_end
+  (t8_forest_partition_data_context_t *pcontext);
+
 T8_EXTERN_C_END ();
 
 #endif /* !T8_FOREST_PARTITION_H! */
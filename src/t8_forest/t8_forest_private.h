@@ -44,6 +44,20 @@ void                t8_forest_compute_desc (t8_forest_t forest);
  * of the coarse mesh. */
 void                t8_forest_populate (t8_forest_t forest);
 
+/** Adapt callback function to refine every element in the forest.
+ * \ref t8_forest_adapt recognizes this callback and refines trees with
+ * elements of a single level without calling it for every element.
+ * \return                  Always return 1, to refine every element
+ */
+int                 t8_forest_refine_everything (t8_forest_t forest,
+                                                 t8_forest_t forest_from,
+                                                 t8_locidx_t which_tree,
+                                                 t8_locidx_t lelement_id,
+                                                 t8_eclass_scheme_c *ts,
+                                                 const int is_family,
+                                                 const int num_elements,
+                                                 t8_element_t *elements[]);
+
 /** Return the eclass scheme of a given element class associated to a forest.
  * This function does not check whether the given forest is committed, use with
  * caution and only if you are sure that the eclass_scheme was set.
@@ -107,6 +121,13 @@ void                t8_forest_copy_trees (t8_forest_t forest,
                                           t8_forest_t from,
                                           int copy_elements);
 
+/* Set the trees of forest as in from and fill them with the elements of from.
+ * If from is only referenced once, its elements are moved instead of copied
+ * and from must not be used anymore other than to unreference it.
+ */
+void                t8_forest_move_trees (t8_forest_t forest,
+                                          t8_forest_t from);
+
 /** Given the local id of a tree in a forest, return the coarse tree of the
  * cmesh that corresponds to this tree, also return the neighbor information of
  * the tree.
@@ -153,6 +174,21 @@ t8_element_t       *t8_forest_get_tree_element (t8_tree_t tree,
 t8_element_array_t *t8_forest_get_tree_element_array (t8_forest_t forest,
                                                       t8_locidx_t ltreeid);
 
+/** Search for a linear element id (at forest->maxlevel) in a sorted array of
+ * elements. If the element does not exist, return the largest index i
+ * such that the element at position i has a smaller id than the given one.
+ * \param [in]  elements   A sorted array of elements, for example the elements
+ *                         of a local tree or of a ghost tree.
+ * \param [in]  element_id The linear id at level \a maxlevel of the element
+ *                         to search for.
+ * \param [in]  maxlevel   The level at which the linear ids are compared.
+ * \return                 The index of the element, or the largest index of an
+ *                         element with smaller id. If no such index exists, -1.
+ */
+t8_locidx_t         t8_forest_bin_search_lower (t8_element_array_t *elements,
+                                                t8_linearidx_t element_id,
+                                                int maxlevel);
+
 /** Find the owner process of a given element, deprecated version.
  * Use t8_forest_element_find_owner instead.
  * \param [in]    forest  The forest.
@@ -434,6 +470,54 @@ int                 t8_forest_element_has_leaf_desc (t8_forest_t forest,
                                                      *element,
                                                      t8_eclass_scheme_c *ts);
 
+/** Query whether a tree of a forest uses a linear geometry.
+ * \param [in]  forest    The forest.
+ * \param [in]  ltreeid   The local id of a tree in \a forest.
+ * \return                True if the geometry of the tree is linear, then the
+ *                        faces of its elements are planar.
+ * \a forest must be committed before calling this function.
+ */
+int                 t8_forest_tree_is_linear (t8_forest_t forest,
+                                              t8_locidx_t ltreeid);
+
+/** Like \ref t8_forest_element_bounding_box, but with the result of
+ * \ref t8_forest_tree_is_linear for the element's tree given, such that it can be
+ * computed once per tree.
+ * \param [in]  tree_is_linear The result of \ref t8_forest_tree_is_linear for \a ltreeid.
+ */
+void                t8_forest_element_bounding_box_ext (t8_forest_t forest,
+                                                        t8_locidx_t ltreeid,
+                                                        const t8_element_t
+                                                        *element,
+                                                        double bounds[6],
+                                                        int tree_is_linear);
+
+/** Like \ref t8_forest_element_points_reference_coords, but with the bounding
+ * box of the element given, such that it can be reused.
+ * \param [in]  bounds   If not NULL, the box computed by \ref t8_forest_element_bounding_box
+ *                       for \a element. Points outside of it are rejected without
+ *                       inverting the geometry. If NULL, the geometry is inverted for
+ *                       all points, for example if they were already tested against the box.
+ */
+void                t8_forest_element_points_reference_coords_ext
+  (t8_forest_t forest, t8_locidx_t ltreeid, const t8_element_t *element,
+   const double *points, int num_points, const double tolerance,
+   double *ref_coords, int *is_inside, const double *bounds);
+
+/** Like \ref t8_forest_element_point_inside, but with the result of
+ * \ref t8_forest_tree_is_linear for the element's tree given, such that it can be
+ * computed once per tree.
+ * \param [in]  tree_is_linear The result of \ref t8_forest_tree_is_linear for \a ltreeid.
+ */
+int                 t8_forest_element_point_inside_ext (t8_forest_t forest,
+                                                        t8_locidx_t ltreeid,
+                                                        const t8_element_t
+                                                        *element,
+                                                        const double point[3],
+                                                        const double
+                                                        tolerance,
+                                                        int tree_is_linear);
+
 T8_EXTERN_C_END ();
 
 #endif /* !T8_FOREST_PRIVATE_H! */
@@ -35,6 +35,7 @@
 #include <t8_data/t8_containers.h>
 #include <t8_forest/t8_forest_adapt.h>
 #include <t8_forest.h>
+#include <t8_forest/t8_forest_geometry_cache.h>
 
 typedef struct t8_profile t8_profile_t; /* Defined below */
 typedef struct t8_forest_ghost *t8_forest_ghost_t;      /* Defined below */
@@ -99,11 +100,27 @@ typedef struct t8_forest
                                              repartitioning, \see t8_forest_balance */
   int                 do_ghost;         /**< If True, a ghost layer will be created when the forest is committed. */
   t8_ghost_type_t     ghost_type;       /**< If a ghost layer will be created, the type of neighbors that count as ghost. */
+  int                 set_geometry_cache; /**< If True, a geometry cache will be created when the forest is committed.
+                                             See \ref t8_forest_set_geometry_cache. */
+  int                 set_geometry_cache_quadrature; /**< If positive, the geometry cache computes volumes and face areas
+                                                          with this many quadrature points per direction.
+                                                          See \ref t8_forest_set_geometry_cache_ext. */
   int                 ghost_algorithm;  /**< Controls the algorithm used for ghost. 1 = balanced only. 2 = also unbalanced
                                              3 = top-down search and unbalanced. */
+  int                 ghost_width;      /**< The number of element layers in the ghost layer.
+                                             See \ref t8_forest_set_ghost_ext. */
+  int                 set_compress_messages; /**< If True, elements are packed when they are sent during partition
+                                                  and ghost creation. See \ref t8_forest_set_compress_messages. */
+  int                 set_neighbor_collectives; /**< If True, partition and ghost use MPI-3 neighborhood collectives.
+                                                     See \ref t8_forest_set_neighbor_collectives. */
+  int                 set_ghost_async;  /**< If True, commit returns before the ghost layer is received.
+                                             See \ref t8_forest_set_ghost_async. */
   void               *user_data;        /**< Pointer for arbitrary user data. \see t8_forest_set_user_data. */
   void                (*user_function) ();/**< Pointer for arbitrary user function. \see t8_forest_set_user_function. */
   void               *t8code_data;      /**< Pointer for arbitrary data that is used internally. */
+  int                 skip_offsets;     /**< If True, \ref t8_forest_commit does not create \a element_offsets,
+                                             \a tree_offsets and \a global_first_desc. Only used internally for
+                                             intermediate forests that are only partitioned afterwards. */
   int                 committed;        /**< \ref t8_forest_commit called? */
   int                 mpisize;          /**< Number of MPI processes. */
   int                 mpirank;          /**< Number of this MPI process. */
@@ -113,6 +130,10 @@ typedef struct t8_forest
   t8_gloidx_t         global_num_trees; /**< The total number of global trees */
   sc_array_t         *trees;
   t8_forest_ghost_t   ghosts;           /**< If not NULL, the ghost elements. \see t8_forest_ghost.h */
+  sc_MPI_Comm         ghost_comm;       /**< If not sc_MPI_COMM_NULL, the graph communicator of the remote
+                                             processes of the ghost layer. Only used with neighborhood collectives. */
+  t8_forest_geometry_cache_t *geometry_cache; /**< If not NULL, the cached geometry of the local and ghost elements.
+                                                   \see t8_forest_geometry_cache.h */
   t8_shmem_array_t    element_offsets; /**< If partitioned, for each process the global index
                                             of its first element. Since it is memory consuming,
                                             it is usually only constructed when needed and otherwise unallocated. */
@@ -215,6 +236,8 @@ typedef struct t8_forest_ghost
 
   sc_mempool_t       *glo_tree_mempool;
   sc_mempool_t       *proc_offset_mempool;
+  void               *pending;  /* If not NULL, the ghost elements are still being received.
+                                   The communication is completed by t8_forest_ghost_wait. */
 } t8_forest_ghost_struct_t;
 
 #endif /* ! T8_FOREST_TYPES_H! */
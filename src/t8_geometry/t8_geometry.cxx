@@ -81,8 +81,7 @@ t8_geom_handler_init (t8_geometry_handler_t **pgeom_handler)
   /* Is not committed yet. */
   geom_handler->is_committed = 0;
   /* Set default values. */
-  geom_handler->active_geometry = NULL;
-  geom_handler->active_tree = -1;
+  t8_geometry_context_init (&geom_handler->active_context, NULL);
   t8_refcount_init (&geom_handler->rc);
   T8_ASSERT (t8_geom_handler_is_initialized (geom_handler));
   *pgeom_handler = geom_handler;
@@ -215,33 +214,18 @@ t8_geom_handler_commit (t8_geometry_handler_t *geom_handler)
   T8_ASSERT (t8_geom_handler_is_initialized (geom_handler));
   /* Must not be committed */
   T8_ASSERT (!t8_geom_handler_is_committed (geom_handler));
-  /* If we only have one geometry (which is a standard use case).
-   * We set this to be the active geometry and know that we will not
-   * have to look for any other geometry in t8_geom_handler_update_tree.
-   * If we have more than one geometry, we set the active geometry to
-   * NULL, sort the geometries array and will search for a tree's geometry
-   * if it is not the active one in t8_geom_handler_update_tree.
-   */
-  if (t8_geom_handler_get_num_geometries (geom_handler) == 1) {
-    /* Set the active geometry to the only geometry. */
-    /* *INDENT-OFF* */
-    geom_handler->active_geometry =
-      *(t8_geometry_c **)
-      sc_array_index (&geom_handler->registered_geometries, 0);
-      t8_debugf ("Commiting geom handler. Set '%s' as active geometry.\n",
-       geom_handler->active_geometry->t8_geom_get_name());
-    /* *INDENT-ON* */
-  }
-  else {
+  /* If we have more than one geometry, we sort the geometries array
+   * such that we can search for a tree's geometry when it is loaded into
+   * a context. If we only have one geometry (which is a standard use case),
+   * all trees use this geometry and we never need to search. */
+  if (t8_geom_handler_get_num_geometries (geom_handler) > 1) {
     /* Sort the geometry array. */
     sc_array_sort (&geom_handler->registered_geometries,
                    t8_geom_handler_compare_names);
-    /* Set the active geometry to NULL */
-    geom_handler->active_geometry = NULL;
   }
-  /* Set the active tree to an invalid value such that
-   * the first call with any tree will trigger t8_geom_handler_update_tree. */
-  geom_handler->active_tree = -1;
+  /* No tree is loaded in the handler's context, such that
+   * the first call with any tree will load it. */
+  t8_geometry_context_init (&geom_handler->active_context, NULL);
   /* Set committed flag. */
   geom_handler->is_committed = 1;
   /* Final Check that we are now committed. */
@@ -287,39 +271,84 @@ t8_geom_handler_get_unique_geometry (const t8_geometry_handler_t
   return *(const t8_geometry_c **) sc_array_index_int (geometries, 0);
 }
 
+void
+t8_geometry_context_init (t8_geometry_context_t *context, t8_cmesh_t cmesh)
+{
+  T8_ASSERT (context != NULL);
+  context->cmesh = cmesh;
+  context->geometry = NULL;
+  context->gtreeid = -1;
+  context->tree_class = T8_ECLASS_INVALID;
+  context->tree_vertices = NULL;
+  context->tree_data = NULL;
+}
+
+/* If the given tree is not the one loaded in the context,
+ * load its geometry, class, vertices and geometry specific data. */
 static inline void
-t8_geom_handler_update_tree (t8_geometry_handler_t *geom_handler,
-                             t8_cmesh_t cmesh, t8_gloidx_t gtreeid)
+t8_geometry_context_update_tree (t8_geometry_context_t *context,
+                                 t8_gloidx_t gtreeid)
 {
-  /* Must be committed */
-  T8_ASSERT (t8_geom_handler_is_committed (geom_handler));
+  t8_cmesh_t          cmesh = context->cmesh;
+
+  T8_ASSERT (cmesh != NULL && t8_cmesh_is_committed (cmesh));
+  T8_ASSERT (t8_geom_handler_is_committed (cmesh->geometry_handler));
   T8_ASSERT (0 <= gtreeid && gtreeid < t8_cmesh_get_num_trees (cmesh));
-  if (geom_handler->active_tree != gtreeid) {
-    int                 num_geoms =
-      t8_geom_handler_get_num_geometries (geom_handler);
-    /* This tree is not the active tree. We need to update the 
-     * active tree, its geometry and its data. */
-    /* Set the new tree as active. */
-    geom_handler->active_tree = gtreeid;
-    if (num_geoms > 1) {
-      /* Find and load the geometry of that tree. 
-       * Only necessary if we have more than one geometry. */
-      geom_handler->active_geometry =
-        (t8_geometry_c *) t8_cmesh_get_tree_geometry (cmesh, gtreeid);
-    }
-    SC_CHECK_ABORTF (geom_handler->active_geometry != NULL,
+  if (context->gtreeid != gtreeid) {
+    const t8_locidx_t   ltreeid = t8_cmesh_get_local_id (cmesh, gtreeid);
+
+    context->gtreeid = gtreeid;
+    context->geometry = t8_cmesh_get_tree_geometry (cmesh, gtreeid);
+    SC_CHECK_ABORTF (context->geometry != NULL,
                      "Could not find geometry for tree with global id %li.\n",
                      gtreeid);
-    /* Get the user data for this geometry and this tree. */
-    geom_handler->active_geometry->t8_geom_load_tree_data (cmesh, gtreeid);
+    if (t8_cmesh_treeid_is_ghost (cmesh, ltreeid)) {
+      /* Ghosts do not store vertices. */
+      context->tree_class =
+        t8_cmesh_get_ghost_class (cmesh,
+                                  t8_cmesh_ltreeid_to_ghostid (cmesh,
+                                                               ltreeid));
+      context->tree_vertices = NULL;
+    }
+    else {
+      context->tree_class = t8_cmesh_get_tree_class (cmesh, ltreeid);
+      context->tree_vertices = t8_cmesh_get_tree_vertices (cmesh, ltreeid);
+    }
+    /* Get the geometry specific data for this tree. */
+    context->geometry->t8_geom_load_tree_context (context);
   }
 }
 
 void
-t8_geometry_evaluate (t8_cmesh_t cmesh, t8_gloidx_t gtreeid,
-                      const double *ref_coords, double *out_coords)
+t8_geometry_context_evaluate (t8_geometry_context_t *context,
+                              t8_gloidx_t gtreeid, const double *ref_coords,
+                              size_t num_coords, double *out_coords)
+{
+  t8_geometry_context_update_tree (context, gtreeid);
+  /* *INDENT-OFF* */
+  context->geometry->t8_geom_evaluate_context (context, ref_coords,
+                                               num_coords, out_coords);
+  /* *INDENT-ON* */
+}
+
+void
+t8_geometry_context_jacobian (t8_geometry_context_t *context,
+                              t8_gloidx_t gtreeid, const double *ref_coords,
+                              double *jacobian)
+{
+  t8_geometry_context_update_tree (context, gtreeid);
+  /* *INDENT-OFF* */
+  context->geometry->t8_geom_jacobian_context (context, ref_coords,
+                                               jacobian);
+  /* *INDENT-ON* */
+}
+
+/* Return the context of the cmesh's geometry handler, reset to
+ * \a cmesh if it was last used with a different cmesh.
+ * Derived cmeshes may share the geometry handler. */
+static inline t8_geometry_context_t *
+t8_geometry_get_active_context (t8_cmesh_t cmesh)
 {
-  double              start_wtime = 0;  /* Used for profiling. */
   /* The cmesh must be committed */
   T8_ASSERT (t8_cmesh_is_committed (cmesh));
   /* Get the geometry handler of the cmesh. */
@@ -327,28 +356,42 @@ t8_geometry_evaluate (t8_cmesh_t cmesh, t8_gloidx_t gtreeid,
   /* The handler must be committed. */
   T8_ASSERT (t8_geom_handler_is_committed (geom_handler));
 
+  if (geom_handler->active_context.cmesh != cmesh) {
+    t8_geometry_context_init (&geom_handler->active_context, cmesh);
+  }
+  return &geom_handler->active_context;
+}
+
+void
+t8_geometry_evaluate (t8_cmesh_t cmesh, t8_gloidx_t gtreeid,
+                      const double *ref_coords, double *out_coords)
+{
+  t8_geometry_evaluate_batch (cmesh, gtreeid, ref_coords, 1, out_coords);
+}
+
+void
+t8_geometry_evaluate_batch (t8_cmesh_t cmesh, t8_gloidx_t gtreeid,
+                            const double *ref_coords, size_t num_coords,
+                            double *out_coords)
+{
+  double              start_wtime = 0;  /* Used for profiling. */
+  t8_geometry_context_t *context = t8_geometry_get_active_context (cmesh);
+
   if (cmesh->profile != NULL) {
     /* Measure the runtime of geometry evaluation.
      * We accumulate the runtime over all calls. */
     start_wtime = sc_MPI_Wtime ();
   }
-  /* Detect whether we call this function for the first time in a row for 
-   * this tree and if so update the active tree and geometry. */
-  t8_geom_handler_update_tree (geom_handler, cmesh, gtreeid);
-
-  T8_ASSERT (geom_handler->active_geometry != NULL);
-
-  /* Evaluate the geometry. */
-  geom_handler->active_geometry->t8_geom_evaluate (cmesh,
-                                                   geom_handler->active_tree,
-                                                   ref_coords, out_coords);
+  /* Load the tree if it is not the active tree and evaluate the geometry. */
+  t8_geometry_context_evaluate (context, gtreeid, ref_coords, num_coords,
+                                out_coords);
 
   if (cmesh->profile != NULL) {
     /* If profiling is enabled, add the runtime to the profiling
-     * variable. */
+     * variable. We count each point as one evaluation. */
     cmesh->profile->geometry_evaluate_runtime +=
       sc_MPI_Wtime () - start_wtime;
-    cmesh->profile->geometry_evaluate_num_calls++;
+    cmesh->profile->geometry_evaluate_num_calls += num_coords;
   }
 }
 
@@ -356,21 +399,6 @@ void
 t8_geometry_jacobian (t8_cmesh_t cmesh, t8_gloidx_t gtreeid,
                       const double *ref_coords, double *jacobian)
 {
-  /* The cmesh must be committed */
-  T8_ASSERT (t8_cmesh_is_committed (cmesh));
-  /* Get the geometry handler of the cmesh of the forest. */
-  t8_geometry_handler_t *geom_handler = cmesh->geometry_handler;
-  /* The handler must be committed. */
-  T8_ASSERT (t8_geom_handler_is_committed (geom_handler));
-
-  /* Detect whether we call this function for the first time in a row for 
-   * this tree and if so update the active tree and geometry. */
-  t8_geom_handler_update_tree (geom_handler, cmesh, gtreeid);
-
-  /* Evaluate the jacobian. */
-  /* *INDENT-OFF* */
-  geom_handler->active_geometry->
-    t8_geom_evalute_jacobian (cmesh, geom_handler->active_tree, ref_coords,
-                              jacobian);
-  /* *INDENT-ON* */
+  t8_geometry_context_jacobian (t8_geometry_get_active_context (cmesh),
+                                gtreeid, ref_coords, jacobian);
 }
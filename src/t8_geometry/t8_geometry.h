@@ -41,14 +41,31 @@ typedef struct t8_geometry t8_geometry_c;
  * include it after the typedef. */
 #include <t8_cmesh.h>
 
+/** A geometry evaluation context stores the data of the tree that
+ * is currently evaluated. It is owned by the caller, such that the
+ * geometries themselves do not need to store any per tree state.
+ * Thus, evaluation with different contexts is thread-safe for geometries
+ * that implement \a t8_geom_evaluate_context and a caller may keep several
+ * trees loaded at the same time by using several contexts.
+ * Use \ref t8_geometry_context_init to initialize a context.
+ */
+typedef struct t8_geometry_context
+{
+  t8_cmesh_t          cmesh;            /**< The cmesh whose trees are evaluated. */
+  const t8_geometry_c *geometry;        /**< The geometry of the loaded tree. */
+  t8_gloidx_t         gtreeid;          /**< The global id of the loaded tree, -1 if none is loaded. */
+  t8_eclass_t         tree_class;       /**< The eclass of the loaded tree. */
+  const double       *tree_vertices;    /**< The vertices of the loaded tree, may be NULL. */
+  const void         *tree_data;        /**< Geometry specific data of the loaded tree. */
+} t8_geometry_context_t;
+
 typedef struct t8_geometry_handler
 {
   sc_array_t          registered_geometries;
                                         /**< Stores all geometries that are handled by this geometry_handler. */
-  t8_geometry_c      *active_geometry;
-                                  /**< Points to the currently loaded geometry (the geometry that was used last and is likely to be used next). */
-  t8_gloidx_t         active_tree;
-                              /**< The global tree id of the last tree for which geometry was used. */
+  t8_geometry_context_t active_context;
+                                       /**< The context used by \ref t8_geometry_evaluate and \ref t8_geometry_jacobian.
+                                            It stores the tree that was used last and is likely to be used next. */
   int                 is_committed;
                                /**< If true, no new geometries can be registered. */
   t8_refcount_t       rc;
@@ -143,11 +160,95 @@ t8_geometry_c      *t8_geom_handler_find_geometry (const
                                                    *geom_handler,
                                                    const char *name);
 
+/**
+ * Initialize a geometry evaluation context for a cmesh.
+ * No tree is loaded, the first evaluation loads the tree's data.
+ * A context does not allocate memory and does not need to be destroyed.
+ * It must not be used after \a cmesh was destroyed.
+ * \param [out] context    The context to initialize.
+ * \param [in]  cmesh      A committed cmesh.
+ */
+void                t8_geometry_context_init (t8_geometry_context_t *context,
+                                              t8_cmesh_t cmesh);
+
+/**
+ * Evaluate the geometry of a tree at one or more reference points using
+ * a caller owned context. If \a gtreeid is not the tree loaded in \a context,
+ * the tree's geometry and data are loaded into \a context first.
+ * Calls with different contexts may be carried out concurrently.
+ * \param [in,out] context    An initialized context.
+ * \param [in]     gtreeid    The global id of a tree of the context's cmesh.
+ * \param [in]     ref_coords Array of 3 * \a num_coords reference coordinates.
+ * \param [in]     num_coords The number of points.
+ * \param [out]    out_coords Array of 3 * \a num_coords entries. On output the
+ *                            physical coordinates of the points.
+ */
+void                t8_geometry_context_evaluate (t8_geometry_context_t
+                                                  *context,
+                                                  t8_gloidx_t gtreeid,
+                                                  const double *ref_coords,
+                                                  size_t num_coords,
+                                                  double *out_coords);
+
+/**
+ * Evaluate the jacobian of the geometry of a tree at a reference point
+ * using a caller owned context.
+ * \param [in,out] context    An initialized context.
+ * \param [in]     gtreeid    The global id of a tree of the context's cmesh.
+ * \param [in]     ref_coords The reference coordinates of the point.
+ * \param [out]    jacobian   The jacobian at \a ref_coords, see \a t8_geom_evalute_jacobian.
+ */
+void                t8_geometry_context_jacobian (t8_geometry_context_t
+                                                  *context,
+                                                  t8_gloidx_t gtreeid,
+                                                  const double *ref_coords,
+                                                  double *jacobian);
+
+/**
+ * Evaluate the geometry of a tree at a reference point.
+ * This uses the context of the cmesh's geometry handler and is thus not
+ * thread-safe. Use \ref t8_geometry_context_evaluate if you need to evaluate
+ * concurrently.
+ * \param [in]  cmesh      A committed cmesh.
+ * \param [in]  gtreeid    The global id of a tree of \a cmesh.
+ * \param [in]  ref_coords The reference coordinates of the point.
+ * \param [out] out_coords The physical coordinates of the point.
+ */
 void                t8_geometry_evaluate (t8_cmesh_t cmesh,
                                           t8_gloidx_t gtreeid,
                                           const double *ref_coords,
                                           double *out_coords);
 
+/**
+ * Evaluate the geometry of a tree at several reference points in one call.
+ * This is equivalent to calling \ref t8_geometry_evaluate for each point,
+ * but the tree's geometry and data are looked up only once and the geometry
+ * may map all points at once.
+ * \param [in]  cmesh      A committed cmesh.
+ * \param [in]  gtreeid    The global id of a tree of \a cmesh.
+ * \param [in]  ref_coords Array of 3 * \a num_coords reference coordinates.
+ *                         The i-th point starts at entry 3*i. Only the first
+ *                         dimension many entries of each point are used.
+ * \param [in]  num_coords The number of points.
+ * \param [out] out_coords Array of 3 * \a num_coords entries. On output the
+ *                         physical coordinates of the points.
+ */
+void                t8_geometry_evaluate_batch (t8_cmesh_t cmesh,
+                                                t8_gloidx_t gtreeid,
+                                                const double *ref_coords,
+                                                size_t num_coords,
+                                                double *out_coords);
+
+/**
+ * Evaluate the jacobian of the geometry of a tree at a reference point.
+ * This uses the context of the cmesh's geometry handler and is thus not
+ * thread-safe. Use \ref t8_geometry_context_jacobian if you need to evaluate
+ * concurrently.
+ * \param [in]  cmesh      A committed cmesh.
+ * \param [in]  gtreeid    The global id of a tree of \a cmesh.
+ * \param [in]  ref_coords The reference coordinates of the point.
+ * \param [out] jacobian   The jacobian at \a ref_coords.
+ */
 void                t8_geometry_jacobian (t8_cmesh_t cmesh,
                                           t8_gloidx_t gtreeid,
                                           const double *ref_coords,
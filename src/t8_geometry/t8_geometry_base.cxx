@@ -27,6 +27,75 @@
 #include <t8_geometry/t8_geometry_base.hxx>
 #include <t8_geometry/t8_geometry_base.h>
 
+/* Evaluate the geometry point by point. */
+/* *INDENT-OFF* */
+/* indent adds second const */
+void
+t8_geometry::t8_geom_evaluate_batch (t8_cmesh_t cmesh, t8_gloidx_t gtreeid,
+                                     const double *ref_coords,
+                                     size_t num_coords,
+                                     double *out_coords) const
+/* *INDENT-ON* */
+{
+  size_t              icoord;
+
+  for (icoord = 0; icoord < num_coords; ++icoord) {
+    t8_geom_evaluate (cmesh, gtreeid, ref_coords + 3 * icoord,
+                      out_coords + 3 * icoord);
+  }
+}
+
+/* Geometries without per tree data do not need to load anything. */
+/* *INDENT-OFF* */
+void
+t8_geometry::t8_geom_load_tree_context (t8_geometry_context_t *context) const
+/* *INDENT-ON* */
+{
+  context->tree_data = NULL;
+}
+
+/* *INDENT-OFF* */
+void
+t8_geometry::t8_geom_load_legacy (const t8_geometry_context_t *context) const
+/* *INDENT-ON* */
+{
+  if (legacy_cmesh != context->cmesh || legacy_tree != context->gtreeid) {
+    /* The tree data interface is not const, since it stores the
+     * tree's data in the geometry. */
+    const_cast < t8_geometry * >(this)->t8_geom_load_tree_data (context->cmesh,
+                                                                context->gtreeid);
+    legacy_cmesh = context->cmesh;
+    legacy_tree = context->gtreeid;
+  }
+}
+
+/* Evaluate via the tree data stored in the geometry. */
+/* *INDENT-OFF* */
+void
+t8_geometry::t8_geom_evaluate_context (const t8_geometry_context_t *context,
+                                       const double *ref_coords,
+                                       size_t num_coords,
+                                       double *out_coords) const
+/* *INDENT-ON* */
+{
+  t8_geom_load_legacy (context);
+  t8_geom_evaluate_batch (context->cmesh, context->gtreeid, ref_coords,
+                          num_coords, out_coords);
+}
+
+/* Compute the jacobian via the tree data stored in the geometry. */
+/* *INDENT-OFF* */
+void
+t8_geometry::t8_geom_jacobian_context (const t8_geometry_context_t *context,
+                                       const double *ref_coords,
+                                       double *jacobian) const
+/* *INDENT-ON* */
+{
+  t8_geom_load_legacy (context);
+  t8_geom_evalute_jacobian (context->cmesh, context->gtreeid, ref_coords,
+                            jacobian);
+}
+
 /* Load the coordinates of the newly active tree to the active_tree_vertices
  * variable. */
 void
@@ -53,6 +122,18 @@ t8_geometry_w_vertices::t8_geom_load_tree_data (t8_cmesh_t cmesh,
              || active_tree_class == T8_ECLASS_PYRAMID);
 }
 
+/* The vertices are already loaded into the context. */
+/* *INDENT-OFF* */
+void
+t8_geometry_w_vertices::t8_geom_load_tree_context (t8_geometry_context_t
+                                                   *context) const
+/* *INDENT-ON* */
+{
+  T8_ASSERT (t8_eclass_to_dimension[context->tree_class] == dimension);
+  T8_ASSERT (context->tree_class != T8_ECLASS_INVALID);
+  context->tree_data = NULL;
+}
+
 /** Get the dimension of a geometry.
  * \param [in]  geom  A geometry.
  * \return            The dimension of \a geom.
@@ -41,7 +41,7 @@ public:
   /* Basic constructor that sets the dimension, the name, and the name for the attribute. */
   t8_geometry (int dimension, const char *name, const char *attribute_name =
                NULL)
-:  dimension (dimension), name (name) {
+:  dimension (dimension), name (name), legacy_cmesh (NULL), legacy_tree (-1) {
   }
 
   /* Base constructor with no arguments. We need this since it
@@ -71,6 +71,24 @@ public:
                                         const double *ref_coords,
                                         double out_coords[3]) const = 0;
 
+  /**
+   * Map several points in the reference space $$[0,1]^dimension$$ of one tree to $$\mathbb R^3$$.
+   * The default implementation calls \a t8_geom_evaluate for each point. Geometries
+   * should override it if the points can be mapped more efficiently in one go.
+   * \param [in]  cmesh      The cmesh in which the points lie.
+   * \param [in]  gtreeid    The global tree (of the cmesh) in which the reference points are.
+   * \param [in]  ref_coords Array of 3 * \a num_coords entries. The entries 3*i, ..., 3*i + dimension - 1
+   *                         specify the i-th point in [0,1]^dimension, remaining entries are ignored.
+   * \param [in]  num_coords The number of points.
+   * \param [out] out_coords Array of 3 * \a num_coords entries. On output the mapped coordinates
+   *                         in physical space of the points in \a ref_coords.
+   */
+  virtual void        t8_geom_evaluate_batch (t8_cmesh_t cmesh,
+                                              t8_gloidx_t gtreeid,
+                                              const double *ref_coords,
+                                              size_t num_coords,
+                                              double *out_coords) const;
+
   /**
    * Compute the jacobian of the \a t8_geom_evaluate map at a point in the reference space $$[0,1]^dimension$$.
    * \param [in]  cmesh      The cmesh in which the point lies.
@@ -94,6 +112,49 @@ public:
   virtual void        t8_geom_load_tree_data (t8_cmesh_t cmesh,
                                               t8_gloidx_t gtreeid) = 0;
 
+  /** Load the geometry specific data of a tree into an evaluation context.
+   * This function is called whenever a context switches to a new tree.
+   * The cmesh, tree id, eclass and vertices in \a context are already set.
+   * The default implementation sets the context's tree data to NULL.
+   * \param [in,out] context    The context of the tree.
+   */
+  virtual void        t8_geom_load_tree_context (t8_geometry_context_t
+                                                 *context) const;
+
+  /**
+   * Map points in the reference space $$[0,1]^dimension$$ of the tree loaded in
+   * a context to $$\mathbb R^3$$.
+   * Geometries that override this function must only read per tree data
+   * from \a context, such that evaluation is thread-safe.
+   * The default implementation loads the tree via \a t8_geom_load_tree_data and calls
+   * \a t8_geom_evaluate_batch. It stores the loaded tree in the geometry and is
+   * thus not thread-safe.
+   * \param [in]  context    A context in which a tree with this geometry is loaded.
+   * \param [in]  ref_coords Array of 3 * \a num_coords entries, the i-th point starts at entry 3*i.
+   * \param [in]  num_coords The number of points.
+   * \param [out] out_coords Array of 3 * \a num_coords entries. The mapped coordinates in physical space.
+   */
+  virtual void        t8_geom_evaluate_context (const t8_geometry_context_t
+                                                *context,
+                                                const double *ref_coords,
+                                                size_t num_coords,
+                                                double *out_coords) const;
+
+  /**
+   * Compute the jacobian at a point in the reference space $$[0,1]^dimension$$
+   * of the tree loaded in a context.
+   * The default implementation loads the tree via \a t8_geom_load_tree_data and calls
+   * \a t8_geom_evalute_jacobian. It is thus not thread-safe.
+   * \param [in]  context    A context in which a tree with this geometry is loaded.
+   * \param [in]  ref_coords Array of \a dimension many entries, specifying a point in [0,1]^dimension.
+   * \param [out] jacobian   The jacobian at \a ref_coords. Array of size dimension x 3. Indices 3*i, 3*i+1, 3*i+2
+   *                         correspond to the i-th column of the jacobian (Entry 3*i + j is del f_j/del x_i).
+   */
+  virtual void        t8_geom_jacobian_context (const t8_geometry_context_t
+                                                *context,
+                                                const double *ref_coords,
+                                                double *jacobian) const;
+
   /**
    * Get the dimension of this geometry.
    * \return The dimension.
@@ -119,6 +180,18 @@ protected:
 
   const char         *name;
                     /**< The name of this geometry. */
+
+private:
+  /* Load the context's tree via t8_geom_load_tree_data, if it is not
+   * the tree that was loaded last. Used by the default context functions. */
+  void                t8_geom_load_legacy (const t8_geometry_context_t
+                                           *context) const;
+
+  mutable t8_cmesh_t  legacy_cmesh;
+                     /**< The cmesh of the tree last loaded via \a t8_geom_load_tree_data. */
+
+  mutable t8_gloidx_t legacy_tree;
+                      /**< The tree last loaded via \a t8_geom_load_tree_data. */
 };
 
 class               t8_geometry_w_vertices:public t8_geometry
@@ -160,6 +233,14 @@ public:
   virtual void        t8_geom_load_tree_data (t8_cmesh_t cmesh,
                                               t8_gloidx_t gtreeid);
 
+  /** Check that the tree loaded into a context is supported by this geometry.
+   * The tree's class and vertices are already stored in the context,
+   * so there is no further data to load.
+   * \param [in,out] context    The context of the tree.
+   */
+  virtual void        t8_geom_load_tree_context (t8_geometry_context_t
+                                                 *context) const;
+
 protected:
   t8_gloidx_t         active_tree;      /*< The tree of which currently vertices are loaded. */
   t8_eclass_t         active_tree_class;        /*< The class of the currently active tree. */
@@ -168,6 +168,159 @@ t8_geom_compute_linear_geometry (t8_eclass_t tree_class,
   }
 }
 
+/* Compute the coefficients of the linear map of a tree as a polynomial
+ * in the reference coordinates. The monomials are
+ *   line: 1, x
+ *   tri:  1, x, y
+ *   tet:  1, x, y, z
+ *   quad: 1, x, y, xy
+ *   hex:  1, x, y, z, xy, xz, yz, xyz
+ * coefficients[3 * k + j] is the coefficient of the k-th monomial
+ * for the j-th physical coordinate.
+ * Returns the number of monomials. */
+static int
+t8_geom_linear_coefficients (t8_eclass_t tree_class,
+                             const double *tree_vertices,
+                             double coefficients[24])
+{
+  const double       *v = tree_vertices;
+  int                 j;
+
+  for (j = 0; j < 3; j++) {
+    coefficients[j] = v[j];
+    switch (tree_class) {
+    case T8_ECLASS_LINE:
+      coefficients[3 + j] = v[3 + j] - v[j];
+      break;
+    case T8_ECLASS_TRIANGLE:
+      coefficients[3 + j] = v[3 + j] - v[j];
+      coefficients[6 + j] = v[6 + j] - v[3 + j];
+      break;
+    case T8_ECLASS_TET:
+      coefficients[3 + j] = v[3 + j] - v[j];
+      coefficients[6 + j] = v[9 + j] - v[6 + j];
+      coefficients[9 + j] = v[6 + j] - v[3 + j];
+      break;
+    case T8_ECLASS_QUAD:
+      coefficients[3 + j] = v[3 + j] - v[j];
+      coefficients[6 + j] = v[6 + j] - v[j];
+      coefficients[9 + j] = v[9 + j] - v[6 + j] - v[3 + j] + v[j];
+      break;
+    case T8_ECLASS_HEX:
+      coefficients[3 + j] = v[3 + j] - v[j];
+      coefficients[6 + j] = v[6 + j] - v[j];
+      coefficients[9 + j] = v[12 + j] - v[j];
+      coefficients[12 + j] = v[9 + j] - v[6 + j] - v[3 + j] + v[j];
+      coefficients[15 + j] = v[15 + j] - v[12 + j] - v[3 + j] + v[j];
+      coefficients[18 + j] = v[18 + j] - v[12 + j] - v[6 + j] + v[j];
+      coefficients[21 + j] = v[21 + j] - v[18 + j] - v[15 + j] + v[12 + j]
+        - v[9 + j] + v[6 + j] + v[3 + j] - v[j];
+      break;
+    default:
+      SC_ABORT_NOT_REACHED ();
+    }
+  }
+  switch (tree_class) {
+  case T8_ECLASS_LINE:
+    return 2;
+  case T8_ECLASS_TRIANGLE:
+    return 3;
+  case T8_ECLASS_TET:
+  case T8_ECLASS_QUAD:
+    return 4;
+  default:
+    return 8;
+  }
+}
+
+void
+t8_geom_compute_linear_geometry_batch (t8_eclass_t tree_class,
+                                       const double *tree_vertices,
+                                       const double *ref_coords,
+                                       size_t num_coords,
+                                       double *out_coords)
+{
+  double              c[24];
+  size_t              ip;
+  int                 j;
+
+  switch (tree_class) {
+  case T8_ECLASS_LINE:
+  case T8_ECLASS_TRIANGLE:
+  case T8_ECLASS_TET:
+  case T8_ECLASS_QUAD:
+  case T8_ECLASS_HEX:
+    break;
+  default:
+    /* Vertices, prisms and pyramids are mapped point by point. */
+    for (ip = 0; ip < num_coords; ++ip) {
+      t8_geom_compute_linear_geometry (tree_class, tree_vertices,
+                                       ref_coords + 3 * ip,
+                                       out_coords + 3 * ip);
+    }
+    return;
+  }
+
+  (void) t8_geom_linear_coefficients (tree_class, tree_vertices, c);
+  /* We evaluate the polynomial with the coefficients fixed for all points.
+   * The loops over the points have no dependencies and no branches, such
+   * that the compiler can vectorize them. */
+  switch (tree_class) {
+  case T8_ECLASS_LINE:
+    for (ip = 0; ip < num_coords; ++ip) {
+      const double        x = ref_coords[3 * ip];
+      for (j = 0; j < 3; j++) {
+        out_coords[3 * ip + j] = c[j] + c[3 + j] * x;
+      }
+    }
+    break;
+  case T8_ECLASS_TRIANGLE:
+    for (ip = 0; ip < num_coords; ++ip) {
+      const double        x = ref_coords[3 * ip];
+      const double        y = ref_coords[3 * ip + 1];
+      for (j = 0; j < 3; j++) {
+        out_coords[3 * ip + j] = c[j] + c[3 + j] * x + c[6 + j] * y;
+      }
+    }
+    break;
+  case T8_ECLASS_TET:
+    for (ip = 0; ip < num_coords; ++ip) {
+      const double        x = ref_coords[3 * ip];
+      const double        y = ref_coords[3 * ip + 1];
+      const double        z = ref_coords[3 * ip + 2];
+      for (j = 0; j < 3; j++) {
+        out_coords[3 * ip + j] = c[j] + c[3 + j] * x + c[6 + j] * y
+          + c[9 + j] * z;
+      }
+    }
+    break;
+  case T8_ECLASS_QUAD:
+    for (ip = 0; ip < num_coords; ++ip) {
+      const double        x = ref_coords[3 * ip];
+      const double        y = ref_coords[3 * ip + 1];
+      for (j = 0; j < 3; j++) {
+        out_coords[3 * ip + j] = c[j] + c[3 + j] * x + c[6 + j] * y
+          + c[9 + j] * x * y;
+      }
+    }
+    break;
+  case T8_ECLASS_HEX:
+    for (ip = 0; ip < num_coords; ++ip) {
+      const double        x = ref_coords[3 * ip];
+      const double        y = ref_coords[3 * ip + 1];
+      const double        z = ref_coords[3 * ip + 2];
+      for (j = 0; j < 3; j++) {
+        out_coords[3 * ip + j] = c[j] + c[3 + j] * x + c[6 + j] * y
+          + c[9 + j] * z + c[12 + j] * x * y + c[15 + j] * x * z
+          + c[18 + j] * y * z + c[21 + j] * x * y * z;
+      }
+    }
+    break;
+  default:
+    SC_ABORT_NOT_REACHED ();
+  }
+}
+
 void
 t8_geom_get_face_vertices (const t8_eclass_t tree_class,
                            const double *tree_vertices,
@@ -201,3 +354,114 @@ t8_geom_get_edge_vertices (const t8_eclass_t tree_class,
     }
   }
 }
+
+void
+t8_geom_compute_linear_jacobian (t8_eclass_t tree_class,
+                                 const double *tree_vertices,
+                                 const double *ref_coords, double *jacobian)
+{
+  const double       *v = tree_vertices;
+  const double        x = ref_coords[0];
+  double              c[24];
+  int                 j;
+
+  switch (tree_class) {
+  case T8_ECLASS_VERTEX:
+    /* The jacobian has no columns. */
+    break;
+  case T8_ECLASS_LINE:
+  case T8_ECLASS_TRIANGLE:
+  case T8_ECLASS_TET:
+    /* The map is affine, the columns are the coefficients of the
+     * linear monomials. */
+    (void) t8_geom_linear_coefficients (tree_class, tree_vertices, c);
+    memcpy (jacobian, c + 3,
+            3 * t8_eclass_to_dimension[tree_class] * sizeof (double));
+    break;
+  case T8_ECLASS_QUAD:
+    {
+      const double        y = ref_coords[1];
+      (void) t8_geom_linear_coefficients (tree_class, tree_vertices, c);
+      for (j = 0; j < 3; j++) {
+        jacobian[j] = c[3 + j] + c[9 + j] * y;
+        jacobian[3 + j] = c[6 + j] + c[9 + j] * x;
+      }
+    }
+    break;
+  case T8_ECLASS_HEX:
+    {
+      const double        y = ref_coords[1];
+      const double        z = ref_coords[2];
+      (void) t8_geom_linear_coefficients (tree_class, tree_vertices, c);
+      for (j = 0; j < 3; j++) {
+        jacobian[j] = c[3 + j] + c[12 + j] * y + c[15 + j] * z
+          + c[21 + j] * y * z;
+        jacobian[3 + j] = c[6 + j] + c[12 + j] * x + c[18 + j] * z
+          + c[21 + j] * x * z;
+        jacobian[6 + j] = c[9 + j] + c[15 + j] * x + c[18 + j] * y
+          + c[21 + j] * x * y;
+      }
+    }
+    break;
+  case T8_ECLASS_PRISM:
+    {
+      /* The prism is a triangle T(z) = T_0 + z (T_1 - T_0) that
+       * moves from the bottom triangle T_0 to the top triangle T_1. */
+      const double        y = ref_coords[1];
+      const double        z = ref_coords[2];
+      double              t0, t1, t2, d0, d1, d2;
+      for (j = 0; j < 3; j++) {
+        d0 = v[9 + j] - v[j];
+        d1 = v[12 + j] - v[3 + j];
+        d2 = v[15 + j] - v[6 + j];
+        t0 = v[j] + z * d0;
+        t1 = v[3 + j] + z * d1;
+        t2 = v[6 + j] + z * d2;
+        jacobian[j] = t1 - t0;
+        jacobian[3 + j] = t2 - t1;
+        jacobian[6 + j] = d0 + (d1 - d0) * x + (d2 - d1) * y;
+      }
+    }
+    break;
+  case T8_ECLASS_PYRAMID:
+    {
+      /* t8_geom_compute_linear_geometry projects the point from the apex
+       * onto the base quad, the projected point has the coordinates
+       * q = ((x - z) / (1 - z), (y - z) / (1 - z)) and the ratio of the
+       * projection is z. Thus the map is
+       *   (1 - z) B(q) + z v_4,
+       * where B(q) = b_0 + b_1 q_0 + b_2 q_1 + b_3 q_0 q_1 is the bilinear map
+       * of the base quad. Differentiating gives the columns
+       *   b_1 + b_3 q_1,  b_2 + b_3 q_0  and
+       *   v_4 - b_0 - b_1 - b_2 + b_3 (q_0 q_1 - q_0 - q_1).
+       * At the apex q is not defined. There we use the limit along the
+       * line from the center of the base to the apex, q = (1/2, 1/2). */
+      const double        y = ref_coords[1];
+      const double        z = ref_coords[2];
+      double              q0, q1, b0, b1, b2, b3;
+
+      if (z < 1) {
+        q0 = (x - z) / (1 - z);
+        q1 = (y - z) / (1 - z);
+      }
+      else {
+        /* The apex */
+        q0 = q1 = 0.5;
+      }
+      for (j = 0; j < 3; j++) {
+        b0 = v[j];
+        b1 = v[3 + j] - v[j];
+        b2 = v[6 + j] - v[j];
+        b3 = v[9 + j] - v[6 + j] - v[3 + j] + v[j];
+        jacobian[j] = b1 + b3 * q1;
+        jacobian[3 + j] = b2 + b3 * q0;
+        jacobian[6 + j] = v[12 + j] - b0 - b1 - b2
+          + b3 * (q0 * q1 - q0 - q1);
+      }
+    }
+    break;
+  default:
+    SC_ABORT ("Linear jacobian computation is supported only for "
+              "vertices/lines/triangles/tets/quads/prisms/hexes/pyramids.");
+  }
+}
@@ -38,6 +38,43 @@ void                t8_geom_compute_linear_geometry (t8_eclass_t tree_class,
                                                      const double *ref_coords,
                                                      double out_coords[3]);
 
+/** Map several points of a tree with linear geometry.
+ * For lines, triangles, quads, tets and hexes the coefficients of the map are
+ * computed once and all points are evaluated in a tight loop.
+ * All other classes are mapped point by point with \ref t8_geom_compute_linear_geometry.
+ * \param [in]    tree_class     The eclass of the tree.
+ * \param [in]    tree_vertices  Array with the tree vertex coordinates.
+ * \param [in]    ref_coords     Array of 3 * \a num_coords reference coordinates.
+ *                               The i-th point starts at entry 3*i.
+ * \param [in]    num_coords     The number of points.
+ * \param [out]   out_coords     Array of 3 * \a num_coords entries. On output the
+ *                               mapped points.
+ */
+void                t8_geom_compute_linear_geometry_batch (t8_eclass_t
+                                                           tree_class,
+                                                           const double
+                                                           *tree_vertices,
+                                                           const double
+                                                           *ref_coords,
+                                                           size_t num_coords,
+                                                           double
+                                                           *out_coords);
+
+/** Compute the jacobian of the linear geometry of a tree.
+ * \param [in]    tree_class     The eclass of the tree.
+ * \param [in]    tree_vertices  Array with the tree vertex coordinates.
+ * \param [in]    ref_coords     The reference coordinates of the point.
+ * \param [out]   jacobian       Array of 3 * dim entries, where dim is the dimension of
+ *                               \a tree_class. Entry 3*i + j is del f_j/del x_i.
+ * \note The jacobian of a pyramid is not continuous at its apex. There we return
+ *       the limit along the line from the center of the base to the apex.
+ */
+void                t8_geom_compute_linear_jacobian (t8_eclass_t tree_class,
+                                                     const double
+                                                     *tree_vertices,
+                                                     const double *ref_coords,
+                                                     double *jacobian);
+
 /** Interpolates linearly between 2, bilinearly between 4 or trilineraly between 8 points.
  * \param [in]    coefficients        An array of size at least dim giving the coefficients used for the interpolation
  * \param [in]    corner_values       An array of size 2^dim * 3, giving for each corner (in zorder) of
@@ -28,7 +28,9 @@ t8_geometry_analytic::t8_geometry_analytic (int dim, const char *name_in,
                                             jacobian_in,
                                             t8_geom_load_tree_data_fn
                                             load_tree_data_in,
-                                            const void *user_data_in)
+                                            const void *user_data_in,
+                                            t8_geom_analytic_batch_fn
+                                            analytical_batch_in)
 {
   T8_ASSERT (0 <= dim && dim <= 3);
 
@@ -39,6 +41,7 @@ t8_geometry_analytic::t8_geometry_analytic (int dim, const char *name_in,
   jacobian = jacobian_in;
   load_tree_data = load_tree_data_in;
   user_data = user_data_in;
+  analytical_batch = analytical_batch_in;
 }
 
 /**
@@ -61,6 +64,37 @@ t8_geometry_analytic::t8_geom_evaluate (t8_cmesh_t cmesh,
                        tree_data, user_data);
 }
 
+/**
+ * Map several points in the reference space $$[0,1]^dimension$$ of one tree to $$\mathbb R^3$$.
+ * \param [in]  gtreeid     The global tree (of the cmesh) in which the reference points are.
+ * \param [in]  ref_coords  Array of 3 * \a num_coords entries, the i-th point starts at entry 3*i.
+ * \param [in]  num_coords  The number of points.
+ * \param [out] out_coords  Array of 3 * \a num_coords entries. The mapped coordinates in physical space.
+ */
+/* *INDENT-OFF* */
+/* Indent has trouble with the const keyword at the end */
+void
+t8_geometry_analytic::t8_geom_evaluate_batch (t8_cmesh_t cmesh,
+                                              t8_gloidx_t gtreeid,
+                                              const double *ref_coords,
+                                              size_t num_coords,
+                                              double *out_coords) const
+/* *INDENT-ON* */
+{
+  if (analytical_batch != NULL) {
+    analytical_batch (cmesh, gtreeid, ref_coords, num_coords, out_coords,
+                      tree_data, user_data);
+    return;
+  }
+  T8_ASSERT (analytical_function != NULL);
+  /* Call the analytical function directly instead of going through
+   * the virtual t8_geom_evaluate for each point. */
+  for (size_t icoord = 0; icoord < num_coords; ++icoord) {
+    analytical_function (cmesh, gtreeid, ref_coords + 3 * icoord,
+                         out_coords + 3 * icoord, tree_data, user_data);
+  }
+}
+
 /**
  * Compute the jacobian of the \a t8_geom_evaluate map at a point in the reference space $$[0,1]^dimension$$.
  * \param [in]  gtreeid     The global tree (of the cmesh) in which the reference point is.
@@ -96,6 +130,58 @@ t8_geometry_analytic::t8_geom_load_tree_data (t8_cmesh_t cmesh,
   }
 }
 
+/* *INDENT-OFF* */
+/* Indent has trouble with the const keyword at the end */
+void
+t8_geometry_analytic::t8_geom_evaluate_context (const t8_geometry_context_t
+                                                *context,
+                                                const double *ref_coords,
+                                                size_t num_coords,
+                                                double *out_coords) const
+/* *INDENT-ON* */
+{
+  if (analytical_batch != NULL) {
+    analytical_batch (context->cmesh, context->gtreeid, ref_coords,
+                      num_coords, out_coords, context->tree_data, user_data);
+    return;
+  }
+  T8_ASSERT (analytical_function != NULL);
+  for (size_t icoord = 0; icoord < num_coords; ++icoord) {
+    analytical_function (context->cmesh, context->gtreeid,
+                         ref_coords + 3 * icoord, out_coords + 3 * icoord,
+                         context->tree_data, user_data);
+  }
+}
+
+/* *INDENT-OFF* */
+/* Indent has trouble with the const keyword at the end */
+void
+t8_geometry_analytic::t8_geom_jacobian_context (const t8_geometry_context_t
+                                                *context,
+                                                const double *ref_coords,
+                                                double *jacobian_out) const
+/* *INDENT-ON* */
+{
+  T8_ASSERT (jacobian != NULL);
+  jacobian (context->cmesh, context->gtreeid, ref_coords, jacobian_out,
+            context->tree_data, user_data);
+}
+
+/* *INDENT-OFF* */
+/* Indent has trouble with the const keyword at the end */
+void
+t8_geometry_analytic::t8_geom_load_tree_context (t8_geometry_context_t
+                                                 *context) const
+/* *INDENT-ON* */
+{
+  if (load_tree_data != NULL) {
+    load_tree_data (context->cmesh, context->gtreeid, &context->tree_data);
+  }
+  else {
+    context->tree_data = NULL;
+  }
+}
+
 void
 t8_geom_load_tree_data_vertices (t8_cmesh_t cmesh, t8_gloidx_t gtreeid,
                                  const void **vertices_out)
@@ -65,6 +65,26 @@ typedef void        (*t8_geom_analytic_jacobian_fn) (t8_cmesh_t cmesh,
                                                      const void *tree_data,
                                                      const void *user_data);
 
+/**
+ * Definition of a batched analytic geometry function.
+ * This function maps several reference points of one tree to physical
+ * coordinates.
+ * \param [in]  cmesh       The cmesh.
+ * \param [in]  gtreeid     The global tree (of the cmesh) in which the reference points are.
+ * \param [in]  ref_coords  Array of 3 * \a num_coords entries, the i-th point starts at entry 3*i.
+ * \param [in]  num_coords  The number of points.
+ * \param [out] out_coords  Array of 3 * \a num_coords entries. The mapped coordinates in physical space.
+ * \param [in]  tree_data   The data of the current tree as loaded by a \ref t8_geom_load_tree_data_fn.
+ * \param [in]  user_data   The user data pointer stored in the geometry.
+ */
+typedef void        (*t8_geom_analytic_batch_fn) (t8_cmesh_t cmesh,
+                                                  t8_gloidx_t gtreeid,
+                                                  const double *ref_coords,
+                                                  size_t num_coords,
+                                                  double *out_coords,
+                                                  const void *tree_data,
+                                                  const void *user_data);
+
 /* TODO: Document. */
 typedef void        (*t8_geom_load_tree_data_fn) (t8_cmesh_t cmesh,
                                                   t8_gloidx_t gtreeid,
@@ -81,12 +101,16 @@ public:
    * \param [in] analytical The analytical function to use for this geometry.
    * \param [in] jacobian   The jacobian of \a analytical.
    * \param [in] load_tree_data The function that is used to load a tree's data.
+   * \param [in] user_data  Additional user data that is passed to the functions.
+   * \param [in] analytical_batch Optional batched version of \a analytical.
+   *                       If NULL, batches are evaluated point by point with \a analytical.
    */
   t8_geometry_analytic (int dimension, const char *name,
                         t8_geom_analytic_fn analytical,
                         t8_geom_analytic_jacobian_fn jacobian,
                         t8_geom_load_tree_data_fn load_tree_data,
-                        const void *user_data);
+                        const void *user_data,
+                        t8_geom_analytic_batch_fn analytical_batch = NULL);
 
   /** The destructor. 
    * Clears the allocated memory.
@@ -109,6 +133,22 @@ public:
                                         const double *ref_coords,
                                         double out_coords[3]) const;
 
+  /**
+   * Map several points in the reference space $$[0,1]^dimension$$ of one tree to $$\mathbb R^3$$.
+   * Calls the batched analytical function if provided and the analytical function
+   * for each point otherwise.
+   * \param [in]  cmesh      The cmesh in which the points lie.
+   * \param [in]  gtreeid    The global tree (of the cmesh) in which the reference points are.
+   * \param [in]  ref_coords Array of 3 * \a num_coords entries, the i-th point starts at entry 3*i.
+   * \param [in]  num_coords The number of points.
+   * \param [out] out_coords Array of 3 * \a num_coords entries. The mapped coordinates in physical space.
+   */
+  virtual void        t8_geom_evaluate_batch (t8_cmesh_t cmesh,
+                                              t8_gloidx_t gtreeid,
+                                              const double *ref_coords,
+                                              size_t num_coords,
+                                              double *out_coords) const;
+
   /**
    * Compute the jacobian of the \a t8_geom_evaluate map at a point in the reference space $$[0,1]^dimension$$.
    * \param [in]  cmesh      The cmesh in which the point lies.
@@ -126,6 +166,39 @@ public:
                                                 const double *ref_coords,
                                                 double *jacobian) const;
 
+  /**
+   * Map points in the reference space of the tree loaded in a context to $$\mathbb R^3$$.
+   * The tree data is taken from \a context, such that this is thread-safe
+   * if the analytical functions are.
+   * \param [in]  context    A context in which a tree with this geometry is loaded.
+   * \param [in]  ref_coords Array of 3 * \a num_coords entries, the i-th point starts at entry 3*i.
+   * \param [in]  num_coords The number of points.
+   * \param [out] out_coords Array of 3 * \a num_coords entries. The mapped coordinates in physical space.
+   */
+  virtual void        t8_geom_evaluate_context (const t8_geometry_context_t
+                                                *context,
+                                                const double *ref_coords,
+                                                size_t num_coords,
+                                                double *out_coords) const;
+
+  /**
+   * Compute the jacobian at a point in the reference space of the tree loaded in a context.
+   * \param [in]  context    A context in which a tree with this geometry is loaded.
+   * \param [in]  ref_coords Array of \a dimension many entries, specifying a point in [0,1]^dimension.
+   * \param [out] jacobian   The jacobian at \a ref_coords.
+   */
+  virtual void        t8_geom_jacobian_context (const t8_geometry_context_t
+                                                *context,
+                                                const double *ref_coords,
+                                                double *jacobian) const;
+
+  /** Load the tree data into a context with the load_tree_data function
+   * given in the constructor.
+   * \param [in,out] context    The context of the tree.
+   */
+  virtual void        t8_geom_load_tree_context (t8_geometry_context_t
+                                                 *context) const;
+
   /** Update a possible internal data buffer for per tree data.
    * This function is called before the first coordinates in a new tree are
    * evaluated. You can use it for example to load the vertex coordinates of the 
@@ -146,6 +219,8 @@ private:
 
   t8_geom_analytic_jacobian_fn jacobian;   /**< Its jacobian. */
 
+  t8_geom_analytic_batch_fn analytical_batch; /**< The batched analytical function, may be NULL. */
+
   t8_geom_load_tree_data_fn load_tree_data; /**< The function to load the tree data. */
 
   const void         *tree_data;        /** Tree data pointer that can be set in \a load_tree_data and 
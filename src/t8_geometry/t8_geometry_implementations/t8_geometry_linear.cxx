@@ -64,6 +64,45 @@ t8_geometry_linear::t8_geom_evaluate (t8_cmesh_t cmesh,
                                    out_coords);
 }
 
+/**
+ * Map several points in the reference space $$[0,1]^dimension$$ of one tree to $$\mathbb R^3$$.
+ * \param [in]  cmesh      The cmesh in which the points lie.
+ * \param [in]  gtreeid    The global tree (of the cmesh) in which the reference points are.
+ * \param [in]  ref_coords Array of 3 * \a num_coords entries, the i-th point starts at entry 3*i.
+ * \param [in]  num_coords The number of points.
+ * \param [out] out_coords Array of 3 * \a num_coords entries. The mapped coordinates in physical space.
+ */
+/* *INDENT-OFF* */
+/* indent adds second const */
+void
+t8_geometry_linear::t8_geom_evaluate_batch (t8_cmesh_t cmesh,
+                                            t8_gloidx_t gtreeid,
+                                            const double *ref_coords,
+                                            size_t num_coords,
+                                            double *out_coords) const
+/* *INDENT-ON* */
+{
+  t8_geom_compute_linear_geometry_batch (active_tree_class,
+                                         active_tree_vertices, ref_coords,
+                                         num_coords, out_coords);
+}
+
+/* *INDENT-OFF* */
+/* indent adds second const */
+void
+t8_geometry_linear::t8_geom_evaluate_context (const t8_geometry_context_t
+                                              *context,
+                                              const double *ref_coords,
+                                              size_t num_coords,
+                                              double *out_coords) const
+/* *INDENT-ON* */
+{
+  T8_ASSERT (context->tree_vertices != NULL);
+  t8_geom_compute_linear_geometry_batch (context->tree_class,
+                                         context->tree_vertices, ref_coords,
+                                         num_coords, out_coords);
+}
+
 /**
  * Compute the jacobian of the \a t8_geom_evaluate map at a point in the reference space $$[0,1]^dimension$$.
  * \param [in]  cmesh      The cmesh in which the point lies.
@@ -82,7 +121,23 @@ t8_geometry_linear::t8_geom_evalute_jacobian (t8_cmesh_t cmesh,
                                               double *jacobian) const
 /* *INDENT-ON* */
 {
-  SC_ABORT ("Not implemented.");
+  t8_geom_compute_linear_jacobian (active_tree_class, active_tree_vertices,
+                                   ref_coords, jacobian);
+}
+
+/* *INDENT-OFF* */
+/* indent adds second const */
+void
+t8_geometry_linear::t8_geom_jacobian_context (const t8_geometry_context_t
+                                              *context,
+                                              const double *ref_coords,
+                                              double *jacobian) const
+/* *INDENT-ON* */
+{
+  T8_ASSERT (context->tree_vertices != NULL);
+  t8_geom_compute_linear_jacobian (context->tree_class,
+                                   context->tree_vertices, ref_coords,
+                                   jacobian);
 }
 
 T8_EXTERN_C_BEGIN ();
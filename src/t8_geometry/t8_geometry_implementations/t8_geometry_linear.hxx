@@ -62,6 +62,34 @@ public:
                                         const double *ref_coords,
                                         double out_coords[3]) const;
 
+  /**
+   * Map several points in the reference space $$[0,1]^dimension$$ of one tree to $$\mathbb R^3$$.
+   * \param [in]  cmesh      The cmesh in which the points lie.
+   * \param [in]  gtreeid    The global tree (of the cmesh) in which the reference points are.
+   * \param [in]  ref_coords Array of 3 * \a num_coords entries, the i-th point starts at entry 3*i.
+   * \param [in]  num_coords The number of points.
+   * \param [out] out_coords Array of 3 * \a num_coords entries. The mapped coordinates in physical space.
+   */
+  virtual void        t8_geom_evaluate_batch (t8_cmesh_t cmesh,
+                                              t8_gloidx_t gtreeid,
+                                              const double *ref_coords,
+                                              size_t num_coords,
+                                              double *out_coords) const;
+
+  /**
+   * Map points in the reference space of the tree loaded in a context to $$\mathbb R^3$$.
+   * Only reads the tree's class and vertices from \a context and is thus thread-safe.
+   * \param [in]  context    A context in which a tree with this geometry is loaded.
+   * \param [in]  ref_coords Array of 3 * \a num_coords entries, the i-th point starts at entry 3*i.
+   * \param [in]  num_coords The number of points.
+   * \param [out] out_coords Array of 3 * \a num_coords entries. The mapped coordinates in physical space.
+   */
+  virtual void        t8_geom_evaluate_context (const t8_geometry_context_t
+                                                *context,
+                                                const double *ref_coords,
+                                                size_t num_coords,
+                                                double *out_coords) const;
+
   /**
    * Compute the jacobian of the \a t8_geom_evaluate map at a point in the reference space $$[0,1]^dimension$$.
    * \param [in]  cmesh      The cmesh in which the point lies.
@@ -75,6 +103,19 @@ public:
                                                 const double *ref_coords,
                                                 double *jacobian) const;
 
+  /**
+   * Compute the jacobian at a point in the reference space of the tree loaded in a context.
+   * Only reads the tree's class and vertices from \a context and is thus thread-safe.
+   * \param [in]  context    A context in which a tree with this geometry is loaded.
+   * \param [in]  ref_coords Array of \a dimension many entries, specifying a point in [0,1]^dimension.
+   * \param [out] jacobian   The jacobian at \a ref_coords. Array of size dimension x 3. Indices 3*i, 3*i+1, 3*i+2
+   *                         correspond to the i-th column of the jacobian (Entry 3*i + j is del f_j/del x_i).
+   */
+  virtual void        t8_geom_jacobian_context (const t8_geometry_context_t
+                                                *context,
+                                                const double *ref_coords,
+                                                double *jacobian) const;
+
   /* Load tree data is inherited from t8_geometry_w_vertices. */
 
 };
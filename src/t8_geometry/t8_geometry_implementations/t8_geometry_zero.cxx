@@ -81,6 +81,31 @@ t8_geometry_zero::t8_geom_evalute_jacobian (t8_cmesh_t cmesh,
   memset (jacobian, 0, sizeof (double) * 3 * dimension);
 }
 
+/* *INDENT-OFF* */
+/* Indent has trouble with the const keyword at the end */
+void
+t8_geometry_zero::t8_geom_evaluate_context (const t8_geometry_context_t
+                                            *context,
+                                            const double *ref_coords,
+                                            size_t num_coords,
+                                            double *out_coords) const
+/* *INDENT-ON* */
+{
+  memset (out_coords, 0, sizeof (double) * 3 * num_coords);
+}
+
+/* *INDENT-OFF* */
+/* Indent has trouble with the const keyword at the end */
+void
+t8_geometry_zero::t8_geom_jacobian_context (const t8_geometry_context_t
+                                            *context,
+                                            const double *ref_coords,
+                                            double *jacobian) const
+/* *INDENT-ON* */
+{
+  memset (jacobian, 0, sizeof (double) * 3 * dimension);
+}
+
 inline void
 t8_geometry_zero::t8_geom_load_tree_data (t8_cmesh_t cmesh,
                                           t8_gloidx_t gtreeid)
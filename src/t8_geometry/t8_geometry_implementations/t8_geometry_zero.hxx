@@ -72,6 +72,32 @@ public:
                                                 const double *ref_coords,
                                                 double *jacobian) const;
 
+  /**
+   * Map points in the reference space to $$\mathbb R^3$$ using a context.
+   * \param [in]  context    A context in which a tree with this geometry is loaded.
+   * \param [in]  ref_coords Array of 3 * \a num_coords entries, the i-th point starts at entry 3*i.
+   * \param [in]  num_coords The number of points.
+   * \param [out] out_coords Array of 3 * \a num_coords entries.
+   * \note All entries in out_coords will be set to 0.
+   */
+  virtual void        t8_geom_evaluate_context (const t8_geometry_context_t
+                                                *context,
+                                                const double *ref_coords,
+                                                size_t num_coords,
+                                                double *out_coords) const;
+
+  /**
+   * Compute the jacobian at a point in the reference space using a context.
+   * \param [in]  context    A context in which a tree with this geometry is loaded.
+   * \param [in]  ref_coords Array of \a dimension many entries, specifying a point in [0,1]^dimension.
+   * \param [out] jacobian   The jacobian at \a ref_coords.
+   * \note All entries in \a jacobian will be set to zero.
+   */
+  virtual void        t8_geom_jacobian_context (const t8_geometry_context_t
+                                                *context,
+                                                const double *ref_coords,
+                                                double *jacobian) const;
+
   /** Update a possible internal data buffer for per tree data.
    * This function is called before the first coordinates in a new tree are
    * evaluated.
@@ -0,0 +1,179 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+#include <t8_geometry/t8_geometry_quadrature.h>
+
+/* Evaluate the Legendre polynomial P_n and its derivative at x in (-1,1). */
+static double
+t8_geom_quadrature_legendre (int n, double x, double *derivative)
+{
+  double              p0 = 1, p1 = x, p2;
+  int                 k;
+
+  /* Three term recursion, p1 = P_k, p0 = P_{k-1} */
+  for (k = 2; k <= n; k++) {
+    p2 = ((2 * k - 1) * x * p1 - (k - 1) * p0) / k;
+    p0 = p1;
+    p1 = p2;
+  }
+  /* P_n'(x) = n (x P_n(x) - P_{n-1}(x)) / (x^2 - 1) */
+  *derivative = n * (x * p1 - p0) / (x * x - 1);
+  return p1;
+}
+
+void
+t8_geom_quadrature_gauss_legendre (int num_points, double *points,
+                                   double *weights)
+{
+  const int           n = num_points;
+  double              x, dp, dx;
+  int                 i, iter;
+
+  T8_ASSERT (n >= 1);
+  /* The rule is symmetric, we compute the nodes in (0,1] of the
+   * rule on [-1,1] with Newton's method and map them to [0,1]. */
+  for (i = 0; i < (n + 1) / 2; i++) {
+    /* Initial guess for the i-th root of the Legendre polynomial P_n. */
+    x = cos (M_PI * (i + 0.75) / (n + 0.5));
+    for (iter = 0; iter < 100; iter++) {
+      dx = t8_geom_quadrature_legendre (n, x, &dp) / dp;
+      x -= dx;
+      if (fabs (dx) < 1e-15) {
+        break;
+      }
+    }
+    /* Evaluate the derivative at the final root for the weight. */
+    (void) t8_geom_quadrature_legendre (n, x, &dp);
+    points[i] = 0.5 * (1 - x);
+    points[n - 1 - i] = 0.5 * (1 + x);
+    weights[i] = weights[n - 1 - i] = 1. / ((1 - x * x) * dp * dp);
+  }
+}
+
+int
+t8_geom_quadrature_num_points (t8_eclass_t eclass, int num_points_1d)
+{
+  int                 num_points = 1, idim;
+
+  for (idim = 0; idim < t8_eclass_to_dimension[eclass]; idim++) {
+    num_points *= num_points_1d;
+  }
+  return num_points;
+}
+
+void
+t8_geom_quadrature_rule (t8_eclass_t eclass, int num_points_1d,
+                         double *points, double *weights)
+{
+  const int           n = num_points_1d;
+  double             *gl_points, *gl_weights;
+  double              u, v, w, weight;
+  int                 i, j, k, ipoint;
+
+  T8_ASSERT (n >= 1);
+  gl_points = T8_ALLOC (double, n);
+  gl_weights = T8_ALLOC (double, n);
+  t8_geom_quadrature_gauss_legendre (n, gl_points, gl_weights);
+  memset (points, 0,
+          3 * t8_geom_quadrature_num_points (eclass, n) * sizeof (double));
+
+  switch (eclass) {
+  case T8_ECLASS_VERTEX:
+    weights[0] = 1;
+    break;
+  case T8_ECLASS_LINE:
+    for (i = 0; i < n; i++) {
+      points[3 * i] = gl_points[i];
+      weights[i] = gl_weights[i];
+    }
+    break;
+  case T8_ECLASS_QUAD:
+  case T8_ECLASS_TRIANGLE:
+    for (j = 0, ipoint = 0; j < n; j++) {
+      for (i = 0; i < n; i++, ipoint++) {
+        u = gl_points[i];
+        v = gl_points[j];
+        weight = gl_weights[i] * gl_weights[j];
+        if (eclass == T8_ECLASS_QUAD) {
+          points[3 * ipoint] = u;
+          points[3 * ipoint + 1] = v;
+        }
+        else {
+          /* x = u, y = u v */
+          points[3 * ipoint] = u;
+          points[3 * ipoint + 1] = u * v;
+          weight *= u;
+        }
+        weights[ipoint] = weight;
+      }
+    }
+    break;
+  case T8_ECLASS_HEX:
+  case T8_ECLASS_TET:
+  case T8_ECLASS_PRISM:
+  case T8_ECLASS_PYRAMID:
+    for (k = 0, ipoint = 0; k < n; k++) {
+      for (j = 0; j < n; j++) {
+        for (i = 0; i < n; i++, ipoint++) {
+          u = gl_points[i];
+          v = gl_points[j];
+          w = gl_points[k];
+          weight = gl_weights[i] * gl_weights[j] * gl_weights[k];
+          switch (eclass) {
+          case T8_ECLASS_HEX:
+            points[3 * ipoint] = u;
+            points[3 * ipoint + 1] = v;
+            points[3 * ipoint + 2] = w;
+            break;
+          case T8_ECLASS_TET:
+            /* x = u, z = u v, y = u v w */
+            points[3 * ipoint] = u;
+            points[3 * ipoint + 1] = u * v * w;
+            points[3 * ipoint + 2] = u * v;
+            weight *= u * u * v;
+            break;
+          case T8_ECLASS_PRISM:
+            /* triangle (x,y) = (u, u v) times z = w */
+            points[3 * ipoint] = u;
+            points[3 * ipoint + 1] = u * v;
+            points[3 * ipoint + 2] = w;
+            weight *= u;
+            break;
+          default:
+            /* pyramid: z = w, x = w + (1 - w) u, y = w + (1 - w) v */
+            T8_ASSERT (eclass == T8_ECLASS_PYRAMID);
+            points[3 * ipoint] = w + (1 - w) * u;
+            points[3 * ipoint + 1] = w + (1 - w) * v;
+            points[3 * ipoint + 2] = w;
+            weight *= (1 - w) * (1 - w);
+          }
+          weights[ipoint] = weight;
+        }
+      }
+    }
+    break;
+  default:
+    SC_ABORT_NOT_REACHED ();
+  }
+  T8_FREE (gl_points);
+  T8_FREE (gl_weights);
+}
@@ -0,0 +1,81 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/** \file t8_geometry_quadrature.h
+ * Gauss quadrature rules on the reference elements of all eclasses.
+ * The reference elements are those used by the linear geometry:
+ *  - line:     [0,1]
+ *  - quad:     [0,1]^2
+ *  - hex:      [0,1]^3
+ *  - triangle: 0 <= y <= x <= 1
+ *  - tet:      0 <= y <= z <= x <= 1
+ *  - prism:    0 <= y <= x <= 1, 0 <= z <= 1
+ *  - pyramid:  0 <= z <= x, y <= 1
+ * Lines, quads and hexes use tensor Gauss-Legendre rules. The other classes
+ * use collapsed (Duffy) Gauss-Legendre rules, mapping the unit square or cube
+ * onto the element.
+ */
+
+#ifndef T8_GEOMETRY_QUADRATURE_H
+#define T8_GEOMETRY_QUADRATURE_H
+
+#include <t8.h>
+#include <t8_eclass.h>
+
+T8_EXTERN_C_BEGIN ();
+
+/** Compute the Gauss-Legendre rule with \a num_points points on [0,1].
+ * The rule integrates polynomials up to degree 2 * \a num_points - 1 exactly.
+ * \param [in]  num_points  The number of points, at least 1.
+ * \param [out] points      Array of \a num_points entries. On output the points.
+ * \param [out] weights     Array of \a num_points entries. On output the weights.
+ */
+void                t8_geom_quadrature_gauss_legendre (int num_points,
+                                                       double *points,
+                                                       double *weights);
+
+/** Return the number of points of the quadrature rule of an eclass.
+ * \param [in]  eclass        The eclass.
+ * \param [in]  num_points_1d The number of points per direction.
+ * \return                    \a num_points_1d to the power of the dimension of \a eclass.
+ */
+int                 t8_geom_quadrature_num_points (t8_eclass_t eclass,
+                                                   int num_points_1d);
+
+/** Compute the quadrature rule of an eclass on its reference element.
+ * The weights sum up to the volume of the reference element.
+ * \param [in]  eclass        The eclass.
+ * \param [in]  num_points_1d The number of points per direction.
+ * \param [out] points        Array of 3 * \ref t8_geom_quadrature_num_points entries.
+ *                            On output the points, the i-th point starts at entry 3*i.
+ *                            Unused coordinates are set to 0.
+ * \param [out] weights       Array of \ref t8_geom_quadrature_num_points entries.
+ *                            On output the weights.
+ */
+void                t8_geom_quadrature_rule (t8_eclass_t eclass,
+                                             int num_points_1d,
+                                             double *points,
+                                             double *weights);
+
+T8_EXTERN_C_END ();
+
+#endif /* !T8_GEOMETRY_QUADRATURE_H! */
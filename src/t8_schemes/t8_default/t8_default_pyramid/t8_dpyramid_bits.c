@@ -237,6 +237,10 @@ t8_dpyramid_is_inside_tet (const t8_dpyramid_t *tet, const int level,
  * 
  * \param[in] tet The input element
  * \return The level of the last ancestor with the shape of a tetrahedron  
+ * \note This function checks the ancestors level by level. It is not on the
+ * path of the SFC kernels, which use the cached switch_shape_at_level, and is
+ * only called when the level has to be computed from scratch, that is for face
+ * neighbors and extruded faces, and in debug assertions.
  */
 static int
 t8_dpyramid_compute_switch_shape_at_level (const t8_dpyramid_t *tet)
@@ -507,25 +511,28 @@ static int
 t8_dpyramid_update_index (t8_linearidx_t * id, const t8_dpyramid_type_t type,
                           const t8_linearidx_t pyra, const t8_linearidx_t tet)
 {
-  t8_linearidx_t      test = 0;
-  t8_linearidx_t      shift;
   T8_ASSERT (id != NULL);
   T8_ASSERT (*id >= 0);
-  int                 remain = -1;
-  do {
-    /* Iterate through the local-id. Get the current shift by the type of the
-     * current element*/
-    shift =
-      t8_dpyramid_parenttype_Iloc_to_type[type][remain + 1] >=
-      T8_DPYRAMID_FIRST_TYPE ? pyra : tet;
-    /*Add the shift to test */
-    test += shift;
-    remain++;
-  } while (test <= (*id));
-  /*test is now larger than id, subtract last shift from test */
-  test -= shift;
+  T8_ASSERT (type >= T8_DPYRAMID_FIRST_TYPE);
+  const int          *num_pyra =
+    t8_dpyramid_parenttype_iloc_pyra_w_lower_id[type -
+                                                T8_DPYRAMID_FIRST_TYPE];
+  t8_linearidx_t      offset = 0;
+  int                 remain = 0;
+  /* The children are sorted by their id. The offset of a child is the number
+   * of pyramids and tets in its predecessors. Find the last child whose offset
+   * is not larger than id. */
+  for (int ichild = 1; ichild < T8_DPYRAMID_CHILDREN; ichild++) {
+    const t8_linearidx_t next =
+      num_pyra[ichild] * pyra + (ichild - num_pyra[ichild]) * tet;
+    if (next > *id) {
+      break;
+    }
+    offset = next;
+    remain = ichild;
+  }
   /*Compute the remaining ID */
-  (*id) -= test;
+  (*id) -= offset;
   T8_ASSERT (0 <= remain && remain < T8_DPYRAMID_CHILDREN);
   return remain;
 }
@@ -608,18 +615,51 @@ t8_dpyramid_type_at_level (const t8_dpyramid_t *p, const int level)
     return compute_type_same_shape (p, level);
   }
   else {
-    /* The shape switches */
+    /* The shape switches. The parent of the ancestor at switch_shape_at_level
+     * is a pyramid whose type only depends on the z-coordinate. */
     T8_ASSERT (t8_dpyramid_shape (p) == T8_ECLASS_TET);
-    t8_dpyramid_t       anc;
-    t8_dpyramid_ancestor (p, p->switch_shape_at_level, &anc);
-    t8_dpyramid_parent (&anc, &anc);
-    if (level == anc.pyramid.level) {
-      /* We have already reached the desired level and can return. */
-      return anc.pyramid.type;
-    }
-    else {
-      return compute_type_same_shape (&anc, level);
-    }
+    const int           pyra_level = p->switch_shape_at_level - 1;
+    const t8_dpyramid_type_t pyra_type =
+      (p->pyramid.z & T8_DPYRAMID_LEN (p->switch_shape_at_level)) ?
+      T8_DPYRAMID_SECOND_TYPE : T8_DPYRAMID_FIRST_TYPE;
+    return compute_type_same_shape_ext (p, level, pyra_type, pyra_level);
+  }
+}
+
+/**
+ * Given the type of the ancestor of \a p at \a level, compute the local id of
+ * this ancestor and the type of its parent.
+ * 
+ * \param[in]  p         Input pyramid
+ * \param[in]  level     The level of the ancestor, 0 < \a level <= level of \a p
+ * \param[in]  type      The type of the ancestor of \a p at \a level
+ * \param[out] local_id  On output the child id of the ancestor within its parent
+ * \return               The type of the ancestor of \a p at \a level - 1
+ */
+static t8_dpyramid_type_t
+t8_dpyramid_ancestor_local_id (const t8_dpyramid_t *p, const int level,
+                               const t8_dpyramid_type_t type, int *local_id)
+{
+  T8_ASSERT (0 < level && level <= T8_DPYRAMID_MAXLEVEL);
+  const t8_dpyramid_cube_id_t cube_id = compute_cubeid (p, level);
+
+  if (type >= T8_DPYRAMID_FIRST_TYPE) {
+    /* A pyramid in a pyramid */
+    *local_id = t8_dpyramid_type_cid_to_Iloc[type][cube_id];
+    return t8_dpyramid_type_cid_to_parenttype[type -
+                                              T8_DPYRAMID_FIRST_TYPE]
+      [cube_id];
+  }
+  else if (level == p->switch_shape_at_level) {
+    /* A tetrahedron in a pyramid */
+    *local_id = t8_dpyramid_type_cid_to_Iloc[type][cube_id];
+    return (cube_id & 0x04) ? T8_DPYRAMID_SECOND_TYPE :
+      T8_DPYRAMID_FIRST_TYPE;
+  }
+  else {
+    /* A tetrahedron in a tetrahedron */
+    *local_id = t8_dtet_type_cid_to_Iloc[type][cube_id];
+    return t8_dpyramid_cid_type_to_parenttype[cube_id][type];
   }
 }
 
@@ -628,42 +668,44 @@ t8_dpyramid_linear_id (const t8_dpyramid_t *p, const int level)
 {
   T8_ASSERT (0 <= p->pyramid.level
              && p->pyramid.level <= T8_DPYRAMID_MAXLEVEL);
+  T8_ASSERT (0 <= level && level <= T8_DPYRAMID_MAXLEVEL);
   t8_linearidx_t      id = 0, sum_1 = 1, sum_2 = 1;
-  t8_dpyramid_t       parent, copy;
+  t8_dpyramid_type_t  type = p->pyramid.type;
+  int                 local_id, start_level = level;
 
-  t8_dpyramid_copy (p, &copy);
-  copy.pyramid.type = t8_dpyramid_type_at_level (p, level);
-  copy.pyramid.level = level;
-  t8_dpyramid_cut_coordinates (&copy, T8_DPYRAMID_MAXLEVEL - level);
+  if (level > p->pyramid.level) {
+    /* The descendants of p at its origin are the first children
+     * and do not contribute to the id, only the shifts grow. */
+    sum_1 = ((t8_linearidx_t) 1) << (3 * (level - p->pyramid.level));
+    sum_2 = sc_intpow64u (6, level - p->pyramid.level);
+    start_level = p->pyramid.level;
+  }
+  else {
+    /* Compute the type of p's ancestor at level */
+    for (int i = p->pyramid.level; i > level; i--) {
+      type = t8_dpyramid_ancestor_local_id (p, i, type, &local_id);
+    }
+  }
 
-  for (int i = level; i > 0; i--) {
+  for (int i = start_level; i > 0; i--) {
     /* Compute the number of pyramids with level maxlvl that are in a pyramid
      * of level i*/
     const t8_linearidx_t pyra_shift = (sum_1 << 1) - sum_2;
-
-    /*Compute the parent and the local id of the current element */
-    t8_dpyramid_parent (&copy, &parent);
-    const t8_linearidx_t local_id = t8_dpyramid_child_id (&copy);
+    const t8_dpyramid_type_t parent_type =
+      t8_dpyramid_ancestor_local_id (p, i, type, &local_id);
 
     /* Compute the number of predecessors within the parent that have the
-     * shape of a pyramid or a tet*/
-    int                 num_pyra;
-    if (t8_dpyramid_shape (&parent) == T8_ECLASS_TET) {
-      /* If the parent is a tet, no predecessors are pyramids */
-      num_pyra = 0;
-    }
-    else {
-      /* The number of pyramid-predecessors */
-      num_pyra =
-        t8_dpyramid_parenttype_iloc_pyra_w_lower_id[parent.pyramid.type -
-                                                    T8_DPYRAMID_FIRST_TYPE]
-        [local_id];
-    }
+     * shape of a pyramid or a tet. If the parent is a tet, no predecessors
+     * are pyramids. */
+    const int           num_pyra = parent_type < T8_DPYRAMID_FIRST_TYPE ? 0 :
+      t8_dpyramid_parenttype_iloc_pyra_w_lower_id[parent_type -
+                                                  T8_DPYRAMID_FIRST_TYPE]
+      [local_id];
     /* The number of tets is the local-id minus the number of pyramid-predecessors */
     const int           num_tet = local_id - num_pyra;
     /* The Id shifts by the number of predecessor elements */
     id += num_pyra * pyra_shift + num_tet * sum_1;
-    t8_dpyramid_copy (&parent, &copy);
+    type = parent_type;
     /* Update the shift */
     sum_1 = sum_1 << 3;
     sum_2 *= 6;
@@ -1636,49 +1678,45 @@ t8_dpyramid_shape (const t8_dpyramid_t *p)
 
 }
 
-static void
-t8_dpyramid_successor_recursion (const t8_dpyramid_t *elem,
-                                 t8_dpyramid_t *succ, const int level)
+void
+t8_dpyramid_successor (const t8_dpyramid_t *elem, t8_dpyramid_t *succ,
+                       const int level)
 {
   T8_ASSERT (1 <= level && level <= T8_DPYRAMID_MAXLEVEL);
+  int                 succ_level = level;
+
   t8_dpyramid_copy (elem, succ);
   succ->pyramid.level = level;
   if (level < succ->switch_shape_at_level) {
     succ->switch_shape_at_level = -1;
   }
   T8_ASSERT (succ->pyramid.type >= 0);
-  const int           child_id = t8_dpyramid_child_id (elem);
-  /*Compute number of children */
-  const int           num_siblings = t8_dpyramid_num_siblings (elem);
-  T8_ASSERT (0 <= child_id && child_id < num_siblings);
-  if (child_id == num_siblings - 1) {
-    int                 shift = T8_DPYRAMID_MAXLEVEL - level + 1;
-    /* Last-child-case. The successor is the successor of the parent element,
-     * but with the given level */
-    t8_dpyramid_successor_recursion (succ, succ, level - 1);
-    succ->pyramid.level = level;
-    /* bits auf level auf child 0 setzen */
-    t8_dpyramid_cut_coordinates (succ, shift);
+  /* Go up while the element is the last child of its parent. The last child
+   * has the same type as its parent, so only the level changes. */
+  int                 child_id = t8_dpyramid_child_id (succ);
+  while (child_id == t8_dpyramid_num_siblings (succ) - 1) {
+    succ_level--;
+    T8_ASSERT (succ_level >= 1);
+    succ->pyramid.level = succ_level;
+    if (succ_level < succ->switch_shape_at_level) {
+      succ->switch_shape_at_level = -1;
+    }
+    child_id = t8_dpyramid_child_id (succ);
   }
-  else {
-    /* Not the last element. Compute child with local ID child_id+1 */
-    t8_dpyramid_parent (succ, succ);
-    t8_dpyramid_child (succ, child_id + 1, succ);
+  /* Compute the child with local ID child_id+1 */
+  t8_dpyramid_parent (succ, succ);
+  t8_dpyramid_child (succ, child_id + 1, succ);
+  if (succ_level < level) {
+    /* The successor is the first descendant at level */
     succ->pyramid.level = level;
+    t8_dpyramid_cut_coordinates (succ, T8_DPYRAMID_MAXLEVEL - succ_level);
   }
-}
-
-void
-t8_dpyramid_successor (const t8_dpyramid_t *elem, t8_dpyramid_t *succ,
-                       const int level)
-{
-  t8_dpyramid_successor_recursion (elem, succ, level);
 #ifdef T8_ENABLE_DEBUG
   if (t8_dpyramid_shape (succ) == T8_ECLASS_PYRAMID) {
     T8_ASSERT (succ->switch_shape_at_level < 0);
   }
   else {
-    T8_ASSERT (succ->switch_shape_at_level =
+    T8_ASSERT (succ->switch_shape_at_level ==
                t8_dpyramid_compute_switch_shape_at_level (succ));
   }
 #endif
@@ -854,6 +854,19 @@ t8_default_scheme_quad_c::t8_element_init (int length, t8_element_t *elem,
 #endif
 }
 
+void
+t8_default_scheme_quad_c::t8_element_new_in_buffer (int length, void *buffer,
+                                                    t8_element_t **elem)
+{
+  int                 i;
+
+  t8_eclass_scheme_c::t8_element_new_in_buffer (length, buffer, elem);
+  /* The topological dimension is not set by t8_element_init in release mode */
+  for (i = 0; i < length; i++) {
+    T8_QUAD_SET_TDIM ((p4est_quadrant_t *) elem[i], 2);
+  }
+}
+
 /** Returns true, if there is one element in the tree, that does not refine into 2^dim children.
  * Returns false otherwise.
  */
@@ -127,6 +127,17 @@ public:
   virtual void        t8_element_init (int length, t8_element_t *elem,
                                        int called_new);
 
+  /** Initialize an array of quad elements in caller provided memory.
+   * Like \ref t8_element_new, this sets the topological dimension of each
+   * quad, which \ref t8_element_init only does in debugging mode.
+   * \param [in] length      The number of quad elements.
+   * \param [in,out] buffer  Memory of at least \a length * \ref t8_element_size bytes.
+   * \param [out] elem       Array of \a length element pointers into \a buffer.
+   * \see t8_eclass_scheme::t8_element_new_in_buffer
+   */
+  virtual void        t8_element_new_in_buffer (int length, void *buffer,
+                                                t8_element_t **elem);
+
   /** Return the refinement level of an element.
    * \param [in] elem    The element whose level should be returned.
    * \return             The level of \b elem.
@@ -148,3 +148,167 @@ const int           t8_dtet_parent_type_type_to_face[6][6] =
   { {-1, 0, 2, -1, 1, 3}, {0, -1, 3, 1, -1, 2}, {1, 3, -1, 0, 2, -1},
 {-1, 2, 0, -1, 3, 1}, {2, -1, 1, 3, -1, 0}, {3, 1, -1, 2, 0, -1}
 };
+
+/* Line b, row c gives the local indices of 2 consecutive levels of
+ * a simplex with type b and cube-ids c (finest level in the lowest bits). */
+const uint8_t       t8_dtet_type_cids_to_Ilocs[6][64] = {
+  {
+    0, 1, 1, 4, 1, 4, 4, 7, 8, 9, 17, 12, 25, 12, 20, 15,
+    8, 9, 25, 20, 25, 12, 20, 15, 32, 33, 33, 44, 49, 36, 52, 39,
+    8, 9, 9, 20, 25, 12, 28, 15, 32, 33, 49, 44, 49, 36, 44, 39,
+    32, 33, 41, 36, 49, 36, 44, 39, 56, 57, 57, 60, 57, 60, 60, 63
+  },
+  {
+    0, 1, 2, 5, 2, 5, 4, 7, 8, 9, 18, 13, 26, 13, 28, 15,
+    16, 17, 26, 21, 26, 13, 12, 23, 40, 41, 34, 45, 50, 37, 44, 47,
+    16, 17, 10, 21, 26, 13, 20, 23, 40, 41, 50, 45, 50, 37, 36, 47,
+    32, 33, 42, 37, 50, 37, 52, 39, 56, 57, 58, 61, 58, 61, 60, 63
+  },
+  {
+    0, 2, 3, 4, 1, 6, 5, 7, 16, 10, 19, 20, 17, 14, 29, 23,
+    24, 18, 27, 28, 17, 14, 13, 31, 32, 42, 35, 36, 49, 38, 45, 39,
+    8, 18, 11, 12, 25, 14, 21, 15, 48, 42, 51, 52, 41, 38, 37, 55,
+    40, 34, 43, 44, 41, 38, 53, 47, 56, 58, 59, 60, 57, 62, 61, 63
+  },
+  {
+    0, 3, 1, 5, 2, 4, 6, 7, 24, 11, 25, 21, 18, 28, 30, 31,
+    8, 19, 9, 29, 18, 28, 14, 15, 40, 43, 41, 37, 50, 52, 46, 47,
+    16, 19, 17, 13, 26, 28, 22, 23, 32, 43, 33, 53, 42, 52, 38, 39,
+    48, 35, 49, 45, 42, 52, 54, 55, 56, 59, 57, 61, 58, 60, 62, 63
+  },
+  {
+    0, 2, 2, 6, 3, 5, 5, 7, 16, 10, 26, 22, 19, 29, 21, 23,
+    16, 10, 10, 30, 19, 29, 21, 23, 48, 34, 42, 38, 51, 53, 53, 55,
+    24, 10, 18, 14, 27, 29, 29, 31, 40, 34, 34, 54, 43, 53, 45, 47,
+    40, 34, 50, 46, 43, 53, 45, 47, 56, 58, 58, 62, 59, 61, 61, 63
+  },
+  {
+    0, 3, 3, 6, 3, 6, 6, 7, 24, 11, 27, 14, 27, 30, 22, 31,
+    24, 11, 11, 22, 27, 30, 22, 31, 48, 35, 43, 46, 51, 54, 54, 55,
+    24, 11, 19, 22, 27, 30, 30, 31, 48, 35, 35, 46, 51, 54, 46, 55,
+    48, 35, 51, 38, 51, 54, 46, 55, 56, 59, 59, 62, 59, 62, 62, 63
+  }
+};
+
+/* Line b, row c gives the type of the ancestor 2 levels up of
+ * a simplex with type b and cube-ids c. */
+const int8_t        t8_dtet_type_cids_to_parenttype[6][64] = {
+  {
+    0, 0, 2, 1, 5, 0, 4, 0, 0, 0, 1, 1, 0, 0, 0, 0,
+    2, 2, 2, 2, 3, 2, 3, 2, 1, 1, 2, 1, 1, 1, 2, 1,
+    5, 5, 4, 5, 5, 5, 4, 5, 0, 0, 0, 0, 5, 0, 5, 0,
+    4, 4, 3, 3, 4, 4, 4, 4, 0, 0, 2, 1, 5, 0, 4, 0
+  },
+  {
+    1, 1, 2, 1, 5, 0, 3, 1, 1, 1, 1, 1, 0, 0, 1, 1,
+    2, 2, 2, 2, 3, 2, 3, 2, 1, 1, 2, 1, 1, 1, 2, 1,
+    5, 5, 4, 5, 5, 5, 4, 5, 0, 0, 0, 0, 5, 0, 5, 0,
+    3, 3, 3, 3, 4, 4, 3, 3, 1, 1, 2, 1, 5, 0, 3, 1
+  },
+  {
+    2, 1, 2, 2, 4, 0, 3, 2, 1, 1, 1, 1, 0, 0, 1, 1,
+    2, 2, 2, 2, 3, 2, 3, 2, 2, 1, 2, 2, 2, 1, 2, 2,
+    4, 5, 4, 4, 4, 5, 4, 4, 0, 0, 0, 0, 5, 0, 5, 0,
+    3, 3, 3, 3, 4, 4, 3, 3, 2, 1, 2, 2, 4, 0, 3, 2
+  },
+  {
+    3, 1, 3, 2, 4, 5, 3, 3, 1, 1, 1, 1, 0, 0, 1, 1,
+    3, 2, 3, 2, 3, 3, 3, 3, 2, 1, 2, 2, 2, 1, 2, 2,
+    4, 5, 4, 4, 4, 5, 4, 4, 5, 0, 5, 0, 5, 5, 5, 5,
+    3, 3, 3, 3, 4, 4, 3, 3, 3, 1, 3, 2, 4, 5, 3, 3
+  },
+  {
+    4, 0, 3, 2, 4, 5, 4, 4, 0, 0, 1, 1, 0, 0, 0, 0,
+    3, 2, 3, 2, 3, 3, 3, 3, 2, 1, 2, 2, 2, 1, 2, 2,
+    4, 5, 4, 4, 4, 5, 4, 4, 5, 0, 5, 0, 5, 5, 5, 5,
+    4, 4, 3, 3, 4, 4, 4, 4, 4, 0, 3, 2, 4, 5, 4, 4
+  },
+  {
+    5, 0, 3, 1, 5, 5, 4, 5, 0, 0, 1, 1, 0, 0, 0, 0,
+    3, 2, 3, 2, 3, 3, 3, 3, 1, 1, 2, 1, 1, 1, 2, 1,
+    5, 5, 4, 5, 5, 5, 4, 5, 5, 0, 5, 0, 5, 5, 5, 5,
+    4, 4, 3, 3, 4, 4, 4, 4, 5, 0, 3, 1, 5, 5, 4, 5
+  }
+};
+
+/* Line b, row I gives the cube-ids of 2 consecutive levels of
+ * the descendant with local indices I of a simplex with type b. */
+const uint8_t       t8_dtet_parenttype_Ilocs_to_cids[6][64] = {
+  {
+    0, 1, 1, 1, 5, 5, 5, 7, 8, 9, 9, 9, 13, 13, 13, 15,
+    8, 12, 12, 12, 14, 14, 14, 15, 8, 12, 12, 12, 13, 13, 13, 15,
+    40, 41, 41, 41, 45, 45, 45, 47, 40, 41, 41, 41, 43, 43, 43, 47,
+    40, 42, 42, 42, 43, 43, 43, 47, 56, 57, 57, 57, 61, 61, 61, 63
+  },
+  {
+    0, 1, 1, 1, 3, 3, 3, 7, 8, 9, 9, 9, 11, 11, 11, 15,
+    8, 10, 10, 10, 11, 11, 11, 15, 8, 10, 10, 10, 14, 14, 14, 15,
+    24, 25, 25, 25, 29, 29, 29, 31, 24, 25, 25, 25, 27, 27, 27, 31,
+    24, 28, 28, 28, 29, 29, 29, 31, 56, 57, 57, 57, 59, 59, 59, 63
+  },
+  {
+    0, 2, 2, 2, 3, 3, 3, 7, 16, 17, 17, 17, 21, 21, 21, 23,
+    16, 17, 17, 17, 19, 19, 19, 23, 16, 18, 18, 18, 19, 19, 19, 23,
+    24, 26, 26, 26, 27, 27, 27, 31, 24, 26, 26, 26, 30, 30, 30, 31,
+    24, 28, 28, 28, 30, 30, 30, 31, 56, 58, 58, 58, 59, 59, 59, 63
+  },
+  {
+    0, 2, 2, 2, 6, 6, 6, 7, 16, 18, 18, 18, 22, 22, 22, 23,
+    16, 20, 20, 20, 22, 22, 22, 23, 16, 20, 20, 20, 21, 21, 21, 23,
+    48, 49, 49, 49, 51, 51, 51, 55, 48, 50, 50, 50, 51, 51, 51, 55,
+    48, 50, 50, 50, 54, 54, 54, 55, 56, 58, 58, 58, 62, 62, 62, 63
+  },
+  {
+    0, 4, 4, 4, 6, 6, 6, 7, 32, 34, 34, 34, 35, 35, 35, 39,
+    32, 34, 34, 34, 38, 38, 38, 39, 32, 36, 36, 36, 38, 38, 38, 39,
+    48, 49, 49, 49, 53, 53, 53, 55, 48, 52, 52, 52, 54, 54, 54, 55,
+    48, 52, 52, 52, 53, 53, 53, 55, 56, 60, 60, 60, 62, 62, 62, 63
+  },
+  {
+    0, 4, 4, 4, 5, 5, 5, 7, 32, 33, 33, 33, 37, 37, 37, 39,
+    32, 33, 33, 33, 35, 35, 35, 39, 32, 36, 36, 36, 37, 37, 37, 39,
+    40, 42, 42, 42, 46, 46, 46, 47, 40, 44, 44, 44, 46, 46, 46, 47,
+    40, 44, 44, 44, 45, 45, 45, 47, 56, 60, 60, 60, 61, 61, 61, 63
+  }
+};
+
+/* Line b, row I gives the type of the descendant 2 levels down with
+ * local indices I of a simplex with type b. */
+const int8_t        t8_dtet_parenttype_Ilocs_to_type[6][64] = {
+  {
+    0, 0, 4, 5, 0, 1, 2, 0, 0, 0, 4, 5, 0, 1, 2, 0,
+    4, 2, 3, 4, 0, 4, 5, 4, 5, 0, 1, 5, 3, 4, 5, 5,
+    0, 0, 4, 5, 0, 1, 2, 0, 1, 1, 2, 3, 0, 1, 5, 1,
+    2, 0, 1, 2, 2, 3, 4, 2, 0, 0, 4, 5, 0, 1, 2, 0
+  },
+  {
+    1, 1, 2, 3, 0, 1, 5, 1, 1, 1, 2, 3, 0, 1, 5, 1,
+    2, 0, 1, 2, 2, 3, 4, 2, 3, 3, 4, 5, 1, 2, 3, 3,
+    0, 0, 4, 5, 0, 1, 2, 0, 1, 1, 2, 3, 0, 1, 5, 1,
+    5, 0, 1, 5, 3, 4, 5, 5, 1, 1, 2, 3, 0, 1, 5, 1
+  },
+  {
+    2, 0, 1, 2, 2, 3, 4, 2, 0, 0, 4, 5, 0, 1, 2, 0,
+    1, 1, 2, 3, 0, 1, 5, 1, 2, 0, 1, 2, 2, 3, 4, 2,
+    2, 0, 1, 2, 2, 3, 4, 2, 3, 3, 4, 5, 1, 2, 3, 3,
+    4, 2, 3, 4, 0, 4, 5, 4, 2, 0, 1, 2, 2, 3, 4, 2
+  },
+  {
+    3, 3, 4, 5, 1, 2, 3, 3, 3, 3, 4, 5, 1, 2, 3, 3,
+    4, 2, 3, 4, 0, 4, 5, 4, 5, 0, 1, 5, 3, 4, 5, 5,
+    1, 1, 2, 3, 0, 1, 5, 1, 2, 0, 1, 2, 2, 3, 4, 2,
+    3, 3, 4, 5, 1, 2, 3, 3, 3, 3, 4, 5, 1, 2, 3, 3
+  },
+  {
+    4, 2, 3, 4, 0, 4, 5, 4, 2, 0, 1, 2, 2, 3, 4, 2,
+    3, 3, 4, 5, 1, 2, 3, 3, 4, 2, 3, 4, 0, 4, 5, 4,
+    0, 0, 4, 5, 0, 1, 2, 0, 4, 2, 3, 4, 0, 4, 5, 4,
+    5, 0, 1, 5, 3, 4, 5, 5, 4, 2, 3, 4, 0, 4, 5, 4
+  },
+  {
+    5, 0, 1, 5, 3, 4, 5, 5, 0, 0, 4, 5, 0, 1, 2, 0,
+    1, 1, 2, 3, 0, 1, 5, 1, 5, 0, 1, 5, 3, 4, 5, 5,
+    3, 3, 4, 5, 1, 2, 3, 3, 4, 2, 3, 4, 0, 4, 5, 4,
+    5, 0, 1, 5, 3, 4, 5, 5, 5, 0, 1, 5, 3, 4, 5, 5
+  }
+};
@@ -34,6 +34,9 @@ T8_EXTERN_C_BEGIN ();
 /** The spatial dimension */
 #define T8_DTET_DIM (3)
 
+/** The number of levels processed in one step by the linear id lookup tables. */
+#define T8_DTET_LUT_LEVELS (2)
+
 /** Store the type of parent for each (cube-id,type) combination. */
 extern const int    t8_dtet_cid_type_to_parenttype[8][6];
 
@@ -107,6 +110,24 @@ extern const int    t8_dtet_face_corner[4][3];
  * \see t8_dtet_face_parent_face
  */
 extern const int    t8_dtet_parent_type_type_to_face[6][6];
+
+/** Store the local indices of T8_DTET_LUT_LEVELS consecutive levels for each
+ * (type,cube-ids) combination. The cube-ids and local indices are
+ * concatenated with the finest level in the lowest bits. */
+extern const uint8_t t8_dtet_type_cids_to_Ilocs[6][64];
+
+/** Store the type of the ancestor T8_DTET_LUT_LEVELS levels up for each
+ * (type,cube-ids) combination. */
+extern const int8_t t8_dtet_type_cids_to_parenttype[6][64];
+
+/** Store the cube-ids of T8_DTET_LUT_LEVELS consecutive levels for each
+ * (parenttype,local indices) combination. */
+extern const uint8_t t8_dtet_parenttype_Ilocs_to_cids[6][64];
+
+/** Store the type of the descendant T8_DTET_LUT_LEVELS levels down for each
+ * (parenttype,local indices) combination. */
+extern const int8_t t8_dtet_parenttype_Ilocs_to_type[6][64];
+
 T8_EXTERN_C_END ();
 
 #endif /* T8_DTET_CONNECTIVITY_H */
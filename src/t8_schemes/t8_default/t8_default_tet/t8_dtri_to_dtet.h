@@ -43,6 +43,7 @@ T8_EXTERN_C_BEGIN ();
 #define T8_DTRI_FACE_CHILDREN T8_DTET_FACE_CHILDREN
 #define T8_DTRI_CORNERS T8_DTET_CORNERS
 #define T8_DTRI_NUM_TYPES T8_DTET_NUM_TYPES
+#define T8_DTRI_LUT_LEVELS T8_DTET_LUT_LEVELS
 
 /* redefine types */
 #define t8_dtri_coord_t t8_dtet_coord_t
@@ -63,6 +64,10 @@ T8_EXTERN_C_BEGIN ();
 #define t8_dtri_parenttype_Iloc_to_cid t8_dtet_parenttype_Iloc_to_cid
 #define t8_dtri_type_cid_to_Iloc t8_dtet_type_cid_to_Iloc
 #define t8_dtri_face_corner t8_dtet_face_corner
+#define t8_dtri_type_cids_to_Ilocs t8_dtet_type_cids_to_Ilocs
+#define t8_dtri_type_cids_to_parenttype t8_dtet_type_cids_to_parenttype
+#define t8_dtri_parenttype_Ilocs_to_cids t8_dtet_parenttype_Ilocs_to_cids
+#define t8_dtri_parenttype_Ilocs_to_type t8_dtet_parenttype_Ilocs_to_type
 
 /* functions in d8_dtri_bits.h */
 #define t8_dtri_is_equal t8_dtet_is_equal
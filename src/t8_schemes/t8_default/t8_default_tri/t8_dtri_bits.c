@@ -27,6 +27,9 @@
 #include <t8_schemes/t8_default/t8_default_tet/t8_dtet_bits.h>
 #include <t8_schemes/t8_default/t8_default_tet/t8_dtet_connectivity.h>
 #endif
+#ifdef __BMI2__
+#include <immintrin.h>
+#endif
 
 typedef int8_t      t8_dtri_cube_id_t;
 
@@ -56,20 +59,143 @@ compute_cubeid (const t8_dtri_t *t, int level)
   return id;
 }
 
+/* Interleave the bits of t's coordinates divided by the length of a
+ * level "level" simplex, such that bits DIM * i to DIM * i + DIM - 1 of the
+ * result are the cube-id of t's ancestor of level "level" - i. */
+static              t8_linearidx_t
+t8_dtri_interleave_cubeids (const t8_dtri_t *t, int level)
+{
+  const int           shift = T8_DTRI_MAXLEVEL - level;
+  t8_linearidx_t      x = (t8_linearidx_t) (t->x >> shift);
+  t8_linearidx_t      y = (t8_linearidx_t) (t->y >> shift);
+#ifdef T8_DTRI_TO_DTET
+  t8_linearidx_t      z = (t8_linearidx_t) (t->z >> shift);
+#endif
+
+  T8_ASSERT (0 <= level && level <= T8_DTRI_MAXLEVEL);
+#ifndef T8_DTRI_TO_DTET
+#ifdef __BMI2__
+  return _pdep_u64 (x, 0x5555555555555555ULL)
+    | _pdep_u64 (y, 0xAAAAAAAAAAAAAAAAULL);
+#else
+  x = (x | x << 16) & 0x0000FFFF0000FFFFULL;
+  x = (x | x << 8) & 0x00FF00FF00FF00FFULL;
+  x = (x | x << 4) & 0x0F0F0F0F0F0F0F0FULL;
+  x = (x | x << 2) & 0x3333333333333333ULL;
+  x = (x | x << 1) & 0x5555555555555555ULL;
+  y = (y | y << 16) & 0x0000FFFF0000FFFFULL;
+  y = (y | y << 8) & 0x00FF00FF00FF00FFULL;
+  y = (y | y << 4) & 0x0F0F0F0F0F0F0F0FULL;
+  y = (y | y << 2) & 0x3333333333333333ULL;
+  y = (y | y << 1) & 0x5555555555555555ULL;
+  return x | y << 1;
+#endif
+#else
+#ifdef __BMI2__
+  return _pdep_u64 (x, 0x1249249249249249ULL)
+    | _pdep_u64 (y, 0x2492492492492492ULL)
+    | _pdep_u64 (z, 0x4924924924924924ULL);
+#else
+  x = (x | x << 32) & 0x001F00000000FFFFULL;
+  x = (x | x << 16) & 0x001F0000FF0000FFULL;
+  x = (x | x << 8) & 0x100F00F00F00F00FULL;
+  x = (x | x << 4) & 0x10C30C30C30C30C3ULL;
+  x = (x | x << 2) & 0x1249249249249249ULL;
+  y = (y | y << 32) & 0x001F00000000FFFFULL;
+  y = (y | y << 16) & 0x001F0000FF0000FFULL;
+  y = (y | y << 8) & 0x100F00F00F00F00FULL;
+  y = (y | y << 4) & 0x10C30C30C30C30C3ULL;
+  y = (y | y << 2) & 0x1249249249249249ULL;
+  z = (z | z << 32) & 0x001F00000000FFFFULL;
+  z = (z | z << 16) & 0x001F0000FF0000FFULL;
+  z = (z | z << 8) & 0x100F00F00F00F00FULL;
+  z = (z | z << 4) & 0x10C30C30C30C30C3ULL;
+  z = (z | z << 2) & 0x1249249249249249ULL;
+  return x | y << 1 | z << 2;
+#endif
+#endif
+}
+
+/* Extract every DIM-th bit of cids, starting at bit "offset".
+ * This is the inverse of the interleaving in t8_dtri_interleave_cubeids. */
+static              t8_dtri_coord_t
+t8_dtri_deinterleave_coord (t8_linearidx_t cids, int offset)
+{
+  t8_linearidx_t      c = cids >> offset;
+
+#ifndef T8_DTRI_TO_DTET
+#ifdef __BMI2__
+  return (t8_dtri_coord_t) _pext_u64 (c, 0x5555555555555555ULL);
+#else
+  c &= 0x5555555555555555ULL;
+  c = (c | c >> 1) & 0x3333333333333333ULL;
+  c = (c | c >> 2) & 0x0F0F0F0F0F0F0F0FULL;
+  c = (c | c >> 4) & 0x00FF00FF00FF00FFULL;
+  c = (c | c >> 8) & 0x0000FFFF0000FFFFULL;
+  c = (c | c >> 16) & 0x00000000FFFFFFFFULL;
+  return (t8_dtri_coord_t) c;
+#endif
+#else
+#ifdef __BMI2__
+  return (t8_dtri_coord_t) _pext_u64 (c, 0x1249249249249249ULL);
+#else
+  c &= 0x1249249249249249ULL;
+  c = (c | c >> 2) & 0x10C30C30C30C30C3ULL;
+  c = (c | c >> 4) & 0x100F00F00F00F00FULL;
+  c = (c | c >> 8) & 0x001F0000FF0000FFULL;
+  c = (c | c >> 16) & 0x001F00000000FFFFULL;
+  c = (c | c >> 32) & 0x00000000001FFFFFULL;
+  return (t8_dtri_coord_t) c;
+#endif
+#endif
+}
+
+/* Given the interleaved cube-ids of "num_levels" consecutive levels,
+ * starting with the finest one, and the type on the finest level,
+ * compute the type of the ancestor "num_levels" levels up.
+ * If ilocs is not NULL, store the local indices of the traversed levels
+ * in it, interleaved in the same way as the cube-ids.
+ * T8_DTRI_LUT_LEVELS levels are processed per table lookup. */
+static              t8_dtri_type_t
+t8_dtri_ascend_cubeids (t8_linearidx_t cids, int num_levels,
+                        t8_dtri_type_t type, t8_linearidx_t *ilocs)
+{
+  const int           lut_bits = T8_DTRI_DIM * T8_DTRI_LUT_LEVELS;
+  const t8_linearidx_t lut_mask = (((t8_linearidx_t) 1) << lut_bits) - 1;
+  t8_linearidx_t      id = 0, key;
+  t8_dtri_cube_id_t   cid;
+  int                 exponent = 0;
+
+  for (; num_levels >= T8_DTRI_LUT_LEVELS; num_levels -= T8_DTRI_LUT_LEVELS) {
+    key = cids & lut_mask;
+    id |= ((t8_linearidx_t) t8_dtri_type_cids_to_Ilocs[type][key]) << exponent;
+    type = t8_dtri_type_cids_to_parenttype[type][key];
+    cids >>= lut_bits;
+    exponent += lut_bits;
+  }
+  for (; num_levels > 0; num_levels--) {
+    cid = cids & (T8_DTRI_CHILDREN - 1);
+    id |= ((t8_linearidx_t) t8_dtri_type_cid_to_Iloc[type][cid]) << exponent;
+    type = t8_dtri_cid_type_to_parenttype[cid][type];
+    cids >>= T8_DTRI_DIM;
+    exponent += T8_DTRI_DIM;
+  }
+  if (ilocs != NULL) {
+    *ilocs = id;
+  }
+  return type;
+}
+
 /* A routine to compute the type of t's ancestor of level "level",
  * if its type at an intermediate level is already known.
  * If "level" equals t's level then t's type is returned.
  * It is not allowed to call this function with "level" greater than t->level.
- * This method runs in O(t->level - level).
+ * This method runs in O((t->level - level) / T8_DTRI_LUT_LEVELS).
  */
 static              t8_dtri_type_t
 compute_type_ext (const t8_dtri_t *t, int level,
                   t8_dtri_type_t known_type, int known_level)
 {
-  int8_t              type = known_type;
-  t8_dtri_cube_id_t   cid;
-  int                 i;
-
   T8_ASSERT (0 <= level && level <= known_level);
   T8_ASSERT (known_level <= t->level);
   if (level == known_level) {
@@ -80,18 +206,24 @@ compute_type_ext (const t8_dtri_t *t, int level,
      *       maybe once we want to allow the root tet to have different types */
     return 0;
   }
-  for (i = known_level; i > level; i--) {
-    cid = compute_cubeid (t, i);
-    /* compute type as the type of T^{i+1}, that is T's ancestor of level i+1 */
-    type = t8_dtri_cid_type_to_parenttype[cid][type];
+  if (known_level - level < T8_DTRI_LUT_LEVELS) {
+    /* Few levels, interleaving the coordinates does not pay off */
+    int8_t              type = known_type;
+    int                 i;
+    for (i = known_level; i > level; i--) {
+      /* compute type as the type of T^{i+1}, that is T's ancestor of level i+1 */
+      type = t8_dtri_cid_type_to_parenttype[compute_cubeid (t, i)][type];
+    }
+    return type;
   }
-  return type;
+  return t8_dtri_ascend_cubeids (t8_dtri_interleave_cubeids (t, known_level),
+                                 known_level - level, known_type, NULL);
 }
 
 /* A routine to compute the type of t's ancestor of level "level".
  * If "level" equals t's level then t's type is returned.
  * It is not allowed to call this function with "level" greater than t->level.
- * This method runs in O(t->level - level).
+ * This method runs in O((t->level - level) / T8_DTRI_LUT_LEVELS).
  */
 static              t8_dtri_type_t
 compute_type (const t8_dtri_t *t, int level)
@@ -1327,35 +1459,33 @@ t8_dtri_linear_id_corner_desc (const t8_dtri_t *t, int corner, int level)
 t8_linearidx_t
 t8_dtri_linear_id (const t8_dtri_t *t, int level)
 {
-  t8_linearidx_t      id = 0;
-  int8_t              type_temp = 0;
-  t8_dtri_cube_id_t   cid;
-  int                 i;
-  int                 exponent;
-  int                 my_level;
+  t8_linearidx_t      id, cids;
+  t8_dtri_type_t      type;
+  int                 exponent = 0;
+  const int           my_level = t->level;
 
   T8_ASSERT (0 <= level && level <= T8_DTRI_MAXLEVEL);
-  my_level = t->level;
-  exponent = 0;
-  /* If the given level is bigger than t's level
-   * we first fill up with the ids of t's descendants at t's
-   * origin with the same type as t */
+  /* The cube-ids of all of t's ancestors, t's own in the lowest bits */
+  cids = t8_dtri_interleave_cubeids (t, my_level);
+  type = t->type;
   if (level > my_level) {
+    /* If the given level is bigger than t's level
+     * we first fill up with the ids of t's descendants at t's
+     * origin with the same type as t */
     exponent = (level - my_level) * T8_DTRI_DIM;
-    type_temp = t->type;
     level = my_level;
   }
-  else {
-    type_temp = compute_type (t, level);
+  else if (level == 0) {
+    return 0;
   }
-  for (i = level; i > 0; i--) {
-    cid = compute_cubeid (t, i);
-    id |=
-      ((t8_linearidx_t) t8_dtri_type_cid_to_Iloc[type_temp][cid]) << exponent;
-    exponent += T8_DTRI_DIM;    /* multiply with 4 (2d) resp. 8  (3d) */
-    type_temp = t8_dtri_cid_type_to_parenttype[cid][type_temp];
+  else {
+    /* Compute the type of t's ancestor at level and drop the cube-ids
+     * of the finer levels */
+    type = t8_dtri_ascend_cubeids (cids, my_level - level, type, NULL);
+    cids >>= T8_DTRI_DIM * (my_level - level);
   }
-  return id;
+  t8_dtri_ascend_cubeids (cids, level, type, &id);
+  return id << exponent;
 }
 
 void
@@ -1398,38 +1528,47 @@ t8_dtri_init_linear_id_with_level (t8_dtri_t *t, t8_linearidx_t id,
 void
 t8_dtri_init_linear_id (t8_dtri_t *t, t8_linearidx_t id, int level)
 {
-  int                 i;
-  int                 offset_coords, offset_index;
+  int                 i, offset_index;
   const int           children_m1 = T8_DTRI_CHILDREN - 1;
-  t8_linearidx_t      local_index;
+  const int           lut_bits = T8_DTRI_DIM * T8_DTRI_LUT_LEVELS;
+  const t8_linearidx_t lut_mask = (((t8_linearidx_t) 1) << lut_bits) - 1;
+  const int           first_levels = level % T8_DTRI_LUT_LEVELS;
+  t8_linearidx_t      local_index, cids = 0;
   t8_dtri_cube_id_t   cid;
   t8_dtri_type_t      type;
   T8_ASSERT (0 <= id && id <= ((t8_linearidx_t) 1) << (T8_DTRI_DIM * level));
 
-  t->level = level;
-  t->x = 0;
-  t->y = 0;
-#ifdef T8_DTRI_TO_DTET
-  t->z = 0;
-#else
-  t->n = 0;
-#endif
   type = 0;                     /* This is the type of the root triangle */
-  for (i = 1; i <= level; i++) {
-    offset_coords = T8_DTRI_MAXLEVEL - i;
-    offset_index = level - i;
+  /* The first levels one by one, such that the remaining levels
+   * are a multiple of T8_DTRI_LUT_LEVELS */
+  for (i = 1; i <= first_levels; i++) {
+    offset_index = T8_DTRI_DIM * (level - i);
     /* Get the local index of T's ancestor on level i */
-    local_index = (id >> (T8_DTRI_DIM * offset_index)) & children_m1;
+    local_index = (id >> offset_index) & children_m1;
     /* Get the type and cube-id of T's ancestor on level i */
     cid = t8_dtri_parenttype_Iloc_to_cid[type][local_index];
     type = t8_dtri_parenttype_Iloc_to_type[type][local_index];
-    t->x |= (cid & 1) ? 1 << offset_coords : 0;
-    t->y |= (cid & 2) ? 1 << offset_coords : 0;
-#ifdef T8_DTRI_TO_DTET
-    t->z |= (cid & 4) ? 1 << offset_coords : 0;
-#endif
+    cids |= ((t8_linearidx_t) cid) << offset_index;
   }
+  /* The remaining levels T8_DTRI_LUT_LEVELS at a time */
+  for (i = first_levels; i < level; i += T8_DTRI_LUT_LEVELS) {
+    offset_index = T8_DTRI_DIM * (level - i - T8_DTRI_LUT_LEVELS);
+    local_index = (id >> offset_index) & lut_mask;
+    cids |= ((t8_linearidx_t)
+             t8_dtri_parenttype_Ilocs_to_cids[type][local_index]) <<
+      offset_index;
+    type = t8_dtri_parenttype_Ilocs_to_type[type][local_index];
+  }
+  t->level = level;
   t->type = type;
+  /* Bits i * DIM + j of cids are the j-th coordinate bit of level level - i */
+  t->x = t8_dtri_deinterleave_coord (cids, 0) << (T8_DTRI_MAXLEVEL - level);
+  t->y = t8_dtri_deinterleave_coord (cids, 1) << (T8_DTRI_MAXLEVEL - level);
+#ifdef T8_DTRI_TO_DTET
+  t->z = t8_dtri_deinterleave_coord (cids, 2) << (T8_DTRI_MAXLEVEL - level);
+#else
+  t->n = 0;
+#endif
 }
 
 void
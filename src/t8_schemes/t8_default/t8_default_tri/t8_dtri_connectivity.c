@@ -98,3 +98,167 @@ const int           t8_dtri_corner_face[3][2] = {
   {0, 2},
   {0, 1}
 };
+
+/* Line b, row c gives the local indices of 4 consecutive levels of
+ * a simplex with type b and cube-ids c (finest level in the lowest bits). */
+const uint8_t       t8_dtri_type_cids_to_Ilocs[2][256] = {
+  {
+    0, 1, 1, 3, 4, 5, 9, 7, 4, 5, 9, 7, 12, 13, 13, 15,
+    16, 17, 33, 19, 20, 21, 25, 23, 36, 37, 41, 39, 28, 29, 45, 31,
+    16, 17, 33, 19, 20, 21, 25, 23, 36, 37, 41, 39, 28, 29, 45, 31,
+    48, 49, 49, 51, 52, 53, 57, 55, 52, 53, 57, 55, 60, 61, 61, 63,
+    64, 65, 129, 67, 68, 69, 73, 71, 132, 133, 137, 135, 76, 77, 141, 79,
+    80, 81, 97, 83, 84, 85, 89, 87, 100, 101, 105, 103, 92, 93, 109, 95,
+    144, 145, 161, 147, 148, 149, 153, 151, 164, 165, 169, 167, 156, 157, 173, 159,
+    112, 113, 177, 115, 116, 117, 121, 119, 180, 181, 185, 183, 124, 125, 189, 127,
+    64, 65, 129, 67, 68, 69, 73, 71, 132, 133, 137, 135, 76, 77, 141, 79,
+    80, 81, 97, 83, 84, 85, 89, 87, 100, 101, 105, 103, 92, 93, 109, 95,
+    144, 145, 161, 147, 148, 149, 153, 151, 164, 165, 169, 167, 156, 157, 173, 159,
+    112, 113, 177, 115, 116, 117, 121, 119, 180, 181, 185, 183, 124, 125, 189, 127,
+    192, 193, 193, 195, 196, 197, 201, 199, 196, 197, 201, 199, 204, 205, 205, 207,
+    208, 209, 225, 211, 212, 213, 217, 215, 228, 229, 233, 231, 220, 221, 237, 223,
+    208, 209, 225, 211, 212, 213, 217, 215, 228, 229, 233, 231, 220, 221, 237, 223,
+    240, 241, 241, 243, 244, 245, 249, 247, 244, 245, 249, 247, 252, 253, 253, 255
+  },
+  {
+    0, 2, 2, 3, 8, 6, 10, 11, 8, 6, 10, 11, 12, 14, 14, 15,
+    32, 18, 34, 35, 24, 22, 26, 27, 40, 38, 42, 43, 44, 30, 46, 47,
+    32, 18, 34, 35, 24, 22, 26, 27, 40, 38, 42, 43, 44, 30, 46, 47,
+    48, 50, 50, 51, 56, 54, 58, 59, 56, 54, 58, 59, 60, 62, 62, 63,
+    128, 66, 130, 131, 72, 70, 74, 75, 136, 134, 138, 139, 140, 78, 142, 143,
+    96, 82, 98, 99, 88, 86, 90, 91, 104, 102, 106, 107, 108, 94, 110, 111,
+    160, 146, 162, 163, 152, 150, 154, 155, 168, 166, 170, 171, 172, 158, 174, 175,
+    176, 114, 178, 179, 120, 118, 122, 123, 184, 182, 186, 187, 188, 126, 190, 191,
+    128, 66, 130, 131, 72, 70, 74, 75, 136, 134, 138, 139, 140, 78, 142, 143,
+    96, 82, 98, 99, 88, 86, 90, 91, 104, 102, 106, 107, 108, 94, 110, 111,
+    160, 146, 162, 163, 152, 150, 154, 155, 168, 166, 170, 171, 172, 158, 174, 175,
+    176, 114, 178, 179, 120, 118, 122, 123, 184, 182, 186, 187, 188, 126, 190, 191,
+    192, 194, 194, 195, 200, 198, 202, 203, 200, 198, 202, 203, 204, 206, 206, 207,
+    224, 210, 226, 227, 216, 214, 218, 219, 232, 230, 234, 235, 236, 222, 238, 239,
+    224, 210, 226, 227, 216, 214, 218, 219, 232, 230, 234, 235, 236, 222, 238, 239,
+    240, 242, 242, 243, 248, 246, 250, 251, 248, 246, 250, 251, 252, 254, 254, 255
+  }
+};
+
+/* Line b, row c gives the type of the ancestor 4 levels up of
+ * a simplex with type b and cube-ids c. */
+const int8_t        t8_dtri_type_cids_to_parenttype[2][256] = {
+  {
+    0, 0, 1, 0, 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 1, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    0, 0, 1, 0, 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 1, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    0, 0, 1, 0, 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 1, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    0, 0, 1, 0, 0, 0, 0, 0, 1, 1, 1, 1, 0, 0, 1, 0
+  },
+  {
+    1, 0, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 1, 0, 1, 1,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 0, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 1, 0, 1, 1,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 0, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 1, 0, 1, 1,
+    0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+    1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1,
+    1, 0, 1, 1, 0, 0, 0, 0, 1, 1, 1, 1, 1, 0, 1, 1
+  }
+};
+
+/* Line b, row I gives the cube-ids of 4 consecutive levels of
+ * the descendant with local indices I of a simplex with type b. */
+const uint8_t       t8_dtri_parenttype_Ilocs_to_cids[2][256] = {
+  {
+    0, 1, 1, 3, 4, 5, 5, 7, 4, 6, 6, 7, 12, 13, 13, 15,
+    16, 17, 17, 19, 20, 21, 21, 23, 20, 22, 22, 23, 28, 29, 29, 31,
+    16, 18, 18, 19, 24, 25, 25, 27, 24, 26, 26, 27, 28, 30, 30, 31,
+    48, 49, 49, 51, 52, 53, 53, 55, 52, 54, 54, 55, 60, 61, 61, 63,
+    64, 65, 65, 67, 68, 69, 69, 71, 68, 70, 70, 71, 76, 77, 77, 79,
+    80, 81, 81, 83, 84, 85, 85, 87, 84, 86, 86, 87, 92, 93, 93, 95,
+    80, 82, 82, 83, 88, 89, 89, 91, 88, 90, 90, 91, 92, 94, 94, 95,
+    112, 113, 113, 115, 116, 117, 117, 119, 116, 118, 118, 119, 124, 125, 125, 127,
+    64, 66, 66, 67, 72, 73, 73, 75, 72, 74, 74, 75, 76, 78, 78, 79,
+    96, 97, 97, 99, 100, 101, 101, 103, 100, 102, 102, 103, 108, 109, 109, 111,
+    96, 98, 98, 99, 104, 105, 105, 107, 104, 106, 106, 107, 108, 110, 110, 111,
+    112, 114, 114, 115, 120, 121, 121, 123, 120, 122, 122, 123, 124, 126, 126, 127,
+    192, 193, 193, 195, 196, 197, 197, 199, 196, 198, 198, 199, 204, 205, 205, 207,
+    208, 209, 209, 211, 212, 213, 213, 215, 212, 214, 214, 215, 220, 221, 221, 223,
+    208, 210, 210, 211, 216, 217, 217, 219, 216, 218, 218, 219, 220, 222, 222, 223,
+    240, 241, 241, 243, 244, 245, 245, 247, 244, 246, 246, 247, 252, 253, 253, 255
+  },
+  {
+    0, 2, 2, 3, 8, 9, 9, 11, 8, 10, 10, 11, 12, 14, 14, 15,
+    32, 33, 33, 35, 36, 37, 37, 39, 36, 38, 38, 39, 44, 45, 45, 47,
+    32, 34, 34, 35, 40, 41, 41, 43, 40, 42, 42, 43, 44, 46, 46, 47,
+    48, 50, 50, 51, 56, 57, 57, 59, 56, 58, 58, 59, 60, 62, 62, 63,
+    128, 129, 129, 131, 132, 133, 133, 135, 132, 134, 134, 135, 140, 141, 141, 143,
+    144, 145, 145, 147, 148, 149, 149, 151, 148, 150, 150, 151, 156, 157, 157, 159,
+    144, 146, 146, 147, 152, 153, 153, 155, 152, 154, 154, 155, 156, 158, 158, 159,
+    176, 177, 177, 179, 180, 181, 181, 183, 180, 182, 182, 183, 188, 189, 189, 191,
+    128, 130, 130, 131, 136, 137, 137, 139, 136, 138, 138, 139, 140, 142, 142, 143,
+    160, 161, 161, 163, 164, 165, 165, 167, 164, 166, 166, 167, 172, 173, 173, 175,
+    160, 162, 162, 163, 168, 169, 169, 171, 168, 170, 170, 171, 172, 174, 174, 175,
+    176, 178, 178, 179, 184, 185, 185, 187, 184, 186, 186, 187, 188, 190, 190, 191,
+    192, 194, 194, 195, 200, 201, 201, 203, 200, 202, 202, 203, 204, 206, 206, 207,
+    224, 225, 225, 227, 228, 229, 229, 231, 228, 230, 230, 231, 236, 237, 237, 239,
+    224, 226, 226, 227, 232, 233, 233, 235, 232, 234, 234, 235, 236, 238, 238, 239,
+    240, 242, 242, 243, 248, 249, 249, 251, 248, 250, 250, 251, 252, 254, 254, 255
+  }
+};
+
+/* Line b, row I gives the type of the descendant 4 levels down with
+ * local indices I of a simplex with type b. */
+const int8_t        t8_dtri_parenttype_Ilocs_to_type[2][256] = {
+  {
+    0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0,
+    0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0,
+    1, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1,
+    0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0,
+    0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0,
+    0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0,
+    1, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1,
+    0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0,
+    1, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1,
+    0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0,
+    1, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1,
+    1, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1,
+    0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0,
+    0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0,
+    1, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1,
+    0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0
+  },
+  {
+    1, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1,
+    0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0,
+    1, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1,
+    1, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1,
+    0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0,
+    0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0,
+    1, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1,
+    0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0,
+    1, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1,
+    0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0,
+    1, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1,
+    1, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1,
+    1, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1,
+    0, 0, 1, 0, 0, 0, 1, 0, 1, 0, 1, 1, 0, 0, 1, 0,
+    1, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1,
+    1, 0, 1, 1, 0, 0, 1, 0, 1, 0, 1, 1, 1, 0, 1, 1
+  }
+};
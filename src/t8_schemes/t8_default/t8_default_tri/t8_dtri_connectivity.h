@@ -33,6 +33,9 @@ T8_EXTERN_C_BEGIN ();
 /** The spatial dimension */
 #define T8_DTRI_DIM (2)
 
+/** The number of levels processed in one step by the linear id lookup tables. */
+#define T8_DTRI_LUT_LEVELS (4)
+
 /** Store the type of parent for each (cube-id,type) combination. */
 extern const int    t8_dtri_cid_type_to_parenttype[4][2];
 
@@ -74,6 +77,23 @@ extern const int    t8_dtri_face_corner[3][2];
 /** Store the indices of the faces of each corner of a triangle. */
 extern const int    t8_dtri_corner_face[3][2];
 
+/** Store the local indices of T8_DTRI_LUT_LEVELS consecutive levels for each
+ * (type,cube-ids) combination. The cube-ids and local indices are
+ * concatenated with the finest level in the lowest bits. */
+extern const uint8_t t8_dtri_type_cids_to_Ilocs[2][256];
+
+/** Store the type of the ancestor T8_DTRI_LUT_LEVELS levels up for each
+ * (type,cube-ids) combination. */
+extern const int8_t t8_dtri_type_cids_to_parenttype[2][256];
+
+/** Store the cube-ids of T8_DTRI_LUT_LEVELS consecutive levels for each
+ * (parenttype,local indices) combination. */
+extern const uint8_t t8_dtri_parenttype_Ilocs_to_cids[2][256];
+
+/** Store the type of the descendant T8_DTRI_LUT_LEVELS levels down for each
+ * (parenttype,local indices) combination. */
+extern const int8_t t8_dtri_parenttype_Ilocs_to_type[2][256];
+
 T8_EXTERN_C_END ();
 
 #endif /* T8_DTRI_CONNECTIVITY_H */
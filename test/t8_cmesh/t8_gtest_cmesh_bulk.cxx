@@ -0,0 +1,196 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we build a partitioned cmesh of a row of quads once via
+ * the stash interface and once via t8_cmesh_set_partition_bulk.
+ * Both cmeshes must be committed, face consistent and must store the same
+ * face connections and vertices. */
+
+#include <gtest/gtest.h>
+#include <t8_cmesh.h>
+#include <t8_cmesh_vtk.h>
+#include "t8_cmesh/t8_cmesh_trees.h"
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+
+/* *INDENT-OFF* */
+class cmesh_bulk_construction : public testing::TestWithParam<int>{
+protected:
+  void SetUp() override {
+    int                 mpirank, mpisize, mpiret;
+    t8_locidx_t         ltree;
+    t8_gloidx_t         gtree;
+    const int           F = t8_eclass_max_num_faces[2];
+
+    mpiret = sc_MPI_Comm_rank (sc_MPI_COMM_WORLD, &mpirank);
+    SC_CHECK_MPI (mpiret);
+    mpiret = sc_MPI_Comm_size (sc_MPI_COMM_WORLD, &mpisize);
+    SC_CHECK_MPI (mpiret);
+
+    trees_per_proc = GetParam ();
+    num_trees = (t8_gloidx_t) trees_per_proc * mpisize;
+    first_tree = (t8_gloidx_t) trees_per_proc * mpirank;
+    last_tree = first_tree + trees_per_proc - 1;
+
+    /* Fill the arrays for a row of quads along the x-axis.
+     * Tree i connects at face 1 to face 0 of tree i + 1. */
+    classes.resize (trees_per_proc, T8_ECLASS_QUAD);
+    vertices.resize (3 * T8_ECLASS_MAX_CORNERS * trees_per_proc, 0);
+    face_neighbors.resize (F * trees_per_proc, -1);
+    ttf.resize (F * trees_per_proc, 0);
+    for (ltree = 0; ltree < trees_per_proc; ltree++) {
+      gtree = first_tree + ltree;
+      double *tree_vertices = &vertices[3 * T8_ECLASS_MAX_CORNERS * ltree];
+      for (int ivertex = 0; ivertex < 4; ivertex++) {
+        tree_vertices[3 * ivertex] = gtree + (ivertex & 1);
+        tree_vertices[3 * ivertex + 1] = (ivertex & 2) >> 1;
+      }
+      if (gtree > 0) {
+        face_neighbors[F * ltree] = gtree - 1;
+        ttf[F * ltree] = t8_cmesh_tree_to_face_encode (2, 1, 0);
+      }
+      if (gtree < num_trees - 1) {
+        face_neighbors[F * ltree + 1] = gtree + 1;
+        ttf[F * ltree + 1] = t8_cmesh_tree_to_face_encode (2, 0, 0);
+      }
+    }
+    if (trees_per_proc > 0 && first_tree > 0) {
+      ghost_ids.push_back (first_tree - 1);
+    }
+    if (trees_per_proc > 0 && last_tree < num_trees - 1) {
+      ghost_ids.push_back (last_tree + 1);
+    }
+    ghost_classes.resize (ghost_ids.size (), T8_ECLASS_QUAD);
+
+    cmesh_from_bulk = build_from_bulk (0);
+    cmesh_from_stash = build_from_stash (0);
+  }
+  void TearDown() override {
+    t8_cmesh_destroy (&cmesh_from_bulk);
+    t8_cmesh_destroy (&cmesh_from_stash);
+  }
+
+  /* Build the cmesh from arrays, refined uniformly to refine_level */
+  t8_cmesh_t build_from_bulk (int refine_level) {
+    t8_cmesh_t          cmesh;
+
+    t8_cmesh_init (&cmesh);
+    t8_cmesh_set_partition_bulk (cmesh, 2, first_tree, trees_per_proc,
+                                 classes.data (), vertices.data (),
+                                 face_neighbors.data (), ttf.data (),
+                                 ghost_ids.size (), ghost_ids.data (),
+                                 ghost_classes.data (), NULL, NULL);
+    if (refine_level > 0) {
+      t8_cmesh_set_refine (cmesh, refine_level, t8_scheme_new_default_cxx ());
+    }
+    t8_cmesh_commit (cmesh, sc_MPI_COMM_WORLD);
+    return cmesh;
+  }
+
+  /* Build the same cmesh via the stash */
+  t8_cmesh_t build_from_stash (int refine_level) {
+    t8_cmesh_t          cmesh;
+    t8_gloidx_t         gtree;
+
+    t8_cmesh_init (&cmesh);
+    t8_cmesh_set_dimension (cmesh, 2);
+    t8_cmesh_set_partition_range (cmesh, 3, first_tree, last_tree);
+    for (gtree = SC_MAX (first_tree - 1, 0);
+         gtree <= SC_MIN (last_tree + 1, num_trees - 1); gtree++) {
+      t8_cmesh_set_tree_class (cmesh, gtree, T8_ECLASS_QUAD);
+      if (gtree < num_trees - 1) {
+        t8_cmesh_set_join (cmesh, gtree, gtree + 1, 1, 0, 0);
+      }
+    }
+    for (t8_locidx_t ltree = 0; ltree < trees_per_proc; ltree++) {
+      t8_cmesh_set_tree_vertices (cmesh, first_tree + ltree,
+                                  &vertices[3 * T8_ECLASS_MAX_CORNERS * ltree],
+                                  4);
+    }
+    if (refine_level > 0) {
+      t8_cmesh_set_refine (cmesh, refine_level, t8_scheme_new_default_cxx ());
+    }
+    t8_cmesh_commit (cmesh, sc_MPI_COMM_WORLD);
+    return cmesh;
+  }
+
+  t8_cmesh_t                cmesh_from_bulk;
+  t8_cmesh_t                cmesh_from_stash;
+  t8_locidx_t               trees_per_proc;
+  t8_gloidx_t               num_trees, first_tree, last_tree;
+  std::vector<t8_eclass_t>  classes;
+  std::vector<double>       vertices;
+  std::vector<t8_gloidx_t>  face_neighbors;
+  std::vector<int8_t>       ttf;
+  std::vector<t8_gloidx_t>  ghost_ids;
+  std::vector<t8_eclass_t>  ghost_classes;
+};
+
+TEST_P (cmesh_bulk_construction, equals_stash_construction) {
+  EXPECT_TRUE (t8_cmesh_is_committed (cmesh_from_bulk));
+  EXPECT_TRUE (t8_cmesh_trees_is_face_consistend (cmesh_from_bulk, cmesh_from_bulk->trees));
+  ASSERT_EQ (t8_cmesh_get_num_trees (cmesh_from_bulk), t8_cmesh_get_num_trees (cmesh_from_stash));
+  ASSERT_EQ (t8_cmesh_get_num_local_trees (cmesh_from_bulk), t8_cmesh_get_num_local_trees (cmesh_from_stash));
+  ASSERT_EQ (t8_cmesh_get_num_ghosts (cmesh_from_bulk), t8_cmesh_get_num_ghosts (cmesh_from_stash));
+
+  for (t8_locidx_t ltree = 0; ltree < trees_per_proc; ltree++) {
+    for (int iface = 0; iface < t8_eclass_num_faces[T8_ECLASS_QUAD]; iface++) {
+      int                 dual_bulk = -1, orient_bulk = -1;
+      int                 dual_stash = -1, orient_stash = -1;
+      const t8_locidx_t   neigh_bulk =
+        t8_cmesh_get_face_neighbor (cmesh_from_bulk, ltree, iface, &dual_bulk, &orient_bulk);
+      const t8_locidx_t   neigh_stash =
+        t8_cmesh_get_face_neighbor (cmesh_from_stash, ltree, iface, &dual_stash, &orient_stash);
+      EXPECT_EQ (neigh_bulk < 0, neigh_stash < 0);
+      if (neigh_bulk >= 0 && neigh_stash >= 0) {
+        EXPECT_EQ (t8_cmesh_get_global_id (cmesh_from_bulk, neigh_bulk),
+                   t8_cmesh_get_global_id (cmesh_from_stash, neigh_stash));
+        EXPECT_EQ (dual_bulk, dual_stash);
+        EXPECT_EQ (orient_bulk, orient_stash);
+      }
+    }
+    const double *vertices_bulk = t8_cmesh_get_tree_vertices (cmesh_from_bulk, ltree);
+    const double *vertices_stash = t8_cmesh_get_tree_vertices (cmesh_from_stash, ltree);
+    ASSERT_TRUE (vertices_bulk != NULL && vertices_stash != NULL);
+    for (int icoord = 0; icoord < 3 * 4; icoord++) {
+      EXPECT_EQ (vertices_bulk[icoord], vertices_stash[icoord]);
+    }
+  }
+}
+
+TEST_P (cmesh_bulk_construction, refine_equals_stash_construction) {
+  t8_cmesh_t          refined_bulk = build_from_bulk (1);
+  t8_cmesh_t          refined_stash = build_from_stash (1);
+
+  EXPECT_TRUE (t8_cmesh_is_committed (refined_bulk));
+  EXPECT_TRUE (t8_cmesh_trees_is_face_consistend (refined_bulk, refined_bulk->trees));
+  /* Each quad is refined into 4 quads */
+  EXPECT_EQ (t8_cmesh_get_num_trees (refined_bulk), 4 * num_trees);
+  EXPECT_EQ (t8_cmesh_get_num_local_trees (refined_bulk), 4 * trees_per_proc);
+  EXPECT_EQ (t8_cmesh_get_num_trees (refined_bulk), t8_cmesh_get_num_trees (refined_stash));
+  EXPECT_EQ (t8_cmesh_get_num_local_trees (refined_bulk), t8_cmesh_get_num_local_trees (refined_stash));
+  EXPECT_EQ (t8_cmesh_get_num_ghosts (refined_bulk), t8_cmesh_get_num_ghosts (refined_stash));
+  t8_cmesh_destroy (&refined_bulk);
+  t8_cmesh_destroy (&refined_stash);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_cmesh_bulk, cmesh_bulk_construction, testing::Values (1, 3, 5));
+/* *INDENT-ON* */
@@ -0,0 +1,105 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+#include <gtest/gtest.h>
+#include <t8_cmesh.h>
+#include "t8_cmesh/t8_cmesh_trees.h"
+#include <t8_cmesh/t8_cmesh_testcases.h>
+#include <sc_shmem.h>
+
+/* Copy each test cmesh into a cmesh whose trees are stored in node-shared
+ * memory and check that both cmeshes are equal. */
+
+/* *INDENT-OFF* */
+class cmesh_node_shared : public testing::TestWithParam<int>{
+protected:
+  void SetUp() override {
+    cmesh_id = GetParam();
+
+    cmesh_original = t8_test_create_cmesh (cmesh_id);
+    t8_cmesh_init (&cmesh_shared);
+    /* We need the original cmesh later, so we ref it */
+    t8_cmesh_ref (cmesh_original);
+    t8_cmesh_set_derive (cmesh_shared, cmesh_original);
+    t8_cmesh_set_node_shared (cmesh_shared, 1);
+    t8_cmesh_commit (cmesh_shared, sc_MPI_COMM_WORLD);
+  }
+  void TearDown() override {
+    t8_cmesh_unref(&cmesh_original);
+    t8_cmesh_unref(&cmesh_shared);
+  }
+
+  t8_cmesh_t        cmesh_original;
+  t8_cmesh_t        cmesh_shared;
+  int               cmesh_id;
+};
+
+TEST_P (cmesh_node_shared, equals_original) {
+  EXPECT_TRUE (t8_cmesh_is_committed (cmesh_shared));
+  EXPECT_TRUE (t8_cmesh_trees_is_face_consistend (cmesh_shared, cmesh_shared->trees));
+  EXPECT_TRUE (t8_cmesh_is_equal (cmesh_original, cmesh_shared));
+  if (!t8_cmesh_is_partitioned (cmesh_shared) && cmesh_shared->num_trees > 0) {
+    /* The trees of a replicated cmesh live in shared memory */
+    EXPECT_TRUE (cmesh_shared->trees->shmem_part != NULL);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_cmesh_node_shared, cmesh_node_shared, testing::Range(0, t8_get_number_of_all_testcases ()));
+
+/* Construct a replicated cmesh of two joined quads with an attribute per tree
+ * from the stash, with or without node sharing. */
+static t8_cmesh_t
+t8_test_cmesh_two_quads (int node_shared)
+{
+  t8_cmesh_t          cmesh;
+  double              data[2][3] = { {0, 1, 2}, {3, 4, 5} };
+
+  t8_cmesh_init (&cmesh);
+  t8_cmesh_set_tree_class (cmesh, 0, T8_ECLASS_QUAD);
+  t8_cmesh_set_tree_class (cmesh, 1, T8_ECLASS_QUAD);
+  t8_cmesh_set_join (cmesh, 0, 1, 1, 0, 0);
+  t8_cmesh_set_attribute (cmesh, 0, t8_get_package_id (), 0, data[0],
+                          3 * sizeof (double), 0);
+  t8_cmesh_set_attribute (cmesh, 1, t8_get_package_id (), 0, data[1],
+                          3 * sizeof (double), 0);
+  t8_cmesh_set_node_shared (cmesh, node_shared);
+  t8_cmesh_commit (cmesh, sc_MPI_COMM_WORLD);
+  return cmesh;
+}
+
+TEST (cmesh_node_shared_stash, equals_private) {
+  t8_cmesh_t        cmesh_private, cmesh_shared;
+  sc_shmem_type_t   shmem_type;
+
+  shmem_type = sc_shmem_get_type (sc_MPI_COMM_WORLD);
+  cmesh_private = t8_test_cmesh_two_quads (0);
+  cmesh_shared = t8_test_cmesh_two_quads (1);
+  /* The trees are constructed directly in shared memory */
+  EXPECT_TRUE (cmesh_shared->trees->shmem_part != NULL);
+  EXPECT_TRUE (t8_cmesh_trees_is_face_consistend (cmesh_shared, cmesh_shared->trees));
+  EXPECT_TRUE (t8_cmesh_is_equal (cmesh_private, cmesh_shared));
+  /* The shared memory type of the communicator is not changed */
+  EXPECT_EQ (shmem_type, sc_shmem_get_type (sc_MPI_COMM_WORLD));
+  t8_cmesh_destroy (&cmesh_private);
+  t8_cmesh_destroy (&cmesh_shared);
+}
+/* *INDENT-ON* */
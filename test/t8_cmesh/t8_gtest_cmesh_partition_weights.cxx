@@ -0,0 +1,140 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we partition a replicated cmesh according to tree weights
+ * with t8_cmesh_set_partition_weights.
+ * We check that each process owns the trees that contain its share of the
+ * weights. We then repartition the partitioned cmesh with the weights
+ * split among the processes and check that the partition does not change. */
+
+#include <gtest/gtest.h>
+#include <t8_cmesh.h>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include "t8_cmesh/t8_cmesh_types.h"
+#include "t8_cmesh/t8_cmesh_trees.h"
+
+/* *INDENT-OFF* */
+class cmesh_partition_weights : public testing::TestWithParam<int>{
+protected:
+  void SetUp() override {
+    int                 mpiret;
+    t8_gloidx_t         itree;
+
+    mpiret = sc_MPI_Comm_rank (sc_MPI_COMM_WORLD, &mpirank);
+    SC_CHECK_MPI (mpiret);
+    mpiret = sc_MPI_Comm_size (sc_MPI_COMM_WORLD, &mpisize);
+    SC_CHECK_MPI (mpiret);
+
+    num_trees = GetParam () * mpisize;
+    /* Weights with zero weighted trees and one heavy tree that
+     * needs to be shared */
+    weights.resize (num_trees);
+    weights_sum.resize (num_trees + 1, 0);
+    for (itree = 0; itree < num_trees; itree++) {
+      weights[itree] = itree % 4 == 3 ? 0 : itree % 7 + 1;
+      if (itree == num_trees / 2) {
+        weights[itree] = 10 * num_trees;
+      }
+      weights_sum[itree + 1] = weights_sum[itree] + weights[itree];
+    }
+
+    cmesh_replicated = t8_cmesh_new_bigmesh (T8_ECLASS_QUAD, num_trees, sc_MPI_COMM_WORLD);
+    t8_cmesh_init (&cmesh_weighted);
+    t8_cmesh_ref (cmesh_replicated);
+    t8_cmesh_set_derive (cmesh_weighted, cmesh_replicated);
+    t8_cmesh_set_partition_weights (cmesh_weighted, weights.data ());
+    t8_cmesh_commit (cmesh_weighted, sc_MPI_COMM_WORLD);
+  }
+  void TearDown() override {
+    t8_cmesh_unref (&cmesh_replicated);
+    t8_cmesh_unref (&cmesh_weighted);
+  }
+
+  /* The first position in the weight sequence that belongs to process proc */
+  t8_gloidx_t split (int proc) {
+    return (t8_gloidx_t) (((long double) weights_sum[num_trees] * proc) / mpisize);
+  }
+
+  int                       mpirank, mpisize;
+  t8_gloidx_t               num_trees;
+  std::vector<t8_gloidx_t>  weights;
+  std::vector<t8_gloidx_t>  weights_sum;
+  t8_cmesh_t                cmesh_replicated;
+  t8_cmesh_t                cmesh_weighted;
+};
+
+TEST_P (cmesh_partition_weights, owns_weight_share) {
+  EXPECT_TRUE (t8_cmesh_is_committed (cmesh_weighted));
+  EXPECT_TRUE (t8_cmesh_trees_is_face_consistend (cmesh_weighted, cmesh_weighted->trees));
+  ASSERT_EQ (t8_cmesh_get_num_trees (cmesh_weighted), num_trees);
+
+  const t8_gloidx_t   first_tree = t8_cmesh_get_first_treeid (cmesh_weighted);
+  const t8_locidx_t   num_local_trees = t8_cmesh_get_num_local_trees (cmesh_weighted);
+  if (split (mpirank) < split (mpirank + 1)) {
+    /* This process has weight, its trees must cover its share */
+    ASSERT_GT (num_local_trees, 0);
+    EXPECT_LE (weights_sum[first_tree], split (mpirank));
+    EXPECT_GE (weights_sum[first_tree + num_local_trees], split (mpirank + 1));
+    EXPECT_EQ (cmesh_weighted->first_tree_shared, weights_sum[first_tree] < split (mpirank));
+  }
+  else {
+    EXPECT_EQ (num_local_trees, 0);
+  }
+  /* Each tree is owned by at least one process */
+  t8_gloidx_t         num_owned = num_local_trees - cmesh_weighted->first_tree_shared;
+  t8_gloidx_t         num_owned_global;
+  int                 mpiret = sc_MPI_Allreduce (&num_owned, &num_owned_global, 1, T8_MPI_GLOIDX,
+                                                 sc_MPI_SUM, sc_MPI_COMM_WORLD);
+  SC_CHECK_MPI (mpiret);
+  EXPECT_EQ (num_owned_global, num_trees);
+}
+
+TEST_P (cmesh_partition_weights, repartition_is_stable) {
+  t8_cmesh_t                cmesh_repartition;
+  std::vector<t8_gloidx_t>  local_weights;
+  const t8_gloidx_t         first_tree = t8_cmesh_get_first_treeid (cmesh_weighted);
+  const t8_locidx_t         num_local_trees = t8_cmesh_get_num_local_trees (cmesh_weighted);
+
+  /* Each process weights its local trees by its part of the tree weight */
+  for (t8_locidx_t ltree = 0; ltree < num_local_trees; ltree++) {
+    const t8_gloidx_t   gtree = first_tree + ltree;
+    const t8_gloidx_t   begin = SC_MAX (weights_sum[gtree], split (mpirank));
+    const t8_gloidx_t   end = SC_MIN (weights_sum[gtree + 1], split (mpirank + 1));
+    local_weights.push_back (SC_MAX (end - begin, 0));
+  }
+  t8_cmesh_init (&cmesh_repartition);
+  t8_cmesh_ref (cmesh_weighted);
+  t8_cmesh_set_derive (cmesh_repartition, cmesh_weighted);
+  t8_cmesh_set_partition_weights (cmesh_repartition, local_weights.data ());
+  t8_cmesh_commit (cmesh_repartition, sc_MPI_COMM_WORLD);
+
+  EXPECT_TRUE (t8_cmesh_is_committed (cmesh_repartition));
+  EXPECT_EQ (t8_cmesh_get_num_local_trees (cmesh_repartition), num_local_trees);
+  if (num_local_trees > 0) {
+    EXPECT_EQ (t8_cmesh_get_first_treeid (cmesh_repartition), first_tree);
+    EXPECT_EQ (cmesh_repartition->first_tree_shared, cmesh_weighted->first_tree_shared);
+  }
+  t8_cmesh_unref (&cmesh_repartition);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_cmesh_partition_weights, cmesh_partition_weights, testing::Values (1, 3, 10));
+/* *INDENT-ON* */
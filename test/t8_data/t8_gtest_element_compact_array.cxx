@@ -0,0 +1,131 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we encode the leaf elements of a uniform forest in a
+ * compact element array. Decoding them one by one and in bulk must give
+ * back the original elements. We also pack and unpack a range of the
+ * leaf elements, which is the encoding of the compact array's blocks. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_forest.h>
+#include <t8_element_cxx.hxx>
+#include <t8_data/t8_containers.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_cmesh/t8_cmesh_examples.h>
+
+/* *INDENT-OFF* */
+class element_compact_array:public testing::TestWithParam <t8_eclass_t> {
+protected:
+  void SetUp () override {
+    eclass = GetParam ();
+    forest = t8_forest_new_uniform (t8_cmesh_new_hypercube (eclass, sc_MPI_COMM_WORLD, 0, 0, 0),
+                                    t8_scheme_new_default_cxx (), 3, 0, sc_MPI_COMM_WORLD);
+  }
+  void TearDown () override {
+    t8_forest_unref (&forest);
+  }
+  t8_forest_t         forest;
+  t8_eclass_t         eclass;
+};
+
+TEST_P (element_compact_array, encode_decode) {
+  t8_element_compact_array_t compact;
+  t8_element_array_t  decoded;
+  t8_element_t       *element;
+
+  for (t8_locidx_t itree = 0; itree < t8_forest_get_num_local_trees (forest); itree++) {
+    t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, t8_forest_get_tree_class (forest, itree));
+    t8_element_array_t *leafs = t8_forest_tree_get_leafs (forest, itree);
+    const size_t num_leafs = t8_element_array_get_count (leafs);
+
+    const size_t num_blocks = (num_leafs + T8_ELEMENT_COMPACT_BLOCK_SIZE - 1) / T8_ELEMENT_COMPACT_BLOCK_SIZE;
+    t8_element_array_t first_leafs, last_leafs;
+
+    /* Encode the leaves in two parts, such that the first part ends inside a block */
+    t8_element_array_init_view (&first_leafs, leafs, 0, num_leafs / 3);
+    t8_element_array_init_view (&last_leafs, leafs, num_leafs / 3, num_leafs - num_leafs / 3);
+    t8_element_compact_array_init (&compact, ts);
+    t8_element_compact_array_encode (&compact, &first_leafs);
+    t8_element_compact_array_encode (&compact, &last_leafs);
+    ASSERT_EQ (t8_element_compact_array_get_count (&compact), num_leafs);
+    /* The leaves have no gaps. Each block needs its offset, the id level and
+     * at most two bytes for the distance of its first element, all other
+     * elements need two bytes. */
+    EXPECT_LE (t8_element_compact_array_get_bytes (&compact), 2 * num_leafs + num_blocks * (sizeof (size_t) + 2));
+
+    /* Decode one by one */
+    ts->t8_element_new (1, &element);
+    for (size_t ileaf = 0; ileaf < num_leafs; ileaf++) {
+      t8_element_compact_array_index (&compact, ileaf, element);
+      EXPECT_EQ (ts->t8_element_compare (element, t8_element_array_index_locidx (leafs, ileaf)), 0);
+      EXPECT_EQ (ts->t8_element_level (element),
+                 ts->t8_element_level (t8_element_array_index_locidx (leafs, ileaf)));
+    }
+    ts->t8_element_destroy (1, &element);
+
+    /* Decode the second half in bulk */
+    t8_element_array_init (&decoded, ts);
+    t8_element_compact_array_decode (&compact, num_leafs / 2, num_leafs - num_leafs / 2, &decoded);
+    ASSERT_EQ (t8_element_array_get_count (&decoded), num_leafs - num_leafs / 2);
+    for (size_t ileaf = num_leafs / 2; ileaf < num_leafs; ileaf++) {
+      EXPECT_EQ (ts->t8_element_compare (t8_element_array_index_locidx (&decoded, ileaf - num_leafs / 2),
+                                         t8_element_array_index_locidx (leafs, ileaf)), 0);
+    }
+    t8_element_array_reset (&decoded);
+    t8_element_compact_array_reset (&compact);
+  }
+}
+
+TEST_P (element_compact_array, pack_unpack) {
+  t8_element_array_t  unpacked;
+
+  for (t8_locidx_t itree = 0; itree < t8_forest_get_num_local_trees (forest); itree++) {
+    t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, t8_forest_get_tree_class (forest, itree));
+    t8_element_array_t *leafs = t8_forest_tree_get_leafs (forest, itree);
+    const size_t num_leafs = t8_element_array_get_count (leafs);
+    const size_t first = num_leafs / 3;
+    const size_t count = num_leafs - first;
+    char *buffer = T8_ALLOC (char, t8_element_array_pack_bound (count));
+
+    /* Pack a range of the leaves. Since the leaves have no gaps, we need
+     * two bytes per element and the id level. */
+    const size_t num_bytes = t8_element_array_pack (leafs, first, count, buffer);
+    EXPECT_EQ (num_bytes, 1 + 2 * count);
+
+    /* Unpack behind an offset */
+    t8_element_array_init_size (&unpacked, ts, count + 1);
+    EXPECT_EQ (t8_element_array_unpack (&unpacked, 1, count, buffer), num_bytes);
+    for (size_t ileaf = 0; ileaf < count; ileaf++) {
+      const t8_element_t *element = t8_element_array_index_locidx (&unpacked, ileaf + 1);
+      const t8_element_t *leaf = t8_element_array_index_locidx (leafs, first + ileaf);
+      EXPECT_EQ (ts->t8_element_compare (element, leaf), 0);
+      EXPECT_EQ (ts->t8_element_level (element), ts->t8_element_level (leaf));
+    }
+    t8_element_array_reset (&unpacked);
+    T8_FREE (buffer);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_element_compact_array, element_compact_array,
+                          testing::Range (T8_ECLASS_ZERO, T8_ECLASS_COUNT));
+/* *INDENT-ON* */
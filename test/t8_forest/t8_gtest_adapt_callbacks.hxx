@@ -0,0 +1,59 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* Adapt callbacks that are shared by the forest tests. */
+
+#ifndef T8_GTEST_ADAPT_CALLBACKS_HXX
+#define T8_GTEST_ADAPT_CALLBACKS_HXX
+
+#include <t8_forest.h>
+#include <t8_element_cxx.hxx>
+
+/* Refine the elements with child id 0 up to level 4, such that the forest
+ * becomes unevenly distributed and non-uniform. */
+inline int
+t8_test_refine_first_child (t8_forest_t forest, t8_forest_t forest_from,
+                            t8_locidx_t which_tree, t8_locidx_t lelement_id,
+                            t8_eclass_scheme_c *ts, const int is_family,
+                            const int num_elements, t8_element_t *elements[])
+{
+  return ts->t8_element_child_id (elements[0]) == 0
+    && ts->t8_element_level (elements[0]) < 4;
+}
+
+/* Coarsen every third family and refine the elements with child id 1 up to
+ * level 4, such that both refined and coarsened elements lie at process
+ * boundaries. */
+inline int
+t8_test_adapt_mixed (t8_forest_t forest, t8_forest_t forest_from,
+                     t8_locidx_t which_tree, t8_locidx_t lelement_id,
+                     t8_eclass_scheme_c *ts, const int is_family,
+                     const int num_elements, t8_element_t *elements[])
+{
+  if (is_family && (lelement_id / num_elements) % 3 == 1) {
+    return -1;
+  }
+  return ts->t8_element_child_id (elements[0]) == 1
+    && ts->t8_element_level (elements[0]) < 4;
+}
+
+#endif /* T8_GTEST_ADAPT_CALLBACKS_HXX */
@@ -0,0 +1,80 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we check that adapting a forest that is exclusively owned,
+ * which changes its element arrays in place, gives the same elements as
+ * adapting a forest that is still referenced elsewhere. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_forest.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include "t8_gtest_adapt_callbacks.hxx"
+
+/* *INDENT-OFF* */
+class forest_adapt_in_place : public testing::TestWithParam<t8_eclass_t> {
+protected:
+  void SetUp () override {
+    eclass = GetParam ();
+    t8_cmesh_t cmesh = t8_cmesh_new_hypercube (eclass, sc_MPI_COMM_WORLD, 0, 0, 0);
+    forest = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), 2, 0, sc_MPI_COMM_WORLD);
+  }
+
+  t8_eclass_t eclass;
+  t8_forest_t forest;
+};
+
+TEST_P (forest_adapt_in_place, equals_adapt_with_copy) {
+  for (int iround = 0; iround < 3; iround++) {
+    /* forest is still referenced, thus new arrays are built */
+    t8_forest_ref (forest);
+    t8_forest_t forest_copy = t8_forest_new_adapt (forest, t8_test_adapt_mixed, 0, 0, NULL);
+    /* forest is now exclusively owned and adapted in place */
+    t8_forest_t forest_in_place = t8_forest_new_adapt (forest, t8_test_adapt_mixed, 0, 0, NULL);
+
+    ASSERT_EQ (t8_forest_get_local_num_elements (forest_copy),
+               t8_forest_get_local_num_elements (forest_in_place));
+    ASSERT_EQ (t8_forest_get_global_num_elements (forest_copy),
+               t8_forest_get_global_num_elements (forest_in_place));
+    for (t8_locidx_t itree = 0; itree < t8_forest_get_num_local_trees (forest_copy); itree++) {
+      t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest_copy, t8_forest_get_tree_class (forest_copy, itree));
+      const t8_locidx_t num_elements = t8_forest_get_tree_num_elements (forest_copy, itree);
+      ASSERT_EQ (num_elements, t8_forest_get_tree_num_elements (forest_in_place, itree));
+      ASSERT_EQ (t8_forest_get_tree_element_offset (forest_copy, itree),
+                 t8_forest_get_tree_element_offset (forest_in_place, itree));
+      for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+        const t8_element_t *element_copy = t8_forest_get_element_in_tree (forest_copy, itree, ielement);
+        const t8_element_t *element_in_place = t8_forest_get_element_in_tree (forest_in_place, itree, ielement);
+        EXPECT_EQ (ts->t8_element_level (element_copy), ts->t8_element_level (element_in_place));
+        EXPECT_EQ (ts->t8_element_compare (element_copy, element_in_place), 0);
+      }
+    }
+    t8_forest_unref (&forest_copy);
+    forest = forest_in_place;
+  }
+  t8_forest_unref (&forest);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_adapt_in_place, forest_adapt_in_place,
+                          testing::Range (T8_ECLASS_LINE, T8_ECLASS_COUNT));
+/* *INDENT-ON* */
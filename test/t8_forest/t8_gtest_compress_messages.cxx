@@ -0,0 +1,89 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we adapt, partition and create the ghost layer of a forest
+ * once with raw element messages and once with packed element messages.
+ * Both forests and their ghost layers must be equal. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_forest.h>
+#include <t8_element_cxx.hxx>
+#include <t8_forest/t8_forest_ghost.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include "t8_gtest_adapt_callbacks.hxx"
+
+/* *INDENT-OFF* */
+class forest_compress_messages : public testing::TestWithParam<t8_eclass_t> {
+protected:
+  void SetUp () override {
+    t8_cmesh_t cmesh = t8_cmesh_new_hypercube (GetParam (), sc_MPI_COMM_WORLD, 0, 0, 0);
+    forest_from = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), 2, 0, sc_MPI_COMM_WORLD);
+    forest_from = t8_forest_new_adapt (forest_from, t8_test_refine_first_child, 1, 0, NULL);
+  }
+  void TearDown () override {
+    t8_forest_unref (&forest_from);
+  }
+
+  /* Partition forest_from and create ghosts */
+  t8_forest_t partition (int compress) {
+    t8_forest_t forest;
+
+    t8_forest_ref (forest_from);
+    t8_forest_init (&forest);
+    t8_forest_set_partition (forest, forest_from, 0);
+    t8_forest_set_ghost (forest, 1, T8_GHOST_FACES);
+    t8_forest_set_compress_messages (forest, compress);
+    t8_forest_commit (forest);
+    return forest;
+  }
+
+  t8_forest_t forest_from;
+};
+
+TEST_P (forest_compress_messages, equals_uncompressed) {
+  t8_forest_t forest = partition (0);
+  t8_forest_t forest_compressed = partition (1);
+
+  EXPECT_TRUE (t8_forest_is_equal (forest, forest_compressed));
+  ASSERT_EQ (t8_forest_get_num_ghosts (forest), t8_forest_get_num_ghosts (forest_compressed));
+  ASSERT_EQ (t8_forest_ghost_num_trees (forest), t8_forest_ghost_num_trees (forest_compressed));
+  for (t8_locidx_t itree = 0; itree < t8_forest_ghost_num_trees (forest); itree++) {
+    t8_element_array_t *ghosts = t8_forest_ghost_get_tree_elements (forest, itree);
+    t8_element_array_t *ghosts_compressed = t8_forest_ghost_get_tree_elements (forest_compressed, itree);
+    t8_eclass_scheme_c *ts = t8_element_array_get_scheme (ghosts);
+    ASSERT_EQ (t8_element_array_get_count (ghosts), t8_element_array_get_count (ghosts_compressed));
+    for (size_t ighost = 0; ighost < t8_element_array_get_count (ghosts); ighost++) {
+      const t8_element_t *ghost = t8_element_array_index_locidx (ghosts, ighost);
+      const t8_element_t *ghost_compressed = t8_element_array_index_locidx (ghosts_compressed, ighost);
+      EXPECT_EQ (ts->t8_element_compare (ghost, ghost_compressed), 0);
+      EXPECT_EQ (ts->t8_element_level (ghost), ts->t8_element_level (ghost_compressed));
+    }
+  }
+  t8_forest_unref (&forest);
+  t8_forest_unref (&forest_compressed);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_compress_messages, forest_compress_messages,
+                          testing::Range (T8_ECLASS_LINE, T8_ECLASS_COUNT));
+/* *INDENT-ON* */
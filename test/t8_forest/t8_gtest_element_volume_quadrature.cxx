@@ -0,0 +1,173 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this file we test the quadrature based element volumes and face areas.
+ *  - hypercube:       On a uniform forest of the unit hypercube the quadrature
+ *                     volumes and face areas match the d-linear ones and the
+ *                     volumes sum up to 1.
+ *  - refined_sum:     For a single distorted tree the volumes of the level 1
+ *                     elements sum up to the volume of the tree.
+ *  - tree_volumes:    t8_forest_tree_element_volumes_quadrature gives the same
+ *                     volumes as t8_forest_element_volume_quadrature.
+ *  - tree_face_areas: t8_forest_tree_element_face_areas_quadrature gives the same
+ *                     areas as t8_forest_element_face_area_quadrature. */
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include <t8_eclass.h>
+#include <t8_forest.h>
+#include <t8_cmesh_vtk.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_geometry/t8_geometry_implementations/t8_geometry_linear.h>
+
+/* The number of quadrature points per direction */
+#define T8_TEST_QUADRATURE_POINTS 4
+
+/* *INDENT-OFF* */
+class element_volume_quadrature:public testing::TestWithParam <t8_eclass_t> {
+protected:
+  void SetUp () override {
+    eclass = GetParam ();
+    /* The pyramid geometry is not polynomial and its jacobian
+     * is approximated, thus the results are not exact. */
+    tolerance = eclass == T8_ECLASS_PYRAMID ? 1e-5 : 1e-12;
+  }
+
+  /* Build a forest of a single tree of the hypercube with distorted vertices. */
+  t8_forest_t distorted_forest (int level) {
+    t8_cmesh_t          hypercube, cmesh;
+
+    hypercube = t8_cmesh_new_hypercube (eclass, sc_MPI_COMM_WORLD, 0, 0, 0);
+    const int num_vertices = t8_eclass_num_vertices[eclass];
+    const double *hypercube_vertices = t8_cmesh_get_tree_vertices (hypercube, 0);
+    double vertices[3 * T8_ECLASS_MAX_CORNERS];
+    for (int i = 0; i < 3 * num_vertices; i++) {
+      vertices[i] = hypercube_vertices[i] + 0.05 * sin (i + 1);
+    }
+    t8_cmesh_destroy (&hypercube);
+
+    t8_cmesh_init (&cmesh);
+    t8_cmesh_register_geometry (cmesh, t8_geometry_linear_new (t8_eclass_to_dimension[eclass]));
+    t8_cmesh_set_tree_class (cmesh, 0, eclass);
+    t8_cmesh_set_tree_vertices (cmesh, 0, vertices, num_vertices);
+    t8_cmesh_commit (cmesh, sc_MPI_COMM_WORLD);
+    return t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), level, 0, sc_MPI_COMM_WORLD);
+  }
+
+  /* Sum up the quadrature volumes of all elements of a forest. */
+  double global_volume (t8_forest_t forest) {
+    double local_volume = 0, volume;
+
+    for (t8_locidx_t itree = 0; itree < t8_forest_get_num_local_trees (forest); itree++) {
+      for (t8_locidx_t ielement = 0; ielement < t8_forest_get_tree_num_elements (forest, itree); ielement++) {
+        const t8_element_t *element = t8_forest_get_element_in_tree (forest, itree, ielement);
+        local_volume += t8_forest_element_volume_quadrature (forest, itree, element,
+                                                             T8_TEST_QUADRATURE_POINTS);
+      }
+    }
+    const int mpiret = sc_MPI_Allreduce (&local_volume, &volume, 1, sc_MPI_DOUBLE, sc_MPI_SUM,
+                                         sc_MPI_COMM_WORLD);
+    SC_CHECK_MPI (mpiret);
+    return volume;
+  }
+
+  t8_eclass_t         eclass;
+  double              tolerance;
+};
+
+TEST_P (element_volume_quadrature, hypercube) {
+  t8_forest_t forest =
+    t8_forest_new_uniform (t8_cmesh_new_hypercube (eclass, sc_MPI_COMM_WORLD, 0, 0, 0),
+                           t8_scheme_new_default_cxx (), 2, 0, sc_MPI_COMM_WORLD);
+
+  for (t8_locidx_t itree = 0; itree < t8_forest_get_num_local_trees (forest); itree++) {
+    t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, t8_forest_get_tree_class (forest, itree));
+    for (t8_locidx_t ielement = 0; ielement < t8_forest_get_tree_num_elements (forest, itree); ielement++) {
+      const t8_element_t *element = t8_forest_get_element_in_tree (forest, itree, ielement);
+      EXPECT_NEAR (t8_forest_element_volume_quadrature (forest, itree, element, T8_TEST_QUADRATURE_POINTS),
+                   t8_forest_element_volume (forest, itree, element), tolerance);
+      for (int iface = 0; iface < ts->t8_element_num_faces (element); iface++) {
+        EXPECT_NEAR (t8_forest_element_face_area_quadrature (forest, itree, element, iface,
+                                                             T8_TEST_QUADRATURE_POINTS),
+                     t8_forest_element_face_area (forest, itree, element, iface), tolerance);
+      }
+    }
+  }
+  EXPECT_NEAR (global_volume (forest), 1, tolerance);
+  t8_forest_unref (&forest);
+}
+
+TEST_P (element_volume_quadrature, refined_sum) {
+  t8_forest_t         coarse = distorted_forest (0);
+  t8_forest_t         fine = distorted_forest (1);
+
+  EXPECT_NEAR (global_volume (fine), global_volume (coarse), tolerance);
+  t8_forest_unref (&coarse);
+  t8_forest_unref (&fine);
+}
+
+TEST_P (element_volume_quadrature, tree_volumes) {
+  t8_forest_t         forest = distorted_forest (2);
+
+  for (t8_locidx_t itree = 0; itree < t8_forest_get_num_local_trees (forest); itree++) {
+    const t8_locidx_t num_elements = t8_forest_get_tree_num_elements (forest, itree);
+    std::vector<double> volumes (num_elements);
+
+    t8_forest_tree_element_volumes_quadrature (forest, itree, T8_TEST_QUADRATURE_POINTS, volumes.data ());
+    for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+      const t8_element_t *element = t8_forest_get_element_in_tree (forest, itree, ielement);
+      EXPECT_DOUBLE_EQ (volumes[ielement],
+                        t8_forest_element_volume_quadrature (forest, itree, element, T8_TEST_QUADRATURE_POINTS));
+    }
+  }
+  t8_forest_unref (&forest);
+}
+
+TEST_P (element_volume_quadrature, tree_face_areas) {
+  t8_forest_t         forest = distorted_forest (2);
+  const int           max_num_faces = t8_eclass_max_num_faces[t8_eclass_to_dimension[eclass]];
+
+  for (t8_locidx_t itree = 0; itree < t8_forest_get_num_local_trees (forest); itree++) {
+    const t8_locidx_t num_elements = t8_forest_get_tree_num_elements (forest, itree);
+    const t8_eclass_t tree_class = t8_forest_get_tree_class (forest, itree);
+    t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, tree_class);
+    std::vector<double> areas (num_elements * max_num_faces);
+
+    t8_forest_tree_element_face_areas_quadrature (forest, itree, T8_TEST_QUADRATURE_POINTS, max_num_faces,
+                                                  areas.data ());
+    for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+      const t8_element_t *element = t8_forest_get_element_in_tree (forest, itree, ielement);
+      for (int iface = 0; iface < ts->t8_element_num_faces (element); iface++) {
+        EXPECT_DOUBLE_EQ (areas[ielement * max_num_faces + iface],
+                          t8_forest_element_face_area_quadrature (forest, itree, element, iface,
+                                                                  T8_TEST_QUADRATURE_POINTS));
+      }
+    }
+  }
+  t8_forest_unref (&forest);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_element_volume_quadrature, element_volume_quadrature,
+                          testing::Range (T8_ECLASS_LINE, T8_ECLASS_COUNT));
+/* *INDENT-ON* */
@@ -0,0 +1,117 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we build a uniform forest with ghost layer and geometry
+ * cache on a replicated hypercube cmesh. The cached centroids, volumes,
+ * face areas and face normals of the local and the ghost elements must
+ * equal the values computed by the t8_forest_element_* functions. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_forest.h>
+#include <t8_forest/t8_forest_ghost.h>
+#include <t8_forest/t8_forest_geometry_cache.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_cmesh/t8_cmesh_examples.h>
+
+/* *INDENT-OFF* */
+class forest_geometry_cache:public testing::TestWithParam <t8_eclass_t> {
+protected:
+  void SetUp () override {
+    eclass = GetParam ();
+    t8_forest_init (&forest);
+    t8_forest_set_cmesh (forest, t8_cmesh_new_hypercube (eclass, sc_MPI_COMM_WORLD, 0, 0, 0),
+                         sc_MPI_COMM_WORLD);
+    t8_forest_set_scheme (forest, t8_scheme_new_default_cxx ());
+    t8_forest_set_level (forest, 2);
+    t8_forest_set_ghost (forest, 1, T8_GHOST_FACES);
+    t8_forest_set_geometry_cache (forest, 1);
+    t8_forest_commit (forest);
+  }
+  void TearDown () override {
+    t8_forest_unref (&forest);
+  }
+
+  /* Compare the cache entries of element \a index with the computed values. */
+  void check_element (const t8_forest_geometry_cache_t *cache, t8_locidx_t ltreeid,
+                      const t8_element_t *element, t8_locidx_t index) {
+    t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, t8_forest_get_tree_class (forest, ltreeid));
+    double centroid[3], normal[3];
+    const int F = cache->max_num_faces;
+
+    t8_forest_element_centroid (forest, ltreeid, element, centroid);
+    for (int idim = 0; idim < 3; idim++) {
+      EXPECT_DOUBLE_EQ (cache->centroid[idim][index], centroid[idim]);
+    }
+    EXPECT_DOUBLE_EQ (cache->volume[index], t8_forest_element_volume (forest, ltreeid, element));
+    for (int iface = 0; iface < ts->t8_element_num_faces (element); iface++) {
+      EXPECT_DOUBLE_EQ (cache->face_area[index * F + iface],
+                        t8_forest_element_face_area (forest, ltreeid, element, iface));
+      t8_forest_element_face_normal (forest, ltreeid, element, iface, normal);
+      for (int idim = 0; idim < 3; idim++) {
+        EXPECT_DOUBLE_EQ (cache->face_normal[idim][index * F + iface], normal[idim]);
+      }
+    }
+  }
+
+  t8_forest_t         forest;
+  t8_eclass_t         eclass;
+};
+
+TEST_P (forest_geometry_cache, equals_element_functions) {
+  const t8_forest_geometry_cache_t *cache = t8_forest_get_geometry_cache (forest);
+  const t8_locidx_t num_local_trees = t8_forest_get_num_local_trees (forest);
+  t8_locidx_t index = 0;
+
+  ASSERT_TRUE (cache != NULL);
+  ASSERT_EQ (cache->num_local_elements, t8_forest_get_local_num_elements (forest));
+  ASSERT_EQ (cache->num_ghosts, t8_forest_get_num_ghosts (forest));
+  for (t8_locidx_t itree = 0; itree < num_local_trees; itree++) {
+    for (t8_locidx_t ielement = 0; ielement < t8_forest_get_tree_num_elements (forest, itree); ielement++) {
+      check_element (cache, itree, t8_forest_get_element_in_tree (forest, itree, ielement), index++);
+    }
+  }
+  /* The cmesh is replicated, thus we can compute the ghosts' geometry. */
+  for (t8_locidx_t ighost_tree = 0; ighost_tree < t8_forest_get_num_ghost_trees (forest); ighost_tree++) {
+    for (t8_locidx_t ighost = 0; ighost < t8_forest_ghost_tree_num_elements (forest, ighost_tree); ighost++) {
+      check_element (cache, num_local_trees + ighost_tree,
+                     t8_forest_ghost_get_element (forest, ighost_tree, ighost), index++);
+    }
+  }
+  EXPECT_EQ (index, cache->num_local_elements + cache->num_ghosts);
+}
+
+TEST_P (forest_geometry_cache, not_inherited) {
+  t8_forest_t forest_copy;
+
+  t8_forest_ref (forest);
+  t8_forest_init (&forest_copy);
+  t8_forest_set_copy (forest_copy, forest);
+  t8_forest_commit (forest_copy);
+  EXPECT_TRUE (t8_forest_get_geometry_cache (forest_copy) == NULL);
+  t8_forest_unref (&forest_copy);
+}
+
+/* Vertices have no ghosts, so we start with lines. */
+INSTANTIATE_TEST_SUITE_P (t8_gtest_forest_geometry_cache, forest_geometry_cache,
+                          testing::Range (T8_ECLASS_LINE, T8_ECLASS_COUNT));
+/* *INDENT-ON* */
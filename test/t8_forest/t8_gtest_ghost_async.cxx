@@ -0,0 +1,146 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we construct ghost layers asynchronously and complete them
+ * with t8_forest_ghost_wait. The ghost layers must equal the ghost layers
+ * that are constructed synchronously. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_forest.h>
+#include <t8_element_cxx.hxx>
+#include <t8_forest/t8_forest_ghost.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_forest/t8_forest_geometry_cache.h>
+#include "t8_gtest_adapt_callbacks.hxx"
+
+/* *INDENT-OFF* */
+class forest_ghost_async : public testing::TestWithParam<t8_eclass_t> {
+protected:
+  void SetUp () override {
+    t8_cmesh_t cmesh = t8_cmesh_new_hypercube (GetParam (), sc_MPI_COMM_WORLD, 0, 0, 0);
+    forest_from = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), 2, 0, sc_MPI_COMM_WORLD);
+    forest_from = t8_forest_new_adapt (forest_from, t8_test_refine_first_child, 1, 0, NULL);
+  }
+  void TearDown () override {
+    t8_forest_unref (&forest_from);
+  }
+
+  /* Partition forest_from and create ghosts */
+  t8_forest_t partition (int async, int geometry_cache = 0) {
+    t8_forest_t forest;
+
+    t8_forest_ref (forest_from);
+    t8_forest_init (&forest);
+    t8_forest_set_partition (forest, forest_from, 0);
+    t8_forest_set_ghost (forest, 1, T8_GHOST_FACES);
+    t8_forest_set_ghost_async (forest, async);
+    t8_forest_set_geometry_cache (forest, geometry_cache);
+    t8_forest_set_profiling (forest, 1);
+    t8_forest_commit (forest);
+    return forest;
+  }
+
+  /* Adapt a forest and update its ghosts */
+  t8_forest_t adapt (t8_forest_t forest, int async) {
+    t8_forest_t forest_adapt;
+
+    t8_forest_init (&forest_adapt);
+    t8_forest_set_adapt (forest_adapt, forest, t8_test_refine_first_child, 0);
+    t8_forest_set_ghost (forest_adapt, 1, T8_GHOST_FACES);
+    t8_forest_set_ghost_async (forest_adapt, async);
+    t8_forest_commit (forest_adapt);
+    return forest_adapt;
+  }
+
+  void check_ghosts (t8_forest_t forest, t8_forest_t forest_async) {
+    ASSERT_FALSE (t8_forest_ghost_is_pending (forest_async));
+    ASSERT_EQ (t8_forest_get_num_ghosts (forest), t8_forest_get_num_ghosts (forest_async));
+    ASSERT_EQ (t8_forest_ghost_num_trees (forest), t8_forest_ghost_num_trees (forest_async));
+    for (t8_locidx_t itree = 0; itree < t8_forest_ghost_num_trees (forest); itree++) {
+      t8_element_array_t *ghosts = t8_forest_ghost_get_tree_elements (forest, itree);
+      t8_element_array_t *ghosts_async = t8_forest_ghost_get_tree_elements (forest_async, itree);
+      t8_eclass_scheme_c *ts = t8_element_array_get_scheme (ghosts);
+      ASSERT_EQ (t8_element_array_get_count (ghosts), t8_element_array_get_count (ghosts_async));
+      for (size_t ighost = 0; ighost < t8_element_array_get_count (ghosts); ighost++) {
+        const t8_element_t *ghost = t8_element_array_index_locidx (ghosts, ighost);
+        const t8_element_t *ghost_async = t8_element_array_index_locidx (ghosts_async, ighost);
+        EXPECT_EQ (ts->t8_element_compare (ghost, ghost_async), 0);
+        EXPECT_EQ (ts->t8_element_level (ghost), ts->t8_element_level (ghost_async));
+      }
+    }
+  }
+
+  t8_forest_t forest_from;
+};
+
+TEST_P (forest_ghost_async, equals_synchronous) {
+  t8_forest_t forest = partition (0);
+  t8_forest_t forest_async = partition (1);
+
+  /* Complete the ghost layer */
+  t8_forest_ghost_wait (forest_async);
+  EXPECT_GE (t8_forest_profile_get_ghostexchange_waittime (forest_async), 0);
+  check_ghosts (forest, forest_async);
+
+  /* The ghosts of the adapted forest are updated asynchronously from the
+   * ghosts of its source */
+  forest = adapt (forest, 0);
+  forest_async = adapt (forest_async, 1);
+  t8_forest_ghost_wait (forest_async);
+  check_ghosts (forest, forest_async);
+
+  t8_forest_unref (&forest);
+  t8_forest_unref (&forest_async);
+}
+
+TEST_P (forest_ghost_async, destroy_pending) {
+  /* Destroying a forest completes its pending ghost layer */
+  t8_forest_t forest_async = partition (1);
+  t8_forest_unref (&forest_async);
+}
+
+TEST_P (forest_ghost_async, geometry_cache_in_wait) {
+  t8_forest_t forest_async = partition (1, 1);
+  /* Processes without local elements do not have a pending ghost layer */
+  const int is_pending = t8_forest_ghost_is_pending (forest_async);
+
+  /* The geometry cache is postponed until the ghost layer is complete */
+  EXPECT_TRUE (!is_pending || t8_forest_get_geometry_cache (forest_async) == nullptr);
+  /* Committing a forest from forest_async completes its ghost layer,
+   * but does not create its geometry cache */
+  t8_forest_ref (forest_async);
+  t8_forest_t forest_adapt = adapt (forest_async, 0);
+  EXPECT_FALSE (t8_forest_ghost_is_pending (forest_async));
+  EXPECT_TRUE (!is_pending || t8_forest_get_geometry_cache (forest_async) == nullptr);
+  /* Waiting creates the geometry cache */
+  t8_forest_ghost_wait (forest_async);
+  EXPECT_NE (t8_forest_get_geometry_cache (forest_async), nullptr);
+
+  t8_forest_unref (&forest_adapt);
+  t8_forest_unref (&forest_async);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_ghost_async, forest_ghost_async,
+                          testing::Range (T8_ECLASS_LINE, T8_ECLASS_COUNT));
+/* *INDENT-ON* */
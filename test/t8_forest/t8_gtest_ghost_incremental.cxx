@@ -0,0 +1,121 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we adapt a forest with ghost layer twice, such that the ghost
+ * layer of the adapted forests is updated from the previous ghost layer.
+ * The updated ghost layers must equal the ghost layers that are created from
+ * scratch for copies of the adapted forests. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_forest.h>
+#include <t8_element_cxx.hxx>
+#include <t8_forest/t8_forest_ghost.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include "t8_gtest_adapt_callbacks.hxx"
+
+/* *INDENT-OFF* */
+class forest_ghost_incremental : public testing::TestWithParam<std::tuple<t8_eclass_t, int>> {
+protected:
+  void SetUp () override {
+    t8_cmesh_t cmesh = t8_cmesh_new_hypercube (std::get<0> (GetParam ()), sc_MPI_COMM_WORLD, 0, 0, 0);
+    t8_forest_init (&forest);
+    t8_forest_set_cmesh (forest, cmesh, sc_MPI_COMM_WORLD);
+    t8_forest_set_scheme (forest, t8_scheme_new_default_cxx ());
+    t8_forest_set_level (forest, 2);
+    t8_forest_set_ghost (forest, 1, T8_GHOST_FACES);
+    t8_forest_commit (forest);
+  }
+  void TearDown () override {
+    t8_forest_unref (&forest);
+  }
+
+  /* Adapt forest and update its ghost layer */
+  void adapt () {
+    t8_forest_t forest_adapt;
+
+    t8_forest_init (&forest_adapt);
+    t8_forest_set_adapt (forest_adapt, forest, t8_test_adapt_mixed, 0);
+    t8_forest_set_ghost (forest_adapt, 1, T8_GHOST_FACES);
+    t8_forest_set_compress_messages (forest_adapt, std::get<1> (GetParam ()));
+    t8_forest_commit (forest_adapt);
+    forest = forest_adapt;
+  }
+
+  /* Copy forest and create the ghost layer from scratch */
+  t8_forest_t copy () {
+    t8_forest_t forest_copy;
+
+    t8_forest_ref (forest);
+    t8_forest_init (&forest_copy);
+    t8_forest_set_copy (forest_copy, forest);
+    t8_forest_set_ghost (forest_copy, 1, T8_GHOST_FACES);
+    t8_forest_commit (forest_copy);
+    return forest_copy;
+  }
+
+  /* Check that the ghosts and remotes of forest equal those of its copy */
+  void check_ghosts () {
+    t8_forest_t forest_copy = copy ();
+    int num_remotes, num_remotes_copy;
+
+    ASSERT_EQ (t8_forest_get_num_ghosts (forest), t8_forest_get_num_ghosts (forest_copy));
+    ASSERT_EQ (t8_forest_ghost_num_trees (forest), t8_forest_ghost_num_trees (forest_copy));
+    for (t8_locidx_t itree = 0; itree < t8_forest_ghost_num_trees (forest); itree++) {
+      t8_element_array_t *ghosts = t8_forest_ghost_get_tree_elements (forest, itree);
+      t8_element_array_t *ghosts_copy = t8_forest_ghost_get_tree_elements (forest_copy, itree);
+      t8_eclass_scheme_c *ts = t8_element_array_get_scheme (ghosts);
+      ASSERT_EQ (t8_forest_ghost_get_global_treeid (forest, itree),
+                 t8_forest_ghost_get_global_treeid (forest_copy, itree));
+      ASSERT_EQ (t8_element_array_get_count (ghosts), t8_element_array_get_count (ghosts_copy));
+      for (size_t ighost = 0; ighost < t8_element_array_get_count (ghosts); ighost++) {
+        const t8_element_t *ghost = t8_element_array_index_locidx (ghosts, ighost);
+        const t8_element_t *ghost_copy = t8_element_array_index_locidx (ghosts_copy, ighost);
+        EXPECT_EQ (ts->t8_element_compare (ghost, ghost_copy), 0);
+        EXPECT_EQ (ts->t8_element_level (ghost), ts->t8_element_level (ghost_copy));
+      }
+    }
+    const int *remotes = t8_forest_ghost_get_remotes (forest, &num_remotes);
+    const int *remotes_copy = t8_forest_ghost_get_remotes (forest_copy, &num_remotes_copy);
+    ASSERT_EQ (num_remotes, num_remotes_copy);
+    for (int iremote = 0; iremote < num_remotes; iremote++) {
+      EXPECT_EQ (remotes[iremote], remotes_copy[iremote]);
+    }
+    t8_forest_unref (&forest_copy);
+  }
+
+  t8_forest_t forest;
+};
+
+TEST_P (forest_ghost_incremental, equals_full_ghost) {
+  adapt ();
+  check_ghosts ();
+  /* Adapt again, now updating a ghost layer that was itself updated */
+  adapt ();
+  check_ghosts ();
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_ghost_incremental, forest_ghost_incremental,
+                          testing::Combine (testing::Range (T8_ECLASS_LINE, T8_ECLASS_COUNT),
+                                            testing::Values (0, 1)));
+/* *INDENT-ON* */
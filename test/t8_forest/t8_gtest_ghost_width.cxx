@@ -0,0 +1,180 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we construct ghost layers of width greater than one.
+ * A wider ghost layer must contain the ghosts of a narrower one, and
+ * t8_forest_ghost_exchange_data must fill the data of all ghosts.
+ * If the width exceeds the number of elements, all non-local elements
+ * must be ghosts. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_forest.h>
+#include <t8_element_cxx.hxx>
+#include <t8_forest/t8_forest_ghost.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include "t8_gtest_adapt_callbacks.hxx"
+
+/* The data that we exchange for each element */
+typedef struct
+{
+  t8_linearidx_t      linear_id;
+  int                 level;
+} t8_test_ghost_width_data_t;
+
+/* *INDENT-OFF* */
+class forest_ghost_width : public testing::TestWithParam<t8_eclass_t> {
+protected:
+  void SetUp () override {
+    cmesh = t8_cmesh_new_hypercube (GetParam (), sc_MPI_COMM_WORLD, 0, 0, 0);
+    scheme = t8_scheme_new_default_cxx ();
+  }
+  void TearDown () override {
+    t8_cmesh_unref (&cmesh);
+    t8_scheme_cxx_unref (&scheme);
+  }
+
+  /* Build a partitioned forest of the given level with ghosts of the given width */
+  t8_forest_t build (int level, int adapt, int ghost_width) {
+    t8_forest_t forest, forest_from;
+
+    t8_cmesh_ref (cmesh);
+    t8_scheme_cxx_ref (scheme);
+    forest_from = t8_forest_new_uniform (cmesh, scheme, level, 0, sc_MPI_COMM_WORLD);
+    if (adapt) {
+      forest_from = t8_forest_new_adapt (forest_from, t8_test_refine_first_child, 1, 0, NULL);
+    }
+    t8_forest_init (&forest);
+    t8_forest_set_partition (forest, forest_from, 0);
+    t8_forest_set_ghost_ext (forest, 1, T8_GHOST_FACES, 3, ghost_width);
+    t8_forest_commit (forest);
+    return forest;
+  }
+
+  /* Check whether an element is a ghost of forest in the tree with global id gtreeid */
+  int is_ghost (t8_forest_t forest, t8_gloidx_t gtreeid, const t8_element_t *element) {
+    const t8_locidx_t lghost_tree = t8_forest_ghost_get_ghost_treeid (forest, gtreeid);
+    if (lghost_tree < 0) {
+      return 0;
+    }
+    t8_element_array_t *ghosts = t8_forest_ghost_get_tree_elements (forest, lghost_tree);
+    t8_eclass_scheme_c *ts = t8_element_array_get_scheme (ghosts);
+    for (size_t ighost = 0; ighost < t8_element_array_get_count (ghosts); ighost++) {
+      const t8_element_t *ghost = t8_element_array_index_locidx (ghosts, ighost);
+      if (ts->t8_element_compare (ghost, element) == 0
+          && ts->t8_element_level (ghost) == ts->t8_element_level (element)) {
+        return 1;
+      }
+    }
+    return 0;
+  }
+
+  /* Check that all ghosts of forest are ghosts of forest_wide */
+  void check_contained (t8_forest_t forest, t8_forest_t forest_wide) {
+    ASSERT_LE (t8_forest_get_num_ghosts (forest), t8_forest_get_num_ghosts (forest_wide));
+    for (t8_locidx_t itree = 0; itree < t8_forest_ghost_num_trees (forest); itree++) {
+      t8_element_array_t *ghosts = t8_forest_ghost_get_tree_elements (forest, itree);
+      const t8_gloidx_t gtreeid = t8_forest_ghost_get_global_treeid (forest, itree);
+      for (size_t ighost = 0; ighost < t8_element_array_get_count (ghosts); ighost++) {
+        EXPECT_TRUE (is_ghost (forest_wide, gtreeid, t8_element_array_index_locidx (ghosts, ighost)));
+      }
+    }
+  }
+
+  /* Exchange the linear id and level of all elements and check them on the ghosts */
+  void check_exchange (t8_forest_t forest) {
+    const t8_locidx_t num_local = t8_forest_get_local_num_elements (forest);
+    const t8_locidx_t num_ghosts = t8_forest_get_num_ghosts (forest);
+    const int maxlevel = t8_forest_get_maxlevel (forest);
+    sc_array_t *data = sc_array_new_count (sizeof (t8_test_ghost_width_data_t), num_local + num_ghosts);
+    t8_test_ghost_width_data_t *entry;
+    t8_locidx_t index = 0;
+
+    for (t8_locidx_t itree = 0; itree < t8_forest_get_num_local_trees (forest); itree++) {
+      t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, t8_forest_get_tree_class (forest, itree));
+      for (t8_locidx_t ielem = 0; ielem < t8_forest_get_tree_num_elements (forest, itree); ielem++, index++) {
+        const t8_element_t *element = t8_forest_get_element_in_tree (forest, itree, ielem);
+        entry = (t8_test_ghost_width_data_t *) sc_array_index_int (data, index);
+        entry->linear_id = ts->t8_element_get_linear_id (element, maxlevel);
+        entry->level = ts->t8_element_level (element);
+      }
+    }
+    for (; index < num_local + num_ghosts; index++) {
+      entry = (t8_test_ghost_width_data_t *) sc_array_index_int (data, index);
+      entry->linear_id = 0;
+      entry->level = -1;
+    }
+
+    t8_forest_ghost_exchange_data (forest, data);
+
+    index = num_local;
+    for (t8_locidx_t itree = 0; itree < t8_forest_ghost_num_trees (forest); itree++) {
+      t8_element_array_t *ghosts = t8_forest_ghost_get_tree_elements (forest, itree);
+      t8_eclass_scheme_c *ts = t8_element_array_get_scheme (ghosts);
+      for (size_t ighost = 0; ighost < t8_element_array_get_count (ghosts); ighost++, index++) {
+        const t8_element_t *ghost = t8_element_array_index_locidx (ghosts, ighost);
+        entry = (t8_test_ghost_width_data_t *) sc_array_index_int (data, index);
+        EXPECT_EQ (entry->linear_id, ts->t8_element_get_linear_id (ghost, maxlevel));
+        EXPECT_EQ (entry->level, ts->t8_element_level (ghost));
+      }
+    }
+    sc_array_destroy (data);
+  }
+
+  t8_cmesh_t cmesh;
+  t8_scheme_cxx_t *scheme;
+};
+
+TEST_P (forest_ghost_width, layers_contained) {
+  t8_forest_t forest = build (2, 1, 1);
+  t8_forest_t forest_wide = build (2, 1, 2);
+  t8_forest_t forest_wider = build (2, 1, 3);
+
+  check_contained (forest, forest_wide);
+  check_contained (forest_wide, forest_wider);
+  check_exchange (forest_wide);
+  check_exchange (forest_wider);
+
+  t8_forest_unref (&forest);
+  t8_forest_unref (&forest_wide);
+  t8_forest_unref (&forest_wider);
+}
+
+TEST_P (forest_ghost_width, all_elements) {
+  /* No face path between two elements is longer than the number of elements */
+  t8_forest_t forest = build (1, 0, 1);
+  const int ghost_width = (int) t8_forest_get_global_num_elements (forest);
+  t8_forest_unref (&forest);
+
+  forest = build (1, 0, ghost_width);
+  if (t8_forest_get_local_num_elements (forest) > 0) {
+    EXPECT_EQ (t8_forest_get_num_ghosts (forest),
+               t8_forest_get_global_num_elements (forest) - t8_forest_get_local_num_elements (forest));
+  }
+  check_exchange (forest);
+  t8_forest_unref (&forest);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_ghost_width, forest_ghost_width,
+                          testing::Range (T8_ECLASS_LINE, T8_ECLASS_COUNT));
+/* *INDENT-ON* */
@@ -0,0 +1,119 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we partition a forest, create its ghost layer, adapt it and
+ * exchange ghost data once with point-to-point messages and once with
+ * neighborhood collectives. The resulting forests, ghost layers and
+ * exchanged data must be equal. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_forest.h>
+#include <t8_element_cxx.hxx>
+#include <t8_forest/t8_forest_ghost.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include "t8_gtest_adapt_callbacks.hxx"
+
+/* *INDENT-OFF* */
+class forest_neighbor_collectives : public testing::TestWithParam<t8_eclass_t> {
+protected:
+  void SetUp () override {
+    t8_cmesh_t cmesh = t8_cmesh_new_hypercube (GetParam (), sc_MPI_COMM_WORLD, 0, 0, 0);
+    forest_from = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), 2, 0, sc_MPI_COMM_WORLD);
+    forest_from = t8_forest_new_adapt (forest_from, t8_test_refine_first_child, 1, 0, NULL);
+  }
+  void TearDown () override {
+    t8_forest_unref (&forest_from);
+  }
+
+  /* Partition forest_from, create ghosts and adapt the result with ghosts */
+  t8_forest_t partition_and_adapt (int use_neighbor) {
+    t8_forest_t forest, forest_adapt;
+
+    t8_forest_ref (forest_from);
+    t8_forest_init (&forest);
+    t8_forest_set_partition (forest, forest_from, 0);
+    t8_forest_set_ghost (forest, 1, T8_GHOST_FACES);
+    t8_forest_set_neighbor_collectives (forest, use_neighbor);
+    t8_forest_commit (forest);
+
+    t8_forest_init (&forest_adapt);
+    t8_forest_set_adapt (forest_adapt, forest, t8_test_refine_first_child, 0);
+    t8_forest_set_ghost (forest_adapt, 1, T8_GHOST_FACES);
+    t8_forest_set_neighbor_collectives (forest_adapt, use_neighbor);
+    t8_forest_commit (forest_adapt);
+    return forest_adapt;
+  }
+
+  /* Exchange the global ids of the elements */
+  void exchange_ids (t8_forest_t forest, sc_array_t *ids) {
+    const t8_locidx_t num_local = t8_forest_get_local_num_elements (forest);
+    const t8_gloidx_t first_id = t8_forest_get_first_local_element_id (forest);
+
+    sc_array_init_count (ids, sizeof (t8_gloidx_t), num_local + t8_forest_get_num_ghosts (forest));
+    for (size_t ielem = 0; ielem < ids->elem_count; ielem++) {
+      *(t8_gloidx_t *) sc_array_index (ids, ielem) = (t8_locidx_t) ielem < num_local ? first_id + ielem : -1;
+    }
+    t8_forest_ghost_exchange_data (forest, ids);
+  }
+
+  t8_forest_t forest_from;
+};
+
+TEST_P (forest_neighbor_collectives, equals_point_to_point) {
+  t8_forest_t forest = partition_and_adapt (0);
+  t8_forest_t forest_neighbor = partition_and_adapt (1);
+  sc_array_t ids, ids_neighbor;
+
+  EXPECT_TRUE (t8_forest_is_equal (forest, forest_neighbor));
+  ASSERT_EQ (t8_forest_get_num_ghosts (forest), t8_forest_get_num_ghosts (forest_neighbor));
+  ASSERT_EQ (t8_forest_ghost_num_trees (forest), t8_forest_ghost_num_trees (forest_neighbor));
+  for (t8_locidx_t itree = 0; itree < t8_forest_ghost_num_trees (forest); itree++) {
+    t8_element_array_t *ghosts = t8_forest_ghost_get_tree_elements (forest, itree);
+    t8_element_array_t *ghosts_neighbor = t8_forest_ghost_get_tree_elements (forest_neighbor, itree);
+    t8_eclass_scheme_c *ts = t8_element_array_get_scheme (ghosts);
+    ASSERT_EQ (t8_element_array_get_count (ghosts), t8_element_array_get_count (ghosts_neighbor));
+    for (size_t ighost = 0; ighost < t8_element_array_get_count (ghosts); ighost++) {
+      const t8_element_t *ghost = t8_element_array_index_locidx (ghosts, ighost);
+      const t8_element_t *ghost_neighbor = t8_element_array_index_locidx (ghosts_neighbor, ighost);
+      EXPECT_EQ (ts->t8_element_compare (ghost, ghost_neighbor), 0);
+      EXPECT_EQ (ts->t8_element_level (ghost), ts->t8_element_level (ghost_neighbor));
+    }
+  }
+
+  exchange_ids (forest, &ids);
+  exchange_ids (forest_neighbor, &ids_neighbor);
+  ASSERT_EQ (ids.elem_count, ids_neighbor.elem_count);
+  for (size_t ielem = 0; ielem < ids.elem_count; ielem++) {
+    EXPECT_GE (*(t8_gloidx_t *) sc_array_index (&ids, ielem), 0);
+    EXPECT_EQ (*(t8_gloidx_t *) sc_array_index (&ids, ielem), *(t8_gloidx_t *) sc_array_index (&ids_neighbor, ielem));
+  }
+  sc_array_reset (&ids);
+  sc_array_reset (&ids_neighbor);
+  t8_forest_unref (&forest);
+  t8_forest_unref (&forest_neighbor);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_neighbor_collectives, forest_neighbor_collectives,
+                          testing::Range (T8_ECLASS_LINE, T8_ECLASS_COUNT));
+/* *INDENT-ON* */
@@ -0,0 +1,122 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we partition two fields of element data asynchronously
+ * with t8_forest_partition_data_begin/end. We check that the data of the
+ * ranges that are reported as valid is correct before the transfer is
+ * finished and that all data is correct afterwards. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_forest.h>
+#include <t8_forest/t8_forest_partition.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include "t8_gtest_adapt_callbacks.hxx"
+
+/* Check the data of local elements first to end - 1 of the new forest */
+static void
+t8_test_check_range (const sc_array_t *ids, const sc_array_t *values,
+                     t8_gloidx_t first_global, t8_locidx_t first,
+                     t8_locidx_t end)
+{
+  for (t8_locidx_t ielement = first; ielement < end; ielement++) {
+    const t8_gloidx_t global_id = first_global + ielement;
+    EXPECT_EQ (*(t8_gloidx_t *) sc_array_index_int ((sc_array_t *) ids, ielement), global_id);
+    EXPECT_EQ (*(double *) sc_array_index_int ((sc_array_t *) values, ielement), 0.5 * global_id);
+  }
+}
+
+/* *INDENT-OFF* */
+class forest_partition_data_async : public testing::TestWithParam<t8_eclass_t> {
+protected:
+  void SetUp () override {
+    t8_cmesh_t cmesh = t8_cmesh_new_hypercube (GetParam (), sc_MPI_COMM_WORLD, 0, 0, 0);
+    forest_from = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), 2, 0, sc_MPI_COMM_WORLD);
+    forest_from = t8_forest_new_adapt (forest_from, t8_test_refine_first_child, 0, 0, NULL);
+    t8_forest_ref (forest_from);
+    t8_forest_init (&forest_to);
+    t8_forest_set_partition (forest_to, forest_from, 0);
+    t8_forest_commit (forest_to);
+  }
+  void TearDown () override {
+    t8_forest_unref (&forest_from);
+    t8_forest_unref (&forest_to);
+  }
+
+  t8_forest_t forest_from, forest_to;
+};
+
+TEST_P (forest_partition_data_async, data_is_transferred) {
+  const t8_locidx_t num_from = t8_forest_get_local_num_elements (forest_from);
+  const t8_locidx_t num_to = t8_forest_get_local_num_elements (forest_to);
+  const t8_gloidx_t first_from = t8_forest_get_first_local_element_id (forest_from);
+  const t8_gloidx_t first_to = t8_forest_get_first_local_element_id (forest_to);
+  sc_array_t ids_in, values_in, ids_out, values_out;
+  t8_locidx_t first, end;
+
+  sc_array_init_size (&ids_in, sizeof (t8_gloidx_t), num_from);
+  sc_array_init_size (&values_in, sizeof (double), num_from);
+  for (t8_locidx_t ielement = 0; ielement < num_from; ielement++) {
+    *(t8_gloidx_t *) sc_array_index_int (&ids_in, ielement) = first_from + ielement;
+    *(double *) sc_array_index_int (&values_in, ielement) = 0.5 * (first_from + ielement);
+  }
+  sc_array_init_size (&ids_out, sizeof (t8_gloidx_t), num_to);
+  sc_array_init_size (&values_out, sizeof (double), num_to);
+
+  const sc_array_t *data_in[2] = { &ids_in, &values_in };
+  sc_array_t *data_out[2] = { &ids_out, &values_out };
+  t8_forest_partition_data_context_t context =
+    t8_forest_partition_data_begin (forest_from, forest_to, 2, data_in, data_out);
+
+  /* The ranges cover all local elements in order */
+  const int num_ranges = t8_forest_partition_data_num_ranges (context);
+  t8_locidx_t covered = 0;
+  for (int irange = 0; irange < num_ranges; irange++) {
+    t8_forest_partition_data_get_range (context, irange, &first, &end);
+    EXPECT_EQ (first, covered);
+    EXPECT_LT (first, end);
+    covered = end;
+  }
+  EXPECT_EQ (covered, num_to);
+
+  /* Check the ranges that are already valid */
+  t8_forest_partition_data_test (context);
+  for (int irange = 0; irange < num_ranges; irange++) {
+    if (t8_forest_partition_data_get_range (context, irange, &first, &end)) {
+      t8_test_check_range (&ids_out, &values_out, first_to, first, end);
+    }
+  }
+
+  t8_forest_partition_data_end (&context);
+  EXPECT_TRUE (context == NULL);
+  t8_test_check_range (&ids_out, &values_out, first_to, 0, num_to);
+
+  sc_array_reset (&ids_in);
+  sc_array_reset (&values_in);
+  sc_array_reset (&ids_out);
+  sc_array_reset (&values_out);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_partition_data_async, forest_partition_data_async,
+                          testing::Range (T8_ECLASS_LINE, T8_ECLASS_COUNT));
+/* *INDENT-ON* */
@@ -0,0 +1,114 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we partition element data of variable size with
+ * t8_forest_partition_data_variable. Each element carries a number of bytes
+ * depending on its global id and the values of the bytes are derived
+ * from the global id as well, so that we can check the data after
+ * partitioning. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_forest.h>
+#include <t8_forest/t8_forest_partition.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include "t8_gtest_adapt_callbacks.hxx"
+
+/* The number of bytes of an element */
+static size_t
+t8_test_data_size (t8_gloidx_t global_id)
+{
+  return global_id % 7;
+}
+
+/* The value of a byte of an element */
+static char
+t8_test_data_value (t8_gloidx_t global_id, size_t ibyte)
+{
+  return (char) ((global_id + 3 * ibyte) % 128);
+}
+
+/* *INDENT-OFF* */
+class forest_partition_data_variable : public testing::TestWithParam<t8_eclass_t> {
+protected:
+  void SetUp () override {
+    t8_cmesh_t cmesh = t8_cmesh_new_hypercube (GetParam (), sc_MPI_COMM_WORLD, 0, 0, 0);
+    forest_from = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), 2, 0, sc_MPI_COMM_WORLD);
+    forest_from = t8_forest_new_adapt (forest_from, t8_test_refine_first_child, 0, 0, NULL);
+    t8_forest_ref (forest_from);
+    t8_forest_init (&forest_to);
+    t8_forest_set_partition (forest_to, forest_from, 0);
+    t8_forest_commit (forest_to);
+  }
+  void TearDown () override {
+    t8_forest_unref (&forest_from);
+    t8_forest_unref (&forest_to);
+  }
+
+  t8_forest_t forest_from, forest_to;
+};
+
+TEST_P (forest_partition_data_variable, data_is_transferred) {
+  const t8_locidx_t num_from = t8_forest_get_local_num_elements (forest_from);
+  const t8_locidx_t num_to = t8_forest_get_local_num_elements (forest_to);
+  const t8_gloidx_t first_from = t8_forest_get_first_local_element_id (forest_from);
+  const t8_gloidx_t first_to = t8_forest_get_first_local_element_id (forest_to);
+  sc_array_t data_in, sizes_in, data_out, offsets_out;
+
+  sc_array_init (&data_in, 1);
+  sc_array_init_size (&sizes_in, sizeof (size_t), num_from);
+  for (t8_locidx_t ielement = 0; ielement < num_from; ielement++) {
+    const t8_gloidx_t global_id = first_from + ielement;
+    const size_t size = t8_test_data_size (global_id);
+    *(size_t *) sc_array_index_int (&sizes_in, ielement) = size;
+    char *data = (char *) sc_array_push_count (&data_in, size);
+    for (size_t ibyte = 0; ibyte < size; ibyte++) {
+      data[ibyte] = t8_test_data_value (global_id, ibyte);
+    }
+  }
+
+  sc_array_init (&data_out, 1);
+  sc_array_init (&offsets_out, sizeof (size_t));
+  t8_forest_partition_data_variable (forest_from, forest_to, &data_in, &sizes_in, &data_out, &offsets_out);
+
+  ASSERT_EQ (offsets_out.elem_count, (size_t) num_to + 1);
+  ASSERT_EQ (*(size_t *) sc_array_index_int (&offsets_out, num_to), data_out.elem_count);
+  for (t8_locidx_t ielement = 0; ielement < num_to; ielement++) {
+    const t8_gloidx_t global_id = first_to + ielement;
+    const size_t offset = *(size_t *) sc_array_index_int (&offsets_out, ielement);
+    const size_t size = *(size_t *) sc_array_index_int (&offsets_out, ielement + 1) - offset;
+    ASSERT_EQ (size, t8_test_data_size (global_id));
+    for (size_t ibyte = 0; ibyte < size; ibyte++) {
+      EXPECT_EQ (data_out.array[offset + ibyte], t8_test_data_value (global_id, ibyte));
+    }
+  }
+
+  sc_array_reset (&data_in);
+  sc_array_reset (&sizes_in);
+  sc_array_reset (&data_out);
+  sc_array_reset (&offsets_out);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_partition_data_variable, forest_partition_data_variable,
+                          testing::Range (T8_ECLASS_LINE, T8_ECLASS_COUNT));
+/* *INDENT-ON* */
@@ -0,0 +1,95 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we partition an adapted forest with set_for_coarsening
+ * and check that no family of leaf elements is split between processes.
+ * To this end, we coarsen every family once and compare the number of
+ * elements with the same forest that was coarsened on a single process. */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_forest.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_cmesh/t8_cmesh_examples.h>
+
+/* Refine all elements with even child id. Since this only depends on the
+ * element, the result is independent of the partition. */
+static int
+t8_test_refine_even_child (t8_forest_t forest, t8_forest_t forest_from,
+                           t8_locidx_t which_tree, t8_locidx_t lelement_id,
+                           t8_eclass_scheme_c *ts, const int is_family,
+                           const int num_elements, t8_element_t *elements[])
+{
+  return ts->t8_element_level (elements[0]) == 0
+    || ts->t8_element_child_id (elements[0]) % 2 == 0;
+}
+
+/* Coarsen every family. */
+static int
+t8_test_coarsen_family (t8_forest_t forest, t8_forest_t forest_from,
+                        t8_locidx_t which_tree, t8_locidx_t lelement_id,
+                        t8_eclass_scheme_c *ts, const int is_family,
+                        const int num_elements, t8_element_t *elements[])
+{
+  return is_family ? -1 : 0;
+}
+
+/* *INDENT-OFF* */
+class forest_partition_for_coarsening : public testing::TestWithParam<t8_eclass_t> {
+protected:
+  void SetUp () override {
+    eclass = GetParam ();
+  }
+
+  /* Build an adapted forest on comm. If for_coarsening is true,
+   * it is partitioned with set_for_coarsening. Coarsen all families of this
+   * forest once and return the global number of elements. */
+  t8_gloidx_t num_coarsened_elements (sc_MPI_Comm comm, int for_coarsening) {
+    t8_cmesh_t cmesh = t8_cmesh_new_hypercube (eclass, comm, 0, 0, 0);
+    t8_forest_t forest = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), 1, 0, comm);
+    forest = t8_forest_new_adapt (forest, t8_test_refine_even_child, 0, 0, NULL);
+    forest = t8_forest_new_adapt (forest, t8_test_refine_even_child, 0, 0, NULL);
+    if (for_coarsening) {
+      t8_forest_t forest_partition;
+      t8_forest_init (&forest_partition);
+      t8_forest_set_partition (forest_partition, forest, 1);
+      t8_forest_commit (forest_partition);
+      forest = forest_partition;
+    }
+    forest = t8_forest_new_adapt (forest, t8_test_coarsen_family, 0, 0, NULL);
+    const t8_gloidx_t num_elements = t8_forest_get_global_num_elements (forest);
+    t8_forest_unref (&forest);
+    return num_elements;
+  }
+
+  t8_eclass_t eclass;
+};
+
+TEST_P (forest_partition_for_coarsening, families_are_local) {
+  const t8_gloidx_t num_serial = num_coarsened_elements (sc_MPI_COMM_SELF, 0);
+  const t8_gloidx_t num_parallel = num_coarsened_elements (sc_MPI_COMM_WORLD, 1);
+  EXPECT_EQ (num_serial, num_parallel);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_partition_for_coarsening, forest_partition_for_coarsening,
+                          testing::Range (T8_ECLASS_LINE, T8_ECLASS_COUNT));
+/* *INDENT-ON* */
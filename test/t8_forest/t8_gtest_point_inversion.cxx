@@ -0,0 +1,168 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this file we test the point inversion of elements.
+ *  - linear:  On a uniform forest of the hypercube the centroid of each element
+ *             lies inside of it and t8_forest_locate_points finds the element.
+ *             A point far away lies inside no element.
+ *  - curved:  On a quad with an analytic, curved geometry we map a reference
+ *             point of each element to physical space. Inverting the geometry
+ *             must give back the reference point and t8_forest_locate_points
+ *             must find the element. */
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include <t8_eclass.h>
+#include <t8_forest.h>
+#include <t8_forest/t8_forest_iterate.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_geometry/t8_geometry_implementations/t8_geometry_analytic.hxx>
+
+/* *INDENT-OFF* */
+class point_inversion:public testing::TestWithParam <t8_eclass_t> {
+protected:
+  void SetUp () override {
+    eclass = GetParam ();
+    forest = t8_forest_new_uniform (t8_cmesh_new_hypercube (eclass, sc_MPI_COMM_WORLD, 0, 0, 0),
+                                    t8_scheme_new_default_cxx (), 2, 0, sc_MPI_COMM_WORLD);
+  }
+  void TearDown () override {
+    t8_forest_unref (&forest);
+  }
+  t8_forest_t         forest;
+  t8_eclass_t         eclass;
+};
+
+TEST_P (point_inversion, linear) {
+  const double        tolerance = 1e-10;
+  const t8_locidx_t   num_elements = t8_forest_get_local_num_elements (forest);
+  std::vector<double> centroids (3 * num_elements);
+  std::vector<t8_locidx_t> element_index (num_elements);
+  std::vector<double> ref_coords (3 * num_elements);
+  double              far_point[3];
+  double              ref[3];
+  int                 is_inside;
+
+  for (t8_locidx_t itree = 0, index = 0; itree < t8_forest_get_num_local_trees (forest); itree++) {
+    for (t8_locidx_t ielement = 0; ielement < t8_forest_get_tree_num_elements (forest, itree);
+         ielement++, index++) {
+      const t8_element_t *element = t8_forest_get_element_in_tree (forest, itree, ielement);
+      double *centroid = &centroids[3 * index];
+      t8_forest_element_centroid (forest, itree, element, centroid);
+      t8_forest_element_points_reference_coords (forest, itree, element, centroid, 1, tolerance,
+                                                 ref, &is_inside);
+      EXPECT_TRUE (is_inside);
+      EXPECT_TRUE (t8_forest_element_point_inside (forest, itree, element, centroid, tolerance));
+      for (int idim = 0; idim < 3; idim++) {
+        far_point[idim] = centroid[idim] + 10;
+      }
+      t8_forest_element_points_reference_coords (forest, itree, element, far_point, 1, tolerance,
+                                                 ref, &is_inside);
+      EXPECT_FALSE (is_inside);
+    }
+  }
+  t8_forest_locate_points (forest, centroids.data (), num_elements, tolerance, element_index.data (),
+                           ref_coords.data ());
+  for (t8_locidx_t index = 0; index < num_elements; index++) {
+    EXPECT_EQ (element_index[index], index);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_point_inversion, point_inversion, testing::Range (T8_ECLASS_LINE, T8_ECLASS_COUNT));
+
+/* A curved map of the unit square. */
+static void
+t8_test_curved_quad (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords,
+                     double out_coords[3], const void *tree_data, const void *user_data)
+{
+  out_coords[0] = ref_coords[0] + 0.1 * sin (M_PI * ref_coords[1]);
+  out_coords[1] = ref_coords[1] + 0.1 * sin (M_PI * ref_coords[0]);
+  out_coords[2] = 0;
+}
+
+static void
+t8_test_curved_quad_jacobian (t8_cmesh_t cmesh, t8_gloidx_t gtreeid, const double *ref_coords,
+                              double *jacobian, const void *tree_data, const void *user_data)
+{
+  jacobian[0] = 1;
+  jacobian[1] = 0.1 * M_PI * cos (M_PI * ref_coords[0]);
+  jacobian[2] = 0;
+  jacobian[3] = 0.1 * M_PI * cos (M_PI * ref_coords[1]);
+  jacobian[4] = 1;
+  jacobian[5] = 0;
+}
+
+TEST (point_inversion, curved) {
+  const double        tolerance = 1e-10;
+  const double        element_ref[3] = { 0.3, 0.7, 0 };
+  t8_cmesh_t          cmesh;
+  t8_forest_t         curved_forest;
+  double              corners[4][3], tree_ref[3], ref[3];
+  int                 is_inside;
+
+  t8_cmesh_init (&cmesh);
+  t8_cmesh_register_geometry (cmesh, new t8_geometry_analytic (2, "t8_test_curved_quad", t8_test_curved_quad,
+                                                               t8_test_curved_quad_jacobian, NULL, NULL));
+  t8_cmesh_set_tree_class (cmesh, 0, T8_ECLASS_QUAD);
+  t8_cmesh_commit (cmesh, sc_MPI_COMM_WORLD);
+  curved_forest = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), 3, 0, sc_MPI_COMM_WORLD);
+
+  const t8_locidx_t   num_elements = t8_forest_get_local_num_elements (curved_forest);
+  std::vector<double> points (3 * num_elements);
+  std::vector<t8_locidx_t> element_index (num_elements);
+  std::vector<double> ref_coords (3 * num_elements);
+  t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (curved_forest, T8_ECLASS_QUAD);
+
+  for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+    const t8_element_t *element = t8_forest_get_element_in_tree (curved_forest, 0, ielement);
+    double *point = &points[3 * ielement];
+    /* Map the reference point bilinearly into the tree and from there with the geometry. */
+    for (int icorner = 0; icorner < 4; icorner++) {
+      ts->t8_element_vertex_reference_coords (element, icorner, corners[icorner]);
+    }
+    for (int idim = 0; idim < 3; idim++) {
+      tree_ref[idim] = (1 - element_ref[0]) * (1 - element_ref[1]) * corners[0][idim]
+        + element_ref[0] * (1 - element_ref[1]) * corners[1][idim]
+        + (1 - element_ref[0]) * element_ref[1] * corners[2][idim]
+        + element_ref[0] * element_ref[1] * corners[3][idim];
+    }
+    t8_test_curved_quad (cmesh, 0, tree_ref, point, NULL, NULL);
+
+    t8_forest_element_points_reference_coords (curved_forest, 0, element, point, 1, tolerance, ref,
+                                               &is_inside);
+    EXPECT_TRUE (is_inside);
+    EXPECT_NEAR (ref[0], element_ref[0], 1e-8);
+    EXPECT_NEAR (ref[1], element_ref[1], 1e-8);
+    EXPECT_TRUE (t8_forest_element_point_inside (curved_forest, 0, element, point, tolerance));
+  }
+  t8_forest_locate_points (curved_forest, points.data (), num_elements, tolerance, element_index.data (),
+                           ref_coords.data ());
+  for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+    EXPECT_EQ (element_index[ielement], ielement);
+    EXPECT_NEAR (ref_coords[3 * ielement], element_ref[0], 1e-8);
+    EXPECT_NEAR (ref_coords[3 * ielement + 1], element_ref[1], 1e-8);
+  }
+  t8_forest_unref (&curved_forest);
+}
+/* *INDENT-ON* */
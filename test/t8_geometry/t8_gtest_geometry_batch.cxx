@@ -0,0 +1,121 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this file we test the batched geometry evaluation.
+ *  - batch_equals_single: Evaluating many points of a tree with
+ *                         t8_geometry_evaluate_batch gives the same result as
+ *                         evaluating them one by one with t8_geometry_evaluate.
+ *  - tree_coordinates:    t8_forest_tree_element_coordinates gives the same
+ *                         vertex coordinates as t8_forest_element_coordinate.
+ * We use a single tree of each eclass with distorted vertices and the linear geometry. */
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <cmath>
+#include <t8_eclass.h>
+#include <t8_forest.h>
+#include <t8_cmesh_vtk.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_geometry/t8_geometry.h>
+#include <t8_geometry/t8_geometry_implementations/t8_geometry_linear.h>
+
+/* *INDENT-OFF* */
+class geometry_batch:public testing::TestWithParam <t8_eclass_t> {
+protected:
+  void SetUp () override {
+    t8_cmesh_t          hypercube;
+
+    eclass = GetParam ();
+    /* Copy and distort the vertices of the hypercube's first tree. */
+    hypercube = t8_cmesh_new_hypercube (eclass, comm, 0, 0, 0);
+    const int num_vertices = t8_eclass_num_vertices[eclass];
+    const double *hypercube_vertices = t8_cmesh_get_tree_vertices (hypercube, 0);
+    double vertices[3 * T8_ECLASS_MAX_CORNERS];
+    for (int i = 0; i < 3 * num_vertices; i++) {
+      vertices[i] = hypercube_vertices[i] + 0.05 * sin (i + 1);
+    }
+    t8_cmesh_destroy (&hypercube);
+
+    t8_cmesh_init (&cmesh);
+    t8_cmesh_register_geometry (cmesh, t8_geometry_linear_new (t8_eclass_to_dimension[eclass]));
+    t8_cmesh_set_tree_class (cmesh, 0, eclass);
+    t8_cmesh_set_tree_vertices (cmesh, 0, vertices, num_vertices);
+    t8_cmesh_commit (cmesh, comm);
+  }
+  void TearDown () override {
+    t8_cmesh_destroy (&cmesh);
+  }
+  t8_cmesh_t          cmesh;
+  t8_eclass_t         eclass;
+  sc_MPI_Comm         comm = sc_MPI_COMM_WORLD;
+};
+
+TEST_P (geometry_batch, batch_equals_single) {
+  const size_t        num_points = 100;
+  std::vector<double> ref_coords (3 * num_points);
+  std::vector<double> out_batch (3 * num_points);
+  double              out_single[3];
+
+  /* Deterministic points in [0,0.9)^3. We stay away from the tip of the pyramid. */
+  for (size_t i = 0; i < 3 * num_points; i++) {
+    ref_coords[i] = fmod (0.6180339887 * (i + 1), 0.9);
+  }
+  t8_geometry_evaluate_batch (cmesh, 0, ref_coords.data (), num_points, out_batch.data ());
+  for (size_t ipoint = 0; ipoint < num_points; ipoint++) {
+    t8_geometry_evaluate (cmesh, 0, &ref_coords[3 * ipoint], out_single);
+    for (int j = 0; j < 3; j++) {
+      EXPECT_NEAR (out_batch[3 * ipoint + j], out_single[j], 1e-12);
+    }
+  }
+}
+
+TEST_P (geometry_batch, tree_coordinates) {
+  t8_forest_t         forest;
+  const int           level = 2;
+  double              coords[3];
+
+  t8_cmesh_ref (cmesh);
+  forest = t8_forest_new_uniform (cmesh, t8_scheme_new_default_cxx (), level, 0, comm);
+  const int num_tree_corners = t8_eclass_num_vertices[eclass];
+  for (t8_locidx_t itree = 0; itree < t8_forest_get_num_local_trees (forest); itree++) {
+    const t8_locidx_t num_elements = t8_forest_get_tree_num_elements (forest, itree);
+    t8_eclass_scheme_c *ts = t8_forest_get_eclass_scheme (forest, t8_forest_get_tree_class (forest, itree));
+    std::vector<double> tree_coords (3 * num_tree_corners * num_elements);
+
+    t8_forest_tree_element_coordinates (forest, itree, tree_coords.data ());
+    for (t8_locidx_t ielement = 0; ielement < num_elements; ielement++) {
+      const t8_element_t *element = t8_forest_get_element_in_tree (forest, itree, ielement);
+      const int num_corners = ts->t8_element_num_corners (element);
+      for (int icorner = 0; icorner < num_corners; icorner++) {
+        t8_forest_element_coordinate (forest, itree, element, icorner, coords);
+        for (int j = 0; j < 3; j++) {
+          EXPECT_NEAR (tree_coords[3 * (num_tree_corners * ielement + icorner) + j], coords[j], 1e-12);
+        }
+      }
+    }
+  }
+  t8_forest_unref (&forest);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_geometry_batch, geometry_batch, testing::Range (T8_ECLASS_ZERO, T8_ECLASS_COUNT));
+/* *INDENT-ON* */
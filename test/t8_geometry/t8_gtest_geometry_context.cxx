@@ -0,0 +1,78 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this test we evaluate the geometry of a hypercube cmesh with two
+ * geometry contexts. One context always evaluates a tree and the other
+ * one its successor, such that both trees stay loaded. The results must
+ * equal the evaluation via the cmesh's own context. */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <t8_eclass.h>
+#include <t8_cmesh.h>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_geometry/t8_geometry.h>
+
+/* *INDENT-OFF* */
+class geometry_context:public testing::TestWithParam <t8_eclass_t> {
+protected:
+  void SetUp () override {
+    eclass = GetParam ();
+    cmesh = t8_cmesh_new_hypercube (eclass, sc_MPI_COMM_WORLD, 0, 0, 0);
+  }
+  void TearDown () override {
+    t8_cmesh_destroy (&cmesh);
+  }
+  t8_cmesh_t          cmesh;
+  t8_eclass_t         eclass;
+};
+
+TEST_P (geometry_context, alternating_trees) {
+  t8_geometry_context_t context_a, context_b;
+  const t8_gloidx_t   num_trees = t8_cmesh_get_num_trees (cmesh);
+  double              ref_coords[3];
+  double              out_a[3], out_b[3], out_a_ref[3], out_b_ref[3];
+
+  t8_geometry_context_init (&context_a, cmesh);
+  t8_geometry_context_init (&context_b, cmesh);
+  for (t8_gloidx_t itree = 0; itree < num_trees; itree++) {
+    const t8_gloidx_t   jtree = (itree + 1) % num_trees;
+    for (int ipoint = 0; ipoint < 10; ipoint++) {
+      for (int j = 0; j < 3; j++) {
+        ref_coords[j] = fmod (0.6180339887 * (3 * ipoint + j + 1), 0.9);
+      }
+      t8_geometry_context_evaluate (&context_a, itree, ref_coords, 1, out_a);
+      t8_geometry_context_evaluate (&context_b, jtree, ref_coords, 1, out_b);
+      EXPECT_EQ (context_a.gtreeid, itree);
+      EXPECT_EQ (context_b.gtreeid, jtree);
+      t8_geometry_evaluate (cmesh, itree, ref_coords, out_a_ref);
+      t8_geometry_evaluate (cmesh, jtree, ref_coords, out_b_ref);
+      for (int j = 0; j < 3; j++) {
+        EXPECT_EQ (out_a[j], out_a_ref[j]);
+        EXPECT_EQ (out_b[j], out_b_ref[j]);
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_geometry_context, geometry_context, testing::Range (T8_ECLASS_ZERO, T8_ECLASS_COUNT));
+/* *INDENT-ON* */
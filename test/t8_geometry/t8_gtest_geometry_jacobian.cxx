@@ -0,0 +1,96 @@
+/*
+  This file is part of t8code.
+  t8code is a C library to manage a collection (a forest) of multiple
+  connected adaptive space-trees of general element classes in parallel.
+
+  Copyright (C) 2015 the developers
+
+  t8code is free software; you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation; either version 2 of the License, or
+  (at your option) any later version.
+
+  t8code is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with t8code; if not, write to the Free Software Foundation, Inc.,
+  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/* In this file we test the jacobian of the linear geometry.
+ * For a single tree of each eclass with distorted vertices the jacobian
+ * computed by t8_geometry_jacobian must match central finite differences
+ * of t8_geometry_evaluate. */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <t8_eclass.h>
+#include <t8_cmesh.h>
+#include <t8_cmesh_vtk.h>
+#include <t8_cmesh/t8_cmesh_examples.h>
+#include <t8_geometry/t8_geometry.h>
+#include <t8_geometry/t8_geometry_implementations/t8_geometry_linear.h>
+
+/* *INDENT-OFF* */
+class geometry_jacobian:public testing::TestWithParam <t8_eclass_t> {
+protected:
+  void SetUp () override {
+    t8_cmesh_t          hypercube;
+
+    eclass = GetParam ();
+    /* Copy and distort the vertices of the hypercube's first tree. */
+    hypercube = t8_cmesh_new_hypercube (eclass, sc_MPI_COMM_WORLD, 0, 0, 0);
+    const int num_vertices = t8_eclass_num_vertices[eclass];
+    const double *hypercube_vertices = t8_cmesh_get_tree_vertices (hypercube, 0);
+    double vertices[3 * T8_ECLASS_MAX_CORNERS];
+    for (int i = 0; i < 3 * num_vertices; i++) {
+      vertices[i] = hypercube_vertices[i] + 0.05 * sin (i + 1);
+    }
+    t8_cmesh_destroy (&hypercube);
+
+    t8_cmesh_init (&cmesh);
+    t8_cmesh_register_geometry (cmesh, t8_geometry_linear_new (t8_eclass_to_dimension[eclass]));
+    t8_cmesh_set_tree_class (cmesh, 0, eclass);
+    t8_cmesh_set_tree_vertices (cmesh, 0, vertices, num_vertices);
+    t8_cmesh_commit (cmesh, sc_MPI_COMM_WORLD);
+  }
+  void TearDown () override {
+    t8_cmesh_destroy (&cmesh);
+  }
+  t8_cmesh_t          cmesh;
+  t8_eclass_t         eclass;
+};
+
+TEST_P (geometry_jacobian, finite_differences) {
+  const int           num_points = 20;
+  const int           dim = t8_eclass_to_dimension[eclass];
+  const double        h = 1e-6;
+  double              ref_coords[3], point[3], plus[3], minus[3];
+  double              jacobian[9];
+
+  for (int ipoint = 0; ipoint < num_points; ipoint++) {
+    /* Deterministic points in [0.1,0.8]^3, away from the boundary and the tip of the pyramid. */
+    for (int i = 0; i < 3; i++) {
+      ref_coords[i] = 0.1 + fmod (0.6180339887 * (3 * ipoint + i + 1), 0.7);
+    }
+    t8_geometry_jacobian (cmesh, 0, ref_coords, jacobian);
+    for (int idim = 0; idim < dim; idim++) {
+      for (int i = 0; i < 3; i++) {
+        point[i] = ref_coords[i];
+      }
+      point[idim] = ref_coords[idim] + h;
+      t8_geometry_evaluate (cmesh, 0, point, plus);
+      point[idim] = ref_coords[idim] - h;
+      t8_geometry_evaluate (cmesh, 0, point, minus);
+      for (int j = 0; j < 3; j++) {
+        EXPECT_NEAR (jacobian[3 * idim + j], (plus[j] - minus[j]) / (2 * h), 1e-5);
+      }
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_geometry_jacobian, geometry_jacobian, testing::Range (T8_ECLASS_LINE, T8_ECLASS_COUNT));
+/* *INDENT-ON* */
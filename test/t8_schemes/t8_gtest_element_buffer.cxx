@@ -0,0 +1,75 @@
+/*
+This file is part of t8code.
+t8code is a C library to manage a collection (a forest) of multiple
+connected adaptive space-trees of general element classes in parallel.
+
+Copyright (C) 2015 the developers
+
+t8code is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+t8code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with t8code; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/** \file t8_gtest_element_buffer.cxx
+ * Elements that are initialized in a caller provided buffer with
+ * t8_element_new_in_buffer must behave like elements from t8_element_new.
+ * We compute the children of a level 1 element in both ways and compare them.
+ */
+
+#include <gtest/gtest.h>
+#include <vector>
+#include <t8_eclass.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+
+/* *INDENT-OFF* */
+class element_buffer:public testing::TestWithParam <t8_eclass_t> {
+protected:
+  void SetUp () override {
+    eclass = GetParam ();
+    scheme = t8_scheme_new_default_cxx ();
+    ts = scheme->eclass_schemes[eclass];
+  }
+  void TearDown () override {
+    t8_scheme_cxx_unref (&scheme);
+  }
+  t8_scheme_cxx      *scheme;
+  t8_eclass_scheme_c *ts;
+  t8_eclass_t         eclass;
+};
+
+TEST_P (element_buffer, children_equal_new) {
+  t8_element_t       *element, *children[T8_ECLASS_MAX_CHILDREN];
+  t8_element_t       *buffer_children[T8_ECLASS_MAX_CHILDREN];
+  const size_t        element_size = ts->t8_element_size ();
+  std::vector<char>   buffer ((1 + T8_ECLASS_MAX_CHILDREN) * element_size);
+
+  /* The last element of the first level */
+  ts->t8_element_new_in_buffer (1, buffer.data (), &element);
+  ts->t8_element_set_linear_id (element, 1, ts->t8_element_count_leafs_from_root (1) - 1);
+  const int num_children = ts->t8_element_num_children (element);
+  ASSERT_LE (num_children, T8_ECLASS_MAX_CHILDREN);
+
+  ts->t8_element_new (num_children, children);
+  ts->t8_element_children (element, num_children, children);
+  ts->t8_element_new_in_buffer (num_children, buffer.data () + element_size, buffer_children);
+  ts->t8_element_children (element, num_children, buffer_children);
+  for (int ichild = 0; ichild < num_children; ichild++) {
+    EXPECT_EQ ((char *) buffer_children[ichild], buffer.data () + (1 + ichild) * element_size);
+    EXPECT_EQ (ts->t8_element_compare (children[ichild], buffer_children[ichild]), 0);
+    EXPECT_EQ (ts->t8_element_level (buffer_children[ichild]), 2);
+  }
+  ts->t8_element_destroy (num_children, children);
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_element_buffer, element_buffer, testing::Range (T8_ECLASS_ZERO, T8_ECLASS_COUNT));
+/* *INDENT-ON* */
@@ -0,0 +1,85 @@
+/*
+This file is part of t8code.
+t8code is a C library to manage a collection (a forest) of multiple
+connected adaptive space-trees of general element classes in parallel.
+
+Copyright (C) 2015 the developers
+
+t8code is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+t8code is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with t8code; if not, write to the Free Software Foundation, Inc.,
+51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+*/
+
+/** \file t8_gtest_sfc_iterator.cxx
+ * The SFC iterator must produce the same elements as consecutive calls to
+ * t8_element_successor. We start it at the first element and in the middle
+ * of a uniform level and compare it with the successor up to the last element.
+ */
+
+#include <gtest/gtest.h>
+#include <t8_eclass.h>
+#include <t8_schemes/t8_default/t8_default_cxx.hxx>
+
+/* *INDENT-OFF* */
+class sfc_iterator:public testing::TestWithParam <std::tuple<t8_eclass_t, int>> {
+protected:
+  void SetUp () override {
+    eclass = std::get<0> (GetParam ());
+    level = std::get<1> (GetParam ());
+    scheme = t8_scheme_new_default_cxx ();
+    ts = scheme->eclass_schemes[eclass];
+    if (eclass == T8_ECLASS_VERTEX) {
+      level = 0;
+    }
+    ts->t8_element_new (1, &element);
+    ts->t8_element_new (1, &successor);
+  }
+  void TearDown () override {
+    ts->t8_element_destroy (1, &element);
+    ts->t8_element_destroy (1, &successor);
+    t8_scheme_cxx_unref (&scheme);
+  }
+  t8_scheme_cxx      *scheme;
+  t8_eclass_scheme_c *ts;
+  t8_eclass_t         eclass;
+  int                 level;
+  t8_element_t       *element, *successor;
+};
+
+TEST_P (sfc_iterator, equals_successor) {
+  const t8_linearidx_t num_elements = ts->t8_element_count_leafs_from_root (level);
+  const t8_linearidx_t first_ids[2] = { 0, num_elements / 2 };
+
+  for (int istart = 0; istart < 2; istart++) {
+    t8_element_sfc_iterator_t iter;
+    t8_element_sfc_iterator_init (&iter, ts, level, first_ids[istart]);
+    ts->t8_element_set_linear_id (element, level, first_ids[istart]);
+    for (t8_linearidx_t id = first_ids[istart]; id < num_elements; id++) {
+      ASSERT_EQ (ts->t8_element_compare (t8_element_sfc_iterator_current (&iter), element), 0);
+      ASSERT_EQ (ts->t8_element_get_linear_id (t8_element_sfc_iterator_current (&iter), level), id);
+      if (id + 1 < num_elements) {
+        ASSERT_TRUE (t8_element_sfc_iterator_next (&iter));
+        ts->t8_element_successor (element, successor, level);
+        ts->t8_element_copy (successor, element);
+      }
+    }
+    /* The last element has no successor */
+    EXPECT_FALSE (t8_element_sfc_iterator_next (&iter));
+    t8_element_sfc_iterator_reset (&iter);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P (t8_gtest_sfc_iterator, sfc_iterator,
+                          testing::Combine (testing::Range (T8_ECLASS_ZERO, T8_ECLASS_COUNT),
+                                            testing::Range (1, 4)));
+/* *INDENT-ON* */